@@ -41,6 +41,10 @@ endif
 ifdef USE_LM32LOG
   USE_MMU := 1
 endif
+ifdef FG_DEEP_BUFFER
+  USE_MMU := 1
+  USE_SCU_EXTERN_RAM := 1
+endif
 
 ifdef NEW_ADDAC_HANDSHAKE
  DEFINES += _CONFIG_WAS_READ_FOR_ADDAC_DAQ
@@ -114,6 +118,14 @@ ifdef ADDAC_DAQ
      DEFINES += CONFIG_DIOB_WITH_DAQ
      VERSION_STR += "+DIOB-DAQ"
   endif
+  ifdef ADDAC_DAQ_BUDGET_US
+     DEFINES += CONFIG_DAQ_SERVICE_BUDGET_US=$(ADDAC_DAQ_BUDGET_US)
+     VERSION_STR += "+DSB"
+  endif
+endif
+ifdef FG_DEEP_BUFFER
+  DEFINES += CONFIG_FG_DEEP_BUFFER
+  VERSION_STR += "+DFB"
 endif
 ifdef USE_ADDAC_FG_TASK
   VERSION_STR += "+AFGT"
@@ -142,6 +154,9 @@ ifndef MIL_DAQ_USE_RAM
 endif
 SOURCE += $(SCU_DIR)/fg/scu_fg_macros.c
 SOURCE += $(SCU_DIR)/fg/scu_fg_handler.c
+ifdef FG_DEEP_BUFFER
+  SOURCE += $(SCU_DIR)/fg/scu_fg_deep_buffer.c
+endif
 SOURCE += $(SCU_DIR)/scu_command_handler.c
 SOURCE += $(SCU_DIR)/temperature/scu_temperature.c
 ifdef SCU_MIL
@@ -192,19 +207,19 @@ SOURCE += $(WR_DIR)/w1-hw.c
 ifdef ADDAC_DAQ
    ifdef MIL_DAQ_USE_RAM
     ifdef NEW_ADDAC_HANDSHAKE
-      SHARED_SIZE = 24832
+      SHARED_SIZE = 24844
     else
-      SHARED_SIZE = 24836
+      SHARED_SIZE = 24848
     endif
    else
     ifdef NEW_ADDAC_HANDSHAKE
-      SHARED_SIZE = 65776
+      SHARED_SIZE = 65788
     else
-      SHARED_SIZE = 65780
+      SHARED_SIZE = 65792
     endif
    endif
 else
-   SHARED_SIZE = 81920
+   SHARED_SIZE = 81932
 endif
 DOX_MACRO_EXPANSION = "YES"
 DOX_EXTRACT_STATIC         = "YES"
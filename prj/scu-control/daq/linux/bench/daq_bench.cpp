@@ -0,0 +1,925 @@
+/*!
+ * @file daq_bench.cpp
+ * @brief Throughput- and latency benchmark of the Linux DAQ receive paths.
+ *
+ * Measures the ADDAC-DAQ, the MIL-DAQ, the feedback tuple pairing,
+ * the DDR3 burst- and transparent reading and the multi-buffer
+ * against a simulated SCU (see scu_simulator.hpp and daq_simulator.hpp)
+ * or against a real SCU.
+ *
+ * Each benchmark prints one line in JSON format on stdout, so the results
+ * can be recorded and compared release over release:
+ * @code
+ * {"bench":"sdaq","duration_s":5.000,"blocks":1234,"blocks_per_s":246.8,
+ *  "tuples":...,"tuples_per_s":...,"wb_cycles_per_block":...,
+ *  "latency_us":{"p50":...,"p99":...,"p999":...}}
+ * @endcode
+ * The meaning of "blocks" depends on the benchmark:
+ * - sdaq:     Received ADDAC-DAQ data blocks, tuples are the data words.
+ * - sdaq_batched: Like sdaq, but with the batched reading of up to
+ *             SDAQ_DRAIN_BLOCK_BUDGET blocks per call of distributeData().
+ * - mdaq:     Received MIL-DAQ items, each item is one tuple.
+ * - feedback: Delivered set- and actual value tuples.
+ * - feedback_block: Calls of onDataBlock(), tuples are the delivered
+ *             set- and actual value tuples.
+ * - ddr3:     Read accesses, tuples are the read 64-bit words.
+ * - mubu:     Pull operations of the measured consumer, tuples are the
+ *             pulled items.
+ * - crc:      CRC checked blocks of the local CPU,
+ *             tuples are the payload words.
+ * - recorder: ADDAC-DAQ blocks written by daq::DaqRecorder in a temporary
+ *             file, tuples are the payload words.
+ * - replay:   ADDAC-DAQ blocks and MIL-DAQ items recorded from the target
+ *             and replayed as fast as possible by the simulated SCU,
+ *             tuples are the data words respectively items. It measures
+ *             the Linux receive path in isolation, the latency is not
+ *             measured.
+ *
+ * The latency is the time between the writing of the data by the LM32
+ * respectively by the producer and the invocation of the callback function.
+ * It is based on the time stamps of the data, therefore it's meaningful
+ * for the simulated SCU only, where the time stamps are taken from the
+ * system time of the host.
+ * The wishbone cycles are counted by the simulated SCU only,
+ * otherwise they are zero.
+ *
+ * Usage: daq_bench [net-address [seconds per benchmark]]
+ *
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <scu_fg_feedback.hpp>
+#include <scu_ddr3_access.hpp>
+#include <scu_wb_histogram.hpp>
+#include <daq_recorder.hpp>
+#include <TMubu.hpp>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace Scu;
+using namespace std;
+
+namespace
+{
+
+/*!
+ * @brief Default target: simulated SCU with two ADDAC devices and four
+ *        MIL function generators.
+ */
+constexpr char   DEFAULT_NET_ADDRESS[] = EB_SIMULATOR_PREFIX
+                                         "addac=2,mil=4,milrate=2000,speedup=10,tick=200";
+constexpr double DEFAULT_DURATION_S    = 5.0;
+
+/*!
+ * @brief Number of 64-bit words per read access of the DDR3 benchmark.
+ */
+constexpr uint   DDR3_READ_LEN         = 1024;
+
+/*!
+ * @brief Maximum number of ADDAC-DAQ blocks per call of distributeData()
+ *        in the batched benchmark.
+ * @see daq::DaqAdministration::setDrainBlockBudget
+ */
+constexpr uint   SDAQ_DRAIN_BLOCK_BUDGET = 16;
+
+constexpr std::size_t MUBU_CAPACITY    = 100000;
+constexpr std::size_t MUBU_CHUNK       = 64;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Collects the counters and latency samples of a single benchmark
+ *        and prints them in JSON format.
+ */
+class BenchResult
+{
+   const std::string m_name;
+   std::vector<double> m_vLatency;
+   daq::USEC_T       m_startTime;
+   daq::USEC_T       m_stopTime;
+   uint64_t          m_startCycles;
+   uint64_t          m_stopCycles;
+
+public:
+   uint64_t          m_blocks;
+   uint64_t          m_tuples;
+
+   BenchResult( const std::string& rName )
+      :m_name( rName )
+      ,m_startTime( 0 )
+      ,m_stopTime( 0 )
+      ,m_startCycles( 0 )
+      ,m_stopCycles( 0 )
+      ,m_blocks( 0 )
+      ,m_tuples( 0 )
+   {
+      m_vLatency.reserve( 1000000 );
+   }
+
+   void start( const uint64_t cycles = 0 )
+   {
+      m_startCycles = cycles;
+      m_startTime   = daq::getSysMicrosecs();
+   }
+
+   /*!
+    * @brief Returns the system time in microseconds at which the benchmark
+    *        of the given duration in seconds has to end.
+    */
+   daq::USEC_T getStopTime( const double duration ) const
+   {
+      return m_startTime + static_cast<daq::USEC_T>(duration * daq::MICROSECS_PER_SEC);
+   }
+
+   void stop( const uint64_t cycles = 0 )
+   {
+      m_stopTime   = daq::getSysMicrosecs();
+      m_stopCycles = cycles;
+   }
+
+   /*!
+    * @brief Adds a latency sample in microseconds.
+    */
+   void addLatency( const double latency )
+   {
+      m_vLatency.push_back( latency );
+   }
+
+   /*!
+    * @brief Adds the latency of a white rabbit time stamp in nanoseconds
+    *        related to the current system time.
+    */
+   void addTimestamp( const uint64_t timestamp )
+   {
+      addLatency( static_cast<double>(daq::getSysMicrosecs())
+                  - static_cast<double>(timestamp) / 1000.0 );
+   }
+
+   void print( std::ostream& out );
+
+private:
+   double percentile( const double p );
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Returns the given percentile of the collected latencies,
+ *        nearest rank method.
+ * @note The order of the samples becomes modified.
+ */
+double BenchResult::percentile( const double p )
+{
+   if( m_vLatency.empty() )
+      return 0.0;
+
+   std::size_t rank = static_cast<std::size_t>(std::ceil( p * m_vLatency.size() ));
+   rank = std::min( std::max( rank, static_cast<std::size_t>(1) ), m_vLatency.size() ) - 1;
+   std::nth_element( m_vLatency.begin(), m_vLatency.begin() + rank, m_vLatency.end() );
+   return m_vLatency[rank];
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void BenchResult::print( std::ostream& out )
+{
+   const double duration = static_cast<double>(m_stopTime - m_startTime)
+                           / daq::MICROSECS_PER_SEC;
+   const double cycles   = static_cast<double>(m_stopCycles - m_startCycles);
+
+   std::ostringstream line;
+   line << std::fixed << std::setprecision( 3 )
+        << "{\"bench\":\"" << m_name << '"'
+        << ",\"duration_s\":" << duration
+        << ",\"blocks\":" << m_blocks
+        << ",\"blocks_per_s\":" << ((duration > 0.0)? m_blocks / duration : 0.0)
+        << ",\"tuples\":" << m_tuples
+        << ",\"tuples_per_s\":" << ((duration > 0.0)? m_tuples / duration : 0.0)
+        << ",\"wb_cycles_per_block\":" << ((m_blocks != 0)? cycles / m_blocks : 0.0)
+        << ",\"latency_us\":{\"p50\":" << percentile( 0.5 )
+        << ",\"p99\":" << percentile( 0.99 )
+        << ",\"p999\":" << percentile( 0.999 )
+        << "}}";
+   out << line.str() << endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Etherbone connection of a single benchmark, each benchmark
+ *        starts with a new simulated SCU.
+ */
+class BenchConnection
+{
+   DaqEb::EtherboneConnection::EBC_PTR_T m_pEbc;
+
+public:
+   BenchConnection( const std::string& rAddress )
+      :m_pEbc( DaqEb::EtherboneConnection::getInstance( rAddress ) )
+   {
+      m_pEbc->connect();
+   }
+
+   ~BenchConnection( void )
+   {
+      if( m_pEbc->isConnected() )
+         m_pEbc->disconnect();
+      DaqEb::EtherboneConnection::releaseInstance( m_pEbc );
+   }
+
+   DaqEb::EtherboneConnection::EBC_PTR_T get( void )
+   {
+      return m_pEbc;
+   }
+
+   uint64_t getCycleCount( void ) const
+   {
+      return m_pEbc->getSimulatedCycleCount();
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief ADDAC-DAQ channel of the benchmark.
+ */
+class BenchDaqChannel: public daq::DaqChannel
+{
+   BenchResult& m_rResult;
+   const bool   m_measureLatency;
+
+public:
+   BenchDaqChannel( const uint number, BenchResult& rResult,
+                    const bool measureLatency )
+      :daq::DaqChannel( number )
+      ,m_rResult( rResult )
+      ,m_measureLatency( measureLatency )
+   {}
+
+   bool onDataBlock( daq::DAQ_DATA_T* pData, std::size_t wordLen ) override
+   {
+      m_rResult.m_blocks++;
+      m_rResult.m_tuples += wordLen;
+      if( m_measureLatency )
+         m_rResult.addTimestamp( descriptorGetTimeStamp() );
+      return false;
+   }
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief ADDAC-DAQ devices and channels of a benchmark.
+ */
+struct BENCH_DAQ_T
+{
+   std::vector<std::unique_ptr<daq::DaqDevice>>  m_vDevices;
+   std::vector<std::unique_ptr<BenchDaqChannel>> m_vChannels;
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Registers all channels of all found ADDAC devices and switches
+ *        them in continuous mode.
+ */
+void startAllDaqChannels( daq::DaqAdministration& rDaqAdmin, BENCH_DAQ_T& rDaq,
+                          BenchResult& rResult, const bool measureLatency = true )
+{
+   for( uint i = 1; i <= rDaqAdmin.getMaxFoundDevices(); i++ )
+   {
+      rDaq.m_vDevices.emplace_back( new daq::DaqDevice( rDaqAdmin.getSlotNumber( i ) ) );
+      rDaqAdmin.registerDevice( rDaq.m_vDevices.back().get() );
+      for( uint c = 1; c <= rDaqAdmin.readMaxChannels( i ); c++ )
+      {
+         rDaq.m_vChannels.emplace_back( new BenchDaqChannel( c, rResult,
+                                                             measureLatency ) );
+         rDaq.m_vDevices.back()->registerChannel( rDaq.m_vChannels.back().get() );
+      }
+   }
+   if( rDaq.m_vChannels.empty() )
+      throw daq::Exception( "No ADDAC-DAQ found!" );
+
+   for( auto& pChannel: rDaq.m_vChannels )
+      pChannel->sendEnableContineous( daq::DAQ_SAMPLE_1MS );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of daq::DaqAdministration::distributeData()
+ *        with all channels of all found ADDAC devices in continuous mode.
+ * @param drainBlockBudget Maximum number of blocks per call,
+ *        one means the one-block-per-call mode.
+ */
+void benchSdaq( const std::string& rName, const std::string& rAddress,
+                const double duration, const uint drainBlockBudget )
+{
+   BenchResult result( rName );
+   BenchConnection ebConnection( rAddress );
+   {
+      daq::DaqAdministration daqAdmin( ebConnection.get() );
+      daqAdmin.setCrcCheck();
+      daqAdmin.setDrainBlockBudget( drainBlockBudget );
+      BENCH_DAQ_T oDaq;
+      startAllDaqChannels( daqAdmin, oDaq, result );
+
+      result.start( ebConnection.getCycleCount() );
+      const daq::USEC_T stopTime = result.getStopTime( duration );
+      while( daq::getSysMicrosecs() < stopTime )
+         daqAdmin.distributeData();
+      result.stop( ebConnection.getCycleCount() );
+
+      const uint crcErrors = daqAdmin.getCrcErrorCount();
+      daqAdmin.sendReset();
+      if( crcErrors != 0 )
+         throw daq::Exception( std::to_string( crcErrors ) + " CRC errors!" );
+   }
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief MIL-DAQ compare object of the benchmark.
+ */
+class BenchMilCompare: public MiLdaq::DaqCompare
+{
+   BenchResult& m_rResult;
+
+public:
+   BenchMilCompare( const uint address, BenchResult& rResult )
+      :MiLdaq::DaqCompare( address )
+      ,m_rResult( rResult )
+   {}
+
+   void onData( uint64_t wrTimeStampTAI, MiLdaq::MIL_DAQ_T actlValue,
+                                         MiLdaq::MIL_DAQ_T setValue ) override
+   {
+      m_rResult.m_blocks++;
+      m_rResult.m_tuples++;
+      if( m_measureLatency )
+         m_rResult.addTimestamp( wrTimeStampTAI );
+   }
+
+   bool m_measureLatency = true;
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief MIL-DAQ devices and compare objects of a benchmark.
+ */
+struct BENCH_MIL_T
+{
+   std::map<uint, std::unique_ptr<MiLdaq::DaqDevice>> m_devices;
+   std::vector<std::unique_ptr<BenchMilCompare>>      m_vCompares;
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Registers compare objects of all found MIL function generators.
+ */
+void registerAllMilCompares( MiLdaq::DaqAdministrationFgList& rMilAdmin,
+                             BENCH_MIL_T& rMil, BenchResult& rResult,
+                             const bool measureLatency = true )
+{
+   for( const auto& fg: rMilAdmin.getFgList() )
+   {
+      if( !fg.isMIL() )
+         continue;
+      auto& rpDevice = rMil.m_devices[fg.getSocket()];
+      if( !rpDevice )
+      {
+         rpDevice.reset( new MiLdaq::DaqDevice( fg.getSocket() ) );
+         rMilAdmin.registerDevice( rpDevice.get() );
+      }
+      rMil.m_vCompares.emplace_back( new BenchMilCompare( fg.getDevice(), rResult ) );
+      rMil.m_vCompares.back()->m_measureLatency = measureLatency;
+      rpDevice->registerDaqCompare( rMil.m_vCompares.back().get() );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of MiLdaq::DaqAdministration::distributeData()
+ *        with all found MIL function generators.
+ */
+void benchMdaq( const std::string& rAddress, const double duration )
+{
+   BenchResult result( "mdaq" );
+   BenchConnection ebConnection( rAddress );
+   {
+      MiLdaq::DaqAdministrationFgList milAdmin( ebConnection.get() );
+      BENCH_MIL_T oMil;
+      registerAllMilCompares( milAdmin, oMil, result );
+      if( oMil.m_vCompares.empty() )
+         throw daq::Exception( "No MIL function generator found!" );
+
+      result.start( ebConnection.getCycleCount() );
+      const daq::USEC_T stopTime = result.getStopTime( duration );
+      while( daq::getSysMicrosecs() < stopTime )
+         milAdmin.distributeData();
+      result.stop( ebConnection.getCycleCount() );
+   }
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Feedback channel of the benchmark, receives the paired
+ *        set- and actual values.
+ */
+class BenchFeedbackChannel: public FgFeedbackChannel
+{
+   BenchResult& m_rResult;
+
+public:
+   BenchFeedbackChannel( const uint fgNumber, BenchResult& rResult )
+      :FgFeedbackChannel( fgNumber )
+      ,m_rResult( rResult )
+   {}
+
+   void onData( uint64_t wrTimeStampTAI, DAQ_T actlValue, DAQ_T setValue ) override
+   {
+      m_rResult.m_blocks++;
+      m_rResult.m_tuples++;
+      m_rResult.addTimestamp( wrTimeStampTAI );
+   }
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Feedback channel of the benchmark, receives the paired
+ *        set- and actual values in blocks.
+ */
+class BenchFeedbackBlockChannel: public FgFeedbackBlock
+{
+   BenchResult& m_rResult;
+
+public:
+   BenchFeedbackBlockChannel( const uint fgNumber, BenchResult& rResult )
+      :FgFeedbackBlock( fgNumber )
+      ,m_rResult( rResult )
+   {}
+
+   void onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                     const DAQ_SPAN_T& rActValues,
+                     const DAQ_SPAN_T& rSetValues ) override
+   {
+      m_rResult.m_blocks++;
+      m_rResult.m_tuples += rTimestamps.size();
+      m_rResult.addTimestamp( rTimestamps.back() );
+   }
+};
+
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of FgFeedbackAdministration::distributeData()
+ *        including the pairing of set- and actual values of all found
+ *        function generators.
+ *
+ * The ADDAC-DAQ channels of the function generators become started
+ * in continuous mode by a further DAQ administration object, because
+ * there is no running function generator which would do this on the LM32.
+ * @param CT BenchFeedbackChannel or BenchFeedbackBlockChannel
+ */
+template <typename CT>
+void benchFeedback( const std::string& rName, const std::string& rAddress,
+                    const double duration )
+{
+   BenchResult result( rName );
+   BenchConnection ebConnection( rAddress );
+   {
+      FgFeedbackAdministration fbAdmin( ebConnection.get(), false );
+      daq::DaqAdministration   daqCommand( ebConnection.get(), false );
+      std::map<uint, std::unique_ptr<FgFeedbackDevice>> devices;
+      std::vector<std::unique_ptr<CT>> vChannels;
+
+      for( const auto& fg: fbAdmin.getFgList() )
+      {
+         auto& rpDevice = devices[fg.getSocket()];
+         if( !rpDevice )
+            rpDevice.reset( new FgFeedbackDevice( fg.getSocket() ) );
+         vChannels.emplace_back( new CT( fg.getDevice(), result ) );
+         rpDevice->registerChannel( vChannels.back().get() );
+      }
+      if( vChannels.empty() )
+         throw daq::Exception( "No function generator found!" );
+
+      for( auto& rDevice: devices )
+      {
+         fbAdmin.registerDevice( rDevice.second.get() );
+         if( rDevice.second->isMil() )
+            continue;
+         for( const auto& pChannel: vChannels )
+         {
+            if( pChannel->getSocket() != rDevice.first )
+               continue;
+            const uint fgNumber = pChannel->getFgNumber();
+            const auto type     = rDevice.second->getTyp();
+            daqCommand.sendEnableContineous( rDevice.first,
+                          1 + daq::daqGetSetDaqNumberOfFg( fgNumber, type ),
+                          daq::DAQ_SAMPLE_1MS );
+            daqCommand.sendEnableContineous( rDevice.first,
+                          1 + daq::daqGetActualDaqNumberOfFg( fgNumber, type ),
+                          daq::DAQ_SAMPLE_1MS );
+         }
+      }
+
+      result.start( ebConnection.getCycleCount() );
+      const daq::USEC_T stopTime = result.getStopTime( duration );
+      while( daq::getSysMicrosecs() < stopTime )
+         fbAdmin.distributeData();
+      result.stop( ebConnection.getCycleCount() );
+
+      uint64_t unpaired = 0;
+      for( const auto& pChannel: vChannels )
+         unpaired += pChannel->getUnpairedBlockCount();
+      cerr << "Unpaired ADDAC blocks: " << unpaired << endl;
+
+      daqCommand.sendReset();
+   }
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of Ddr3Access::read() in burst-, transparent- or
+ *        self tuning mode.
+ * @param burstLimit Ddr3Access::ALWAYS_BURST, Ddr3Access::NEVER_BURST
+ *                   or Ddr3Access::AUTO_BURST
+ */
+void benchDdr3( const std::string& rAddress, const double duration,
+                const int burstLimit )
+{
+   BenchResult result( (burstLimit == Ddr3Access::NEVER_BURST)? "ddr3_transparent" :
+                       (burstLimit == Ddr3Access::AUTO_BURST)?  "ddr3_auto" : "ddr3_burst" );
+   BenchConnection ebConnection( rAddress );
+   {
+      Ddr3Access ddr3( ebConnection.get(), burstLimit );
+      std::vector<uint64_t> vBuffer( DDR3_READ_LEN );
+      const uint maxIndex = ddr3.getMaxCapacity64() - DDR3_READ_LEN;
+      uint index = 0;
+
+      result.start( ebConnection.getCycleCount() );
+      const daq::USEC_T stopTime = result.getStopTime( duration );
+      while( daq::getSysMicrosecs() < stopTime )
+      {
+         const daq::USEC_T t = daq::getSysMicrosecs();
+         ddr3.read( index, vBuffer.data(), DDR3_READ_LEN );
+         result.addLatency( static_cast<double>(daq::getSysMicrosecs() - t) );
+         result.m_blocks++;
+         result.m_tuples += DDR3_READ_LEN;
+         index += DDR3_READ_LEN;
+         if( index > maxIndex )
+            index = 0;
+      }
+      result.stop( ebConnection.getCycleCount() );
+
+      if( burstLimit == Ddr3Access::AUTO_BURST )
+      {
+         static const char* modeNames[Ddr3Access::READ_MODES] =
+            { "transparent", "burst", "split" };
+         const Ddr3Access::SIZE_CLASS_T model = ddr3.getCostModel( DDR3_READ_LEN );
+         for( uint mode = 0; mode < Ddr3Access::READ_MODES; mode++ )
+         {
+            cerr << "DDR3 " << modeNames[mode] << ": "
+                 << model.m_aCost[mode].m_nsPerWord << " ns/word, "
+                 << model.m_aCost[mode].m_samples << " samples" << endl;
+         }
+         cerr << "DDR3 preferred mode: "
+              << modeNames[ddr3.getPreferredReadMode( DDR3_READ_LEN )] << endl;
+      }
+   }
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of mubu::TMultiBuffer with one producer thread and
+ *        four buffers: The first one becomes emptied by the measured
+ *        consumer, two further ones by background consumer threads and
+ *        the last one becomes never read.
+ */
+void benchMubu( const double duration )
+{
+   using CLOCK_T = std::chrono::steady_clock;
+   using MUBU_T  = mubu::TMultiBuffer<CLOCK_T::time_point>;
+   constexpr uint BACKGROUND_CONSUMERS = 2;
+
+   BenchResult result( "mubu" );
+   MUBU_T mubu( MUBU_CAPACITY );
+   for( uint i = 0; i < BACKGROUND_CONSUMERS + 2; i++ )
+      mubu.createBuffer( i );
+
+   std::atomic<bool> stop( false );
+   std::thread producer( [&]()
+   {
+      MUBU_T::VECTOR_T vChunk( MUBU_CHUNK );
+      while( !stop )
+      {
+         std::fill( vChunk.begin(), vChunk.end(), CLOCK_T::now() );
+         mubu.push( vChunk );
+      }
+   });
+
+   std::vector<std::thread> vConsumers;
+   for( uint i = 1; i <= BACKGROUND_CONSUMERS; i++ )
+   {
+      vConsumers.emplace_back( [&mubu, &stop, i]()
+      {
+         MUBU_T::Buffer* pBuffer = mubu.getBuffer( i );
+         MUBU_T::VECTOR_T vReceived;
+         while( !stop )
+         {
+            vReceived.clear();
+            pBuffer->pull( vReceived, MUBU_CHUNK );
+         }
+      });
+   }
+
+   MUBU_T::VECTOR_T vReceived;
+   result.start();
+   const daq::USEC_T stopTime = result.getStopTime( duration );
+   while( daq::getSysMicrosecs() < stopTime )
+   {
+      vReceived.clear();
+      const std::size_t n = mubu.pull( 0, vReceived, MUBU_CHUNK );
+      if( n == 0 )
+         continue;
+      const auto now = CLOCK_T::now();
+      for( const auto& rTime: vReceived )
+         result.addLatency( std::chrono::duration<double, std::micro>( now - rTime ).count() );
+      result.m_blocks++;
+      result.m_tuples += n;
+   }
+   result.stop();
+   stop = true;
+   producer.join();
+   for( auto& rConsumer: vConsumers )
+      rConsumer.join();
+   for( uint i = 0; i < BACKGROUND_CONSUMERS + 2; i++ )
+      cerr << "Overruns of buffer " << i << ": " << mubu.getOverrunCount( i ) << endl;
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of the block CRC kernel daq::daqBlockCrc() over short
+ *        ADDAC-DAQ blocks, without any wishbone access.
+ *
+ * Before the measurement the SIMD kernel becomes compared with the
+ * scalar reference.
+ */
+void benchCrc( const double duration )
+{
+   constexpr std::size_t PAYLOAD_LEN = daq::DaqInterface::c_contineousDataLen -
+                                       daq::DaqInterface::c_discriptorWordSize;
+   constexpr std::size_t BLOCK_COUNT = 64;
+
+   std::vector<daq::DAQ_DATA_T> vBlocks( BLOCK_COUNT * daq::DaqInterface::c_contineousDataLen );
+   uint32_t seed = 4711;
+   for( auto& rWord: vBlocks )
+   {
+      seed = seed * 1103515245 + 12345;
+      rWord = static_cast<daq::DAQ_DATA_T>(seed >> 16);
+   }
+
+   for( std::size_t len = 0; len <= daq::DaqInterface::c_contineousDataLen; len++ )
+   {
+      if( daq::daqCrcSum( vBlocks.data(), len, daq::DAQ_CRC_START_VALUE ) !=
+          daq::daqCrcSumScalar( vBlocks.data(), len, daq::DAQ_CRC_START_VALUE ) )
+         throw daq::Exception( "SIMD CRC differs from scalar reference at length "
+                               + std::to_string( len ) );
+   }
+
+   BenchResult result( "crc" );
+   uint8_t dummy = 0;
+   result.start();
+   const daq::USEC_T stopTime = result.getStopTime( duration );
+   while( daq::getSysMicrosecs() < stopTime )
+   {
+      for( std::size_t i = 0; i < BLOCK_COUNT; i++ )
+      {
+         daq::DAQ_DATA_T* pBlock = &vBlocks[i * daq::DaqInterface::c_contineousDataLen];
+         const daq::USEC_T start = daq::getSysMicrosecs();
+         dummy ^= daq::daqBlockCrc( pBlock, PAYLOAD_LEN );
+         result.addLatency( static_cast<double>(daq::getSysMicrosecs() - start) );
+      }
+      result.m_blocks += BLOCK_COUNT;
+      result.m_tuples += BLOCK_COUNT * PAYLOAD_LEN;
+   }
+   result.stop();
+   cerr << "CRC: " << static_cast<uint>(dummy) << endl;
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of daq::DaqRecorder with synthetic ADDAC-DAQ blocks of
+ *        four channels, the latency is the duration of a single write call.
+ *
+ * After the measurement the file becomes read back by daq::DaqRecordFile
+ * and the number of records and channels become verified.
+ */
+void benchRecorder( const double duration )
+{
+   constexpr std::size_t PAYLOAD_LEN = daq::DaqInterface::c_contineousDataLen -
+                                       daq::DaqInterface::c_discriptorWordSize;
+   constexpr uint        CHANNELS    = 4;
+
+   const std::string fileName = "/tmp/daq_bench_" + std::to_string( ::getpid() ) + ".rec";
+   std::vector<daq::DAQ_DATA_T> vPayload( PAYLOAD_LEN );
+   for( std::size_t i = 0; i < vPayload.size(); i++ )
+      vPayload[i] = static_cast<daq::DAQ_DATA_T>(i);
+
+   daq::DAQ_DESCRIPTOR_T oDescriptor;
+   ::memset( &oDescriptor, 0, sizeof( oDescriptor ) );
+
+   BenchResult result( "recorder" );
+   uint stalls;
+   {
+      daq::DaqRecorder recorder( fileName, "daq_bench" );
+      for( uint i = 0; i < CHANNELS; i++ )
+         recorder.addChannel( daq::DAQ_REC_KIND_ADDAC_DAQ,
+                              "bench-channel-" + std::to_string( i ) );
+      result.start();
+      const daq::USEC_T stopTime = result.getStopTime( duration );
+      while( daq::getSysMicrosecs() < stopTime )
+      {
+         const daq::USEC_T start = daq::getSysMicrosecs();
+         recorder.writeAddacBlock( result.m_blocks % CHANNELS, oDescriptor,
+                                   vPayload.data(), vPayload.size() );
+         result.addLatency( static_cast<double>(daq::getSysMicrosecs() - start) );
+         result.m_blocks++;
+         result.m_tuples += PAYLOAD_LEN;
+      }
+      stalls = recorder.getStallCount();
+      recorder.close();
+      result.stop();
+   }
+
+   {
+      const daq::DaqRecordFile file( fileName );
+      ::unlink( fileName.c_str() );
+      if( file.getRecordCount() != result.m_blocks )
+         throw daq::Exception( "Recorder: " + std::to_string( file.getRecordCount() ) +
+                               " records read back, expected " +
+                               std::to_string( result.m_blocks ) );
+      if( file.getChannels().size() != CHANNELS )
+         throw daq::Exception( "Recorder: channel definitions are missing" );
+      cerr << "Recorder: " << file.getNumberOfChunks() << " chunks, "
+           << stalls << " stalls" << endl;
+   }
+   result.print( cout );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Benchmark of the replay: the ADDAC-DAQ blocks and the MIL-DAQ
+ *        items of the target become recorded via setRecorder() of both
+ *        administrations during the half duration and then replayed by the
+ *        simulated SCU in the fast mode into new administrations.
+ *
+ * Verifies that each recorded block and item becomes received once again.
+ */
+void benchReplay( const std::string& rAddress, const double duration )
+{
+   const std::string fileName = "/tmp/daq_bench_" + std::to_string( ::getpid() ) +
+                                "_replay.rec";
+   uint64_t recorded;
+   {
+      BenchResult capture( "capture" );
+      BenchConnection ebConnection( rAddress );
+      daq::DaqRecorder recorder( fileName, "daq_bench " + rAddress );
+      {
+         daq::DaqAdministration daqAdmin( ebConnection.get() );
+         daqAdmin.setCrcCheck();
+         MiLdaq::DaqAdministrationFgList milAdmin( ebConnection.get() );
+         BENCH_DAQ_T oDaq;
+         BENCH_MIL_T oMil;
+         startAllDaqChannels( daqAdmin, oDaq, capture );
+         registerAllMilCompares( milAdmin, oMil, capture );
+         daqAdmin.setRecorder( &recorder );
+         milAdmin.setRecorder( &recorder );
+
+         capture.start();
+         const daq::USEC_T stopTime = capture.getStopTime( duration / 2.0 );
+         while( daq::getSysMicrosecs() < stopTime )
+         {
+            daqAdmin.distributeData();
+            milAdmin.distributeData();
+         }
+
+         daqAdmin.setRecorder( nullptr );
+         milAdmin.setRecorder( nullptr );
+         daqAdmin.sendReset();
+      }
+      recorder.close();
+      recorded = recorder.getRecordCount();
+   }
+
+   BenchResult result( "replay" );
+   uint crcErrors;
+   {
+      BenchConnection ebConnection( EB_SIMULATOR_PREFIX "fast=1,delay=10,replay=" +
+                                    fileName );
+      daq::DaqAdministration daqAdmin( ebConnection.get() );
+      daqAdmin.setCrcCheck();
+      MiLdaq::DaqAdministrationFgList milAdmin( ebConnection.get() );
+      BENCH_DAQ_T oDaq;
+      BENCH_MIL_T oMil;
+      startAllDaqChannels( daqAdmin, oDaq, result, false );
+      registerAllMilCompares( milAdmin, oMil, result, false );
+
+      result.start( ebConnection.getCycleCount() );
+      const daq::USEC_T timeout = result.getStopTime( duration * 10.0 );
+      while( (result.m_blocks < recorded) && (daq::getSysMicrosecs() < timeout) )
+      {
+         daqAdmin.distributeData();
+         milAdmin.distributeData();
+      }
+      result.stop( ebConnection.getCycleCount() );
+
+      crcErrors = daqAdmin.getCrcErrorCount();
+      daqAdmin.sendReset();
+   }
+   ::unlink( fileName.c_str() );
+
+   if( crcErrors != 0 )
+      throw daq::Exception( std::to_string( crcErrors ) + " CRC errors!" );
+   if( result.m_blocks != recorded )
+      throw daq::Exception( "Replay: " + std::to_string( result.m_blocks ) +
+                            " blocks and items received, expected " +
+                            std::to_string( recorded ) );
+   result.print( cout );
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+int main( int argc, const char** ppArgv )
+{
+   const std::string address = (argc > 1)? ppArgv[1] : DEFAULT_NET_ADDRESS;
+   const double duration     = (argc > 2)? ::atof( ppArgv[2] ) : DEFAULT_DURATION_S;
+
+   if( duration <= 0.0 )
+   {
+      cerr << "ERROR: Invalid duration: \"" << ppArgv[2] << '"' << endl;
+      return EXIT_FAILURE;
+   }
+   cerr << "Target: " << address << ", " << duration
+        << " seconds per benchmark" << endl;
+
+   int ret = EXIT_SUCCESS;
+   const auto run = [&]( const char* name, const std::function<void()>& bench )
+   {
+      cerr << "Running: " << name << endl;
+      try
+      {
+         bench();
+      }
+      catch( std::exception& e )
+      {
+         cerr << "ERROR: " << name << ": " << e.what() << endl;
+         ret = EXIT_FAILURE;
+      }
+   };
+
+   run( "sdaq", [&]() { benchSdaq( "sdaq", address, duration, 1 ); } );
+   run( "sdaq_batched", [&]()
+      { benchSdaq( "sdaq_batched", address, duration, SDAQ_DRAIN_BLOCK_BUDGET ); } );
+   run( "mdaq", [&]() { benchMdaq( address, duration ); } );
+   run( "feedback", [&]()
+      { benchFeedback<BenchFeedbackChannel>( "feedback", address, duration ); } );
+   run( "feedback_block", [&]()
+      { benchFeedback<BenchFeedbackBlockChannel>( "feedback_block", address, duration ); } );
+   run( "ddr3_transparent", [&]()
+                    { benchDdr3( address, duration, Ddr3Access::NEVER_BURST ); } );
+   run( "ddr3_burst", [&]()
+                    { benchDdr3( address, duration, Ddr3Access::ALWAYS_BURST ); } );
+   run( "ddr3_auto", [&]()
+                    { benchDdr3( address, duration, Ddr3Access::AUTO_BURST ); } );
+   run( "mubu", [&]() { benchMubu( duration ); } );
+   run( "crc", [&]() { benchCrc( duration ); } );
+   run( "recorder", [&]() { benchRecorder( duration ); } );
+   run( "replay", [&]() { benchReplay( address, duration ); } );
+
+   cerr << "Wishbone latencies of all benchmarks:\n";
+   WbHistogram::get().snapshot().print( cerr );
+   return ret;
+}
+
+//================================== EOF ======================================
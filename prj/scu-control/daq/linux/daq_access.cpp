@@ -39,6 +39,7 @@ DaqAccess::DaqAccess( EBC_PTR_T poEb )
 #ifdef CONFIG_MIL_FG
    ,m_milDaqLm32Offset( INVALID_OFFSET )
 #endif
+   ,m_isRingDirectSupport( false )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
    probe();
@@ -63,6 +64,7 @@ void DaqAccess::probe( void )
 #ifdef CONFIG_MIL_FG
    m_milDaqLm32Offset = INVALID_OFFSET;
 #endif
+   m_isRingDirectSupport = false;
 
   /*
    * First step: Investigation whether the single ADDAC-DAQ LM32
@@ -164,6 +166,17 @@ void DaqAccess::probe( void )
       */
       DEBUG_MESSAGE( "LM32-firmware detected where MIL-DAQ-data becomes stored in DDR3-RAM or SRAM." );
       m_addacDaqLM32Offset = ADDAC_DAQ_OFFSET;
+
+      /*
+       * Fourth step: Investigation whether the firmware supports the
+       * direct handshake protocol of the ring buffers. A legacy firmware
+       * doesn't publish this word, the shared memory ends before.
+       */
+      uint32_t capabilities;
+      readLM32( &capabilities, 1, RING_CAPABILITY_OFFSET, sizeof( capabilities ) );
+      m_isRingDirectSupport = (capabilities == RAM_RING_DIRECT_CAPABILITY);
+      DEBUG_MESSAGE( "Direct ring buffer handshake "
+                     << (m_isRingDirectSupport? "supported" : "not supported") );
       return;
    }
    DEBUG_MESSAGE( "Probeing failed!" );
@@ -69,11 +69,39 @@ public:
     */
    constexpr static uint ADDAC_DAQ_OFFSET     = sizeof( FG::SAFT_LIB_T )
                                               + sizeof( MiLdaq::MIL_DAQ_ADMIN_T );
+
+   /*!
+    * @brief Value for the relative offset in the LM32-shared-memory
+    *        for the capability word of the ring buffer handshake when the
+    *        ADDAC-DAQ administration object is at ADDAC_DAQ_OFFSET.
+    * @see RAM_RING_DIRECT_CAPABILITY
+    */
+   constexpr static uint RING_CAPABILITY_OFFSET = ADDAC_DAQ_OFFSET
+                                              + sizeof( daq::DAQ_SHARED_IO_T );
+
+   /*!
+    * @brief Value for the relative offset in the LM32-shared-memory
+    *        for the read sequence of the MIL-DAQ ring buffer, valid when
+    *        the capability word has been found.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   constexpr static uint MIL_RING_SEQUENCE_OFFSET = RING_CAPABILITY_OFFSET
+                                              + sizeof( uint32_t );
+
+   /*!
+    * @brief Value for the relative offset in the LM32-shared-memory
+    *        for the read sequence of the ADDAC-DAQ ring buffer, valid when
+    *        the capability word has been found.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   constexpr static uint ADDAC_RING_SEQUENCE_OFFSET = MIL_RING_SEQUENCE_OFFSET
+                                              + sizeof( RAM_RING_SEQUENCE_T );
 private:
    uint                         m_addacDaqLM32Offset;
 #ifdef CONFIG_MIL_FG
    uint                         m_milDaqLm32Offset;
 #endif
+   bool                         m_isRingDirectSupport;
 public:
    /*!
     * @brief Constructor establishes the etherbone connection if it's not
@@ -114,6 +142,16 @@ public:
       return m_addacDaqLM32Offset;
    }
 
+   /*!
+    * @brief Returns "true" if the LM32 firmware supports the direct
+    *        handshake protocol of the DAQ ring buffers.
+    * @see RAM_RING_DIRECT_CAPABILITY
+    */
+   bool isRingDirectSupport( void ) const
+   {
+      return m_isRingDirectSupport;
+   }
+
    /*!
     * @brief Returns "true" if the LM32 firmware supports ADDAC/ACU DAQs.
     */
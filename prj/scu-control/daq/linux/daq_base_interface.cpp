@@ -41,6 +41,13 @@ DaqBaseInterface::DaqBaseInterface( EBC_PTR_T poEtherbone,
    ,m_oWatchdog( dataTimeout )
    ,m_fifoAlarmThreshold( 0 )
    ,m_fifoAlarmTriggered( false )
+   ,m_adaptivePolling( false )
+   ,m_ringProtocol( RING_PROTOCOL_T::LEGACY )
+   ,m_ringRequestPending( true )
+   ,m_oRingClient()
+   ,m_oRingView()
+   ,m_ringSequenceOffset( 0 )
+   ,m_ringSequence( 0 )
    ,m_maxEbCycleDataLen( c_defaultMaxEbCycleDataLen )
    ,m_blockReadEbCycleGapTimeUs( c_defaultBlockReadEbCycleGapTimeUs )
 {
@@ -59,6 +66,13 @@ DaqBaseInterface::DaqBaseInterface( DaqAccess* poEbAccess,
    ,m_oWatchdog( dataTimeout )
    ,m_fifoAlarmThreshold( 0 )
    ,m_fifoAlarmTriggered( false )
+   ,m_adaptivePolling( false )
+   ,m_ringProtocol( RING_PROTOCOL_T::LEGACY )
+   ,m_ringRequestPending( true )
+   ,m_oRingClient()
+   ,m_oRingView()
+   ,m_ringSequenceOffset( 0 )
+   ,m_ringSequence( 0 )
    ,m_maxEbCycleDataLen( c_defaultMaxEbCycleDataLen )
    ,m_blockReadEbCycleGapTimeUs( c_defaultBlockReadEbCycleGapTimeUs )
 {
@@ -87,26 +101,134 @@ void DaqBaseInterface::checkIntegrity( void )
    if( m_poRingAdmin->indexes.end > m_poRingAdmin->indexes.capacity )
       throw daq::Exception( "Write index of DAQ-buffer is corrupt!" );
 
-   if( m_poRingAdmin->wasRead > m_poRingAdmin->indexes.capacity )
+   if( ((m_poRingAdmin->wasRead & RAM_RING_HANDSHAKE_MASK) == 0) &&
+       (m_poRingAdmin->wasRead > m_poRingAdmin->indexes.capacity) )
       throw daq::Exception(  "Value of wasRead of DAQ-buffer is corrupt!" );
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void DaqBaseInterface::updateRingProtocol( void )
+{
+   switch( m_ringProtocol )
+   {
+      case RING_PROTOCOL_T::REQUESTED:
+      {
+         if( ramRingSharedIsDirectRequest( m_poRingAdmin ) )
+         { /*
+            * LM32 has not answered yet.
+            */
+            return;
+         }
+         if( !ramRingSharedIsDirect( m_poRingAdmin ) )
+         { /*
+            * Legacy LM32 firmware has cleared the request.
+            */
+            DEBUG_MESSAGE( "LM32 supports the legacy ring handshake only." );
+            m_ringProtocol = RING_PROTOCOL_T::LEGACY;
+            return;
+         }
+         ramRingClientInit( &m_oRingClient, m_poRingAdmin, getRingSequence() );
+         m_ringProtocol  = RING_PROTOCOL_T::DIRECT;
+         break;
+      }
+      case RING_PROTOCOL_T::DIRECT:
+      {
+         if( ramRingSharedIsDirect( m_poRingAdmin ) )
+            break;
+         /*
+          * LM32 has reset the ring buffer, that falls back to the
+          * legacy protocol.
+          */
+         m_ringProtocol       = RING_PROTOCOL_T::LEGACY;
+         m_ringRequestPending = true;
+      } FALL_THROUGH
+      case RING_PROTOCOL_T::LEGACY:
+      {
+         if( ramRingSharedIsDirect( m_poRingAdmin ) )
+         { /*
+            * Direct protocol has been already negotiated by a previous
+            * session, continuing at the published read index.
+            */
+            ramRingClientInit( &m_oRingClient, m_poRingAdmin, getRingSequence() );
+            m_ringProtocol  = RING_PROTOCOL_T::DIRECT;
+            break;
+         }
+         /*
+          * The request will be sent once only, only when no acknowledge
+          * is pending and only to a firmware which has published its
+          * support. A legacy LM32 firmware would add the request to the
+          * read index.
+          */
+         if( !m_ringRequestPending || (m_poRingAdmin->wasRead != 0) ||
+             !getEbAccess()->isRingDirectSupport() )
+            return;
+
+         m_ringRequestPending    = false;
+         m_poRingAdmin->wasRead  = ramRingSharedGetDirectRequest( m_poRingAdmin );
+         m_ringProtocol          = RING_PROTOCOL_T::REQUESTED;
+         writeWasRead();
+         return;
+      }
+   }
+
+   /*
+    * Direct protocol: Replacing the indexes of the LM32 by the view
+    * beginning at the own read index.
+    */
+   if( !ramRingClientGetView( &m_oRingClient, &m_oRingView, m_poRingAdmin,
+                              getRingSequence() ) )
+   {
+      DEBUG_MESSAGE( "DAQ-buffer overrun, continuing at: " << m_oRingView.start );
+      onDataError();
+   }
+   m_poRingAdmin->indexes = m_oRingView;
+}
+
+/*! --------------------------------------------------------------------------
+ */
+void DaqBaseInterface::readRingAdmin( void* pTarget, const std::size_t len,
+                                      const std::size_t offset )
+{
+   if( getRingSequence() == nullptr )
+   {
+      readLM32( pTarget, len, offset );
+      return;
+   }
+
+   /*
+    * The read sequence becomes read behind the indexes within the
+    * same etherbone cycle.
+    */
+   assert( m_daqBaseOffset != 0 );
+   assert( m_ringSequenceOffset != 0 );
+   EB_BATCH_T oBatch;
+   RAM_RING_SEQUENCE_T sequenceBe;
+   getEbAccess()->readLM32( oBatch, pTarget, len, offset + m_daqBaseOffset );
+   getEbAccess()->readLM32( oBatch, &sequenceBe, sizeof( sequenceBe ),
+                            m_ringSequenceOffset );
+   getEbAccess()->execute( oBatch );
+   m_ringSequence = gsi::convertByteEndian( sequenceBe );
+}
+
 /*! --------------------------------------------------------------------------
  */
 void DaqBaseInterface::initRingAdmin( RAM_RING_SHARED_INDEXES_T* pAdmin,
-                                      const std::size_t daqBaseOffset  )
+                                      const std::size_t daqBaseOffset,
+                                      const std::size_t ringSequenceOffset )
 {
    assert( m_poRingAdmin == nullptr );
    assert( m_daqBaseOffset == 0 );
 
-   m_poRingAdmin   = pAdmin;
-   m_daqBaseOffset = daqBaseOffset;
+   m_poRingAdmin        = pAdmin;
+   m_daqBaseOffset      = daqBaseOffset;
+   m_ringSequenceOffset = ringSequenceOffset;
    assert( dynamic_cast<RAM_RING_SHARED_INDEXES_T*>(m_poRingAdmin) != nullptr );
 
    RAM_RING_SHARED_INDEXES_T lm32Order;
 
 
-   readLM32( &lm32Order, sizeof( RAM_RING_SHARED_INDEXES_T ) );
+   readRingAdmin( &lm32Order, sizeof( RAM_RING_SHARED_INDEXES_T ) );
    BYTE_SWAP( m_poRingAdmin, lm32Order, indexes.offset );
    BYTE_SWAP( m_poRingAdmin, lm32Order, indexes.capacity );
    BYTE_SWAP( m_poRingAdmin, lm32Order, indexes.start );
@@ -114,6 +236,7 @@ void DaqBaseInterface::initRingAdmin( RAM_RING_SHARED_INDEXES_T* pAdmin,
    BYTE_SWAP( m_poRingAdmin, lm32Order, wasRead );
 
    checkIntegrity();
+   updateRingProtocol();
 }
 
 /*! --------------------------------------------------------------------------
@@ -136,17 +259,18 @@ void DaqBaseInterface::updateMemAdmin( void )
                   offsetof( RAM_RING_SHARED_INDEXES_T, indexes.end ) +
                   sizeof( lm32Order.indexes.end ), "" );
 
-   readLM32( &lm32Order.indexes.start,
-               sizeof( lm32Order.indexes.start )
-             + sizeof( lm32Order.indexes.end )
-             + sizeof( lm32Order.wasRead ),
-             offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ) );
+   readRingAdmin( &lm32Order.indexes.start,
+                    sizeof( lm32Order.indexes.start )
+                  + sizeof( lm32Order.indexes.end )
+                  + sizeof( lm32Order.wasRead ),
+                  offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ) );
 
    BYTE_SWAP( m_poRingAdmin, lm32Order, indexes.start );
    BYTE_SWAP( m_poRingAdmin, lm32Order, indexes.end );
    BYTE_SWAP( m_poRingAdmin, lm32Order, wasRead );
 
    checkIntegrity();
+   updateRingProtocol();
 }
 
 /*! --------------------------------------------------------------------------
@@ -166,6 +290,7 @@ uint DaqBaseInterface::getNumberOfNewData( void )
    updateMemAdmin();
 
    const uint currentNumberOfData = getCurrentNumberOfData();
+   m_oPollScheduler.setLevel( currentNumberOfData );
    if( m_fifoAlarmThreshold > 0 )
    {
       assert( getRamCapacity() > 0 );
@@ -181,19 +306,30 @@ uint DaqBaseInterface::getNumberOfNewData( void )
          m_fifoAlarmTriggered = false;
    }
 
-   if( getWasRead() != 0 )
+   if( m_ringProtocol == RING_PROTOCOL_T::REQUESTED )
    { /*
-      * Server respectively the LM32 has not synchronized the read index yet.
-      * Therefore no data are present as well.
+      * Waiting once for the answer of the LM32 to the protocol request.
       */
       return 0;
    }
 
-   if( (m_lastReadIndex == getReadIndex()) && (lastWasToRead != 0) )
+   if( m_ringProtocol == RING_PROTOCOL_T::LEGACY )
    {
-      sendWasRead( lastWasToRead );
-      // DEBUG_MESSAGE( "Second sendWasRead( " << lastWasToRead << " );" );
-      return 0;
+      if( getWasRead() != 0 )
+      { /*
+         * Server respectively the LM32 has not synchronized the read index yet.
+         * Therefore no data are present as well.
+         */
+         return 0;
+      }
+
+      if( (m_lastReadIndex == getReadIndex()) && (lastWasToRead != 0) &&
+          ((lastWasToRead & RAM_RING_HANDSHAKE_MASK) == 0) )
+      {
+         sendWasRead( lastWasToRead );
+         // DEBUG_MESSAGE( "Second sendWasRead( " << lastWasToRead << " );" );
+         return 0;
+      }
    }
    m_lastReadIndex = getReadIndex();
 
@@ -221,42 +357,201 @@ uint DaqBaseInterface::getFiFoLevelPerTenThousand( void )
 
 /*! --------------------------------------------------------------------------
  */
-void DaqBaseInterface::sendWasRead( const uint wasRead )
+void DaqBaseInterface::prepareWasRead( const uint wasRead )
 {
-   assert( dynamic_cast<RAM_RING_SHARED_INDEXES_T*>(m_poRingAdmin) != nullptr );
+   if( m_ringProtocol != RING_PROTOCOL_T::DIRECT )
+   {
+      ramRingSharedSetWasRead( m_poRingAdmin, wasRead );
+      return;
+   }
 
-   ramRingSharedSetWasRead( m_poRingAdmin, wasRead );
+   /*
+    * The number of items counts from the read index of the last
+    * update, like in the legacy protocol.
+    */
+   RAM_RING_INDEXES_T view = m_oRingView;
+   ramRingAddToReadIndex( &view, wasRead );
+   ramRingSharedSetConsumerIndex( m_poRingAdmin,
+                                  ramRingClientRelease( &m_oRingClient, &view,
+                                                        getRingSequence() ) );
+}
+
+/*! --------------------------------------------------------------------------
+ */
+void DaqBaseInterface::writeWasRead( void )
+{
    RAM_RING_INDEX_T wasReadBe = gsi::convertByteEndian( m_poRingAdmin->wasRead );
    writeLM32( &wasReadBe, sizeof( wasReadBe ), offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ));
 }
 
+/*! --------------------------------------------------------------------------
+ */
+void DaqBaseInterface::sendWasRead( const uint wasRead )
+{
+   assert( dynamic_cast<RAM_RING_SHARED_INDEXES_T*>(m_poRingAdmin) != nullptr );
+
+   prepareWasRead( wasRead );
+   writeWasRead();
+}
+
 /*! --------------------------------------------------------------------------
  */
 void DaqBaseInterface::onDataReadingPause( void )
 {
+   if( m_adaptivePolling && m_oPollScheduler.isUrgent() )
+   { /*
+      * FIFO threatens to overflow, no time for pauses.
+      */
+      return;
+   }
+
    if( m_blockReadEbCycleGapTimeUs != 0 )
      ::usleep( m_blockReadEbCycleGapTimeUs );
 }
 
 /*! --------------------------------------------------------------------------
  */
-void DaqBaseInterface::readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData,
+void DaqBaseInterface::schedulePoll( const uint remaining )
+{
+   if( !m_adaptivePolling )
+      return;
+
+   m_oPollScheduler.schedule( daq::getSysMicrosecs(), remaining,
+                              getRamCapacity(), m_fifoAlarmThreshold );
+}
+
+/*! --------------------------------------------------------------------------
+ */
+bool DaqBaseInterface::readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData,
                                     std::size_t len )
 {
    const std::size_t maxLen = ( m_maxEbCycleDataLen == 0 )? len : m_maxEbCycleDataLen;
-   while( true )
+   while( len > maxLen )
    {
-      const std::size_t partLen = std::min( len, maxLen );
-      /*
-       * The next function occupies the wishbone/etherbone bus!
-       */
-      readRam( pData, partLen );
-      len -= partLen;
-      if( len == 0 )
-         break;
-      pData += partLen;
+      readRam( pData, maxLen );
+      len   -= maxLen;
+      pData += maxLen;
       onDataReadingPause();
    }
+
+   EB_BATCH_T oBatch;
+   getEbAccess()->readRam( oBatch, pData, len, m_poRingAdmin->indexes );
+
+   RING_CHECK_T oCheck;
+   prepareRingCheck( oBatch, oCheck );
+   /*
+    * The next function occupies the wishbone/etherbone bus!
+    */
+   getEbAccess()->execute( oBatch );
+
+   /*
+    * Nothing has been acknowledged yet, so the overrun becomes reported
+    * by the next updateMemAdmin().
+    */
+   return isRingCheckPassed( oCheck );
+}
+
+/*! --------------------------------------------------------------------------
+ */
+void DaqBaseInterface::prepareRingCheck( EB_BATCH_T& rBatch, RING_CHECK_T& rCheck )
+{
+   rCheck.isActive = (m_ringProtocol == RING_PROTOCOL_T::DIRECT);
+   if( !rCheck.isActive )
+      return;
+
+   /*
+    * The client state becomes copied before the acknowledge can modify it.
+    */
+   rCheck.oClient = m_oRingClient;
+   static_assert( offsetof( RAM_RING_SHARED_INDEXES_T, indexes.end ) ==
+                  offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ) +
+                  sizeof( rCheck.aIndexesBe[0] ), "" );
+   assert( m_daqBaseOffset != 0 );
+   getEbAccess()->readLM32( rBatch, rCheck.aIndexesBe, sizeof( rCheck.aIndexesBe ),
+                            offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ) + m_daqBaseOffset );
+   if( getRingSequence() == nullptr )
+      return;
+   /*
+    * Behind the indexes, the LM32 increments it before overwriting.
+    */
+   assert( m_ringSequenceOffset != 0 );
+   getEbAccess()->readLM32( rBatch, &rCheck.sequenceBe, sizeof( rCheck.sequenceBe ),
+                            m_ringSequenceOffset );
+}
+
+/*! --------------------------------------------------------------------------
+ */
+bool DaqBaseInterface::isRingCheckPassed( RING_CHECK_T& rCheck )
+{
+   if( !rCheck.isActive )
+      return true;
+
+   RAM_RING_SHARED_INDEXES_T server = *m_poRingAdmin;
+   server.indexes.start = gsi::convertByteEndian( rCheck.aIndexesBe[0] );
+   server.indexes.end   = gsi::convertByteEndian( rCheck.aIndexesBe[1] );
+   RAM_RING_SEQUENCE_T sequence = 0;
+   const RAM_RING_SEQUENCE_T* pSequence = nullptr;
+   if( getRingSequence() != nullptr )
+   {
+      sequence  = gsi::convertByteEndian( rCheck.sequenceBe );
+      pSequence = &sequence;
+   }
+   RAM_RING_INDEXES_T view;
+   if( ramRingClientGetView( &rCheck.oClient, &view, &server, pSequence ) )
+   { /*
+      * The acknowledge checks against the latest sequence.
+      */
+      if( pSequence != nullptr )
+         m_ringSequence = sequence;
+      return true;
+   }
+
+   DEBUG_MESSAGE( "DAQ-data overwritten while reading, read index: "
+                  << m_oRingView.start );
+   return false;
+}
+
+/*! --------------------------------------------------------------------------
+ */
+void DaqBaseInterface::readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData,
+                                    std::size_t len,
+                                    const uint wasRead )
+{
+   assert( dynamic_cast<RAM_RING_SHARED_INDEXES_T*>(m_poRingAdmin) != nullptr );
+
+   const std::size_t maxLen = ( m_maxEbCycleDataLen == 0 )? len : m_maxEbCycleDataLen;
+   while( len > maxLen )
+   {
+      readRam( pData, maxLen );
+      len   -= maxLen;
+      pData += maxLen;
+      onDataReadingPause();
+   }
+
+   EB_BATCH_T oBatch;
+   if( len > 0 )
+      getEbAccess()->readRam( oBatch, pData, len, m_poRingAdmin->indexes );
+
+   assert( m_daqBaseOffset != 0 );
+
+   RING_CHECK_T oCheck;
+   prepareRingCheck( oBatch, oCheck );
+
+   prepareWasRead( wasRead );
+   RAM_RING_INDEX_T wasReadBe = gsi::convertByteEndian( m_poRingAdmin->wasRead );
+   getEbAccess()->writeLM32( oBatch, &wasReadBe, sizeof( wasReadBe ),
+                             offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ) + m_daqBaseOffset );
+   /*
+    * The next function occupies the wishbone/etherbone bus!
+    */
+   getEbAccess()->execute( oBatch );
+
+   /*
+    * The data has been already acknowledged, so the next updateMemAdmin()
+    * wouldn't recognize the overrun anymore.
+    */
+   if( !isRingCheckPassed( oCheck ) )
+      onDataError();
 }
 
 /*! --------------------------------------------------------------------------
@@ -34,6 +34,7 @@
 #include <daq_ring_admin.h>
 #include <daq_fg_allocator.h>
 #include <watchdog_poll.hpp>
+#include <poll_scheduler.hpp>
 #include <assert.h>
 
 #ifndef DAQ_DEFAULT_WB_DEVICE
@@ -170,11 +171,23 @@ class DaqBaseInterface
 {
 public:
    using EBC_PTR_T = EtherboneAccess::EBC_PTR_T;
+   using EB_BATCH_T = EtherboneAccess::EB_BATCH_T;
 
 protected:
    using EB_STATUS_T  = eb_status_t;
 
 private:
+   /*!
+    * @brief State of the ring buffer handshake with the LM32.
+    * @see RAM_RING_PROTOCOL_FLAG
+    */
+   enum class RING_PROTOCOL_T
+   {
+      LEGACY,    /*!<@brief Acknowledge via wasRead          */
+      REQUESTED, /*!<@brief Direct protocol requested        */
+      DIRECT     /*!<@brief Read index published directly    */
+   };
+
    DaqAccess*                   m_poEbAccess;
    const bool                   m_ebAccessSelfCreated;
    RAM_RING_SHARED_INDEXES_T*   m_poRingAdmin;
@@ -183,6 +196,46 @@ private:
    Watchdog                     m_oWatchdog;
    uint                         m_fifoAlarmThreshold;
    bool                         m_fifoAlarmTriggered;
+   bool                         m_adaptivePolling;
+   PollScheduler                m_oPollScheduler;
+   /*!
+    * @brief Check whether the LM32 has overwritten data while reading
+    *        in the direct protocol.
+    * @see prepareRingCheck
+    */
+   struct RING_CHECK_T
+   {
+      bool               isActive;
+      RAM_RING_CLIENT_T  oClient;
+      RAM_RING_INDEX_T   aIndexesBe[2];
+      RAM_RING_SEQUENCE_T sequenceBe;
+   };
+
+   RING_PROTOCOL_T              m_ringProtocol;
+   bool                         m_ringRequestPending;
+   RAM_RING_CLIENT_T            m_oRingClient;
+   RAM_RING_INDEXES_T           m_oRingView;
+   std::size_t                  m_ringSequenceOffset;
+   RAM_RING_SEQUENCE_T          m_ringSequence;
+
+   /*!
+    * @brief Returns a pointer to the last read sequence of the ring buffer
+    *        or nullptr when the LM32 firmware doesn't publish it.
+    */
+   const RAM_RING_SEQUENCE_T* getRingSequence( void ) const
+   {
+      return getEbAccess()->isRingDirectSupport()? &m_ringSequence : nullptr;
+   }
+
+   /*!
+    * @brief Reads the ring indexes from the LM32 together with the
+    *        read sequence if published, within the same etherbone cycle.
+    * @param pTarget Target for the indexes in LM32 byte order.
+    * @param len Number of bytes to read.
+    * @param offset Offset relative to the ring administration object.
+    */
+   void readRingAdmin( void* pTarget, const std::size_t len,
+                       const std::size_t offset = 0 );
 
 protected:
    static constexpr std::size_t c_defaultMaxEbCycleDataLen = 10;
@@ -285,6 +338,63 @@ public:
       return m_blockReadEbCycleGapTimeUs;
    }
 
+   /*!
+    * @brief Enables or disables the adaptive polling.
+    *
+    * When enabled, then the time of the next poll becomes derived from the
+    * FIFO fill level and the observed fill rate, and the pause between
+    * divided data blocks will omitted when the FIFO threatens to overflow.
+    * @see PollScheduler
+    */
+   void enableAdaptivePolling( const bool enable = true )
+   {
+      m_adaptivePolling = enable;
+      m_oPollScheduler.reset();
+   }
+
+   bool isAdaptivePolling( void ) const
+   {
+      return m_adaptivePolling;
+   }
+
+   /*!
+    * @brief Returns a reference to the poll scheduler object, e.g. for
+    *        adjusting its limits.
+    */
+   PollScheduler& getPollScheduler( void )
+   {
+      return m_oPollScheduler;
+   }
+
+   /*!
+    * @brief Returns "true" if this DAQ-FIFO has to be polled.
+    * @note In non-adaptive mode always "true".
+    */
+   bool isPollDue( void ) const
+   {
+      if( !m_adaptivePolling )
+         return true;
+      return m_oPollScheduler.isDue( daq::getSysMicrosecs() );
+   }
+
+   /*!
+    * @brief Returns the time in microseconds up to the next poll.
+    * @note In non-adaptive mode always zero.
+    */
+   uint getPollDelayUs( void ) const
+   {
+      if( !m_adaptivePolling )
+         return 0;
+      return m_oPollScheduler.getDelayUs( daq::getSysMicrosecs() );
+   }
+
+   /*!
+    * @brief Calculates the time of the next poll, it has to be invoked
+    *        after each call of distributeData().
+    * @param remaining Return value of distributeData().
+    */
+   void schedulePoll( const uint remaining );
+
    /*!
     * @brief Returns the maximum capacity of the ADDAC or MIL DAQ data-buffer
     *        in minimum addressable payload units of the used RAM-type.
@@ -369,6 +479,37 @@ public:
 private:
    void checkIntegrity( void );
 
+   /*!
+    * @brief Evaluates the handshake word read from the LM32 and builds the
+    *        view of the ring buffer in the direct protocol.
+    */
+   void updateRingProtocol( void );
+
+   /*!
+    * @brief Prepares the handshake word for the acknowledge of the given
+    *        number of items.
+    */
+   void prepareWasRead( const uint wasRead );
+
+   /*!
+    * @brief Writes the handshake word into the LM32 shared memory.
+    */
+   void writeWasRead( void );
+
+   /*!
+    * @brief Queues the reading of the LM32 indexes in the given batch
+    *        after the data, in the direct protocol only.
+    */
+   void prepareRingCheck( EB_BATCH_T& rBatch, RING_CHECK_T& rCheck );
+
+   /*!
+    * @brief Evaluates the LM32 indexes read by the batch prepared by
+    *        prepareRingCheck().
+    * @retval true The LM32 hasn't overwritten the read data.
+    * @retval false The read data are possibly corrupt.
+    */
+   bool isRingCheckPassed( RING_CHECK_T& rCheck );
+
    void readLM32( eb_user_data_t pData,
                   const std::size_t len,
                   const std::size_t offset = 0,
@@ -449,16 +590,57 @@ public:
    }
 
 protected:
-   void initRingAdmin( RAM_RING_SHARED_INDEXES_T* pAdmin, const std::size_t daqBaseOffset  );
+   /*!
+    * @brief Initializes the ring administration from the LM32.
+    * @param pAdmin Pointer to the local copy of the ring administration.
+    * @param daqBaseOffset Offset of the ring administration in the
+    *                      LM32 shared memory.
+    * @param ringSequenceOffset Offset of the read sequence of this ring
+    *                           buffer in the LM32 shared memory.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   void initRingAdmin( RAM_RING_SHARED_INDEXES_T* pAdmin,
+                       const std::size_t daqBaseOffset,
+                       const std::size_t ringSequenceOffset );
 
    /*!
     * @brief Sends the number DDR3-items back to the LM32.
     *
     * The LM32 will add this to the read-index once he has enter
     * the handling routine of this buffer.
+    *
+    * In the direct protocol the new read index becomes published instead,
+    * it is valid immediately without any acknowledge of the LM32.
     */
    void sendWasRead( const uint wasRead );
 
+   /*!
+    * @brief Returns "true" when the LM32 takes over the read index published
+    *        by this client directly.
+    * @see RAM_RING_PROTOCOL_FLAG
+    */
+   bool isRingDirect( void ) const
+   {
+      return m_ringProtocol == RING_PROTOCOL_T::DIRECT;
+   }
+
+   /*!
+    * @brief Reads the last block of DAQ-data and sends the number of
+    *        read items back to the LM32 within the same etherbone cycle.
+    *
+    * Leading parts of a large block will be read divided in the same manner
+    * like readDaqData(), only the last part becomes fused with the
+    * acknowledge, this saves one etherbone round trip per poll.
+    * @see readDaqData
+    * @see sendWasRead
+    * @param pData Destination buffer.
+    * @param len Number of items to read.
+    * @param wasRead Number of items to acknowledge, usually the
+    *                total number of items read since the last acknowledge.
+    */
+   void readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData, std::size_t len,
+                     const uint wasRead );
+
    /*!
     * @brief Reads the DDR3-RAM.
     * @param pData Target address in which the data elements shall be copied.
@@ -508,8 +690,15 @@ protected:
     *
     * That makes time gaps for making occasions for other EB-access devices
     * e.g.: SAFTLIB
-    */
-   void readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData, std::size_t len );
+    *
+    * In the direct protocol the LM32 indexes becomes read within the
+    * etherbone cycle of the last part, so it can be recognized whether
+    * the LM32 has overwritten the data meanwhile.
+    * @retval true Data are valid.
+    * @retval false LM32 has overwritten the data while reading, the data
+    *               shall be discarded without acknowledge.
+    */
+   bool readDaqData( daq::RAM_DAQ_PAYLOAD_T* pData, std::size_t len );
 
    /*!
     * @brief Callback function becomes invoked when a data timeout
@@ -143,6 +143,33 @@ void EbRamAccess::readRam( RAM_DAQ_PAYLOAD_T* pData,
    rIndexes = indexes;
 }
 
+/*! ---------------------------------------------------------------------------
+ * @see daq_eb_ram_buffer.hpp
+ */
+void EbRamAccess::readRam( EB_BATCH_T& rBatch,
+                           RAM_DAQ_PAYLOAD_T* pData,
+                           std::size_t len,
+                           RAM_RING_INDEXES_T& rIndexes
+                         )
+{
+   assert( m_poRamBuffer->isConnected() );
+
+   RAM_RING_INDEXES_T indexes = rIndexes;
+   const std::size_t lenToEnd = ramRingGetUpperReadSize( &indexes );
+   if( lenToEnd < len )
+   {
+      m_poRamBuffer->read( rBatch, ramRingGetReadIndex( &indexes ),
+                           reinterpret_cast<uint64_t*>(pData), lenToEnd );
+      ramRingAddToReadIndex( &indexes, lenToEnd );
+      len   -= lenToEnd;
+      pData += lenToEnd;
+   }
+   m_poRamBuffer->read( rBatch, ramRingGetReadIndex( &indexes ),
+                        reinterpret_cast<uint64_t*>(pData), len );
+   ramRingAddToReadIndex( &indexes, len );
+   rIndexes = indexes;
+}
+
 #ifdef CONFIG_EB_TIME_MEASSUREMENT //==========================================
    #ifdef CONFIG_EB_TIME_MEASSUREMENT_TO_STDERR
      #warning "Timemeasurment output to stderr is active"
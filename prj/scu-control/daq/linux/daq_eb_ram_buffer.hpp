@@ -63,7 +63,8 @@ namespace daq
 class EbRamAccess
 {
 public:
-   using EBC_PTR_T = EtherboneAccess::EBC_PTR_T;
+   using EBC_PTR_T  = EtherboneAccess::EBC_PTR_T;
+   using EB_BATCH_T = EtherboneAccess::EB_BATCH_T;
 
 private:
    /*!
@@ -96,7 +97,8 @@ public:
           UNKNOWN    = 0,
           LM32_READ  = 1,
           LM32_WRITE = 2,
-          DDR3_READ  = 3
+          DDR3_READ  = 3,
+          BATCH      = 4
        };
 
        USEC_T      m_duration;
@@ -235,6 +237,37 @@ public:
     */
    void readRam( RAM_DAQ_PAYLOAD_T* pData, std::size_t len, RAM_RING_INDEXES_T& rIndexes );
 
+   /*!
+    * @brief Queues the reading of circular administrated data from the
+    *        SCU-RAM in the given batch object.
+    *
+    * In contrast to the non batched variant a wrap around at the end of
+    * the ring buffer doesn't cost a further etherbone cycle.
+    * @see execute
+    * @param rBatch Batch object.
+    * @param pData Pointer to the destination buffer of type RAM_DAQ_PAYLOAD_T,
+    *              it has to stay valid until the batch has been executed.
+    * @param len Number of RAM-items of type RAM_DAQ_PAYLOAD_T to read.
+    * @param rIndexes Ring buffer administrator object.
+    */
+   void readRam( EB_BATCH_T& rBatch, RAM_DAQ_PAYLOAD_T* pData,
+                 std::size_t len, RAM_RING_INDEXES_T& rIndexes );
+
+   /*!
+    * @brief Executes all queued accesses of the given batch object
+    *        within a single etherbone cycle and makes it empty.
+    * @param rBatch Batch object.
+    */
+   void execute( EB_BATCH_T& rBatch )
+   {
+      startTimeMeasurement();
+   #ifdef CONFIG_EB_TIME_MEASSUREMENT
+      const std::size_t size = rBatch.getNumberOfOperations() * sizeof(uint32_t);
+   #endif
+      m_oLm32.execute( rBatch );
+      stopTimeMeasurement( size, TIME_MEASUREMENT_T::BATCH );
+   }
+
    /*!
     * @brief Reads data from the LM32 shared memory area.
     * @note In this case a homogeneous data object is provided so
@@ -283,6 +316,36 @@ public:
       m_oLm32.write( offset, pData, len, format | EB_BIG_ENDIAN );
       stopTimeMeasurement( len * (format & 0xFF), TIME_MEASUREMENT_T::LM32_WRITE );
    }
+
+   /*!
+    * @brief Queues the reading of data from the LM32 shared memory area
+    *        in the given batch object.
+    * @see readLM32
+    * @see execute
+    */
+   void readLM32( EB_BATCH_T& rBatch,
+                  eb_user_data_t pData,
+                  const std::size_t len,
+                  const std::size_t offset = 0,
+                  const etherbone::format_t format = EB_DATA8 )
+   {
+      m_oLm32.read( rBatch, offset, pData, len, format | EB_BIG_ENDIAN );
+   }
+
+   /*!
+    * @brief Queues the writing of data in the LM32 shared memory area
+    *        in the given batch object.
+    * @see writeLM32
+    * @see execute
+    */
+   void writeLM32( EB_BATCH_T& rBatch,
+                   const eb_user_data_t pData,
+                   const std::size_t len,
+                   const std::size_t offset = 0,
+                   const etherbone::format_t format = EB_DATA8 )
+   {
+      m_oLm32.write( rBatch, offset, pData, len, format | EB_BIG_ENDIAN );
+   }
 };
 
 } // namespace daq
@@ -0,0 +1,800 @@
+/*!
+ * @file daq_recorder.cpp
+ * @brief Recorder of feedback tuples, ADDAC-DAQ blocks and MIL-DAQ items
+ *        in a chunked binary file, and memory mapped reader of such files.
+ *
+ * @see daq_recorder.hpp
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include "daq_recorder.hpp"
+
+using namespace Scu;
+using namespace daq;
+using namespace std;
+
+namespace
+{
+
+/*!
+ * @brief Alignment of the records within a chunk.
+ */
+constexpr uint32_t RECORD_ALIGN = sizeof(uint64_t);
+
+template< typename T >
+inline T alignUp( const T value, const T alignment )
+{
+   return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/*!
+ * @brief Offset of the first record of a chunk.
+ */
+constexpr uint32_t FIRST_RECORD_OFFSET =
+   (sizeof(DAQ_REC_CHUNK_HEADER_T) + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+
+string systemError( const string& rText, const string& rFileName )
+{
+   return rText + " \"" + rFileName + "\": " + ::strerror( errno );
+}
+
+} // namespace
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+bool Scu::daq::parseRecordAddacName( const string& rName, uint& rSlot, uint& rChannel )
+{
+   int length = 0;
+   return (::sscanf( rName.c_str(), "slot-%u-channel-%u%n",
+                     &rSlot, &rChannel, &length ) == 2) &&
+          (static_cast<size_t>(length) == rName.size());
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+bool Scu::daq::parseRecordFgName( const string& rName, uint& rSocket, uint& rDevice )
+{
+   int length = 0;
+   return (::sscanf( rName.c_str(), "fg-%u-%u%n",
+                     &rSocket, &rDevice, &length ) == 2) &&
+          (static_cast<size_t>(length) == rName.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+DaqRecorder::DaqRecorder( const string& rFileName,
+                          const string& rDescription,
+                          const uint32_t chunkSize,
+                          const uint numberOfBuffers )
+   :m_fileName( rFileName )
+   ,m_chunkSize( alignUp( max( chunkSize, FIRST_RECORD_OFFSET + 1 ),
+                          DAQ_REC_FILE_HEADER_SIZE ) )
+   ,m_fd( -1 )
+   ,m_nextChunkNumber( 0 )
+   ,m_stop( false )
+   ,m_recordCount( 0 )
+   ,m_writtenBytes( 0 )
+   ,m_stallCount( 0 )
+{
+   m_oCurrent.m_pData  = nullptr;
+   m_oCurrent.m_number = 0;
+
+   m_fd = ::open( m_fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+   if( m_fd < 0 )
+      throw Exception( systemError( "Can't create record file", m_fileName ) );
+
+   DAQ_REC_FILE_HEADER_T oHeader;
+   ::memset( &oHeader, 0, sizeof( oHeader ) );
+   ::memcpy( oHeader.m_magic, DAQ_REC_MAGIC, sizeof( oHeader.m_magic ) );
+   oHeader.m_version       = DAQ_REC_VERSION;
+   oHeader.m_byteOrderMark = DAQ_REC_BYTE_ORDER_MARK;
+   oHeader.m_headerSize    = DAQ_REC_FILE_HEADER_SIZE;
+   oHeader.m_chunkSize     = m_chunkSize;
+   oHeader.m_maxIndex      = DAQ_REC_MAX_INDEX;
+   oHeader.m_creationTime  =
+      chrono::duration_cast<chrono::nanoseconds>(
+                    chrono::system_clock::now().time_since_epoch() ).count();
+   ::strncpy( oHeader.m_description, rDescription.c_str(),
+              sizeof( oHeader.m_description ) - 1 );
+
+   try
+   {
+      writeAll( &oHeader, sizeof( oHeader ), 0 );
+
+      for( uint i = 0; i < max( numberOfBuffers, 2U ); i++ )
+      {
+         void* pBuffer;
+         if( ::posix_memalign( &pBuffer, DAQ_REC_FILE_HEADER_SIZE, m_chunkSize ) != 0 )
+            throw Exception( "Can't allocate chunk buffer for recorder!" );
+         m_vAllBuffers.push_back( static_cast<uint8_t*>(pBuffer) );
+      }
+   }
+   catch( ... )
+   {
+      for( const auto& pBuffer: m_vAllBuffers )
+         ::free( pBuffer );
+      ::close( m_fd );
+      throw;
+   }
+   m_vFreeBuffers = m_vAllBuffers;
+
+   startChunk();
+   m_oWriter = thread( &DaqRecorder::writerThread, this );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+DaqRecorder::~DaqRecorder( void )
+{
+   try
+   {
+      close();
+   }
+   catch( ... )
+   {
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+void DaqRecorder::close( void )
+{
+   if( m_fd < 0 )
+      return;
+
+   {
+      lock_guard<mutex> lock( m_oRecordMutex );
+      /*
+       * The first chunk becomes written in any case, so that even a empty
+       * recording contains at least the channel definitions.
+       */
+      if( m_oCurrent.m_pData != nullptr )
+      {
+         if( (getCurrentHeader()->m_recordCount > 0) || (m_oCurrent.m_number == 0) )
+            submitChunk();
+         m_oCurrent.m_pData = nullptr;
+      }
+   }
+
+   {
+      lock_guard<mutex> lock( m_oQueueMutex );
+      m_stop = true;
+   }
+   m_oQueueCondition.notify_all();
+   m_oWriter.join();
+
+   for( const auto& pBuffer: m_vAllBuffers )
+      ::free( pBuffer );
+   m_vAllBuffers.clear();
+   m_vFreeBuffers.clear();
+
+   const int ret = ::close( m_fd );
+   m_fd = -1;
+   if( (ret != 0) && m_writeError.empty() )
+      m_writeError = systemError( "Can't close record file", m_fileName );
+
+   checkWriteError();
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+uint DaqRecorder::addChannel( const DAQ_REC_CHANNEL_KIND_T kind,
+                              const string& rName )
+{
+   lock_guard<mutex> lock( m_oRecordMutex );
+   checkWriteError();
+
+   const uint channel = m_vChannels.size();
+   if( channel > numeric_limits<uint16_t>::max() )
+      throw Exception( "Too many recorder channels!" );
+
+   m_vChannels.push_back( { kind, rName, 0 } );
+   m_vIndexSlot.push_back( -1 );
+   appendChannelDefinition( channel );
+   return channel;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+void DaqRecorder::writeTuple( const uint channel, const uint64_t timestamp,
+                              const uint32_t actValue, const uint32_t setValue )
+{
+   const DAQ_REC_TUPLE_T oTuple = { actValue, setValue };
+   write( DAQ_REC_FEEDBACK_TUPLE, channel, timestamp, 0,
+          &oTuple, sizeof( oTuple ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+void DaqRecorder::writeMilItem( const uint channel, const uint64_t timestamp,
+                                const DAQ_REC_MIL_ITEM_T& rItem )
+{
+   write( DAQ_REC_MIL_ITEM, channel, timestamp, 0, &rItem, sizeof( rItem ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+void DaqRecorder::writeAddacBlock( const uint channel,
+                                   const DAQ_DESCRIPTOR_T& rDescriptor,
+                                   const DAQ_DATA_T* pData,
+                                   const size_t wordLen )
+{
+   DAQ_DESCRIPTOR_T& rDescr = const_cast<DAQ_DESCRIPTOR_T&>(rDescriptor);
+   write( DAQ_REC_ADDAC_BLOCK, channel,
+          daqDescriptorGetTimeStamp( &rDescr ),
+          daqDescriptorGetSequence( &rDescr ),
+          &rDescriptor, sizeof( rDescriptor ),
+          pData, wordLen * sizeof( DAQ_DATA_T ) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+void DaqRecorder::flush( void )
+{
+   lock_guard<mutex> lock( m_oRecordMutex );
+   checkWriteError();
+
+   if( getCurrentHeader()->m_recordCount == 0 )
+      return;
+
+   /*
+    * The current chunk will be continued, therefore a copy of it
+    * becomes handed over to the writer thread.
+    */
+   CHUNK_T oCopy;
+   oCopy.m_pData  = acquireBuffer();
+   oCopy.m_number = m_oCurrent.m_number;
+   const uint32_t bytes = alignUp( getCurrentHeader()->m_usedBytes,
+                                   DAQ_REC_FILE_HEADER_SIZE );
+   ::memcpy( oCopy.m_pData, m_oCurrent.m_pData, getCurrentHeader()->m_usedBytes );
+   ::memset( &oCopy.m_pData[getCurrentHeader()->m_usedBytes], 0,
+             bytes - getCurrentHeader()->m_usedBytes );
+   {
+      lock_guard<mutex> queueLock( m_oQueueMutex );
+      m_queue.push_back( { oCopy, bytes } );
+   }
+   m_oQueueCondition.notify_all();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::write( const DAQ_REC_TYPE_T type, const uint channel,
+                         const uint64_t timestamp, const uint32_t sequence,
+                         const void* pPayload1, const uint32_t size1,
+                         const void* pPayload2, const uint32_t size2 )
+{
+   lock_guard<mutex> lock( m_oRecordMutex );
+   checkWriteError();
+
+   if( channel >= m_vChannels.size() )
+      throw Exception( "Recorder channel " + to_string( channel ) +
+                       " isn't defined!" );
+
+   append( type, channel, timestamp, sequence,
+           pPayload1, size1, pPayload2, size2 );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::append( const DAQ_REC_TYPE_T type, const uint channel,
+                          const uint64_t timestamp, const uint32_t sequence,
+                          const void* pPayload1, const uint32_t size1,
+                          const void* pPayload2, const uint32_t size2 )
+{
+   const uint32_t size = sizeof( DAQ_REC_RECORD_T ) + size1 + size2;
+   const uint32_t alignedSize = alignUp( size, RECORD_ALIGN );
+   const bool     isData = (type != DAQ_REC_CHANNEL);
+
+   DAQ_REC_CHUNK_HEADER_T* pHeader = getCurrentHeader();
+
+   if( isData )
+   {
+      /*
+       * Starting a new chunk when the record doesn't fit in the current
+       * one or when the index of the current chunk is full.
+       */
+      if( (pHeader->m_usedBytes + alignedSize > m_chunkSize) ||
+          ((m_vIndexSlot[channel] < 0) &&
+           (pHeader->m_indexCount >= DAQ_REC_MAX_INDEX)) )
+      {
+         if( pHeader->m_recordCount == 0 )
+            throw Exception( "Record of " + to_string( size ) +
+                             " bytes doesn't fit in a chunk of " +
+                             to_string( m_chunkSize ) + " bytes!" );
+         submitChunk();
+         startChunk();
+         pHeader = getCurrentHeader();
+         if( pHeader->m_usedBytes + alignedSize > m_chunkSize )
+            throw Exception( "Record of " + to_string( size ) +
+                             " bytes doesn't fit in a chunk of " +
+                             to_string( m_chunkSize ) + " bytes!" );
+      }
+   }
+   else if( pHeader->m_usedBytes + alignedSize > m_chunkSize )
+   {
+      throw Exception( "Channel definitions don't fit in a recorder chunk!" );
+   }
+
+   const uint32_t offset = pHeader->m_usedBytes;
+   uint8_t* pDest = &m_oCurrent.m_pData[offset];
+
+   DAQ_REC_RECORD_T oRecord;
+   oRecord.m_type      = type;
+   oRecord.m_channel   = channel;
+   oRecord.m_size      = size1 + size2;
+   oRecord.m_timestamp = timestamp;
+   oRecord.m_sequence  = sequence;
+   oRecord.m_reserved  = 0;
+   ::memcpy( pDest, &oRecord, sizeof( oRecord ) );
+   pDest += sizeof( oRecord );
+   if( size1 > 0 )
+      ::memcpy( pDest, pPayload1, size1 );
+   pDest += size1;
+   if( size2 > 0 )
+      ::memcpy( pDest, pPayload2, size2 );
+   pDest += size2;
+   ::memset( pDest, 0, alignedSize - size );
+   pHeader->m_usedBytes += alignedSize;
+
+   if( !isData )
+      return;
+
+   if( type != DAQ_REC_ADDAC_BLOCK )
+   { /*
+      * Tuples and MIL items haven't a own sequence number.
+      */
+      reinterpret_cast<DAQ_REC_RECORD_T*>(&m_oCurrent.m_pData[offset])->m_sequence =
+         m_vChannels[channel].m_sequence++;
+   }
+   const uint32_t recSequence =
+      reinterpret_cast<DAQ_REC_RECORD_T*>(&m_oCurrent.m_pData[offset])->m_sequence;
+
+   DAQ_REC_INDEX_ENTRY_T* pIndex;
+   if( m_vIndexSlot[channel] < 0 )
+   {
+      m_vIndexSlot[channel] = pHeader->m_indexCount;
+      pIndex = &pHeader->m_aIndex[pHeader->m_indexCount++];
+      pIndex->m_channel           = channel;
+      pIndex->m_recordCount       = 0;
+      pIndex->m_minTimestamp      = timestamp;
+      pIndex->m_maxTimestamp      = timestamp;
+      pIndex->m_firstSequence     = recSequence;
+      pIndex->m_firstRecordOffset = offset;
+   }
+   else
+   {
+      pIndex = &pHeader->m_aIndex[m_vIndexSlot[channel]];
+      pIndex->m_minTimestamp = min( pIndex->m_minTimestamp, timestamp );
+      pIndex->m_maxTimestamp = max( pIndex->m_maxTimestamp, timestamp );
+   }
+   pIndex->m_lastSequence = recSequence;
+   pIndex->m_recordCount++;
+
+   if( pHeader->m_recordCount == 0 )
+   {
+      pHeader->m_minTimestamp = timestamp;
+      pHeader->m_maxTimestamp = timestamp;
+   }
+   else
+   {
+      pHeader->m_minTimestamp = min( pHeader->m_minTimestamp, timestamp );
+      pHeader->m_maxTimestamp = max( pHeader->m_maxTimestamp, timestamp );
+   }
+   pHeader->m_recordCount++;
+   m_recordCount++;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::appendChannelDefinition( const uint channel )
+{
+   const CHANNEL_T& rChannel = m_vChannels[channel];
+   DAQ_REC_CHANNEL_T oDefinition;
+   oDefinition.m_kind    = rChannel.m_kind;
+   oDefinition.m_nameLen = min( rChannel.m_name.size(),
+                                static_cast<size_t>(numeric_limits<uint16_t>::max()) );
+   append( DAQ_REC_CHANNEL, channel, 0, 0,
+           &oDefinition, sizeof( oDefinition ),
+           rChannel.m_name.data(), oDefinition.m_nameLen );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::startChunk( void )
+{
+   m_oCurrent.m_pData  = acquireBuffer();
+   m_oCurrent.m_number = m_nextChunkNumber++;
+
+   DAQ_REC_CHUNK_HEADER_T* pHeader = getCurrentHeader();
+   ::memset( pHeader, 0, FIRST_RECORD_OFFSET );
+   pHeader->m_magic     = DAQ_REC_CHUNK_MAGIC;
+   pHeader->m_number    = m_oCurrent.m_number;
+   pHeader->m_usedBytes = FIRST_RECORD_OFFSET;
+
+   fill( m_vIndexSlot.begin(), m_vIndexSlot.end(), -1 );
+   for( uint i = 0; i < m_vChannels.size(); i++ )
+      appendChannelDefinition( i );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::submitChunk( void )
+{
+   const uint32_t used  = getCurrentHeader()->m_usedBytes;
+   const uint32_t bytes = alignUp( used, DAQ_REC_FILE_HEADER_SIZE );
+   ::memset( &m_oCurrent.m_pData[used], 0, bytes - used );
+   {
+      lock_guard<mutex> lock( m_oQueueMutex );
+      m_queue.push_back( { m_oCurrent, bytes } );
+   }
+   m_oQueueCondition.notify_all();
+   m_oCurrent.m_pData = nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+uint8_t* DaqRecorder::acquireBuffer( void )
+{
+   unique_lock<mutex> lock( m_oQueueMutex );
+   if( m_vFreeBuffers.empty() )
+   {
+      m_stallCount++;
+      m_oQueueCondition.wait( lock, [this]
+      {
+         return !m_vFreeBuffers.empty() || !m_writeError.empty();
+      });
+      if( !m_writeError.empty() )
+         throw Exception( m_writeError );
+   }
+   uint8_t* pBuffer = m_vFreeBuffers.back();
+   m_vFreeBuffers.pop_back();
+   return pBuffer;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::checkWriteError( void )
+{
+   lock_guard<mutex> lock( m_oQueueMutex );
+   if( !m_writeError.empty() )
+      throw Exception( m_writeError );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::writerThread( void )
+{
+   unique_lock<mutex> lock( m_oQueueMutex );
+   while( true )
+   {
+      m_oQueueCondition.wait( lock, [this]
+      {
+         return !m_queue.empty() || m_stop;
+      });
+      if( m_queue.empty() )
+         break;
+
+      const JOB_T oJob = m_queue.front();
+      m_queue.pop_front();
+      lock.unlock();
+
+      string error;
+      try
+      {
+         writeAll( oJob.m_oChunk.m_pData, oJob.m_bytes,
+                   static_cast<off_t>(DAQ_REC_FILE_HEADER_SIZE) +
+                   static_cast<off_t>(oJob.m_oChunk.m_number) * m_chunkSize );
+      }
+      catch( Exception& e )
+      {
+         error = e.what();
+      }
+
+      lock.lock();
+      if( error.empty() )
+         m_writtenBytes += oJob.m_bytes;
+      else if( m_writeError.empty() )
+         m_writeError = error;
+      m_vFreeBuffers.push_back( oJob.m_oChunk.m_pData );
+      m_oQueueCondition.notify_all();
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqRecorder::writeAll( const void* pData, size_t size, off_t offset )
+{
+   const uint8_t* p = static_cast<const uint8_t*>(pData);
+   while( size > 0 )
+   {
+      const ssize_t ret = ::pwrite( m_fd, p, size, offset );
+      if( ret < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         throw Exception( systemError( "Can't write record file", m_fileName ) );
+      }
+      p      += ret;
+      size   -= ret;
+      offset += ret;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+DaqRecordFile::DaqRecordFile( const string& rFileName )
+   :m_fd( -1 )
+   ,m_pMap( nullptr )
+   ,m_mapSize( 0 )
+   ,m_numberOfChunks( 0 )
+{
+   m_fd = ::open( rFileName.c_str(), O_RDONLY );
+   if( m_fd < 0 )
+      throw Exception( systemError( "Can't open record file", rFileName ) );
+
+   struct stat oStat;
+   if( ::fstat( m_fd, &oStat ) != 0 )
+   {
+      const string msg = systemError( "Can't stat record file", rFileName );
+      ::close( m_fd );
+      throw Exception( msg );
+   }
+
+   m_mapSize = oStat.st_size;
+   if( m_mapSize < sizeof( DAQ_REC_FILE_HEADER_T ) )
+   {
+      ::close( m_fd );
+      throw Exception( "File \"" + rFileName + "\" is not a DAQ record file!" );
+   }
+
+   void* pMap = ::mmap( nullptr, m_mapSize, PROT_READ, MAP_SHARED, m_fd, 0 );
+   if( pMap == MAP_FAILED )
+   {
+      const string msg = systemError( "Can't map record file", rFileName );
+      ::close( m_fd );
+      throw Exception( msg );
+   }
+   m_pMap = static_cast<const uint8_t*>(pMap);
+
+   const DAQ_REC_FILE_HEADER_T& rHeader = getHeader();
+   string error;
+   if( ::memcmp( rHeader.m_magic, DAQ_REC_MAGIC, sizeof( rHeader.m_magic ) ) != 0 )
+      error = "File \"" + rFileName + "\" is not a DAQ record file!";
+   else if( rHeader.m_byteOrderMark != DAQ_REC_BYTE_ORDER_MARK )
+      error = "Record file \"" + rFileName + "\" has a foreign byte order!";
+   else if( rHeader.m_version != DAQ_REC_VERSION )
+      error = "Record file \"" + rFileName + "\" has the unsupported version " +
+              to_string( rHeader.m_version ) + '!';
+   else if( (rHeader.m_headerSize != DAQ_REC_FILE_HEADER_SIZE) ||
+            (rHeader.m_chunkSize <= FIRST_RECORD_OFFSET) ||
+            (rHeader.m_maxIndex > DAQ_REC_MAX_INDEX) )
+      error = "Record file \"" + rFileName + "\" is corrupt!";
+
+   if( !error.empty() )
+   {
+      ::munmap( pMap, m_mapSize );
+      ::close( m_fd );
+      throw Exception( error );
+   }
+
+   const size_t chunkBytes = m_mapSize - rHeader.m_headerSize;
+   m_numberOfChunks = chunkBytes / rHeader.m_chunkSize;
+   /*
+    * The last chunk can be shorter than the chunk size.
+    */
+   if( (chunkBytes % rHeader.m_chunkSize) >= FIRST_RECORD_OFFSET )
+      m_numberOfChunks++;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+DaqRecordFile::~DaqRecordFile( void )
+{
+   ::munmap( const_cast<uint8_t*>(m_pMap), m_mapSize );
+   ::close( m_fd );
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+const DAQ_REC_CHUNK_HEADER_T& DaqRecordFile::getChunk( const uint number ) const
+{
+   if( number >= m_numberOfChunks )
+      throw Exception( "Record chunk " + to_string( number ) +
+                       " is out of range!" );
+
+   const size_t offset = getHeader().m_headerSize +
+                         static_cast<size_t>(number) * getHeader().m_chunkSize;
+   const DAQ_REC_CHUNK_HEADER_T& rChunk =
+      *reinterpret_cast<const DAQ_REC_CHUNK_HEADER_T*>(&m_pMap[offset]);
+
+   if( (rChunk.m_magic != DAQ_REC_CHUNK_MAGIC) || (rChunk.m_number != number) ||
+       (rChunk.m_usedBytes > min( static_cast<size_t>(getHeader().m_chunkSize),
+                                  m_mapSize - offset )) ||
+       (rChunk.m_indexCount > DAQ_REC_MAX_INDEX) )
+      throw Exception( "Record chunk " + to_string( number ) + " is corrupt!" );
+
+   return rChunk;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+uint DaqRecordFile::findChunk( const uint64_t timestamp ) const
+{
+   uint first = 0;
+   uint count = m_numberOfChunks;
+   while( count > 0 )
+   {
+      const uint step = count / 2;
+      const DAQ_REC_CHUNK_HEADER_T& rChunk = getChunk( first + step );
+      if( (rChunk.m_recordCount > 0) && (rChunk.m_maxTimestamp < timestamp) )
+      {
+         first += step + 1;
+         count -= step + 1;
+      }
+      else
+      {
+         count = step;
+      }
+   }
+   return first;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+bool DaqRecordFile::forEachRecord( const uint number,
+                                   const RECORD_CALLBACK_T& rCallback,
+                                   const int channel ) const
+{
+   const DAQ_REC_CHUNK_HEADER_T& rChunk = getChunk( number );
+   const uint8_t* pChunk = reinterpret_cast<const uint8_t*>(&rChunk);
+
+   uint32_t offset    = FIRST_RECORD_OFFSET;
+   uint32_t remaining = numeric_limits<uint32_t>::max();
+   if( channel >= 0 )
+   {
+      remaining = 0;
+      for( uint i = 0; i < rChunk.m_indexCount; i++ )
+      {
+         if( rChunk.m_aIndex[i].m_channel != static_cast<uint>(channel) )
+            continue;
+         offset    = rChunk.m_aIndex[i].m_firstRecordOffset;
+         remaining = rChunk.m_aIndex[i].m_recordCount;
+         break;
+      }
+   }
+
+   while( (remaining > 0) &&
+          (offset + sizeof( DAQ_REC_RECORD_T ) <= rChunk.m_usedBytes) )
+   {
+      const DAQ_REC_RECORD_T& rRecord =
+         *reinterpret_cast<const DAQ_REC_RECORD_T*>(&pChunk[offset]);
+      if( offset + sizeof( DAQ_REC_RECORD_T ) + rRecord.m_size > rChunk.m_usedBytes )
+         throw Exception( "Record chunk " + to_string( number ) + " is corrupt!" );
+
+      if( (channel < 0) ||
+          ((rRecord.m_channel == channel) && (rRecord.m_type != DAQ_REC_CHANNEL)) )
+      {
+         if( channel >= 0 )
+            remaining--;
+         if( rCallback( rRecord, &pChunk[offset + sizeof( DAQ_REC_RECORD_T )] ) )
+            return true;
+      }
+      offset += alignUp( static_cast<uint32_t>(sizeof( DAQ_REC_RECORD_T ) + rRecord.m_size),
+                         RECORD_ALIGN );
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+const DAQ_REC_RECORD_T* DaqRecordFile::nextRecord( uint& rChunk,
+                                                   uint32_t& rOffset ) const
+{
+   while( rChunk < m_numberOfChunks )
+   {
+      const DAQ_REC_CHUNK_HEADER_T& rHeader = getChunk( rChunk );
+      if( rOffset < FIRST_RECORD_OFFSET )
+         rOffset = FIRST_RECORD_OFFSET;
+
+      if( rOffset + sizeof( DAQ_REC_RECORD_T ) <= rHeader.m_usedBytes )
+      {
+         const DAQ_REC_RECORD_T* pRecord =
+            reinterpret_cast<const DAQ_REC_RECORD_T*>(
+                          &reinterpret_cast<const uint8_t*>(&rHeader)[rOffset] );
+         if( rOffset + sizeof( DAQ_REC_RECORD_T ) + pRecord->m_size > rHeader.m_usedBytes )
+            throw Exception( "Record chunk " + to_string( rChunk ) + " is corrupt!" );
+         rOffset += alignUp( static_cast<uint32_t>(sizeof( DAQ_REC_RECORD_T ) +
+                                                   pRecord->m_size),
+                             RECORD_ALIGN );
+         return pRecord;
+      }
+      rChunk++;
+      rOffset = 0;
+   }
+   return nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+vector<DaqRecordFile::CHANNEL_T> DaqRecordFile::getChannels( const uint number ) const
+{
+   vector<CHANNEL_T> vChannels;
+   if( m_numberOfChunks == 0 )
+      return vChannels;
+
+   forEachRecord( number, [&]( const DAQ_REC_RECORD_T& rRecord, const void* pPayload )
+   {
+      if( rRecord.m_type != DAQ_REC_CHANNEL )
+         return false;
+
+      const DAQ_REC_CHANNEL_T* pDefinition =
+                         static_cast<const DAQ_REC_CHANNEL_T*>(pPayload);
+      if( vChannels.size() <= rRecord.m_channel )
+         vChannels.resize( rRecord.m_channel + 1 );
+      vChannels[rRecord.m_channel].m_kind =
+                      static_cast<DAQ_REC_CHANNEL_KIND_T>(pDefinition->m_kind);
+      vChannels[rRecord.m_channel].m_name =
+         string( reinterpret_cast<const char*>(&pDefinition[1]),
+                 pDefinition->m_nameLen );
+      return false;
+   });
+   return vChannels;
+}
+
+/*!----------------------------------------------------------------------------
+ * @see daq_recorder.hpp
+ */
+uint64_t DaqRecordFile::getRecordCount( void ) const
+{
+   uint64_t count = 0;
+   for( uint i = 0; i < m_numberOfChunks; i++ )
+      count += getChunk( i ).m_recordCount;
+   return count;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,607 @@
+/*!
+ * @file daq_recorder.hpp
+ * @brief Recorder of feedback tuples, ADDAC-DAQ blocks and MIL-DAQ items
+ *        in a chunked binary file, and memory mapped reader of such files.
+ *
+ * File layout:
+ * @code
+ * +------------------------+  offset 0
+ * | DAQ_REC_FILE_HEADER_T  |  DAQ_REC_FILE_HEADER_SIZE bytes
+ * +------------------------+  offset DAQ_REC_FILE_HEADER_SIZE
+ * | chunk 0                |  m_chunkSize bytes
+ * +------------------------+
+ * | chunk 1                |
+ * +------------------------+
+ * | ...                    |
+ * @endcode
+ * Each chunk begins with a DAQ_REC_CHUNK_HEADER_T, which contains the
+ * index of the chunk: the timestamp range and the sequence range of each
+ * channel recorded in this chunk. The records (DAQ_REC_RECORD_T followed
+ * by its payload) follow the chunk header, each record is aligned to
+ * eight bytes. The definitions of all known channels are repeated at the
+ * begin of each chunk, so each chunk can be decoded by its own.
+ *
+ * All values are in the byte order of the recording host, which is
+ * documented by DAQ_REC_FILE_HEADER_T::m_byteOrderMark.
+ *
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _DAQ_RECORDER_HPP
+#define _DAQ_RECORDER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <daq_exception.hpp>
+#include <daq_descriptor.h>
+
+namespace Scu
+{
+namespace daq
+{
+
+/*!
+ * @brief Identification of a DAQ record file: "SCUDAQR" + version digit.
+ */
+constexpr char     DAQ_REC_MAGIC[8]         = { 'S','C','U','D','A','Q','R','1' };
+constexpr uint32_t DAQ_REC_VERSION          = 1;
+constexpr uint32_t DAQ_REC_BYTE_ORDER_MARK  = 0x01020304;
+constexpr uint32_t DAQ_REC_CHUNK_MAGIC      = 0x4B4E4843; /* "CHNK" */
+
+/*!
+ * @brief Size of the file header and alignment of the chunks and of
+ *        the write accesses.
+ */
+constexpr uint32_t DAQ_REC_FILE_HEADER_SIZE = 4096;
+
+/*!
+ * @brief Default size of a chunk.
+ */
+constexpr uint32_t DAQ_REC_DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+/*!
+ * @brief Maximum number of channels of the index of a chunk.
+ *
+ * When further channels occur, then the chunk becomes closed
+ * and a new one becomes started.
+ */
+constexpr uint32_t DAQ_REC_MAX_INDEX        = 32;
+
+/*!
+ * @brief Record types.
+ */
+enum DAQ_REC_TYPE_T: uint16_t
+{
+   /*!
+    * @brief Definition of a channel, payload is DAQ_REC_CHANNEL_T followed
+    *        by the name.
+    */
+   DAQ_REC_CHANNEL        = 1,
+
+   /*!
+    * @brief Function generator feedback tuple, payload is DAQ_REC_TUPLE_T.
+    */
+   DAQ_REC_FEEDBACK_TUPLE = 2,
+
+   /*!
+    * @brief Complete ADDAC/ACU-DAQ block, payload is the device descriptor
+    *        followed by the data words.
+    */
+   DAQ_REC_ADDAC_BLOCK    = 3,
+
+   /*!
+    * @brief MIL-DAQ item, payload is DAQ_REC_MIL_ITEM_T.
+    */
+   DAQ_REC_MIL_ITEM       = 4
+};
+
+/*!
+ * @brief Kind of a recorded channel.
+ */
+enum DAQ_REC_CHANNEL_KIND_T: uint16_t
+{
+   DAQ_REC_KIND_FEEDBACK  = 1,
+   DAQ_REC_KIND_ADDAC_DAQ = 2,
+   DAQ_REC_KIND_MIL_DAQ   = 3
+};
+
+/*!
+ * @brief Header of a record file.
+ */
+struct DAQ_REC_FILE_HEADER_T
+{
+   char     m_magic[sizeof(DAQ_REC_MAGIC)];
+   uint32_t m_version;
+   uint32_t m_byteOrderMark;
+   uint32_t m_headerSize;
+   uint32_t m_chunkSize;
+   uint32_t m_maxIndex;
+   uint32_t m_reserved;
+
+   /*!
+    * @brief Start time of the recording in nanoseconds since epoch.
+    */
+   uint64_t m_creationTime;
+
+   /*!
+    * @brief Zero terminated free text, e.g. tool and SCU name.
+    */
+   char     m_description[DAQ_REC_FILE_HEADER_SIZE - 40];
+};
+static_assert( sizeof(DAQ_REC_FILE_HEADER_T) == DAQ_REC_FILE_HEADER_SIZE, "" );
+
+/*!
+ * @brief Index entry of a channel within a chunk.
+ */
+struct DAQ_REC_INDEX_ENTRY_T
+{
+   uint16_t m_channel;
+   uint16_t m_reserved;
+   uint32_t m_recordCount;
+   uint64_t m_minTimestamp;
+   uint64_t m_maxTimestamp;
+   uint32_t m_firstSequence;
+   uint32_t m_lastSequence;
+
+   /*!
+    * @brief Offset of the first record of this channel relative to the
+    *        begin of the chunk.
+    */
+   uint32_t m_firstRecordOffset;
+   uint32_t m_reserved2;
+};
+static_assert( sizeof(DAQ_REC_INDEX_ENTRY_T) == 40, "" );
+
+/*!
+ * @brief Header and index of a chunk.
+ */
+struct DAQ_REC_CHUNK_HEADER_T
+{
+   uint32_t              m_magic;
+   uint32_t              m_number;
+
+   /*!
+    * @brief Number of bytes of the chunk which are in use,
+    *        including this header.
+    */
+   uint32_t              m_usedBytes;
+
+   /*!
+    * @brief Number of data records, channel definitions are not counted.
+    */
+   uint32_t              m_recordCount;
+   uint64_t              m_minTimestamp;
+   uint64_t              m_maxTimestamp;
+   uint32_t              m_indexCount;
+   uint32_t              m_reserved;
+   DAQ_REC_INDEX_ENTRY_T m_aIndex[DAQ_REC_MAX_INDEX];
+};
+
+/*!
+ * @brief Header of a record.
+ */
+struct DAQ_REC_RECORD_T
+{
+   uint16_t m_type;
+   uint16_t m_channel;
+
+   /*!
+    * @brief Payload size in bytes without header and alignment padding.
+    */
+   uint32_t m_size;
+
+   /*!
+    * @brief White rabbit timestamp in nanoseconds.
+    */
+   uint64_t m_timestamp;
+
+   /*!
+    * @brief Block sequence number of ADDAC blocks, otherwise a running
+    *        number of the channel given by the recorder.
+    */
+   uint32_t m_sequence;
+   uint32_t m_reserved;
+};
+static_assert( sizeof(DAQ_REC_RECORD_T) == 24, "" );
+
+/*!
+ * @brief Payload of the record type DAQ_REC_CHANNEL.
+ */
+struct DAQ_REC_CHANNEL_T
+{
+   uint16_t m_kind;
+   uint16_t m_nameLen;
+   /* followed by m_nameLen characters without zero termination */
+};
+
+/*!
+ * @brief Payload of the record type DAQ_REC_FEEDBACK_TUPLE.
+ */
+struct DAQ_REC_TUPLE_T
+{
+   uint32_t m_actValue;
+   uint32_t m_setValue;
+};
+
+/*!
+ * @brief Payload of the record type DAQ_REC_MIL_ITEM.
+ *
+ * It keeps the raw MIL-DAQ item as received from the LM32 including
+ * the function generator macro, so that a recording can be replayed
+ * unchanged.
+ */
+struct DAQ_REC_MIL_ITEM_T
+{
+   uint16_t m_setValue;
+   uint16_t m_actValue;
+   uint8_t  m_socket;
+   uint8_t  m_device;
+   uint8_t  m_version;
+   uint8_t  m_outputBits;
+};
+static_assert( sizeof(DAQ_REC_MIL_ITEM_T) == 8, "" );
+
+/*!
+ * @brief Returns the recorder channel name of a ADDAC/ACU-DAQ channel.
+ * @param slot SCU-bus slot number, beginning at 1.
+ * @param channel Channel number, beginning at 1.
+ */
+inline std::string makeRecordAddacName( const uint slot, const uint channel )
+{
+   return "slot-" + std::to_string( slot ) + "-channel-" + std::to_string( channel );
+}
+
+/*!
+ * @brief Returns the recorder channel name of a function generator.
+ */
+inline std::string makeRecordFgName( const uint socket, const uint device )
+{
+   return "fg-" + std::to_string( socket ) + '-' + std::to_string( device );
+}
+
+/*!
+ * @brief Counterpart of makeRecordAddacName().
+ * @retval true Name is a ADDAC/ACU-DAQ channel name.
+ */
+bool parseRecordAddacName( const std::string& rName, uint& rSlot, uint& rChannel );
+
+/*!
+ * @brief Counterpart of makeRecordFgName().
+ * @retval true Name is a function generator name.
+ */
+bool parseRecordFgName( const std::string& rName, uint& rSocket, uint& rDevice );
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Writes records in a chunked record file.
+ *
+ * The chunks become filled in the calling thread and written by a
+ * background thread in full chunk size at chunk aligned file offsets.
+ * When the writer thread can't keep up, the recording functions are
+ * waiting for a free chunk buffer, no record gets lost.
+ *
+ * A write error of the background thread becomes thrown as daq::Exception
+ * by the next recording function respectively by close().
+ */
+class DaqRecorder
+{
+   /*!
+    * @brief Chunk buffer, aligned to DAQ_REC_FILE_HEADER_SIZE.
+    */
+   struct CHUNK_T
+   {
+      uint8_t*  m_pData;
+      uint32_t  m_number;
+   };
+
+   /*!
+    * @brief Write job of the background thread.
+    */
+   struct JOB_T
+   {
+      CHUNK_T  m_oChunk;
+
+      /*!
+       * @brief Number of bytes to write, multiple of
+       *        DAQ_REC_FILE_HEADER_SIZE.
+       */
+      uint32_t m_bytes;
+   };
+
+   /*!
+    * @brief Definition of a recorded channel.
+    */
+   struct CHANNEL_T
+   {
+      DAQ_REC_CHANNEL_KIND_T m_kind;
+      std::string            m_name;
+      uint32_t               m_sequence;
+   };
+
+   const std::string        m_fileName;
+   const uint32_t           m_chunkSize;
+   int                      m_fd;
+
+   std::vector<CHANNEL_T>   m_vChannels;
+
+   /*!
+    * @brief Slot of each channel in the index of the current chunk,
+    *        negative if not yet in the current chunk.
+    */
+   std::vector<int>         m_vIndexSlot;
+
+   CHUNK_T                  m_oCurrent;
+   uint32_t                 m_nextChunkNumber;
+
+   std::vector<uint8_t*>    m_vAllBuffers;
+   std::vector<uint8_t*>    m_vFreeBuffers;
+   std::deque<JOB_T>        m_queue;
+   std::mutex               m_oQueueMutex;
+   std::condition_variable  m_oQueueCondition;
+   std::string              m_writeError;
+   bool                     m_stop;
+   std::thread              m_oWriter;
+
+   /*!
+    * @brief Protects the recording functions for concurrent callers.
+    */
+   std::mutex               m_oRecordMutex;
+
+   uint64_t                 m_recordCount;
+   uint64_t                 m_writtenBytes;
+   uint                     m_stallCount;
+
+public:
+   /*!
+    * @brief Constructor creates respectively truncates the file and starts
+    *        the background writer thread.
+    * @param rFileName Name of the record file.
+    * @param rDescription Free text which becomes stored in the file header.
+    * @param chunkSize Size of each chunk, it will rounded up to a multiple
+    *                  of DAQ_REC_FILE_HEADER_SIZE.
+    * @param numberOfBuffers Number of chunk buffers.
+    */
+   DaqRecorder( const std::string& rFileName,
+                const std::string& rDescription = "",
+                const uint32_t chunkSize = DAQ_REC_DEFAULT_CHUNK_SIZE,
+                const uint numberOfBuffers = 8 );
+
+   /*!
+    * @brief Destructor makes close() if not already done.
+    */
+   ~DaqRecorder( void );
+
+   /*!
+    * @brief Writes the current chunk, waits for the writer thread and
+    *        closes the file.
+    */
+   void close( void );
+
+   /*!
+    * @brief Returns the name of the record file.
+    */
+   const std::string& getFileName( void ) const
+   {
+      return m_fileName;
+   }
+
+   /*!
+    * @brief Defines a new channel.
+    * @param kind Kind of the channel.
+    * @param rName Name of the channel, e.g. "fg-39-0" or "slot-3-channel-1"
+    * @return Channel number for the recording functions.
+    */
+   uint addChannel( const DAQ_REC_CHANNEL_KIND_T kind, const std::string& rName );
+
+   /*!
+    * @brief Records a feedback tuple.
+    */
+   void writeTuple( const uint channel, const uint64_t timestamp,
+                    const uint32_t actValue, const uint32_t setValue );
+
+   /*!
+    * @brief Records a raw MIL-DAQ item.
+    */
+   void writeMilItem( const uint channel, const uint64_t timestamp,
+                      const DAQ_REC_MIL_ITEM_T& rItem );
+
+   /*!
+    * @brief Records a complete ADDAC/ACU-DAQ block.
+    * @param channel Channel number given by addChannel().
+    * @param rDescriptor Device descriptor of the block.
+    * @param pData Data words of the block.
+    * @param wordLen Number of data words.
+    */
+   void writeAddacBlock( const uint channel,
+                         const DAQ_DESCRIPTOR_T& rDescriptor,
+                         const DAQ_DATA_T* pData,
+                         const std::size_t wordLen );
+
+   /*!
+    * @brief Hands the current chunk in its current state over to the
+    *        writer thread, so that the file contains all records which
+    *        has been recorded so far, e.g. for periodic flushing of
+    *        slow channels.
+    * @note The chunk stays the current chunk, a copy of it becomes written
+    *       and it will written again when it is full.
+    */
+   void flush( void );
+
+   /*!
+    * @brief Returns the number of records so far.
+    */
+   uint64_t getRecordCount( void ) const
+   {
+      return m_recordCount;
+   }
+
+   /*!
+    * @brief Returns the number of bytes handed over to the writer thread.
+    */
+   uint64_t getWrittenBytes( void ) const
+   {
+      return m_writtenBytes;
+   }
+
+   /*!
+    * @brief Returns how often the recording had to wait for a
+    *        free chunk buffer.
+    */
+   uint getStallCount( void ) const
+   {
+      return m_stallCount;
+   }
+
+private:
+   void write( const DAQ_REC_TYPE_T type, const uint channel,
+               const uint64_t timestamp, const uint32_t sequence,
+               const void* pPayload1, const uint32_t size1,
+               const void* pPayload2 = nullptr, const uint32_t size2 = 0 );
+
+   void append( const DAQ_REC_TYPE_T type, const uint channel,
+                const uint64_t timestamp, const uint32_t sequence,
+                const void* pPayload1, const uint32_t size1,
+                const void* pPayload2, const uint32_t size2 );
+
+   void appendChannelDefinition( const uint channel );
+
+   DAQ_REC_CHUNK_HEADER_T* getCurrentHeader( void )
+   {
+      return reinterpret_cast<DAQ_REC_CHUNK_HEADER_T*>(m_oCurrent.m_pData);
+   }
+
+   void startChunk( void );
+   void submitChunk( void );
+   uint8_t* acquireBuffer( void );
+   void checkWriteError( void );
+   void writerThread( void );
+   void writeAll( const void* pData, std::size_t size, off_t offset );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Read only access to a record file via memory mapping.
+ */
+class DaqRecordFile
+{
+public:
+   /*!
+    * @brief Definition of a channel found in the file.
+    */
+   struct CHANNEL_T
+   {
+      DAQ_REC_CHANNEL_KIND_T m_kind;
+      std::string            m_name;
+   };
+
+   /*!
+    * @brief Callback type of forEachRecord(), the iteration stops when the
+    *        callback returns true.
+    */
+   using RECORD_CALLBACK_T = std::function<bool( const DAQ_REC_RECORD_T& rRecord,
+                                                 const void* pPayload )>;
+
+private:
+   int                          m_fd;
+   const uint8_t*               m_pMap;
+   std::size_t                  m_mapSize;
+   uint                         m_numberOfChunks;
+
+public:
+   /*!
+    * @brief Constructor maps the given file.
+    * @throw daq::Exception if the file can't be opened or isn't a record file.
+    */
+   DaqRecordFile( const std::string& rFileName );
+   ~DaqRecordFile( void );
+
+   const DAQ_REC_FILE_HEADER_T& getHeader( void ) const
+   {
+      return *reinterpret_cast<const DAQ_REC_FILE_HEADER_T*>(m_pMap);
+   }
+
+   /*!
+    * @brief Returns the number of complete or partially written chunks.
+    */
+   uint getNumberOfChunks( void ) const
+   {
+      return m_numberOfChunks;
+   }
+
+   /*!
+    * @brief Returns the header respectively the index of the given chunk.
+    */
+   const DAQ_REC_CHUNK_HEADER_T& getChunk( const uint number ) const;
+
+   /*!
+    * @brief Returns the number of the first chunk which contains records
+    *        with a timestamp equal or greater than the given one,
+    *        respectively getNumberOfChunks() if there is no such chunk.
+    * @note The chunks are presumed to be in ascending time order.
+    */
+   uint findChunk( const uint64_t timestamp ) const;
+
+   /*!
+    * @brief Invokes the callback function for each record of the
+    *        given chunk.
+    * @param number Chunk number.
+    * @param rCallback Callback function.
+    * @param channel If not negative then only the records of this channel.
+    * @return True if the iteration has been stopped by the callback.
+    */
+   bool forEachRecord( const uint number, const RECORD_CALLBACK_T& rCallback,
+                       const int channel = -1 ) const;
+
+   /*!
+    * @brief Returns the record at the given position and advances the
+    *        position to the following record, chunk borders will crossed.
+    *
+    * Unlike forEachRecord() the iteration can be interrupted and resumed
+    * at any time, e.g. by a replay.
+    * @param rChunk Chunk number of the position, zero at the beginning.
+    * @param rOffset Offset within the chunk, zero at the beginning.
+    * @return Pointer to the record, the payload follows directly;
+    *         nullptr at the end of the file.
+    */
+   const DAQ_REC_RECORD_T* nextRecord( uint& rChunk, uint32_t& rOffset ) const;
+
+   /*!
+    * @brief Returns the definitions of all channels of the given chunk,
+    *        the vector index is the channel number.
+    */
+   std::vector<CHANNEL_T> getChannels( const uint number = 0 ) const;
+
+   /*!
+    * @brief Returns the total number of records of all chunks.
+    */
+   uint64_t getRecordCount( void ) const;
+};
+
+} /* namespace daq */
+} /* namespace Scu */
+
+#endif /* ifndef _DAQ_RECORDER_HPP */
+//================================== EOF ======================================
@@ -0,0 +1,912 @@
+/*!
+ * @file daq_simulator.cpp
+ * @brief Simulation of the LM32 firmware part of the ADDAC- and MIL-DAQ
+ *        and of the function generator list for offline benchmarking of
+ *        the Linux tools.
+ *
+ * @see daq_simulator.hpp
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+/*
+ * Makes the setter functions of the device descriptor visible.
+ */
+#define CONFIG_DAQ_SIMULATE_CHANNEL
+
+#include <scu_control_config.h>
+#include <message_macros.hpp>
+#include <BusException.hpp>
+#include <daq_command_interface.h>
+#include <daq_ramBuffer.h>
+#include <daq_fg_allocator.h>
+#include <scu_shared_mem.h>
+#include <scu_function_generator.h>
+#include <scu_mmu_tag.h>
+#include <daq_access.hpp>
+#include <daq_crc.hpp>
+#include <string.h>
+#include <set>
+#include "daq_simulator.hpp"
+
+using namespace Scu;
+using namespace Scu::daq;
+using namespace Scu::MiLdaq;
+using namespace FeSupport::Scu::Etherbone;
+
+namespace
+{
+/*!
+ * @brief Byte offsets of the shared objects in the LM32 memory.
+ */
+constexpr uint FG_OFFSET    = SHARED_OFFS;
+constexpr uint MIL_OFFSET   = SHARED_OFFS + DaqAccess::MIL_DAQ_OFFSET;
+constexpr uint ADDAC_OFFSET = SHARED_OFFS + DaqAccess::ADDAC_DAQ_OFFSET;
+
+constexpr uint MIL_RING_OFFSET      = MIL_OFFSET + offsetof( MIL_DAQ_ADMIN_T, memAdmin );
+constexpr uint DAQ_RING_OFFSET      = ADDAC_OFFSET + offsetof( DAQ_SHARED_IO_T, ringAdmin );
+constexpr uint DAQ_OPERATION_OFFSET = ADDAC_OFFSET + offsetof( DAQ_SHARED_IO_T, operation );
+constexpr uint MIL_SEQUENCE_OFFSET  = SHARED_OFFS + DaqAccess::MIL_RING_SEQUENCE_OFFSET;
+constexpr uint DAQ_SEQUENCE_OFFSET  = SHARED_OFFS + DaqAccess::ADDAC_RING_SEQUENCE_OFFSET;
+
+/*!
+ * @brief Major version of the function generator firmware expected by
+ *        FgList::scan().
+ */
+constexpr uint32_t FG_FW_VERSION = 4;
+
+/*!
+ * @brief Number of DAQ data words following the device descriptor in
+ *        a short block.
+ */
+constexpr uint SHORT_BLOCK_DATA_WORDS = DAQ_FIFO_DAQ_WORD_SIZE_CRC - DAQ_DESCRIPTOR_WORD_SIZE;
+
+/*!
+ * @brief Total number of words of a short block in the RAM including
+ *        the completion.
+ */
+constexpr uint SHORT_BLOCK_RAM_WORDS = RAM_DAQ_SHORT_BLOCK_LEN * RAM_DAQ_DATA_WORDS_PER_RAM_INDEX;
+
+/*!
+ * @brief Maximum number of blocks per channel which will produced
+ *        within one period of the producer thread.
+ */
+constexpr uint MAX_BLOCKS_PER_TICK = 64;
+
+/*!
+ * @brief Time in microseconds after which the fast replay stops waiting
+ *        for free space in a ring buffer which isn't read by the host.
+ */
+constexpr USEC_T REPLAY_STALL_TIMEOUT_US = 1000000;
+
+} /* anonymous namespace */
+
+/*!----------------------------------------------------------------------------
+ * @brief Registers DaqSimulator as simulator, replacing ScuSimulator.
+ */
+static struct DAQ_SIM_REGISTRAR
+{
+   DAQ_SIM_REGISTRAR( void )
+   {
+      EtherboneConnection::setSimulatorFactory( DaqSimulator::create );
+   }
+} mg_daqSimRegistrar;
+
+/*!----------------------------------------------------------------------------
+ */
+WishboneSimulator* DaqSimulator::create( const std::string& rNetAddress )
+{
+   DaqSimulator* pSimulator = new DaqSimulator( rNetAddress );
+   pSimulator->start();
+   return pSimulator;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+DaqSimulator::DaqSimulator( const std::string& rNetAddress )
+   :ScuSimulator( rNetAddress )
+   ,m_addacSequence( 0 )
+   ,m_milSequence( 0 )
+   ,m_poReplayFile( nullptr )
+   ,m_replayFast( false )
+   ,m_replayDelayUs( 0 )
+   ,m_replayChunk( 0 )
+   ,m_replayOffset( 0 )
+   ,m_pReplayRecord( nullptr )
+   ,m_replayFirstTimestamp( 0 )
+   ,m_replayStartTime( 0 )
+   ,m_replayProgressTime( 0 )
+{
+   DEBUG_MESSAGE_M_FUNCTION( rNetAddress );
+
+   m_speedup      = std::max( getOption( "speedup", 1 ), 1U );
+   m_milRate      = getOption( "milrate", 0 );
+
+   /*
+    * Allocation of the ring buffers like mmuAllocateDaqBuffer() on the LM32.
+    */
+   uint start;
+   const uint addacLen = std::max( getOption( "blocks", DEFAULT_RING_BLOCKS ), 1U )
+                                                     * RAM_DAQ_LONG_BLOCK_LEN;
+   if( !mmuAllocate( mmu::TAG_ADDAC_DAQ, start, addacLen ) )
+      throw BusException( "Simulator: Can't allocate ADDAC-DAQ buffer!" );
+   ::memset( &m_addacRing, 0, sizeof( m_addacRing ) );
+   m_addacRing.indexes.offset   = start;
+   m_addacRing.indexes.capacity = addacLen;
+
+   const uint milLen = DEFAULT_MIL_ITEMS * RAM_ITEM_PER_MIL_DAQ_ITEM;
+   if( !mmuAllocate( mmu::TAG_MIL_DAQ, start, milLen ) )
+      throw BusException( "Simulator: Can't allocate MIL-DAQ buffer!" );
+   ::memset( &m_milRing, 0, sizeof( m_milRing ) );
+   m_milRing.indexes.offset   = start;
+   m_milRing.indexes.capacity = milLen;
+
+   lm32Put( MIL_OFFSET + offsetof( MIL_DAQ_ADMIN_T, magicNumber ),
+            MIL_DAQ_MAGIC_NUMBER );
+   lm32PutRingAdmin( MIL_RING_OFFSET, m_milRing );
+
+   lm32Put( ADDAC_OFFSET + offsetof( DAQ_SHARED_IO_T, magicNumber ),
+            DAQ_MAGIC_NUMBER );
+   lm32PutRingAdmin( DAQ_RING_OFFSET, m_addacRing );
+   lm32Put( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, code ),
+            static_cast<uint32_t>(DAQ_OP_IDLE) );
+   lm32Put( SHARED_OFFS + DaqAccess::RING_CAPABILITY_OFFSET,
+            static_cast<uint32_t>(RAM_RING_DIRECT_CAPABILITY) );
+   lm32Put( MIL_SEQUENCE_OFFSET, m_milSequence );
+   lm32Put( DAQ_SEQUENCE_OFFSET, m_addacSequence );
+
+   const std::string replayFileName = getOptionText( "replay" );
+   if( !replayFileName.empty() )
+   {
+      initReplay( replayFileName );
+   }
+   else
+   {
+      const uint addacDevices = std::min( getOption( "addac", 0 ),
+                                          static_cast<uint>(Bus::MAX_SCU_SLAVES) );
+      for( uint slot = 1; slot <= addacDevices; slot++ )
+         m_vAddacSlots.push_back( slot );
+
+      m_vMilFgs.resize( std::min( getOption( "mil", 0 ),
+                                  static_cast<uint>(MAX_FG_MACROS / 2) ) );
+      for( uint i = 0; i < m_vMilFgs.size(); i++ )
+      {
+         m_vMilFgs[i].socket       = DEV_MIL_EXT;
+         m_vMilFgs[i].device       = i + 1;
+         m_vMilFgs[i].nextItemTime = 0;
+         m_vMilFgs[i].value        = 0;
+      }
+   }
+
+   m_vChannels.resize( getNumberOfAddacDevices() * CHANNELS_PER_DEVICE );
+   resetChannels();
+
+   initFgList();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+DaqSimulator::~DaqSimulator( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+   stop();
+   if( m_poReplayFile != nullptr )
+      delete m_poReplayFile;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Opens the record file of the replay mode and takes the ADDAC
+ *        slots and the MIL function generators from the recording.
+ */
+void DaqSimulator::initReplay( const std::string& rFileName )
+{
+   m_poReplayFile  = new DaqRecordFile( rFileName );
+   m_replayFast    = getOption( "fast", 0 ) != 0;
+   m_replayDelayUs = static_cast<USEC_T>(getOption( "delay", DEFAULT_REPLAY_DELAY_MS ))
+                                                                       * 1000;
+
+   std::set<uint> addacSlots;
+   std::set<std::pair<uint, uint>> milFgs;
+   auto addFg = [&]( const uint socket, const uint device )
+   {
+      if( isAddacFg( socket ) )
+         addacSlots.insert( socket );
+      else if( isMilFg( socket ) )
+         milFgs.insert( { socket, device } );
+   };
+
+   bool            isFirst = true;
+   uint            chunk   = 0;
+   uint32_t        offset  = 0;
+   const DAQ_REC_RECORD_T* pRecord;
+   while( (pRecord = m_poReplayFile->nextRecord( chunk, offset )) != nullptr )
+   {
+      const void* pPayload = &pRecord[1];
+      switch( pRecord->m_type )
+      {
+         case DAQ_REC_CHANNEL:
+         {
+            const DAQ_REC_CHANNEL_T* pDefinition =
+                            static_cast<const DAQ_REC_CHANNEL_T*>(pPayload);
+            const std::string name( reinterpret_cast<const char*>(&pDefinition[1]),
+                                    pDefinition->m_nameLen );
+            uint a, b;
+            if( parseRecordAddacName( name, a, b ) )
+               addFg( a, 0 );
+            else if( parseRecordFgName( name, a, b ) )
+               addFg( a, b );
+            continue;
+         }
+         case DAQ_REC_ADDAC_BLOCK:
+         {
+            if( pRecord->m_size < sizeof( DAQ_DESCRIPTOR_T ) )
+               continue;
+            DAQ_DESCRIPTOR_T descriptor;
+            ::memcpy( &descriptor, pPayload, sizeof( descriptor ) );
+            addFg( daqDescriptorGetSlot( &descriptor ), 0 );
+            break;
+         }
+         case DAQ_REC_MIL_ITEM:
+         {
+            if( pRecord->m_size < sizeof( DAQ_REC_MIL_ITEM_T ) )
+               continue;
+            const DAQ_REC_MIL_ITEM_T* pItem =
+                            static_cast<const DAQ_REC_MIL_ITEM_T*>(pPayload);
+            addFg( pItem->m_socket, pItem->m_device );
+            break;
+         }
+         default:
+         { /*
+            * Feedback tuples are the output of the host, they are not
+            * replayed.
+            */
+            continue;
+         }
+      }
+      if( isFirst )
+      {
+         isFirst = false;
+         m_replayFirstTimestamp = pRecord->m_timestamp;
+      }
+   }
+
+   if( (addacSlots.size() * (CHANNELS_PER_DEVICE / 2) + milFgs.size()) >= MAX_FG_MACROS )
+      throw BusException( "Simulator: Too many function generators in \"" +
+                          rFileName + "\"!" );
+
+   m_vAddacSlots.assign( addacSlots.begin(), addacSlots.end() );
+   for( const auto& fg: milFgs )
+      m_vMilFgs.push_back( { fg.first, fg.second, 0, 0 } );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Initializes the function generator part of the shared memory
+ *        like the scan of the LM32 firmware.
+ */
+void DaqSimulator::initFgList( void )
+{
+   using FG_T = FG::SCU_SHARED_DATA_T;
+
+   lm32Put( FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.magicNumber ), FG_MAGIC_NUMBER );
+   lm32Put( FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.version ), FG_FW_VERSION );
+   lm32Put( FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.mailBoxSlot ), static_cast<uint32_t>(0) );
+   lm32Put( FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.maxChannels ),
+            static_cast<uint32_t>(MAX_FG_CHANNELS) );
+
+   uint offset = FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.aMacros );
+   for( const auto slot: m_vAddacSlots )
+   {
+      for( uint device = 0; device < CHANNELS_PER_DEVICE / 2; device++ )
+      {
+         const FG_MACRO_T macro = { static_cast<uint8_t>(slot),
+                                    static_cast<uint8_t>(device),
+                                    3, 32 };
+         lm32Write( offset, &macro, sizeof( macro ) );
+         offset += sizeof( macro );
+      }
+   }
+   for( const auto& fg: m_vMilFgs )
+   {
+      const FG_MACRO_T macro = { static_cast<uint8_t>(fg.socket),
+                                 static_cast<uint8_t>(fg.device), 1, 16 };
+      lm32Write( offset, &macro, sizeof( macro ) );
+      offset += sizeof( macro );
+   }
+
+   /*
+    * Terminator of the list.
+    */
+   const FG_MACRO_T macro = { 0, 0, 0, 0 };
+   lm32Write( offset, &macro, sizeof( macro ) );
+
+   lm32Put( FG_OFFSET + offsetof( FG_T, oSaftLib.oFg.busy ), static_cast<uint32_t>(0) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqSimulator::resetChannels( void )
+{
+   for( auto& channel: m_vChannels )
+   {
+      channel.periodUs         = 0;
+      channel.sampleRate       = 0;
+      channel.blockDownCounter = 0;
+      channel.sequence         = 0;
+      channel.nextBlockTime    = 0;
+      channel.value            = 0;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqSimulator::onSoftwareInterrupt( const uint slot, const uint32_t signal )
+{
+   if( (signal >> BIT_SIZEOF(uint16_t)) == FG::FG_OP_RESCAN )
+   { /*
+      * The list of function generators is constant, so the rescan becomes
+      * finished immediately.
+      */
+      lm32Put( FG_OFFSET + offsetof( FG::SCU_SHARED_DATA_T, oSaftLib.oFg.busy ),
+               static_cast<uint32_t>(0) );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqSimulator::onCycleEnd( void )
+{
+   syncRing( DAQ_RING_OFFSET, m_addacRing, DAQ_SEQUENCE_OFFSET, m_addacSequence );
+   syncRing( MIL_RING_OFFSET, m_milRing, MIL_SEQUENCE_OFFSET, m_milSequence );
+
+   const uint code = lm32Get<uint32_t>( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, code ) );
+   if( code != DAQ_OP_IDLE )
+      executeCommand( code );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+uint DaqSimulator::getParam( const uint n )
+{
+   return lm32Get<DAQ_REGISTER_T>( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, ioData.param1 )
+                                   + n * sizeof(DAQ_REGISTER_T) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqSimulator::setParam( const uint n, const uint value )
+{
+   lm32Put( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, ioData.param1 )
+            + n * sizeof(DAQ_REGISTER_T), static_cast<DAQ_REGISTER_T>(value) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Executes the command written by the host like
+ *        executeIfRequested() of the LM32 firmware.
+ */
+void DaqSimulator::executeCommand( const uint code )
+{
+   const uint device = lm32Get<uint16_t>( DAQ_OPERATION_OFFSET +
+                             offsetof( DAQ_OPERATION_T, ioData.location.deviceNumber ) );
+   const uint channel = lm32Get<uint16_t>( DAQ_OPERATION_OFFSET +
+                             offsetof( DAQ_OPERATION_T, ioData.location.channel ) );
+
+   DAQ_RETURN_CODE_T ret = DAQ_RET_OK;
+   switch( code )
+   {
+      case DAQ_OP_GET_ERROR_STATUS:
+      {
+         setParam( 0, 0 );
+         break;
+      }
+      case DAQ_OP_RESET:
+      {
+         resetChannels();
+         const RAM_RING_INDEX_T size = ramRingSharedGetSize( &m_addacRing );
+         ramRingSharedReset( &m_addacRing );
+         lm32PutRingAdmin( DAQ_RING_OFFSET, m_addacRing );
+         putSequence( DAQ_SEQUENCE_OFFSET, m_addacSequence, size, m_addacRing );
+         break;
+      }
+      case DAQ_OP_GET_SLOTS:
+      {
+         uint slotFlags = 0;
+         for( const auto slot: m_vAddacSlots )
+            slotFlags |= 1 << (slot - 1);
+         setParam( 0, slotFlags );
+         break;
+      }
+      case DAQ_OP_RESCAN:
+      {
+         ret = DAQ_RET_RESCAN;
+         break;
+      }
+      case DAQ_OP_SYNC_TIMESTAMP:
+      {
+         break;
+      }
+      case DAQ_OP_GET_MACRO_VERSION:
+      case DAQ_OP_GET_CHANNELS:
+      case DAQ_OP_GET_DEVICE_TYPE:
+      {
+         if( (device == 0) || (device > DAQ_MAX) )
+         {
+            ret = DAQ_RET_ERR_SLAVE_OUT_OF_RANGE;
+            break;
+         }
+         if( device > getNumberOfAddacDevices() )
+         {
+            ret = DAQ_RET_ERR_SLAVE_NOT_PRESENT;
+            break;
+         }
+         if( code == DAQ_OP_GET_MACRO_VERSION )
+            setParam( 0, 1 );
+         else if( code == DAQ_OP_GET_CHANNELS )
+            setParam( 0, CHANNELS_PER_DEVICE );
+         else
+            setParam( 0, ADDAC );
+         break;
+      }
+      default:
+      {
+         ret = executeChannelCommand( code, device, channel );
+         break;
+      }
+   }
+
+   lm32Put( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, retCode ), ret );
+   lm32Put( DAQ_OPERATION_OFFSET + offsetof( DAQ_OPERATION_T, code ),
+            static_cast<uint32_t>(DAQ_OP_IDLE) );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Executes a command which concerns a single DAQ channel.
+ * @param device Device number 1..getNumberOfAddacDevices()
+ * @param channel Channel number 1..CHANNELS_PER_DEVICE
+ */
+int DaqSimulator::executeChannelCommand( const uint code, const uint device,
+                                         const uint channel )
+{
+   if( (code < DAQ_OP_PM_ON) || (code > DAQ_OP_GET_TRIGGER_SOURCE_HIR) )
+      return DAQ_RET_ERR_UNKNOWN_OPERATION;
+
+   if( (device == 0) || (device > DAQ_MAX) )
+      return DAQ_RET_ERR_SLAVE_OUT_OF_RANGE;
+
+   if( device > getNumberOfAddacDevices() )
+      return DAQ_RET_ERR_SLAVE_NOT_PRESENT;
+
+   if( (channel == 0) || (channel > DAQ_MAX_CHANNELS) )
+      return DAQ_RET_ERR_CHANNEL_OUT_OF_RANGE;
+
+   if( channel > CHANNELS_PER_DEVICE )
+      return DAQ_RET_ERR_CHANNEL_NOT_PRESENT;
+
+   CHANNEL_T& rChannel = getChannel( device, channel );
+   switch( code )
+   {
+      case DAQ_OP_CONTINUE_ON:
+      {
+         static const uint periods[] = { 0, 1000, 100, 10 };
+         const uint sampleRate = getParam( 0 );
+         if( (sampleRate < DAQ_SAMPLE_1MS) || (sampleRate > DAQ_SAMPLE_10US) )
+            return DAQ_RET_ERR_WRONG_SAMPLE_PARAMETER;
+         rChannel.sampleRate       = sampleRate;
+         rChannel.periodUs         = periods[sampleRate];
+         rChannel.blockDownCounter = getParam( 1 );
+         rChannel.sequence         = 0;
+         rChannel.nextBlockTime    = 0;
+         /*
+          * The replay starts after the host has had the time to switch on
+          * all its channels.
+          */
+         if( (m_poReplayFile != nullptr) && (m_replayStartTime == 0) )
+            m_replayStartTime = daq::getSysMicrosecs() + m_replayDelayUs;
+         break;
+      }
+      case DAQ_OP_CONTINUE_OFF:
+      {
+         rChannel.periodUs = 0;
+         break;
+      }
+      case DAQ_OP_GET_TRIGGER_CONDITION:
+      case DAQ_OP_GET_TRIGGER_DELAY:
+      case DAQ_OP_GET_TRIGGER_MODE:
+      case DAQ_OP_GET_TRIGGER_SOURCE_CON:
+      case DAQ_OP_GET_TRIGGER_SOURCE_HIR:
+      {
+         setParam( 0, 0 );
+         setParam( 1, 0 );
+         break;
+      }
+   }
+   return DAQ_RET_OK;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void DaqSimulator::onProduce( const USEC_T now )
+{
+   syncRing( DAQ_RING_OFFSET, m_addacRing, DAQ_SEQUENCE_OFFSET, m_addacSequence );
+   syncRing( MIL_RING_OFFSET, m_milRing, MIL_SEQUENCE_OFFSET, m_milSequence );
+
+   if( m_poReplayFile != nullptr )
+   {
+      replay( now );
+      ScuSimulator::onProduce( now );
+      return;
+   }
+
+   for( uint i = 0; i < m_vChannels.size(); i++ )
+   {
+      CHANNEL_T& rChannel = m_vChannels[i];
+      if( rChannel.periodUs == 0 )
+         continue;
+
+      const USEC_T interval = std::max( static_cast<USEC_T>(SHORT_BLOCK_DATA_WORDS)
+                                        * rChannel.periodUs / m_speedup,
+                                        static_cast<USEC_T>(1) );
+      if( rChannel.nextBlockTime == 0 )
+         rChannel.nextBlockTime = now + interval;
+
+      uint blocks = 0;
+      while( (rChannel.periodUs != 0) && (now >= rChannel.nextBlockTime) )
+      {
+         if( blocks++ == MAX_BLOCKS_PER_TICK )
+         { /*
+            * The producer can't keep up, the remaining blocks are lost.
+            */
+            rChannel.nextBlockTime = now + interval;
+            break;
+         }
+         produceBlock( i, rChannel, now );
+         rChannel.nextBlockTime += interval;
+
+         /*
+          * Like daqChannelDecrementBlockCounter().
+          */
+         if( rChannel.blockDownCounter == 0 )
+            continue;
+         rChannel.blockDownCounter--;
+         if( rChannel.blockDownCounter == 0 )
+            rChannel.periodUs = 0;
+      }
+   }
+
+   if( m_milRate != 0 )
+   {
+      const USEC_T interval = daq::MICROSECS_PER_SEC / m_milRate;
+      for( auto& rFg: m_vMilFgs )
+      {
+         if( rFg.nextItemTime == 0 )
+            rFg.nextItemTime = now;
+         while( now >= rFg.nextItemTime )
+         {
+            produceMilItem( rFg, now );
+            rFg.nextItemTime += std::max( interval, static_cast<USEC_T>(1) );
+         }
+      }
+   }
+
+   ScuSimulator::onProduce( now );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Synchronizes the read index of a ring buffer with the acknowledge
+ *        of the host and counts the removed items in its read sequence.
+ */
+void DaqSimulator::syncRing( const uint offset, RAM_RING_SHARED_INDEXES_T& rRing,
+                             const uint sequenceOffset, RAM_RING_SEQUENCE_T& rSequence )
+{
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( &rRing );
+   if( lm32SyncRingAdmin( offset, rRing ) )
+      putSequence( sequenceOffset, rSequence, size, rRing );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Counts the items removed from a ring buffer since the given size
+ *        in its read sequence and publishes it, like ramRingSequenceUpdate()
+ *        on the LM32.
+ */
+void DaqSimulator::putSequence( const uint offset, RAM_RING_SEQUENCE_T& rSequence,
+                                const RAM_RING_INDEX_T sizeBefore,
+                                const RAM_RING_SHARED_INDEXES_T& rRing )
+{
+   ramRingSequenceUpdate( &rSequence, sizeBefore, &rRing.indexes );
+   lm32Put( offset, rSequence );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Removes the oldest blocks in the ring buffer until it is enough
+ *        space for a new block of the given number of RAM items,
+ *        like ramMakeSpaceIfNecessary().
+ */
+void DaqSimulator::makeSpace( const uint len )
+{
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( &m_addacRing );
+   while( ramRingSharedGetRemainingCapacity( &m_addacRing ) < len )
+   {
+      RAM_DAQ_PAYLOAD_T aItem[RAM_DAQ_DATA_START_OFFSET];
+      ramRead( ramRingSharedGetReadIndex( &m_addacRing ), aItem, ARRAY_SIZE( aItem ) );
+      DAQ_DESCRIPTOR_T* pDescriptor = reinterpret_cast<DAQ_DESCRIPTOR_T*>(aItem);
+      if( !daqDescriptorVerifyMode( pDescriptor ) )
+      {
+         ramRingSharedReset( &m_addacRing );
+         break;
+      }
+      ramRingSharedAddToReadIndex( &m_addacRing, ramGetSizeByDescriptor( pDescriptor ) );
+   }
+   /*
+    * Before the new block overwrites the removed items.
+    */
+   if( size != ramRingSharedGetSize( &m_addacRing ) )
+      putSequence( DAQ_SEQUENCE_OFFSET, m_addacSequence, size, m_addacRing );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a short block of continuous mode in the ring buffer like
+ *        ramPushDaqDataBlock() of the LM32 firmware.
+ */
+void DaqSimulator::produceBlock( const uint index, CHANNEL_T& rChannel,
+                                 const USEC_T now )
+{
+   union
+   {
+      RAM_DAQ_PAYLOAD_T ramItems[RAM_DAQ_SHORT_BLOCK_LEN];
+      DAQ_DATA_T        buffer[SHORT_BLOCK_RAM_WORDS];
+      DAQ_DESCRIPTOR_T  descriptor;
+   } block;
+
+   for( uint i = DAQ_DESCRIPTOR_WORD_SIZE; i < SHORT_BLOCK_RAM_WORDS; i++ )
+   {
+      if( i < DAQ_FIFO_DAQ_WORD_SIZE_CRC )
+         block.buffer[i] = rChannel.value++;
+      else
+         block.buffer[i] = 0xCAFE;
+   }
+
+   ::memset( &block.descriptor, 0, sizeof( block.descriptor ) );
+   daqDescriptorSetSlot( &block.descriptor, index / CHANNELS_PER_DEVICE + 1 );
+   daqDescriptorSetChannel( &block.descriptor, index % CHANNELS_PER_DEVICE );
+   daqDescriptorSetDaq( &block.descriptor, true );
+   block.descriptor.name.cControl.Sample1ms   = (rChannel.sampleRate == DAQ_SAMPLE_1MS);
+   block.descriptor.name.cControl.Sample100us = (rChannel.sampleRate == DAQ_SAMPLE_100US);
+   block.descriptor.name.cControl.Sample10us  = (rChannel.sampleRate == DAQ_SAMPLE_10US);
+   block.descriptor.name.wr.timeStamp = now * 1000;
+   block.descriptor.name.crcReg.sequence = rChannel.sequence++;
+
+   /*
+    * CRC over the data words and the descriptor without the CRC register.
+    */
+   uint16_t crc = DAQ_CRC_START_VALUE;
+   for( uint i = DAQ_DESCRIPTOR_WORD_SIZE; i < DAQ_FIFO_DAQ_WORD_SIZE_CRC; i++ )
+      crc += daqCrcPolynom( block.buffer[i] );
+   for( uint i = 0; i < (DAQ_DESCRIPTOR_WORD_SIZE - 1); i++ )
+      crc += daqCrcPolynom( block.buffer[i] );
+   daqDescriptorSetCRC( &block.descriptor, static_cast<uint8_t>(crc) );
+
+   pushBlock( block.ramItems, RAM_DAQ_SHORT_BLOCK_LEN, true );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a complete block in the ADDAC-DAQ ring buffer.
+ * @param pItems Block including descriptor and completion.
+ * @param len Number of RAM items of the block.
+ * @param overwrite If true the oldest blocks become removed when the ring
+ *                  buffer is full, otherwise nothing happens in this case.
+ * @retval true Block has been written.
+ */
+bool DaqSimulator::pushBlock( const RAM_DAQ_PAYLOAD_T* pItems, const uint len,
+                              const bool overwrite )
+{
+   if( overwrite )
+      makeSpace( len );
+   else if( ramRingSharedGetRemainingCapacity( &m_addacRing ) < len )
+      return false;
+
+   ramRingWrite( m_addacRing, pItems, len );
+   lm32PutRingIndexes( DAQ_RING_OFFSET, m_addacRing );
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a MIL-DAQ item in the ring buffer. When the buffer is full
+ *        then the oldest item will overwritten.
+ */
+void DaqSimulator::produceMilItem( MIL_FG_T& rFg, const USEC_T now )
+{
+   MIL_DAQ_RAM_ITEM_PAYLOAD_T payload;
+   ::memset( &payload, 0, sizeof( payload ) );
+   payload.item.timestamp         = now * 1000;
+   payload.item.setValue          = rFg.value;
+   payload.item.actValue          = rFg.value + (rFg.value & 0x0003);
+   payload.item.fgMacro.socket    = rFg.socket;
+   payload.item.fgMacro.device    = rFg.device;
+   payload.item.fgMacro.version   = 1;
+   payload.item.fgMacro.outputBits = 16;
+   rFg.value += 0x10;
+
+   pushMilItem( payload, true );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a MIL-DAQ item in the ring buffer.
+ * @param overwrite If true the oldest item becomes removed when the ring
+ *                  buffer is full, otherwise nothing happens in this case.
+ * @retval true Item has been written.
+ */
+bool DaqSimulator::pushMilItem( const MIL_DAQ_RAM_ITEM_PAYLOAD_T& rPayload,
+                                const bool overwrite )
+{
+   if( ramRingSharedGetRemainingCapacity( &m_milRing ) < RAM_ITEM_PER_MIL_DAQ_ITEM )
+   {
+      if( !overwrite )
+         return false;
+      const RAM_RING_INDEX_T size = ramRingSharedGetSize( &m_milRing );
+      ramRingSharedAddToReadIndex( &m_milRing, RAM_ITEM_PER_MIL_DAQ_ITEM );
+      putSequence( MIL_SEQUENCE_OFFSET, m_milSequence, size, m_milRing );
+   }
+
+   ramRingWrite( m_milRing, rPayload.ramPayload, RAM_ITEM_PER_MIL_DAQ_ITEM );
+   lm32PutRingIndexes( MIL_RING_OFFSET, m_milRing );
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+DaqSimulator::CHANNEL_T* DaqSimulator::findChannel( const uint slot,
+                                                    const uint channel )
+{
+   if( (channel == 0) || (channel > CHANNELS_PER_DEVICE) )
+      return nullptr;
+
+   const auto it = std::lower_bound( m_vAddacSlots.begin(),
+                                     m_vAddacSlots.end(), slot );
+   if( (it == m_vAddacSlots.end()) || (*it != slot) )
+      return nullptr;
+
+   return &getChannel( it - m_vAddacSlots.begin() + 1, channel );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes the recorded blocks and items in the ring buffers which are
+ *        due at the given time respectively, in the fast mode, as long as
+ *        the ring buffers have space.
+ */
+void DaqSimulator::replay( const USEC_T now )
+{
+   if( m_replayStartTime == 0 )
+   { /*
+      * Recordings without ADDAC-DAQ blocks don't need to wait for
+      * switched on channels.
+      */
+      if( !m_vAddacSlots.empty() )
+         return;
+      m_replayStartTime = now;
+   }
+
+   if( now < m_replayStartTime )
+      return;
+
+   if( m_replayProgressTime == 0 )
+      m_replayProgressTime = now;
+
+   /*
+    * In the fast mode a ring buffer which isn't read by the host,
+    * e.g. the MIL-DAQ buffer by a ADDAC-DAQ tool, becomes overwritten
+    * as in the real time mode.
+    */
+   const bool overwrite = !m_replayFast ||
+                          ((now - m_replayProgressTime) > REPLAY_STALL_TIMEOUT_US);
+   while( true )
+   {
+      if( m_pReplayRecord == nullptr )
+      {
+         m_pReplayRecord = m_poReplayFile->nextRecord( m_replayChunk, m_replayOffset );
+         if( m_pReplayRecord == nullptr )
+            return;
+      }
+
+      const DAQ_REC_RECORD_T& rRecord = *m_pReplayRecord;
+      if( !m_replayFast && (rRecord.m_timestamp > m_replayFirstTimestamp) &&
+          ((rRecord.m_timestamp - m_replayFirstTimestamp) / 1000 / m_speedup >
+                                                      (now - m_replayStartTime)) )
+         return;
+
+      bool done;
+      switch( rRecord.m_type )
+      {
+         case DAQ_REC_ADDAC_BLOCK: done = replayBlock( rRecord, overwrite );   break;
+         case DAQ_REC_MIL_ITEM:    done = replayMilItem( rRecord, overwrite ); break;
+         default:                  done = true;                                break;
+      }
+      if( !done )
+         return;
+
+      m_pReplayRecord = nullptr;
+      m_replayProgressTime = now;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a recorded ADDAC-DAQ block unchanged, including its CRC,
+ *        in the ring buffer.
+ * @retval false Ring buffer is full.
+ */
+bool DaqSimulator::replayBlock( const DAQ_REC_RECORD_T& rRecord,
+                                const bool overwrite )
+{
+   union
+   {
+      RAM_DAQ_PAYLOAD_T ramItems[RAM_DAQ_LONG_BLOCK_LEN];
+      DAQ_DESCRIPTOR_T  descriptor;
+   } block;
+
+   if( (rRecord.m_size < sizeof( block.descriptor )) ||
+       (rRecord.m_size > sizeof( block )) )
+      return true;
+
+   ::memcpy( &block, &(&rRecord)[1], rRecord.m_size );
+   if( !daqDescriptorVerifyMode( &block.descriptor ) )
+      return true;
+
+   const uint len = ramGetSizeByDescriptor( &block.descriptor );
+   if( rRecord.m_size > len * sizeof( RAM_DAQ_PAYLOAD_T ) )
+      return true;
+   ::memset( &reinterpret_cast<uint8_t*>(&block)[rRecord.m_size], 0,
+             len * sizeof( RAM_DAQ_PAYLOAD_T ) - rRecord.m_size );
+
+   /*
+    * Continuous mode blocks of switched off channels are not produced
+    * by the LM32.
+    */
+   const CHANNEL_T* pChannel = findChannel( daqDescriptorGetSlot( &block.descriptor ),
+                                   daqDescriptorGetChannel( &block.descriptor ) + 1 );
+   if( (pChannel == nullptr) ||
+       (daqDescriptorIsShortBlock( &block.descriptor ) && (pChannel->periodUs == 0)) )
+      return true;
+
+   return pushBlock( block.ramItems, len, overwrite );
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a recorded MIL-DAQ item in the ring buffer.
+ * @retval false Ring buffer is full.
+ */
+bool DaqSimulator::replayMilItem( const DAQ_REC_RECORD_T& rRecord,
+                                  const bool overwrite )
+{
+   if( rRecord.m_size < sizeof( DAQ_REC_MIL_ITEM_T ) )
+      return true;
+
+   const DAQ_REC_MIL_ITEM_T* pItem =
+                  reinterpret_cast<const DAQ_REC_MIL_ITEM_T*>(&(&rRecord)[1]);
+   MIL_DAQ_RAM_ITEM_PAYLOAD_T payload;
+   ::memset( &payload, 0, sizeof( payload ) );
+   payload.item.timestamp          = rRecord.m_timestamp;
+   payload.item.setValue           = pItem->m_setValue;
+   payload.item.actValue           = pItem->m_actValue;
+   payload.item.fgMacro.socket     = pItem->m_socket;
+   payload.item.fgMacro.device     = pItem->m_device;
+   payload.item.fgMacro.version    = pItem->m_version;
+   payload.item.fgMacro.outputBits = pItem->m_outputBits;
+
+   return pushMilItem( payload, overwrite );
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,268 @@
+/*!
+ * @file daq_simulator.hpp
+ * @brief Simulation of the LM32 firmware part of the ADDAC- and MIL-DAQ
+ *        and of the function generator list for offline benchmarking of
+ *        the Linux tools.
+ *
+ * Extends the options of ScuSimulator by:
+ * - addac=<n>    Number of simulated ADDAC devices, residing in the slots
+ *                1..n, each with 4 DAQ channels and 2 function generators.
+ * - mil=<n>      Number of simulated MIL function generators.
+ * - milrate=<Hz> Rate of the MIL-DAQ items per MIL function generator.
+ * - speedup=<n>  Factor which shortens the sample periods of the ADDAC-DAQ.
+ * - blocks=<n>   Capacity of the ADDAC-DAQ ring buffer in long blocks.
+ * - replay=<file> Replays the ADDAC-DAQ blocks and MIL-DAQ items of a
+ *                record file made by DaqRecorder instead of producing
+ *                synthetic data. The ADDAC slots and the MIL function
+ *                generators are taken from the recording then, the options
+ *                addac, mil and milrate are ignored. The file name must
+ *                not contain any of the option separators.
+ * - fast=1       Replays as fast as the host reads the data, otherwise
+ *                in the recorded time intervals divided by speedup.
+ * - delay=<ms>   Delay of the replay start after the first activation of
+ *                a ADDAC-DAQ channel, default 100.
+ *
+ * Example: "sim://addac=4,mil=2,milrate=1000,latency=300" \n
+ * Replay:  "sim://replay=/tmp/incident.rec,fast=1"
+ *
+ * @see scu_simulator.hpp
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _DAQ_SIMULATOR_HPP
+#define _DAQ_SIMULATOR_HPP
+
+#include <scu_simulator.hpp>
+#include <scu_shared_mem.h>
+#include <daq_recorder.hpp>
+
+namespace Scu
+{
+namespace daq
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Simulated SCU with ADDAC-DAQ devices and MIL function generators.
+ *
+ * The DAQ commands of the host become executed at the end of the
+ * etherbone cycle in which the operation code has been written.
+ * Only the continuous mode produces data blocks, the post-mortem and
+ * high-resolution commands are accepted but without effect.
+ *
+ * In the replay mode the recorded blocks and items become written in the
+ * ring buffers unchanged, so the administrations of the host run their
+ * unmodified distributeData() on them. Continuous mode blocks of channels
+ * which are switched off by the host are skipped, like the LM32 doesn't
+ * produce them. In the real time mode the oldest data in the ring buffers
+ * becomes overwritten when the host can't keep up, like on the LM32.
+ * In the fast mode nothing gets lost, the replay waits for free space
+ * as long as the host reads the concerning ring buffer.
+ */
+class DaqSimulator: public ScuSimulator
+{
+   /*!
+    * @brief State of a simulated ADDAC-DAQ channel.
+    */
+   struct CHANNEL_T
+   {
+      /*!
+       * @brief Sample period in microseconds, zero if continuous mode
+       *        is off.
+       */
+      uint     periodUs;
+      uint     sampleRate;
+      uint     blockDownCounter;
+      uint8_t  sequence;
+      USEC_T   nextBlockTime;
+      uint16_t value;
+   };
+
+   /*!
+    * @brief State of a simulated MIL function generator.
+    */
+   struct MIL_FG_T
+   {
+      uint     socket;
+      uint     device;
+      USEC_T   nextItemTime;
+      uint16_t value;
+   };
+
+   /*!
+    * @brief Ascending slot numbers of the simulated ADDAC devices,
+    *        the device number is the index plus one.
+    */
+   std::vector<uint>       m_vAddacSlots;
+   uint                    m_speedup;
+   uint                    m_milRate;
+   std::vector<CHANNEL_T>  m_vChannels;
+   std::vector<MIL_FG_T>   m_vMilFgs;
+
+   /*!
+    * @brief Local copies of the ring buffer administrations in the
+    *        shared memory.
+    */
+   RAM_RING_SHARED_INDEXES_T m_addacRing;
+   RAM_RING_SHARED_INDEXES_T m_milRing;
+
+   /*!
+    * @brief Local copies of the published read sequences of the
+    *        ring buffers.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   RAM_RING_SEQUENCE_T       m_addacSequence;
+   RAM_RING_SEQUENCE_T       m_milSequence;
+
+   /*!
+    * @brief Record file of the replay mode, nullptr in the synthetic mode.
+    */
+   DaqRecordFile*          m_poReplayFile;
+   bool                    m_replayFast;
+   USEC_T                  m_replayDelayUs;
+
+   /*!
+    * @brief Position of the next record in m_poReplayFile.
+    * @see DaqRecordFile::nextRecord
+    */
+   uint                    m_replayChunk;
+   uint32_t                m_replayOffset;
+
+   /*!
+    * @brief Record which waits for its time respectively for free space
+    *        in the ring buffer.
+    */
+   const DAQ_REC_RECORD_T* m_pReplayRecord;
+
+   uint64_t                m_replayFirstTimestamp;
+
+   /*!
+    * @brief Start time of the replay, zero if not started yet.
+    */
+   USEC_T                  m_replayStartTime;
+
+   /*!
+    * @brief Time of the last replayed record, for detecting a host which
+    *        doesn't read a ring buffer in the fast mode.
+    */
+   USEC_T                  m_replayProgressTime;
+
+public:
+   /*!
+    * @brief Maximum number of DAQ channels per ADDAC device.
+    */
+   constexpr static uint CHANNELS_PER_DEVICE = 4;
+
+   /*!
+    * @brief Default capacity of the ADDAC-DAQ ring buffer in long blocks.
+    */
+   constexpr static uint DEFAULT_RING_BLOCKS = 256;
+
+   /*!
+    * @brief Default capacity of the MIL-DAQ ring buffer in MIL-DAQ items.
+    */
+   constexpr static uint DEFAULT_MIL_ITEMS = 10000;
+
+   /*!
+    * @brief Default start delay of the replay in milliseconds.
+    */
+   constexpr static uint DEFAULT_REPLAY_DELAY_MS = 100;
+
+   DaqSimulator( const std::string& rNetAddress );
+
+   virtual ~DaqSimulator( void );
+
+   /*!
+    * @brief Factory function which replaces ScuSimulator::create() when
+    *        this module is linked.
+    */
+   static FeSupport::Scu::Etherbone::WishboneSimulator*
+                                   create( const std::string& rNetAddress );
+
+protected:
+   void onCycleEnd( void ) override;
+
+   void onSoftwareInterrupt( const uint slot, const uint32_t signal ) override;
+
+   void onProduce( const USEC_T now ) override;
+
+private:
+   void initReplay( const std::string& rFileName );
+
+   void initFgList( void );
+
+   void executeCommand( const uint code );
+
+   int executeChannelCommand( const uint code, const uint device,
+                              const uint channel );
+
+   uint getNumberOfAddacDevices( void ) const
+   {
+      return m_vAddacSlots.size();
+   }
+
+   CHANNEL_T& getChannel( const uint device, const uint channel )
+   {
+      return m_vChannels[(device - 1) * CHANNELS_PER_DEVICE + channel - 1];
+   }
+
+   /*!
+    * @brief Returns the channel object of the given slot and channel
+    *        number or nullptr if not present.
+    */
+   CHANNEL_T* findChannel( const uint slot, const uint channel );
+
+   uint getParam( const uint n );
+
+   void setParam( const uint n, const uint value );
+
+   void resetChannels( void );
+
+   void produceBlock( const uint index, CHANNEL_T& rChannel, const USEC_T now );
+
+   void syncRing( const uint offset, RAM_RING_SHARED_INDEXES_T& rRing,
+                  const uint sequenceOffset, RAM_RING_SEQUENCE_T& rSequence );
+
+   void putSequence( const uint offset, RAM_RING_SEQUENCE_T& rSequence,
+                     const RAM_RING_INDEX_T sizeBefore,
+                     const RAM_RING_SHARED_INDEXES_T& rRing );
+
+   void makeSpace( const uint len );
+
+   bool pushBlock( const RAM_DAQ_PAYLOAD_T* pItems, const uint len,
+                   const bool overwrite );
+
+   void produceMilItem( MIL_FG_T& rFg, const USEC_T now );
+
+   bool pushMilItem( const MiLdaq::MIL_DAQ_RAM_ITEM_PAYLOAD_T& rPayload,
+                     const bool overwrite );
+
+   void replay( const USEC_T now );
+
+   bool replayBlock( const DAQ_REC_RECORD_T& rRecord, const bool overwrite );
+
+   bool replayMilItem( const DAQ_REC_RECORD_T& rRecord, const bool overwrite );
+};
+
+} /* namespace daq */
+} /* namespace Scu */
+
+#endif /* ifndef _DAQ_SIMULATOR_HPP */
+//================================== EOF ======================================
@@ -25,6 +25,8 @@
 #include <mdaq_administration.hpp>
 #include <string.h>
 #include <assert.h>
+#include <algorithm>
+#include <limits>
 using namespace Scu::MiLdaq;
 
 
@@ -91,7 +93,10 @@ bool DaqDevice::registerDaqCompare( DaqCompare* poCompare )
    poCompare->m_pParent = this;
    m_channelPtrList.push_back( poCompare );
    if( m_pParent != nullptr )
+   {
+      m_pParent->updateDispatchTable();
       poCompare->onInit();
+   }
    return false;
 }
 
@@ -106,6 +111,8 @@ bool DaqDevice::unregisterDaqCompare( DaqCompare* poCompare )
          assert( i->m_pParent == this );
          m_channelPtrList.remove( i );
          i->m_pParent = nullptr;
+         if( m_pParent != nullptr )
+            m_pParent->updateDispatchTable();
          return false;
       }
    }
@@ -151,10 +158,11 @@ DaqAdministration::DaqAdministration( EBC_PTR_T poEtherbone )
 #endif
   ,m_pMiddleBufferMem( nullptr )
   ,m_middleBufferSize( 0 )
-  ,m_nextReadOutTime( 0 )
 #ifdef CONFIG_DEBUG_MESSAGES
   ,m_dbgIsFirstCall( true )
 #endif
+  ,m_vDispatchTable( c_dispatchTableSize, nullptr )
+  ,m_poRecorder( nullptr )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
    initPtr();
@@ -169,10 +177,11 @@ DaqAdministration::DaqAdministration( DaqAccess* poEbAccess )
 #endif
   ,m_pMiddleBufferMem( nullptr )
   ,m_middleBufferSize( 0 )
-  ,m_nextReadOutTime( 0 )
 #ifdef CONFIG_DEBUG_MESSAGES
   ,m_dbgIsFirstCall( true )
 #endif
+  ,m_vDispatchTable( c_dispatchTableSize, nullptr )
+  ,m_poRecorder( nullptr )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
    initPtr();
@@ -232,6 +241,7 @@ bool DaqAdministration::registerDevice( DaqDevice* pDevice )
    pDevice->m_pParent = this;
    pDevice->m_deviceTyp = daq::MIL;
    m_devicePtrList.push_back( pDevice );
+   updateDispatchTable();
    pDevice->initAll();
    return false;
 }
@@ -250,6 +260,7 @@ bool DaqAdministration::unregisterDevice( DaqDevice* pDevice )
          m_devicePtrList.remove( i );
          i->m_pParent = nullptr;
          i->m_deviceTyp = daq::UNKNOWN;
+         updateDispatchTable();
          return false;
       }
    }
@@ -279,14 +290,29 @@ DaqDevice* DaqAdministration::getDevice( const uint location )
 
 /*-----------------------------------------------------------------------------
  */
-inline
-DaqCompare* DaqAdministration::findDaqCompare( FG_MACRO_T macro )
+void DaqAdministration::updateDispatchTable( void )
 {
-   DaqDevice* pDaqDevice = getDevice( getSocketByFgMacro( macro ) );
-   if( pDaqDevice == nullptr )
-      return nullptr;
+   std::fill( m_vDispatchTable.begin(), m_vDispatchTable.end(), nullptr );
+   for( const auto& pDevice: m_devicePtrList )
+   {
+      if( pDevice->getLocation() > std::numeric_limits<uint8_t>::max() )
+         continue;
 
-   return pDaqDevice->getDaqCompare( getDeviceByFgMacro( macro ) );
+      for( const auto& pCompare: *pDevice )
+      {
+         if( pCompare->getAddress() > std::numeric_limits<uint8_t>::max() )
+            continue;
+
+         DaqCompare*& rpEntry = m_vDispatchTable[getDispatchIndex( pDevice->getLocation(),
+                                                                   pCompare->getAddress() )];
+         /*
+          * Like getDevice() and DaqDevice::getDaqCompare()
+          * the first registered object wins.
+          */
+         if( rpEntry == nullptr )
+            rpEntry = pCompare;
+      }
+   }
 }
 
 #ifdef CONFIG_MILDAQ_BACKWARD_COMPATIBLE
@@ -321,6 +347,7 @@ uint DaqAdministration::distributeDataOld( void )
    if( !readRingPosition() ) // WB-access
       return 0;
    uint size = getBufferSize();
+   getPollScheduler().setLevel( size );
    if( size <= 0 )
       return 0;
 
@@ -366,8 +393,6 @@ uint DaqAdministration::distributeData( void )
       DEBUG_MESSAGE_M_FUNCTION( "" );
    }
 #endif
-//   if( m_nextReadOutTime > daq::getSysMicrosecs() )
-//      return 0;
    /*
     * Getting the number of DDR3 memory items which has to be copied
     * in the middle buffer.
@@ -404,8 +429,7 @@ uint DaqAdministration::distributeData( void )
     * Copying via wishbone/etherbone the DDR3-RAM data in the middle buffer.
     * This occupies the wishbone/etherbone bus!
     */
-   readDaqData( m_pMiddleBufferMem->aPayload, toRead );
-   sendWasRead( toRead );
+   readDaqData( m_pMiddleBufferMem->aPayload, toRead, toRead );
 
    DEBUG_MESSAGE( "After\ntoRead: " << toRead <<
                 "\nWrite-index: " << getWriteIndex() <<
@@ -420,6 +444,9 @@ uint DaqAdministration::distributeData( void )
    {
       const BufferItem* pCurrentItem = &m_pMiddleBufferMem[i].oData;
 
+      if( m_poRecorder != nullptr )
+         recordItem( *pCurrentItem );
+
       DaqCompare* pCurrent = findDaqCompare( pCurrentItem->getChannel() );
       if( pCurrent == nullptr )
       {
@@ -437,11 +464,38 @@ uint DaqAdministration::distributeData( void )
       pCurrent->m_setValueInvalid = true;
    }
 
-   m_nextReadOutTime = daq::getSysMicrosecs() + daq::MICROSECS_PER_SEC / 8;
-
    return getCurrentNumberOfData();
 }
 
+/*-----------------------------------------------------------------------------
+ */
+void DaqAdministration::setRecorder( daq::DaqRecorder* poRecorder )
+{
+   m_poRecorder = poRecorder;
+   m_vRecordChannel.assign( (poRecorder != nullptr)? c_dispatchTableSize : 0, -1 );
+}
+
+/*-----------------------------------------------------------------------------
+ */
+void DaqAdministration::recordItem( const BufferItem& rItem )
+{
+   const FG_MACRO_T macro = rItem.getChannel();
+   const uint socket = getSocketByFgMacro( macro );
+   const uint device = getDeviceByFgMacro( macro );
+
+   int& rRecordChannel = m_vRecordChannel[getDispatchIndex( socket, device )];
+   if( rRecordChannel < 0 )
+      rRecordChannel = m_poRecorder->addChannel( daq::DAQ_REC_KIND_MIL_DAQ,
+                                          daq::makeRecordFgName( socket, device ) );
+
+   const daq::DAQ_REC_MIL_ITEM_T oItem =
+   {
+      rItem.getSetValue(), rItem.getActValue(),
+      macro.socket, macro.device, macro.version, macro.outputBits
+   };
+   m_poRecorder->writeMilItem( rRecordChannel, rItem.getTimestamp(), oItem );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /*! ---------------------------------------------------------------------------
  */
@@ -26,9 +26,11 @@
 #define _MDAQ_ADMINISTRATION_HPP
 
 #include <list>
+#include <vector>
 #include <mdaq_interface.hpp>
 #include <daq_calculations.hpp>
 #include <scu_fg_list.hpp>
+#include <daq_recorder.hpp>
 
 namespace Scu
 {
@@ -263,6 +265,7 @@ protected:
  */
 class DaqAdministration: public DaqInterface
 {
+   friend class DaqDevice;
    using USEC_T = daq::USEC_T;
 #ifdef CONFIG_MILDAQ_BACKWARD_COMPATIBLE
    /*!
@@ -281,10 +284,39 @@ class DaqAdministration: public DaqInterface
 #ifndef __NEW__
    uint             m_lastReadIndex;
 #endif
-   USEC_T           m_nextReadOutTime;
 #ifdef CONFIG_DEBUG_MESSAGES
    bool             m_dbgIsFirstCall;
 #endif
+
+   /*!
+    * @brief Number of entries of the dispatch table: one for each
+    *        possible combination of socket and device of FG_MACRO_T.
+    */
+   constexpr static uint c_dispatchTableSize = 1 << (2 * BIT_SIZEOF(uint8_t));
+
+   /*!
+    * @brief Flat table of the registered DAQ compare objects indexed by
+    *        socket and device of FG_MACRO_T, so the demultiplexing of a
+    *        received item is a single indexed load.
+    *
+    * It mirrors the device- and compare lists and becomes rebuilt
+    * on each registering and unregistering.
+    * @see updateDispatchTable
+    */
+   std::vector<DaqCompare*> m_vDispatchTable;
+
+   /*!
+    * @brief Optional recorder of all received items.
+    * @see setRecorder
+    */
+   daq::DaqRecorder*        m_poRecorder;
+
+   /*!
+    * @brief Recorder channel numbers indexed like m_vDispatchTable,
+    *        negative when not yet defined in the recorder.
+    */
+   std::vector<int>         m_vRecordChannel;
+
 protected:
 
    #define MIL_DEVICE_LIST_BASE std::list
@@ -361,14 +393,60 @@ public:
 
    void reset( void );
 
+   /*!
+    * @brief Sets respectively removes by nullptr a recorder, which
+    *        becomes fed with each received raw MIL-DAQ item.
+    *
+    * The items of all function generators become recorded, registered
+    * or not, so that the recording can be replayed unchanged.
+    * @note The recorder is not owned by this object.
+    */
+   void setRecorder( daq::DaqRecorder* poRecorder );
+
+   /*!
+    * @brief Returns the recorder or nullptr when not recording.
+    */
+   daq::DaqRecorder* getRecorder( void )
+   {
+      return m_poRecorder;
+   }
+
 protected:
    virtual void onUnregistered( const FG_MACRO_T fg ) {}
 
 private:
-   DaqCompare* findDaqCompare( const FG_MACRO_T macro );
+   /*!
+    * @brief Returns the index of the dispatch table of the given
+    *        socket and device.
+    */
+   constexpr static uint getDispatchIndex( const uint socket, const uint device )
+   {
+      return (socket << BIT_SIZEOF(uint8_t)) | device;
+   }
+
+   /*!
+    * @brief Rebuilds the dispatch table from the device- and compare lists.
+    * @see m_vDispatchTable
+    */
+   void updateDispatchTable( void );
+
+   /*!
+    * @brief Returns the registered DAQ compare object of the given
+    *        function generator or nullptr if not registered.
+    */
+   DaqCompare* findDaqCompare( const FG_MACRO_T macro )
+   {
+      return m_vDispatchTable[getDispatchIndex( getSocketByFgMacro( macro ),
+                                                getDeviceByFgMacro( macro ) )];
+   }
 
    void initPtr( void );
 
+   /*!
+    * @brief Hands the given raw item over to the recorder.
+    */
+   void recordItem( const BufferItem& rItem );
+
 #ifdef CONFIG_MILDAQ_BACKWARD_COMPATIBLE
    uint distributeDataNew( void );
    uint distributeDataOld( void );
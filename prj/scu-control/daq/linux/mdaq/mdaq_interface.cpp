@@ -71,7 +71,8 @@ void DaqInterface::init( void )
 #endif
    {
       initRingAdmin( &m_oBufferAdmin.memAdmin,
-                     getEbAccess()->getMilDaqOffset() + offsetof( MIL_DAQ_ADMIN_T, memAdmin ) );
+                     getEbAccess()->getMilDaqOffset() + offsetof( MIL_DAQ_ADMIN_T, memAdmin ),
+                     DaqAccess::MIL_RING_SEQUENCE_OFFSET );
    }
 }
 
@@ -196,6 +197,32 @@ uint DaqInterface::readRingItems( RingItem* pItems, uint size )
 
    RING_ITEM_T beItems[toRead];
 
+   if( (m_maxEbCycleDataLen == 0) || (toRead <= m_maxEbCycleDataLen) )
+   { /*
+      * Small enough for a single etherbone cycle:
+      * Both parts of the ring buffer and the new tail index will be
+      * transferred within one etherbone cycle.
+      */
+      EB_BATCH_T oBatch;
+      if( toRead1 > 0 )
+         getEbAccess()->readLM32( oBatch, &beItems[0],
+                                  toRead1 * sizeof( RING_ITEM_T ),
+                                  offsetof( FG::SCU_SHARED_DATA_T, daq_buf.ring_data ) +
+                                     getTailRingIndex() * sizeof( RING_ITEM_T ) );
+      if( toRead2 > 0 )
+         getEbAccess()->readLM32( oBatch, &beItems[toRead1],
+                                  toRead2 * sizeof( RING_ITEM_T ),
+                                  offsetof( FG::SCU_SHARED_DATA_T, daq_buf.ring_data ) );
+      RING_INDEX_T convTail =
+         gsi::convertByteEndian( static_cast<RING_INDEX_T>((getTailRingIndex() + toRead)
+                                                           % c_ringBufferCapacity) );
+      getEbAccess()->writeLM32( oBatch, &convTail, sizeof( convTail ),
+                                offsetof( FG::SCU_SHARED_DATA_T, daq_buf.ring_tail ) );
+      getEbAccess()->execute( oBatch ); // WB-access
+      convertRingItems( pItems, beItems, toRead );
+      return toRead;
+   }
+
    /*
     * Overlaps the end the data set to be read the end of the linear
     * data buffer, so the data set has to be read in two parts.
@@ -215,9 +242,20 @@ uint DaqInterface::readRingItems( RingItem* pItems, uint size )
       readRingData( &beItems[toRead1], toRead2 ); // WB-access
    }
 
+   convertRingItems( pItems, beItems, toRead );
+   updateRingTail(); // WB-access
+   return toRead;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void DaqInterface::convertRingItems( RingItem* pItems,
+                                     const RING_ITEM_T* beItems,
+                                     const uint len )
+{
    #define __BYTE_SWAP_ITEM( member ) \
       pItems[i].member = gsi::convertByteEndian( beItems[i].member )
-   for( uint i = 0; i < toRead; i++ )
+   for( uint i = 0; i < len; i++ )
    {
       __BYTE_SWAP_ITEM( setvalue );
       __BYTE_SWAP_ITEM( actvalue );
@@ -232,8 +270,6 @@ uint DaqInterface::readRingItems( RingItem* pItems, uint size )
       incrementRingTail();
    }
    #undef __BYTE_SWAP_ITEM
-   updateRingTail(); // WB-access
-   return toRead;
 }
 #endif // #ifdef CONFIG_MILDAQ_BACKWARD_COMPATIBLE
 //================================== EOF ======================================
@@ -201,6 +201,13 @@ private:
    DAQ_RING_T         m_oRing;
 
    void readRingData( RING_ITEM_T* ptr, uint len, uint offset = 0 );
+
+   /*!
+    * @brief Converts the big endian ring items received from LM32 into
+    *        the host byte order and advances the local tail index.
+    */
+   void convertRingItems( RingItem* pItems, const RING_ITEM_T* beItems,
+                          const uint len );
 #endif /* CONFIG_MILDAQ_BACKWARD_COMPATIBLE */
 
 protected:
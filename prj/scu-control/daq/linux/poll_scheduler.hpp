@@ -0,0 +1,286 @@
+/*!
+ *  @file poll_scheduler.hpp
+ *  @brief Adaptive poll scheduler for DAQ FIFOs in DDR3-RAM or SRAM.
+ *
+ *  @note Header only!
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>
+ ******************************************************************************
+ */
+#ifndef _POLL_SCHEDULER_HPP
+#define _POLL_SCHEDULER_HPP
+
+#include <stdint.h>
+#include <algorithm>
+#include <daq_calculations.hpp>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Calculates the time of the next poll of a DAQ-FIFO depending on
+ *        its fill level and its observed fill rate.
+ *
+ * - When no new data has been arrived since the last poll, then the
+ *   poll interval becomes doubled up to the maximum (exponential back off).
+ * - When data arrives, then the poll interval becomes estimated by the time
+ *   which the FIFO needs to reach the target level with the smoothed
+ *   fill rate.
+ * - When the fill level reaches the half of the FIFO alarm threshold,
+ *   then the minimum interval will used and the poll is urgent.
+ *
+ * The fill rate reflects the sum of the sample rates of all active channels
+ * of the concerning DAQ-FIFO.
+ *
+ * @note On this software layer floating point calculations are avoided.
+ */
+class PollScheduler
+{
+public:
+   using USEC_T = daq::USEC_T;
+
+   /*!
+    * @brief Default of the minimum poll interval in microseconds.
+    */
+   static constexpr uint DEFAULT_MIN_INTERVAL_US = 100;
+
+   /*!
+    * @brief Default of the maximum poll interval in microseconds.
+    */
+   static constexpr uint DEFAULT_MAX_INTERVAL_US = 100000;
+
+   /*!
+    * @brief Default fill level in parts per ten thousand which shall be
+    *        not exceeded between two polls.
+    */
+   static constexpr uint DEFAULT_TARGET_LEVEL = 2500;
+
+   /*!
+    * @brief Level in parts per ten thousand from which the poll becomes
+    *        urgent when no FIFO alarm threshold has been set.
+    */
+   static constexpr uint DEFAULT_URGENT_LEVEL = 5000;
+
+private:
+   uint     m_minIntervalUs;
+   uint     m_maxIntervalUs;
+   uint     m_targetLevel;
+   uint     m_intervalUs;
+
+   /*!
+    * @brief Smoothed fill rate in RAM items per second.
+    */
+   uint64_t m_fillRate;
+
+   USEC_T   m_lastPollTime;
+   USEC_T   m_nextPollTime;
+
+   /*!
+    * @brief Number of data items at the last poll.
+    */
+   uint     m_lastLevel;
+
+   /*!
+    * @brief Number of remaining data items after the last poll.
+    */
+   uint     m_lastRemaining;
+   bool     m_urgent;
+
+public:
+   PollScheduler( const uint minIntervalUs = DEFAULT_MIN_INTERVAL_US,
+                  const uint maxIntervalUs = DEFAULT_MAX_INTERVAL_US )
+      :m_minIntervalUs( minIntervalUs )
+      ,m_maxIntervalUs( std::max( minIntervalUs, maxIntervalUs ) )
+      ,m_targetLevel( DEFAULT_TARGET_LEVEL )
+      ,m_intervalUs( minIntervalUs )
+      ,m_fillRate( 0 )
+      ,m_lastPollTime( 0 )
+      ,m_nextPollTime( 0 )
+      ,m_lastLevel( 0 )
+      ,m_lastRemaining( 0 )
+      ,m_urgent( false )
+   {
+   }
+
+   /*!
+    * @brief Sets the limits of the poll interval in microseconds.
+    */
+   void setLimits( const uint minIntervalUs, const uint maxIntervalUs )
+   {
+      m_minIntervalUs = minIntervalUs;
+      m_maxIntervalUs = std::max( minIntervalUs, maxIntervalUs );
+      m_intervalUs    = std::min( std::max( m_intervalUs, m_minIntervalUs ),
+                                  m_maxIntervalUs );
+   }
+
+   uint getMinIntervalUs( void ) const
+   {
+      return m_minIntervalUs;
+   }
+
+   uint getMaxIntervalUs( void ) const
+   {
+      return m_maxIntervalUs;
+   }
+
+   /*!
+    * @brief Sets the fill level in parts per ten thousand which shall be
+    *        not exceeded between two polls.
+    */
+   void setTargetLevel( const uint level = DEFAULT_TARGET_LEVEL )
+   {
+      m_targetLevel = std::min( level, static_cast<uint>(10000) );
+   }
+
+   uint getTargetLevel( void ) const
+   {
+      return m_targetLevel;
+   }
+
+   /*!
+    * @brief Returns the currently calculated poll interval in microseconds.
+    */
+   uint getIntervalUs( void ) const
+   {
+      return m_intervalUs;
+   }
+
+   /*!
+    * @brief Returns the smoothed fill rate in RAM items per second.
+    */
+   uint64_t getFillRate( void ) const
+   {
+      return m_fillRate;
+   }
+
+   /*!
+    * @brief Returns "true" if the fill level has reached the urgent level
+    *        at the last poll.
+    */
+   bool isUrgent( void ) const
+   {
+      return m_urgent;
+   }
+
+   /*!
+    * @brief Returns "true" if the next poll is due.
+    */
+   bool isDue( const USEC_T now ) const
+   {
+      return now >= m_nextPollTime;
+   }
+
+   /*!
+    * @brief Returns the remaining time in microseconds up to the next poll.
+    */
+   uint getDelayUs( const USEC_T now ) const
+   {
+      if( now >= m_nextPollTime )
+         return 0;
+      return static_cast<uint>(m_nextPollTime - now);
+   }
+
+   /*!
+    * @brief Stores the number of data items found in the FIFO at polling.
+    * @note It has to be invoked before schedule().
+    */
+   void setLevel( const uint level )
+   {
+      m_lastLevel = level;
+   }
+
+   /*!
+    * @brief Calculates the time of the next poll.
+    * @param now Current time in microseconds.
+    * @param remaining Number of data items which remains in the FIFO
+    *                  after this poll.
+    * @param capacity Capacity of the FIFO in data items.
+    * @param alarmThreshold FIFO alarm threshold in parts per ten thousand,
+    *                       zero if not set.
+    */
+   void schedule( const USEC_T now, const uint remaining,
+                  const uint capacity, const uint alarmThreshold )
+   {
+      const uint inflow = (m_lastLevel > m_lastRemaining)?
+                          (m_lastLevel - m_lastRemaining) : 0;
+
+      if( (m_lastPollTime != 0) && (now > m_lastPollTime) )
+      { /*
+         * Exponential smoothing of the fill rate with a weight of 1/4
+         * for the new sample.
+         */
+         const uint64_t sample = (static_cast<uint64_t>(inflow) *
+                                   daq::MICROSECS_PER_SEC) / (now - m_lastPollTime);
+         m_fillRate = (m_fillRate * 3 + sample) / 4;
+      }
+
+      const uint level = (capacity > 0)?
+                         static_cast<uint>((static_cast<uint64_t>(m_lastLevel) * 10000) / capacity) : 0;
+      const uint urgentLevel = (alarmThreshold > 0)? alarmThreshold / 2 : DEFAULT_URGENT_LEVEL;
+      m_urgent = level >= urgentLevel;
+
+      if( m_urgent || (remaining != 0) )
+      { /*
+         * FIFO threatens to overflow or has not been emptied.
+         */
+         m_intervalUs = m_minIntervalUs;
+      }
+      else if( (inflow == 0) || (m_fillRate == 0) )
+      { /*
+         * Idle: exponential back off.
+         */
+         m_intervalUs = std::min( std::max( m_intervalUs * 2, static_cast<uint>(1) ),
+                                  m_maxIntervalUs );
+      }
+      else
+      { /*
+         * Time which the FIFO needs to reach the target level.
+         */
+         const uint64_t headroom = (static_cast<uint64_t>(capacity) * m_targetLevel) / 10000;
+         const uint64_t us = (headroom * daq::MICROSECS_PER_SEC) / m_fillRate;
+         m_intervalUs = static_cast<uint>(std::min( std::min( us, static_cast<uint64_t>(m_intervalUs) * 2 ),
+                                                    static_cast<uint64_t>(m_maxIntervalUs) ));
+         m_intervalUs = std::max( m_intervalUs, m_minIntervalUs );
+      }
+
+      m_lastRemaining = remaining;
+      m_lastPollTime  = now;
+      m_nextPollTime  = now + m_intervalUs;
+   }
+
+   /*!
+    * @brief Makes the next poll immediately due.
+    */
+   void reset( void )
+   {
+      m_intervalUs    = m_minIntervalUs;
+      m_fillRate      = 0;
+      m_lastPollTime  = 0;
+      m_nextPollTime  = 0;
+      m_lastLevel     = 0;
+      m_lastRemaining = 0;
+      m_urgent        = false;
+   }
+};
+
+} // namespace Scu
+#endif // ifdef _POLL_SCHEDULER_HPP
+//================================== EOF ======================================
@@ -28,6 +28,7 @@
 #include <scu_fg_feedback.hpp>
 #include <message_macros.hpp>
 #include <string.h>
+#include <unistd.h>
 
 using namespace Scu;
 
@@ -64,14 +65,8 @@ bool FgFeedbackChannel::Common::Throttle::operator()( const uint64_t timestamp,
    const FgFeedbackAdministration* pAdmin = m_pParent->m_pParent->m_pParent->m_pParent;
    assert( pAdmin != nullptr );
 
-   if( ( static_cast<uint>(::abs( static_cast<int>(value - m_lastForwardedValue) )) < pAdmin->m_throttleThreshold ) &&
-       (( timestamp < m_timeThreshold ) || ( pAdmin->m_throttleTimeout == 0 ))
-     )
-      return false;
-
-   m_lastForwardedValue = value;
-   m_timeThreshold = timestamp + pAdmin->m_throttleTimeout;
-   return true;
+   return check( timestamp, value,
+                 pAdmin->m_throttleThreshold, pAdmin->m_throttleTimeout );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -115,16 +110,17 @@ void FgFeedbackChannel::Common::evaluate( const uint64_t wrTimeStampTAI,
          * necessary to forwarding it here, because in order to avoiding
          * a wrong line in a possible plot between two support dots.
          */
-         m_pParent->onData( m_lastSupprTimestamp,
-                            m_lastSupprActValue, m_lastSupprSetValue );
+         m_pParent->forward( m_lastSupprTimestamp,
+                             m_lastSupprActValue, m_lastSupprSetValue );
          m_lastSupprTimestamp = 0;
       }
 
       /*
        * Invoking the the callback function implemented in
-       * the next higher software layer.
+       * the next higher software layer, respectively in threaded mode
+       * handing over to the consumer thread.
        */
-      m_pParent->onData( wrTimeStampTAI, actValue, setValue );
+      m_pParent->forward( wrTimeStampTAI, actValue, setValue );
    }
    else
    { /*
@@ -139,16 +135,117 @@ void FgFeedbackChannel::Common::evaluate( const uint64_t wrTimeStampTAI,
    m_pParent->m_lastTimestamp = wrTimeStampTAI;
 }
 
+/*! ---------------------------------------------------------------------------
+ * @brief Data-reduced forwarding of a whole ADDAC/ACU-DAQ block to the
+ *        higher software-layer.
+ *
+ * Makes the same as evaluate() for each sample of the block, but in a single
+ * pass: The forwarded tuples become compacted in the output buffers and
+ * delivered by one call of FgFeedbackChannel::forwardBlock().
+ * When the throttling is disabled by a threshold of zero each tuple
+ * becomes forwarded, in this case the loop has no branches and the
+ * compiler can vectorize it.
+ * @param timestamp Time stamp of the first sample.
+ * @param sampleTime Time between two samples.
+ * @param pActData Raw actual values of the block.
+ * @param pSetData Raw set values of the block.
+ * @param len Number of samples.
+ */
+void FgFeedbackChannel::Common::evaluateBlock( uint64_t timestamp,
+                                               const uint sampleTime,
+                                               const daq::DAQ_DATA_T* pActData,
+                                               const daq::DAQ_DATA_T* pSetData,
+                                               const std::size_t len )
+{
+   assert( timestamp > 0 );
+
+   if( len == 0 )
+      return;
+
+   const FgFeedbackAdministration* pAdmin = m_pParent->m_pParent->m_pParent;
+   assert( pAdmin != nullptr );
+   const DAQ_T    threshold = pAdmin->m_throttleThreshold;
+   const uint64_t timeout   = pAdmin->m_throttleTimeout;
+   const uint64_t lastTimestamp = timestamp + (len - 1) * sampleTime;
+
+   /*
+    * A suppressed tuple preceding a forwarded one becomes forwarded
+    * as well, therefore the output can be up to twice the input.
+    */
+   if( m_vTimestamps.size() < 2 * len )
+   {
+      m_vTimestamps.resize( 2 * len );
+      m_vActValues.resize( 2 * len );
+      m_vSetValues.resize( 2 * len );
+   }
+   uint64_t* pTimestamps = m_vTimestamps.data();
+   DAQ_T*    pActValues  = m_vActValues.data();
+   DAQ_T*    pSetValues  = m_vSetValues.data();
+
+   std::size_t n = 0;
+   if( threshold == 0 )
+   { /*
+      * Throttling disabled: The set value throttle passes always, so
+      * the actual value throttle becomes never asked and no tuple
+      * becomes suppressed.
+      */
+      for( std::size_t i = 0; i < len; i++ )
+      {
+         pTimestamps[i] = timestamp + i * sampleTime;
+         pActValues[i]  = pActData[i] << FgFeedbackAdministration::VALUE_SHIFT;
+         pSetValues[i]  = pSetData[i] << FgFeedbackAdministration::VALUE_SHIFT;
+      }
+      m_oSetThrottle.check( lastTimestamp, pSetValues[len-1],
+                            threshold, timeout );
+      n = len;
+   }
+   else
+   {
+      for( std::size_t i = 0; i < len; i++, timestamp += sampleTime )
+      {
+         const DAQ_T actValue = pActData[i] << FgFeedbackAdministration::VALUE_SHIFT;
+         const DAQ_T setValue = pSetData[i] << FgFeedbackAdministration::VALUE_SHIFT;
+
+         if( m_oSetThrottle.check( timestamp, setValue, threshold, timeout ) ||
+             m_oActThrottle.check( timestamp, actValue, threshold, timeout ) )
+         {
+            if( m_lastSupprTimestamp != 0 )
+            { /*
+               * See evaluate().
+               */
+               pTimestamps[n] = m_lastSupprTimestamp;
+               pActValues[n]  = m_lastSupprActValue;
+               pSetValues[n]  = m_lastSupprSetValue;
+               n++;
+               m_lastSupprTimestamp = 0;
+            }
+            pTimestamps[n] = timestamp;
+            pActValues[n]  = actValue;
+            pSetValues[n]  = setValue;
+            n++;
+         }
+         else
+         {
+            m_lastSupprTimestamp = timestamp;
+            m_lastSupprSetValue  = setValue;
+            m_lastSupprActValue  = actValue;
+         }
+      }
+   }
+
+   m_pParent->m_lastTimestamp = lastTimestamp;
+
+   if( n > 0 )
+      m_pParent->forwardBlock( pTimestamps, pActValues, pSetValues, n );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /*! ---------------------------------------------------------------------------
  */
 FgFeedbackChannel::AddacFb::Receive::Receive( AddacFb* pParent, const uint n )
    :daq::DaqChannel( n )
    ,m_pParent( pParent )
-   ,m_timestamp( 0 )
-   ,m_sampleTime( 0 )
-   ,m_blockLen( 0 )
-   ,m_sequence( 0 )
+   ,m_lastSequence( 0 )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
    assert( n > 0 );
@@ -162,7 +259,8 @@ FgFeedbackChannel::AddacFb::Receive::~Receive( void )
 }
 
 /*! ---------------------------------------------------------------------------
- * @brief Storing of a incoming ADDAC/ACU-DAQ data block.
+ * @brief Storing of a view of the incoming ADDAC/ACU-DAQ data block
+ *        in the reorder window.
  */
 bool FgFeedbackChannel::AddacFb::Receive::onDataBlock( daq::DAQ_DATA_T* pData,
                                                        std::size_t wordLen )
@@ -180,26 +278,20 @@ bool FgFeedbackChannel::AddacFb::Receive::onDataBlock( daq::DAQ_DATA_T* pData,
       return true;
    }
 
-   if( wordLen >= ARRAY_SIZE(m_aBuffer) )
-   {
-      std::string str = "Size of received data out range. Actual: ";
-      str += std::to_string( wordLen );
-      str += ", maximum: ";
-      str += std::to_string( ARRAY_SIZE(m_aBuffer) );
-      throw daq::Exception( str );
-   }
+   m_lastSequence = descriptorGetSequence();
 
-   m_blockLen   = wordLen;
-   m_sequence   = descriptorGetSequence();
-   m_sampleTime = descriptorGetTimeBase();
+   PENDING_T pending;
+   pending.m_oView      = getBlockView();
+   pending.m_sequence   = m_lastSequence;
+   pending.m_sampleTime = descriptorGetTimeBase();
 
    /*
     * Setting the timestamp at the begining of the ADDAC-DAQ-block, that means
     * at the first sampled value of the block.
     */
-   m_timestamp  = timestamp - m_sampleTime * m_blockLen;
+   pending.m_timestamp  = timestamp - pending.m_sampleTime * wordLen;
 
-   ::memcpy( m_aBuffer, pData, m_blockLen * sizeof(daq::DAQ_DATA_T) );
+   m_window.push_back( pending );
 
    m_pParent->finalizeBlock();
 
@@ -218,20 +310,11 @@ void FgFeedbackChannel::AddacFb::Receive::onInit( void )
  */
 void FgFeedbackChannel::AddacFb::Receive::onReset( void )
 {
+   m_window.clear();
    if( this == &m_pParent->m_oReceiveActValue )
       m_pParent->m_pParent->onReset();
 }
 
-/*! ---------------------------------------------------------------------------
- */
-inline FgFeedbackChannel::DAQ_T
-FgFeedbackChannel::AddacFb::Receive::operator[]( const std::size_t i ) const
-{
-   assert( i < ARRAY_SIZE(m_aBuffer) );
-   return m_aBuffer[i] << FgFeedbackAdministration::VALUE_SHIFT;
-}
-
-
 ///////////////////////////////////////////////////////////////////////////////
 /*! ---------------------------------------------------------------------------
  */
@@ -240,6 +323,7 @@ FgFeedbackChannel::AddacFb::AddacFb( FgFeedbackChannel* pParent,
    :Common( pParent )
    ,m_oReceiveSetValue( this, 1 + daq::daqGetSetDaqNumberOfFg( pParent->getFgNumber(), type ) )
    ,m_oReceiveActValue( this, 1 + daq::daqGetActualDaqNumberOfFg( pParent->getFgNumber(), type ) )
+   ,m_unpairedCount( 0 )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
 }
@@ -252,120 +336,160 @@ FgFeedbackChannel::AddacFb::~AddacFb( void )
 }
 
 /*! ---------------------------------------------------------------------------
- * @brief Forwarding of actual- and set- values to the higher software-layer
- *        once both data blocks has been received.
+ * @brief Returns true if the given set- and actual value blocks
+ *        belonging together.
  */
-void FgFeedbackChannel::AddacFb::finalizeBlock( void )
-{  /*
-    * At the first time one of both channels doesn't received yet,
-    * in this case it's block length is still zero.
+bool FgFeedbackChannel::AddacFb::isPair( const PENDING_T& rSet,
+                                         const PENDING_T& rAct )
+{
+   if( m_pParent->m_pParent->m_pParent->isPairingBySequence() )
+   { /*
+      * +++ Pairing by sequence number +++
+      */
+      return rSet.m_sequence == rAct.m_sequence;
+   }
+
+   /*
+    * +++ Pairing by timestamp +++
+    * That should be the default.
     */
-   if( m_oReceiveSetValue.getBlockLen() == 0 )
-      return;
-   if( m_oReceiveActValue.getBlockLen() == 0 )
-      return;
+   static_assert( REL_PHASE_TOLERANCE == 1 || REL_PHASE_TOLERANCE == 2,
+                  "Relative phase tolerance shall be one or two!" );
+   const uint64_t diff = ::llabs( static_cast<int64_t>(rAct.m_timestamp - rSet.m_timestamp) );
+   return diff <= static_cast<uint64_t>(REL_PHASE_TOLERANCE * rSet.m_sampleTime);
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Drops the oldest waiting block of the given receiver, which
+ *        can't be paired anymore.
+ */
+void FgFeedbackChannel::AddacFb::dropOldest( Receive& rReceive )
+{
+   assert( !rReceive.m_window.empty() );
+   rReceive.m_window.pop_front();
+   m_unpairedCount++;
+
+   const Receive& rOther = (&rReceive == &m_oReceiveSetValue)?
+                                       m_oReceiveActValue : m_oReceiveSetValue;
+   /*
+    * As long as the other stream doesn't deliver any data it's not a
+    * deviation, e.g. one of both DAQ channels isn't started yet.
+    */
+   if( !rOther.m_window.empty() &&
+       m_pParent->m_pParent->m_pParent->isPairingBySequence() )
+   { /*
+      * Throwing a exception if following function will not be overwritten.
+      */
+      m_pParent->onActSetBlockDeviation( m_oReceiveSetValue.getLastSequence(),
+                                         m_oReceiveActValue.getLastSequence() );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Searching for a pair of set- and actual value blocks within the
+ *        reorder windows and forwarding it.
+ *
+ * Each stream delivers its blocks in order, so when a pair has been found
+ * all older blocks of both windows can't be paired anymore.
+ * Becomes invoked after each received continuous block, therefore
+ * at most one new pair can be exist.
+ */
+void FgFeedbackChannel::AddacFb::finalizeBlock( void )
+{
+   auto& rSetWindow = m_oReceiveSetValue.m_window;
+   auto& rActWindow = m_oReceiveActValue.m_window;
 
 #ifdef CONFIG_DBG_DAQ_PAIRING
-   DEBUG_MESSAGE( "set sequence: " << static_cast<uint>(m_oReceiveSetValue.getSequence()) );
-   DEBUG_MESSAGE( "act sequence: " << static_cast<uint>(m_oReceiveActValue.getSequence()) );
+   DEBUG_MESSAGE( "set sequence: " << static_cast<uint>(m_oReceiveSetValue.getLastSequence()) );
+   DEBUG_MESSAGE( "act sequence: " << static_cast<uint>(m_oReceiveActValue.getLastSequence()) );
 #endif
 
+   for( std::size_t s = 0; s < rSetWindow.size(); s++ )
+   {
+      for( std::size_t a = 0; a < rActWindow.size(); a++ )
+      {
+         if( !isPair( rSetWindow[s], rActWindow[a] ) )
+            continue;
+
+         for( ; s > 0; s-- )
+            dropOldest( m_oReceiveSetValue );
+         for( ; a > 0; a-- )
+            dropOldest( m_oReceiveActValue );
+
+         /*
+          * Removing the pair from the windows before forwarding,
+          * the callback functions could throw exceptions.
+          */
+         const PENDING_T set = rSetWindow.front();
+         const PENDING_T act = rActWindow.front();
+         rSetWindow.pop_front();
+         rActWindow.pop_front();
+         forwardPair( set, act );
+         return;
+      }
+   }
+
+   /*
+    * No pair found, the window which has been grown above its limit
+    * doesn't wait any longer for its oldest block.
+    */
+   while( rSetWindow.size() > REORDER_WINDOW )
+      dropOldest( m_oReceiveSetValue );
+   while( rActWindow.size() > REORDER_WINDOW )
+      dropOldest( m_oReceiveActValue );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Forwarding of actual- and set- values of a pair of blocks
+ *        to the higher software-layer.
+ */
+void FgFeedbackChannel::AddacFb::forwardPair( const PENDING_T& rSet,
+                                              const PENDING_T& rAct )
+{
    /*
     * Safety check: The data length of both blocks have to be equal!
     */
-   if( m_oReceiveSetValue.getBlockLen() != m_oReceiveActValue.getBlockLen() )
+   if( rSet.m_oView.size() != rAct.m_oView.size() )
    {
       std::string str = "Different block sizes received: set data: ";
-      str += std::to_string( m_oReceiveSetValue.getBlockLen() );
+      str += std::to_string( rSet.m_oView.size() );
       str += " actual data: ";
-      str += std::to_string( m_oReceiveActValue.getBlockLen() );
+      str += std::to_string( rAct.m_oView.size() );
       throw daq::Exception( str );
    }
 
    /*
     * Safety check: The sample interval time of set and actual data have to be equal!
     */
-   if( m_oReceiveSetValue.getSampleTime() != m_oReceiveActValue.getSampleTime() )
+   if( rSet.m_sampleTime != rAct.m_sampleTime )
    {
       std::string str = "Different sample intervals between set data (";
-      str += std::to_string( m_oReceiveSetValue.getSampleTime() );
+      str += std::to_string( rSet.m_sampleTime );
       str += " us) and actual data (";
-      str += std::to_string( m_oReceiveActValue.getSampleTime() );
+      str += std::to_string( rAct.m_sampleTime );
       str += " us) received!";
       throw daq::Exception( str );
    }
 
-   auto timeStampSetVal = m_oReceiveSetValue.getTimestamp();
-
-   if( m_pParent->m_pParent->m_pParent->isPairingBySequence() )
-   { /*
-      * +++ Pairing by sequence number +++
-      * One of both channels has received first, in this case it has to be wait
-      * for the second channel.
-      * This will accomplished by comparing the sequence numbers.
-      */
-      const auto sequenceDeviation = ::abs( m_oReceiveSetValue.getSequence() -
-                                            m_oReceiveActValue.getSequence() );
-      if( sequenceDeviation != 0 )
-      {
-         if( sequenceDeviation == 1 || sequenceDeviation == static_cast<daq::DAQ_SEQUENCE_T>(~0) )
-         { /*
-            * A sequence number deviation of one means that at the moment only one channel has
-            * received a new data block, therefore it must be wait for the incoming block
-            * of the other channel.
-            * This will happen every second function call in normal operation.
-            */
-            return;
-         }
-
-         /*
-          * Throwing a exception if following function will not be overwritten.
-          */
-         m_pParent->onActSetBlockDeviation( m_oReceiveSetValue.getSequence(),
-                                            m_oReceiveActValue.getSequence() );
-
-         return;
-      }
-   }
-   else
-   { /*
-      * +++ Pairing by timestamp +++
-      * That should be the default.
-      */
-      const auto timeStampActVal = m_oReceiveActValue.getTimestamp();
-      const uint diff = ::abs( static_cast<int64_t>(timeStampActVal - timeStampSetVal));
-      static_assert( REL_PHASE_TOLERANCE == 1 || REL_PHASE_TOLERANCE == 2,
-                     "Relative phase tolerance shall be one or two!" );
-      if( diff > static_cast<uint>(REL_PHASE_TOLERANCE * m_oReceiveSetValue.getSampleTime()) )
-      { /*
-         * Is the time deviation between set- and actual- value-block
-         * greater than a specific value, then it have to be wait for the
-         * incoming block of the other channel.
-         * Therefore this function will be terminated here.
-         * This will happen every second function call in normal operation.
-         */
-         return;
-      }
-
-      if( diff > 0 )
-      {
-         m_pParent->onActSetTimestampDeviation( timeStampSetVal, timeStampActVal );
-      }
+   if( !m_pParent->m_pParent->m_pParent->isPairingBySequence() &&
+       (rSet.m_timestamp != rAct.m_timestamp) )
+   {
+      m_pParent->onActSetTimestampDeviation( rSet.m_timestamp, rAct.m_timestamp );
    }
 
    /*
     * Converting TAI to UTC if requested.
     */
-   timeStampSetVal -= m_pParent->m_pParent->m_pParent->getTaiToUtcOffset();
+   uint64_t timeStampSetVal = rSet.m_timestamp -
+                              m_pParent->m_pParent->m_pParent->getTaiToUtcOffset();
 
    /*
-    * Forwarding of set- and actual- values to the higher software layer.
+    * Forwarding of set- and actual- values to the higher software layer,
+    * directly from the receive buffer.
     */
-   for( std::size_t i = 0; i < m_oReceiveSetValue.getBlockLen();
-        i++, timeStampSetVal += m_oReceiveSetValue.getSampleTime() )
-   {
-      evaluate( timeStampSetVal, m_oReceiveActValue[i], m_oReceiveSetValue[i] );
-   }
+   evaluateBlock( timeStampSetVal, rSet.m_sampleTime,
+                  rAct.m_oView.getData(), rSet.m_oView.getData(),
+                  rSet.m_oView.size() );
 }
 
 #ifdef CONFIG_MIL_FG
@@ -452,6 +576,8 @@ FgFeedbackChannel::FgFeedbackChannel( const uint fgNumber )
       ,m_pParent( nullptr )
       ,m_pCommon( nullptr )
       ,m_lastTimestamp( 0 )
+      ,m_poRing( nullptr )
+      ,m_overflowCount( 0 )
 {
    DEBUG_MESSAGE_M_FUNCTION( fgNumber );
 }
@@ -467,6 +593,126 @@ FgFeedbackChannel::~FgFeedbackChannel( void )
 
    if( m_pCommon != nullptr )
       delete m_pCommon;
+
+   deleteRing();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackChannel::forward( const uint64_t wrTimeStampTAI,
+                                 const DAQ_T actValue,
+                                 const DAQ_T setValue )
+{
+   if( m_poRing == nullptr )
+   {
+      onData( wrTimeStampTAI, actValue, setValue );
+      return;
+   }
+
+   if( !m_poRing->push( { .m_timestamp = wrTimeStampTAI,
+                          .m_actValue  = actValue,
+                          .m_setValue  = setValue } ) )
+      m_overflowCount.fetch_add( 1, std::memory_order_relaxed );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackChannel::forwardBlock( const uint64_t* pTimestamps,
+                                      const DAQ_T* pActValues,
+                                      const DAQ_T* pSetValues,
+                                      const std::size_t len )
+{
+   if( m_poRing == nullptr )
+   {
+      onDataBlock( TIMESTAMP_SPAN_T( pTimestamps, len ),
+                   DAQ_SPAN_T( pActValues, len ),
+                   DAQ_SPAN_T( pSetValues, len ) );
+      return;
+   }
+
+   for( std::size_t i = 0; i < len; i++ )
+   {
+      if( !m_poRing->push( { .m_timestamp = pTimestamps[i],
+                             .m_actValue  = pActValues[i],
+                             .m_setValue  = pSetValues[i] } ) )
+      {
+         m_overflowCount.fetch_add( len - i, std::memory_order_relaxed );
+         return;
+      }
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+void FgFeedbackChannel::onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                                     const DAQ_SPAN_T& rActValues,
+                                     const DAQ_SPAN_T& rSetValues )
+{
+   assert( rTimestamps.size() == rActValues.size() );
+   assert( rTimestamps.size() == rSetValues.size() );
+
+   for( std::size_t i = 0; i < rTimestamps.size(); i++ )
+      onData( rTimestamps[i], rActValues[i], rSetValues[i] );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackChannel::createRing( const std::size_t capacity )
+{
+   if( m_poRing == nullptr )
+      m_poRing = new RING_T( capacity );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackChannel::deleteRing( void )
+{
+   if( m_poRing == nullptr )
+      return;
+
+   delete m_poRing;
+   m_poRing = nullptr;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+std::size_t FgFeedbackChannel::dispatch( const std::size_t max )
+{
+   if( m_poRing == nullptr )
+      return 0;
+
+   RING_ITEM_T aItems[DISPATCH_BLOCK_SIZE];
+   uint64_t    aTimestamps[DISPATCH_BLOCK_SIZE];
+   DAQ_T       aActValues[DISPATCH_BLOCK_SIZE];
+   DAQ_T       aSetValues[DISPATCH_BLOCK_SIZE];
+
+   std::size_t count = 0;
+   while( count < max )
+   {
+      /*
+       * Ternary operator instead of std::min() which would need a
+       * definition of the static constant in C++11.
+       */
+      const std::size_t len = m_poRing->pull( aItems,
+                                ((max - count) < DISPATCH_BLOCK_SIZE)?
+                                 (max - count) : DISPATCH_BLOCK_SIZE );
+      if( len == 0 )
+         break;
+
+      for( std::size_t i = 0; i < len; i++ )
+      {
+         aTimestamps[i] = aItems[i].m_timestamp;
+         aActValues[i]  = aItems[i].m_actValue;
+         aSetValues[i]  = aItems[i].m_setValue;
+      }
+      onDataBlock( TIMESTAMP_SPAN_T( aTimestamps, len ),
+                   DAQ_SPAN_T( aActValues, len ),
+                   DAQ_SPAN_T( aSetValues, len ) );
+      count += len;
+   }
+   return count;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -534,6 +780,17 @@ bool FgFeedbackChannel::isHighResolution( void )
    return getAdministration()->addacWasHighResolution();
 }
 
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+uint64_t FgFeedbackChannel::getUnpairedBlockCount( void ) const
+{
+   const AddacFb* pAddac = dynamic_cast<const AddacFb*>(m_pCommon);
+   if( pAddac == nullptr )
+      return 0;
+   return pAddac->m_unpairedCount;
+}
+
 /*! ---------------------------------------------------------------------------
  * @see scu_fg_feedback.hpp
  */
@@ -746,6 +1003,10 @@ void FgFeedbackDevice::registerChannel( FgFeedbackChannel* pFeedbackChannel )
       throw daq::Exception( str );
    }
 
+   if( (m_pParent != nullptr) && m_pParent->isAcquisitionRunning() )
+      throw daq::Exception( "Feedback channel can't be registered while"
+                            " the acquisition thread is running!" );
+
    assert( pFeedbackChannel->m_pCommon == nullptr );
    pFeedbackChannel->m_pParent = this;
 
@@ -939,6 +1200,10 @@ FgFeedbackAdministration::FgFeedbackAdministration( const std::string& netaddres
    ,m_throttleThreshold( DEFAULT_THROTTLE_THRESHOLD << VALUE_SHIFT )
    ,m_throttleTimeout( DEFAULT_THROTTLE_TIMEOUT * daq::NANOSECS_PER_MILLISEC )
    ,m_ebSelfAcquired( true )
+   ,m_stopAcquisition( false )
+   ,m_acquisitionFailed( false )
+   ,m_acquisitionPollIntervalUs( DEFAULT_ACQUISITION_POLL_INTERVAL_US )
+   ,m_adaptivePolling( false )
    ,m_taiToUtcOffset( 0 )
 #ifdef CONFIG_DEBUG_MESSAGES
    ,m_dbgIsFirstCall( true )
@@ -960,6 +1225,10 @@ FgFeedbackAdministration::FgFeedbackAdministration( EBC_PTR_T poEtherbone,
    ,m_throttleThreshold( DEFAULT_THROTTLE_THRESHOLD << VALUE_SHIFT )
    ,m_throttleTimeout( DEFAULT_THROTTLE_TIMEOUT * daq::NANOSECS_PER_MILLISEC )
    ,m_ebSelfAcquired( false )
+   ,m_stopAcquisition( false )
+   ,m_acquisitionFailed( false )
+   ,m_acquisitionPollIntervalUs( DEFAULT_ACQUISITION_POLL_INTERVAL_US )
+   ,m_adaptivePolling( false )
    ,m_taiToUtcOffset( 0 )
 #ifdef CONFIG_DEBUG_MESSAGES
    ,m_dbgIsFirstCall( true )
@@ -981,6 +1250,10 @@ FgFeedbackAdministration::FgFeedbackAdministration( DaqAccess* poEbAccess,
   ,m_throttleThreshold( DEFAULT_THROTTLE_THRESHOLD << VALUE_SHIFT )
   ,m_throttleTimeout( DEFAULT_THROTTLE_TIMEOUT  * daq::NANOSECS_PER_MILLISEC )
   ,m_ebSelfAcquired( false )
+  ,m_stopAcquisition( false )
+  ,m_acquisitionFailed( false )
+  ,m_acquisitionPollIntervalUs( DEFAULT_ACQUISITION_POLL_INTERVAL_US )
+  ,m_adaptivePolling( false )
   ,m_taiToUtcOffset( 0 )
 #ifdef CONFIG_DEBUG_MESSAGES
   ,m_dbgIsFirstCall( true )
@@ -996,6 +1269,13 @@ FgFeedbackAdministration::~FgFeedbackAdministration( void )
 {
    DEBUG_MESSAGE_M_FUNCTION(getScuDomainName());
 
+   /*
+    * Safety net only, the threaded mode should be already stopped by
+    * stopAcquisition() before derived objects has been destroyed.
+    */
+   joinAcquisitionThread();
+   deleteRings();
+
    for( const auto& pDev: m_lDevList )
       pDev->m_pParent = nullptr;
 
@@ -1042,6 +1322,10 @@ void FgFeedbackAdministration::registerDevice( FgFeedbackDevice* poDevice )
       throw daq::Exception( str );
    }
 
+   if( isAcquisitionRunning() )
+      throw daq::Exception( "Feedback device can't be registered while"
+                            " the acquisition thread is running!" );
+
    if( !isSocketUsed( poDevice->getSocket() ) )
    {
       std::string str = "Device on socket ";
@@ -1122,6 +1406,7 @@ int FgFeedbackAdministration::sendSyncronizeTimestamps( const uint32_t timeOffse
    daq::DaqAdministration::sendSyncronizeTimestamps();
 #endif
 
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
    for( const auto& poDaqAdmin: m_vPollList )
       poDaqAdmin->sendSyncronizeTimestamps( timeOffset, ecaTag );
 
@@ -1149,13 +1434,175 @@ uint FgFeedbackAdministration::distributeData( void )
       DEBUG_MESSAGE_M_FUNCTION("");
    }
 #endif
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
+
    uint remainingData = 0;
    for( const auto& poDaqAdmin: m_vPollList )
-      remainingData += poDaqAdmin->distributeData();
+   {
+      if( !poDaqAdmin->isPollDue() )
+         continue;
+      const uint remaining = poDaqAdmin->distributeData();
+      poDaqAdmin->schedulePoll( remaining );
+      remainingData += remaining;
+   }
 
    return remainingData;
 }
 
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+void FgFeedbackAdministration::setAdaptivePolling( const bool enable,
+                                                   const uint minIntervalUs,
+                                                   const uint maxIntervalUs )
+{
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
+   for( const auto& poDaqAdmin: m_vPollList )
+   {
+      poDaqAdmin->getPollScheduler().setLimits( minIntervalUs, maxIntervalUs );
+      poDaqAdmin->enableAdaptivePolling( enable );
+   }
+   m_adaptivePolling = enable;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+uint FgFeedbackAdministration::getPollDelayUs( const uint defaultUs )
+{
+   if( !m_adaptivePolling )
+      return defaultUs;
+
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
+   uint delay = PollScheduler::DEFAULT_MAX_INTERVAL_US;
+   for( const auto& poDaqAdmin: m_vPollList )
+      delay = std::min( delay, poDaqAdmin->getPollDelayUs() );
+
+   return delay;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+void FgFeedbackAdministration::startAcquisition( const std::size_t ringCapacity,
+                                                 const uint pollIntervalUs )
+{
+   DEBUG_MESSAGE_M_FUNCTION( ringCapacity );
+
+   if( isAcquisitionRunning() )
+      throw daq::Exception( "Acquisition thread is already running!" );
+
+   if( ringCapacity == 0 )
+      throw daq::Exception( "Capacity of hand-off ring can't be zero!" );
+
+   for( const auto& pDev: m_lDevList )
+      for( const auto& pChannel: *pDev )
+         pChannel->createRing( ringCapacity );
+
+   m_acquisitionPollIntervalUs = pollIntervalUs;
+   m_acquisitionException      = nullptr;
+   m_acquisitionFailed.store( false );
+   m_stopAcquisition.store( false );
+   m_oAcquisitionThread = std::thread( &FgFeedbackAdministration::acquisitionLoop, this );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackAdministration::acquisitionLoop( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+   try
+   {
+      while( !m_stopAcquisition.load( std::memory_order_acquire ) )
+      {
+         if( distributeData() == 0 )
+         {
+            const uint delay = getPollDelayUs( m_acquisitionPollIntervalUs );
+            if( delay != 0 )
+               ::usleep( delay );
+         }
+      }
+   }
+   catch( ... )
+   { /*
+      * The exception will forwarded to the consumer thread,
+      * see dispatchData().
+      */
+      m_acquisitionException = std::current_exception();
+      m_acquisitionFailed.store( true, std::memory_order_release );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackAdministration::joinAcquisitionThread( void )
+{
+   if( !isAcquisitionRunning() )
+      return;
+
+   m_stopAcquisition.store( true, std::memory_order_release );
+   m_oAcquisitionThread.join();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FgFeedbackAdministration::deleteRings( void )
+{
+   for( const auto& pDev: m_lDevList )
+      for( const auto& pChannel: *pDev )
+         pChannel->deleteRing();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+void FgFeedbackAdministration::stopAcquisition( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+
+   joinAcquisitionThread();
+   m_acquisitionFailed.store( false );
+
+   for( const auto& pDev: m_lDevList )
+      for( const auto& pChannel: *pDev )
+         pChannel->dispatch();
+
+   deleteRings();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_feedback.hpp
+ */
+std::size_t FgFeedbackAdministration::dispatchData( const std::size_t maxPerChannel )
+{
+   std::size_t count = 0;
+   for( const auto& pDev: m_lDevList )
+      for( const auto& pChannel: *pDev )
+         count += pChannel->dispatch( maxPerChannel );
+
+   if( m_acquisitionFailed.load( std::memory_order_acquire ) )
+   {
+      joinAcquisitionThread();
+      m_acquisitionFailed.store( false );
+      deleteRings();
+      std::rethrow_exception( m_acquisitionException );
+   }
+
+   return count;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint64_t FgFeedbackAdministration::getOverflowCount( void )
+{
+   uint64_t count = 0;
+   for( const auto& pDev: m_lDevList )
+      for( const auto& pChannel: *pDev )
+         count += pChannel->getOverflowCount();
+
+   return count;
+}
+
 /*! ---------------------------------------------------------------------------
  */
 void FgFeedbackAdministration::clearBuffer( const bool update )
@@ -1171,6 +1618,7 @@ void FgFeedbackAdministration::clearBuffer( const bool update )
    daq::DaqAdministration::clearBuffer();
 #endif /* ifdef __DOXYGEN__ */
 
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
    for( const auto& poDaqAdmin: m_vPollList )
    {
       poDaqAdmin->clearBufferRequest();
@@ -1181,6 +1629,7 @@ void FgFeedbackAdministration::clearBuffer( const bool update )
  */
 bool FgFeedbackAdministration::clearBufferOnLevel( const uint threshold )
 {
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
    bool ret = false;
    for( const auto& poDaqAdmin: m_vPollList )
    {
@@ -1209,6 +1658,7 @@ void FgFeedbackAdministration::reset( void )
    daq::DaqAdministration::reset();
 #endif
 
+   std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
    for( const auto& poDaqAdmin: m_vPollList )
       poDaqAdmin->reset();
 }
@@ -1260,6 +1710,7 @@ const char* FgFeedbackAdministration::accessConstantToString( const WB_ACCESS_T
       __ACCESS_TO_STRING( LM32_READ );
       __ACCESS_TO_STRING( LM32_WRITE );
       __ACCESS_TO_STRING( DDR3_READ );
+      __ACCESS_TO_STRING( BATCH );
    }
    return "\0";
 }
@@ -29,7 +29,14 @@
 #define _SCU_FG_FEEDBACK_HPP
 
 #include <list>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
 #include <scu_control_config.h>
+#include <TSpscRing.hpp>
+#include <TSpan.hpp>
 #include <daq_calculations.hpp>
 #include <daq_administration.hpp>
 #ifdef CONFIG_MIL_FG
@@ -79,6 +86,18 @@ public:
     */
    static constexpr DAQ_FLOAT_T MAX_ADC_VALUE_F = static_cast<DAQ_FLOAT_T>(MAX_ADC_VALUE_I);
 
+   /*!
+    * @brief View of the time stamps of a block of tuples.
+    * @see onDataBlock
+    */
+   using TIMESTAMP_SPAN_T = TSpan<uint64_t>;
+
+   /*!
+    * @brief View of the actual- or set- values of a block of tuples.
+    * @see onDataBlock
+    */
+   using DAQ_SPAN_T       = TSpan<DAQ_T>;
+
 private:
    /*!
     * @brief Common object type for ADDAC/ACU- and MIL- feedback channel
@@ -101,6 +120,26 @@ private:
          Throttle( Common* pParent );
          ~Throttle( void );
          bool operator()( const uint64_t timestamp, const DAQ_T value );
+
+         /*!
+          * @brief Returns true if the given value has to be forwarded
+          *        and takes it as the new reference in this case.
+          *
+          * Inline core of operator() without access to the administration,
+          * so it can be used in the loop of Common::evaluateBlock().
+          */
+         bool check( const uint64_t timestamp, const DAQ_T value,
+                     const DAQ_T threshold, const uint64_t timeout )
+         {
+            if( ( static_cast<uint>(::abs( static_cast<int>(value - m_lastForwardedValue) )) < threshold ) &&
+                (( timestamp < m_timeThreshold ) || ( timeout == 0 ))
+              )
+               return false;
+
+            m_lastForwardedValue = value;
+            m_timeThreshold = timestamp + timeout;
+            return true;
+         }
       }; // class Throttle
 
    protected:
@@ -132,12 +171,27 @@ private:
        */
       DAQ_T     m_lastSupprActValue;
 
+      /*!
+       * @brief Output buffers of evaluateBlock() for the time stamps,
+       *        actual- and set- values of the forwarded tuples.
+       *        They grow to the largest block and will reused.
+       */
+      std::vector<uint64_t> m_vTimestamps;
+      std::vector<DAQ_T>    m_vActValues;
+      std::vector<DAQ_T>    m_vSetValues;
+
    public:
       Common( FgFeedbackChannel* pParent );
       virtual ~Common( void );
       void evaluate( const uint64_t wrTimeStampTAI,
                      const DAQ_T actValue,
                      const DAQ_T setValue );
+
+      void evaluateBlock( uint64_t timestamp,
+                          const uint sampleTime,
+                          const daq::DAQ_DATA_T* pActData,
+                          const daq::DAQ_DATA_T* pSetData,
+                          const std::size_t len );
    }; // class Common
 
    /*!
@@ -146,46 +200,64 @@ private:
    class AddacFb: public Common
    {
       friend class FgFeedbackDevice;
+      friend class FgFeedbackChannel;
       static constexpr uint REL_PHASE_TOLERANCE = 2;
+
       /*!
-       * @brief Object type containing the data buffer for received actual or
-       *        set values of a ADDAC-DAQ data block.
+       * @brief Maximum number of received blocks per set- and actual
+       *        value stream which can wait for its partner block.
        */
-      class Receive: public daq::DaqChannel
+      static constexpr std::size_t REORDER_WINDOW = 4;
+
+      /*!
+       * @brief Received continuous block which waits for its partner block.
+       */
+      struct PENDING_T
       {
-         AddacFb*            m_pParent;
+         /*!
+          * @brief View of the block in the receive buffer
+          *        of DaqAdministration, no copy.
+          */
+         daq::DaqBlockView   m_oView;
+
+         /*!
+          * @brief Time stamp of the first sampled value of the block.
+          */
          uint64_t            m_timestamp;
          uint                m_sampleTime;
-         std::size_t         m_blockLen;
          daq::DAQ_SEQUENCE_T m_sequence;
-         daq::DAQ_DATA_T     m_aBuffer[daq::DaqAdministration::c_contineousDataLen];
+      };
 
-      public:
-         Receive( AddacFb* pParent, const uint n );
-         virtual ~Receive( void );
+      /*!
+       * @brief Object type receiving the ADDAC-DAQ data blocks of the actual
+       *        or set values and keeping them until the partner block
+       *        has been received.
+       */
+      class Receive: public daq::DaqChannel
+      {
+         friend class AddacFb;
 
-         uint64_t getTimestamp( void ) const
-         {
-            return m_timestamp;
-         }
+         AddacFb*              m_pParent;
 
-         uint const getSampleTime( void ) const
-         {
-            return m_sampleTime;
-         }
+         /*!
+          * @brief Blocks waiting for pairing, the oldest one first.
+          */
+         std::deque<PENDING_T> m_window;
 
-         daq::DAQ_SEQUENCE_T getSequence( void ) const
-         {
-            return m_sequence;
-         }
+         /*!
+          * @brief Sequence number of the last received block.
+          */
+         daq::DAQ_SEQUENCE_T   m_lastSequence;
 
-         std::size_t getBlockLen( void ) const
+      public:
+         Receive( AddacFb* pParent, const uint n );
+         virtual ~Receive( void );
+
+         daq::DAQ_SEQUENCE_T getLastSequence( void ) const
          {
-            return m_blockLen;
+            return m_lastSequence;
          }
 
-         DAQ_T operator[]( const std::size_t i ) const;
-
       protected:
          bool onDataBlock( daq::DAQ_DATA_T* pData, std::size_t wordLen ) override;
          void onInit( void ) override;
@@ -193,14 +265,20 @@ private:
       }; // class Receive
 
       /*!
-       * @brief Data buffer of the last received set values.
+       * @brief Receiver of the set values.
        */
-      Receive m_oReceiveSetValue;
+      Receive  m_oReceiveSetValue;
 
       /*!
-       * @brief Data buffer of the last received actual values.
+       * @brief Receiver of the actual values.
        */
-      Receive m_oReceiveActValue;
+      Receive  m_oReceiveActValue;
+
+      /*!
+       * @brief Number of blocks which have been dropped because no
+       *        partner block has been found within the reorder window.
+       */
+      uint64_t m_unpairedCount;
 
    public:
       AddacFb( FgFeedbackChannel* pParent, const daq::DAQ_DEVICE_TYP_T type );
@@ -208,6 +286,9 @@ private:
 
    private:
       void finalizeBlock( void );
+      bool isPair( const PENDING_T& rSet, const PENDING_T& rAct );
+      void dropOldest( Receive& rReceive );
+      void forwardPair( const PENDING_T& rSet, const PENDING_T& rAct );
    }; // class AddacFb
 
 #ifdef CONFIG_MIL_FG
@@ -269,6 +350,60 @@ private:
     */
    uint64_t           m_lastTimestamp;
 
+   /*!
+    * @brief Item type of the hand-off ring in the threaded mode.
+    * @see FgFeedbackAdministration::startAcquisition
+    */
+   struct RING_ITEM_T
+   {
+      uint64_t m_timestamp;
+      DAQ_T    m_actValue;
+      DAQ_T    m_setValue;
+   };
+
+   using RING_T = mubu::TSpscRing<RING_ITEM_T>;
+
+   /*!
+    * @brief Pointer to the hand-off ring between the acquisition thread
+    *        and the consumer thread, nullptr when the threaded mode is
+    *        not active.
+    */
+   RING_T*               m_poRing;
+
+   /*!
+    * @brief Number of tuples which has been dropped because the
+    *        hand-off ring was full.
+    */
+   std::atomic<uint64_t> m_overflowCount;
+
+   /*!
+    * @brief Maximum number of tuples which becomes pulled at once from
+    *        the hand-off ring and delivered by onDataBlock().
+    * @see dispatch
+    */
+   static constexpr std::size_t DISPATCH_BLOCK_SIZE = 256;
+
+   /*!
+    * @brief Forwards a tuple either directly to the callback function
+    *        onData() or in threaded mode into the hand-off ring.
+    */
+   void forward( const uint64_t wrTimeStampTAI,
+                 const DAQ_T actValue,
+                 const DAQ_T setValue );
+
+   /*!
+    * @brief Forwards a block of tuples either directly to the callback
+    *        function onDataBlock() or in threaded mode into the
+    *        hand-off ring.
+    */
+   void forwardBlock( const uint64_t* pTimestamps,
+                      const DAQ_T* pActValues,
+                      const DAQ_T* pSetValues,
+                      const std::size_t len );
+
+   void createRing( const std::size_t capacity );
+   void deleteRing( void );
+
 public:
    /*!
     * @brief Constructor of a single function generator feedback channel.
@@ -408,6 +543,55 @@ public:
       return m_lastTimestamp;
    }
 
+   /*!
+    * @brief Returns the number of tuples which has been dropped in threaded
+    *        mode because the consumer was to slow and the hand-off ring
+    *        of this channel was full.
+    * @see FgFeedbackAdministration::startAcquisition
+    */
+   uint64_t getOverflowCount( void ) const
+   {
+      return m_overflowCount.load( std::memory_order_relaxed );
+   }
+
+   /*!
+    * @brief Returns the number of ADDAC/ACU-DAQ blocks which has been
+    *        dropped because the partner block (set- respectively actual
+    *        values) wasn't received within the reorder window.
+    * @note In the case of MIL-DAQ always zero will return.
+    */
+   uint64_t getUnpairedBlockCount( void ) const;
+
+   /*!
+    * @brief Sets the overflow counter to zero.
+    * @see getOverflowCount
+    */
+   void resetOverflowCount( void )
+   {
+      m_overflowCount.store( 0, std::memory_order_relaxed );
+   }
+
+   /*!
+    * @brief Returns the number of tuples in the hand-off ring which
+    *        are not dispatched yet. In non-threaded mode always zero.
+    */
+   std::size_t getRingLevel( void ) const
+   {
+      return (m_poRing == nullptr)? 0 : m_poRing->size();
+   }
+
+   /*!
+    * @brief Consumer function for the threaded mode: Invokes the callback
+    *        function onDataBlock() for the tuples in the hand-off ring of
+    *        this channel, in blocks of at most DISPATCH_BLOCK_SIZE tuples.
+    * @note CAUTION: Per channel only one thread may invoke this function,
+    *       it's the consumer of a single producer single consumer ring!
+    * @see FgFeedbackAdministration::dispatchData
+    * @param max Maximum number of tuples to dispatch.
+    * @return Number of dispatched tuples.
+    */
+   std::size_t dispatch( const std::size_t max = static_cast<std::size_t>(~0) );
+
    /*!
     * @brief Converts a DAQ-raw-data word into a usable
     *        floatingpoint value.
@@ -445,6 +629,25 @@ protected:
                         DAQ_T actlValue,
                         DAQ_T setValue ) = 0;
 
+   /*!
+    * @brief Callback function becomes invoked for a block of incoming
+    *        tuples which belongs to this object, the three views have
+    *        the same size and are valid during this call only.
+    *
+    * The ADDAC/ACU-DAQ tuples of a received pair of blocks become
+    * throttled in one pass and delivered by a single call of this
+    * function, MIL-DAQ tuples in blocks of one tuple.
+    * The default implementation invokes onData() for each tuple,
+    * applications which process the data in blocks can override this
+    * function or use the adapter class FgFeedbackBlock.
+    * @param rTimestamps White rabbit time stamps of the tuples.
+    * @param rActValues Actual values from the DAQ.
+    * @param rSetValues Set values from function generator.
+    */
+   virtual void onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                             const DAQ_SPAN_T& rActValues,
+                             const DAQ_SPAN_T& rSetValues );
+
    /*!
     * @brief Optional callback function becomes invoked once this object
     *        is registered in its container of type DaqDevice and this
@@ -483,6 +686,11 @@ protected:
    /*!
     * @brief Over-writable callback function becomes invoked if the deviation
     *        of sequence-numbers of actual- and set -values greater than one.
+    *
+    * In the pairing by sequence mode this happens when a block becomes
+    * dropped because no partner block has been received within the
+    * reorder window.
+    * @see getUnpairedBlockCount
     * @param setSequ Sequence number of last received set-value block
     * @param actSequ Sequence number of last received actual-value block
     */
@@ -632,6 +840,57 @@ static_assert( sizeof(FgFeedbackChannel) == sizeof(FgFeedbackTuple),
                "Class FgFeedbackTuple shall be a adapter class for function"
                " onData() with no additional member variables!");
 
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Specializing of the class FgFeedbackChannel in which the data
+ *        becomes received in blocks only by the callback function
+ *        onDataBlock().
+ *
+ * Avoids the virtual function call per tuple, single tuples e.g. of the
+ * MIL-DAQ become delivered as blocks of one tuple.
+ * @note This class is completely implemented in this header.
+ */
+class FgFeedbackBlock: public FgFeedbackChannel
+{
+public:
+   /*!
+    * @brief Constructor of a single function generator feedback channel
+    *        specialized for blocks of tuples.
+    * @param fgNumber Number of function generator.
+    */
+   FgFeedbackBlock( const uint fgNumber ): FgFeedbackChannel( fgNumber ) {}
+
+   /*!
+    * @brief Destructor, if a instance of this type has been registered
+    *        then it will deregistered by its self.
+    */
+   virtual ~FgFeedbackBlock( void ) {}
+
+protected:
+   /*!
+    * @brief Callback function becomes invoked for each block of incoming
+    *        tuples which belongs to this object.
+    * @see FgFeedbackChannel::onDataBlock
+    */
+   void onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                     const DAQ_SPAN_T& rActValues,
+                     const DAQ_SPAN_T& rSetValues ) override = 0;
+
+private:
+   void onData( uint64_t wrTimeStampTAI,
+                DAQ_T actlValue,
+                DAQ_T setValue ) override final
+   {
+      onDataBlock( TIMESTAMP_SPAN_T( &wrTimeStampTAI, 1 ),
+                   DAQ_SPAN_T( &actlValue, 1 ),
+                   DAQ_SPAN_T( &setValue, 1 ) );
+   }
+};
+
+static_assert( sizeof(FgFeedbackChannel) == sizeof(FgFeedbackBlock),
+               "Class FgFeedbackBlock shall be a adapter class for function"
+               " onDataBlock() with no additional member variables!");
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 /*!
@@ -876,6 +1135,7 @@ inline bool FgFeedbackChannel::isCompleateRegistered( void )
  */
 class FgFeedbackAdministration
 {
+   friend class FgFeedbackChannel::Common;
    friend class FgFeedbackChannel::Common::Throttle;
 
    using DAQ_POLL_T     = std::vector<DaqBaseInterface*>;
@@ -909,7 +1169,13 @@ public:
       /*!
        * @brief Read access from DDR3-ram has been made.
        */
-      DDR3_READ  = daq::EbRamAccess::TIME_MEASUREMENT_T::DDR3_READ
+      DDR3_READ  = daq::EbRamAccess::TIME_MEASUREMENT_T::DDR3_READ,
+
+      /*!
+       * @brief Batch of several accesses within one etherbone cycle
+       *        has been made.
+       */
+      BATCH      = daq::EbRamAccess::TIME_MEASUREMENT_T::BATCH
    };
 #endif /* ifdef CONFIG_EB_TIME_MEASSUREMENT */
 
@@ -1049,6 +1315,35 @@ private:
     */
    bool                       m_ebSelfAcquired;
 
+   /*!
+    * @brief Acquisition thread in threaded mode.
+    * @see startAcquisition
+    */
+   std::thread                m_oAcquisitionThread;
+
+   /*!
+    * @brief Serializes the accesses of the acquisition thread and
+    *        of the application to the DAQ administration objects.
+    */
+   std::recursive_mutex       m_oAcquisitionMutex;
+
+   std::atomic<bool>          m_stopAcquisition;
+   std::atomic<bool>          m_acquisitionFailed;
+
+   /*!
+    * @brief Exception thrown in the acquisition thread, it becomes
+    *        re-thrown by dispatchData() in the consumer thread.
+    */
+   std::exception_ptr         m_acquisitionException;
+
+   uint                       m_acquisitionPollIntervalUs;
+
+   /*!
+    * @brief Is true when the adaptive polling is enabled.
+    * @see setAdaptivePolling
+    */
+   bool                       m_adaptivePolling;
+
 protected:
    #define DEVICE_LIST_BASE std::list
    using DEVICE_LIST_T = DEVICE_LIST_BASE<FgFeedbackDevice*>;
@@ -1076,9 +1371,9 @@ public:
     * @note If the wishbone/etherbone connection not already open then
     *       this constructor will do that.
     * @param netaddress Textstring with the wishbone device. Default: "dev/wbm0".
-    *                   If the wishbone device already open, then this parameter has no effect.
-    *                   If this parameter differs to the already opened device,
-    *                   then an exception will thrown.
+    *                   If this device is already open, then its connection
+    *                   becomes shared, a different device will opened in
+    *                   a own connection.
     * @param doRescan If true then a rescan command will send to the
     *                 LM32 -application.
     * @param timeout Timeout in milliseconds of the wishbone/etherbone connection.
@@ -1280,6 +1575,50 @@ public:
       return m_oAddacDaqAdmin.getBlockReadEbCycleTimeUs();
    }
 
+   /*!
+    * @brief Sets the maximum number of ADDAC-DAQ blocks which becomes read
+    *        and distributed by a single call of distributeData().
+    *
+    * A value greater than one activates the batched mode, in which all
+    * complete blocks up to this budget becomes read by one ring-buffer
+    * access and acknowledged by a single write access to the LM32.
+    * @note In the case of MIL-devices this function has no effect.
+    * @see daq::DaqAdministration::setDrainBlockBudget
+    * @param budget Maximum number of blocks per call.
+    */
+   void setAddacDrainBlockBudget( const uint budget = daq::DaqAdministration::c_defaultDrainBlockBudget )
+   {
+      std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
+      m_oAddacDaqAdmin.setDrainBlockBudget( budget );
+   }
+
+   /*!
+    * @brief Returns the maximum number of ADDAC-DAQ blocks per call of
+    *        distributeData().
+    * @see setAddacDrainBlockBudget
+    */
+   uint getAddacDrainBlockBudget( void ) const
+   {
+      return m_oAddacDaqAdmin.getDrainBlockBudget();
+   }
+
+   /*!
+    * @brief Sets respectively removes by nullptr a recorder, which becomes
+    *        fed with all raw ADDAC-DAQ blocks and MIL-DAQ items received
+    *        by the inner administrations.
+    * @note The recorder is not owned by this object.
+    * @see daq::DaqAdministration::setRecorder
+    * @see MiLdaq::DaqAdministration::setRecorder
+    */
+   void setRecorder( daq::DaqRecorder* poRecorder )
+   {
+      std::lock_guard<std::recursive_mutex> lock( m_oAcquisitionMutex );
+    #ifdef CONFIG_MIL_FG
+      m_oMilDaqAdmin.setRecorder( poRecorder );
+    #endif
+      m_oAddacDaqAdmin.setRecorder( poRecorder );
+   }
+
 #ifdef CONFIG_EB_TIME_MEASSUREMENT
    /*!
     * @ingroup TIME_MEASUREMENT
@@ -1292,6 +1631,7 @@ public:
     * @retval LM32_READ
     * @retval LM32_WRITE
     * @retval DDR3_READ
+    * @retval BATCH
     */
    WB_ACCESS_T getWbMeasurementMaxTime( daq::USEC_T& rTimestamp, daq::USEC_T& rDuration, std::size_t& rSize )
    {
@@ -1309,6 +1649,7 @@ public:
     * @retval LM32_READ
     * @retval LM32_WRITE
     * @retval DDR3_READ
+    * @retval BATCH
     */
    WB_ACCESS_T getWbMeasurementMinTime( daq::USEC_T& rTimestamp, daq::USEC_T& rDuration, std::size_t& rSize )
    {
@@ -1630,6 +1971,13 @@ public:
     */
    void unregisterDevice( FgFeedbackDevice* poDevice );
 
+private:
+   void acquisitionLoop( void );
+   void joinAcquisitionThread( void );
+   void deleteRings( void );
+
+public:
+
    /*!
     * @ingroup REGISTRATION
     * @brief Returns the number of feedback- devices which has been
@@ -1772,11 +2120,129 @@ public:
     * the associated channel object.
     *
     * @note This function should run in a polling-loop of a own thread.
+    * @see startAcquisition
     * @return Number of remaining data in the DDR3-RAM which are still not evaluated
     *         by the callback functions "onData".
     */
    uint distributeData( void );
 
+   /*!
+    * @brief Enables or disables the adaptive polling of all DAQ-FIFOs.
+    *
+    * When enabled, then each DAQ-FIFO (ADDAC and MIL) will polled by
+    * distributeData() only when its poll is due. The poll time becomes
+    * derived from the FIFO fill level and the observed fill rate:
+    * In idle the poll interval becomes doubled up to maxIntervalUs,
+    * if the fill level approaches the FIFO alarm threshold then
+    * minIntervalUs will used and the pauses between divided data blocks
+    * becomes omitted.
+    * @see PollScheduler
+    * @see getPollDelayUs
+    * @param enable If true then the adaptive polling is active.
+    * @param minIntervalUs Minimum poll interval in microseconds.
+    * @param maxIntervalUs Maximum poll interval in microseconds.
+    */
+   void setAdaptivePolling( const bool enable = true,
+                            const uint minIntervalUs = PollScheduler::DEFAULT_MIN_INTERVAL_US,
+                            const uint maxIntervalUs = PollScheduler::DEFAULT_MAX_INTERVAL_US );
+
+   /*!
+    * @brief Returns "true" if the adaptive polling is enabled.
+    * @see setAdaptivePolling
+    */
+   bool isAdaptivePolling( void ) const
+   {
+      return m_adaptivePolling;
+   }
+
+   /*!
+    * @brief Returns the time in microseconds up to the next due poll of
+    *        any DAQ-FIFO, it's the recommended waiting time of the
+    *        polling loop.
+    * @param defaultUs Return value when the adaptive polling is disabled.
+    */
+   uint getPollDelayUs( const uint defaultUs = DEFAULT_ACQUISITION_POLL_INTERVAL_US );
+
+   /*!
+    * @brief Default capacity in tuples of the hand-off ring per channel
+    *        in threaded mode.
+    */
+   static constexpr std::size_t DEFAULT_RING_CAPACITY = 4096;
+
+   /*!
+    * @brief Default waiting time in microseconds of the acquisition thread
+    *        when no data has been found.
+    */
+   static constexpr uint DEFAULT_ACQUISITION_POLL_INTERVAL_US = 1000;
+
+   /*!
+    * @brief Starts the threaded mode.
+    *
+    * A acquisition thread polls the DAQ-buffers by distributeData() and
+    * pushes the received tuples in a lock-free hand-off ring per channel,
+    * so a slow consumer can no longer stall the etherbone readout.
+    * The tuples will delivered to the callback functions onData() by
+    * dispatchData() invoked by exactly one consumer thread.
+    * The hand-off rings have a single consumer only, so dispatchData()
+    * and FgFeedbackChannel::dispatch() must not be invoked concurrently.
+    *
+    * If a ring is full then the tuple will dropped and counted,
+    * @see FgFeedbackChannel::getOverflowCount
+    * @note All other callback functions, e.g. onDataError() or
+    *       onHighResPostMortemBlock() will still invoked within the
+    *       acquisition thread. Channel queries like isContinous() or
+    *       getLastTimestamp() reflect the state of the acquisition thread
+    *       and not the state of the just dispatched tuple.
+    * @note During the threaded mode no devices or channels can be
+    *       registered or unregistered.
+    * @param ringCapacity Capacity of the hand-off ring per channel in tuples.
+    * @param pollIntervalUs Waiting time in microseconds of the acquisition
+    *                       thread when no data has been found.
+    */
+   void startAcquisition( const std::size_t ringCapacity = DEFAULT_RING_CAPACITY,
+                          const uint pollIntervalUs = DEFAULT_ACQUISITION_POLL_INTERVAL_US );
+
+   /*!
+    * @brief Stops the threaded mode, dispatches the remaining tuples
+    *        and returns to the synchronous mode.
+    * @note This function has to be invoked before a derived object becomes
+    *       destroyed, otherwise its overwritten callback functions could be
+    *       invoked by the acquisition thread during the destruction.
+    * @see startAcquisition
+    */
+   void stopAcquisition( void );
+
+   /*!
+    * @brief Returns "true" if the threaded mode is active.
+    * @see startAcquisition
+    */
+   bool isAcquisitionRunning( void ) const
+   {
+      return m_oAcquisitionThread.joinable();
+   }
+
+   /*!
+    * @brief Consumer function for the threaded mode: Invokes the callback
+    *        function onData() of all registered channels for each
+    *        tuple in the hand-off rings.
+    *
+    * If the acquisition thread has been terminated by an exception, so
+    * this exception becomes re-thrown here, after the remaining tuples
+    * has been dispatched.
+    * @note In non-threaded mode this function does nothing.
+    * @see startAcquisition
+    * @param maxPerChannel Maximum number of tuples per channel.
+    * @return Total number of dispatched tuples.
+    */
+   std::size_t dispatchData( const std::size_t maxPerChannel = static_cast<std::size_t>(~0) );
+
+   /*!
+    * @brief Returns the sum of the overflow counters of all registered
+    *        channels.
+    * @see FgFeedbackChannel::getOverflowCount
+    */
+   uint64_t getOverflowCount( void );
+
    /*!
     * @brief Makes the data buffer empty.
     * @param update If true the indexes in the LM32 shared memory
@@ -70,6 +70,8 @@ DaqChannel::DaqChannel( const uint number )
 DaqChannel::~DaqChannel( void )
 {
    DEBUG_MESSAGE_M_FUNCTION( "ADDAC number: " << m_number );
+   if( m_pParent != nullptr )
+      m_pParent->unregisterChannel( this );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -110,7 +112,10 @@ DaqDevice::~DaqDevice( void )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
    for( const auto& channel: *this )
-      unregisterChannel( channel );
+      channel->m_pParent = nullptr;
+
+   if( m_pParent != nullptr )
+      m_pParent->unregisterDevice( this );
 }
 
 /* ----------------------------------------------------------------------------
@@ -130,7 +135,10 @@ bool DaqDevice::registerChannel( DaqChannel* pChannel )
    pChannel->m_pParent = this;
    m_channelPtrList.push_back( pChannel );
    if( m_pParent != nullptr )
+   {
+      m_pParent->updateDispatchTable();
       pChannel->onInit();
+   }
 
    return false;
 }
@@ -144,14 +152,10 @@ bool DaqDevice::unregisterChannel( DaqChannel* pChannel )
    if( pChannel->m_pParent != this )
       return true;
 
-   for( const auto& i: m_channelPtrList )
-   {
-      if( i != pChannel )
-         continue;
-      //m_channelPtrList.erase( pChannel );
-   }
-
+   m_channelPtrList.remove( pChannel );
    pChannel->m_pParent = nullptr;
+   if( m_pParent != nullptr )
+      m_pParent->updateDispatchTable();
    return false;
 }
 
@@ -197,8 +201,16 @@ DaqAdministration::DaqAdministration( EBC_PTR_T poEtherbone,
                                     )
    :DaqInterface( poEtherbone, doReset, doSendCommand )
    ,m_poBlockBuffer( nullptr )
+   ,m_poCurrentBlock( nullptr )
+   ,m_drainBlockBudget( c_defaultDrainBlockBudget )
+   ,m_oBlockArena( c_blockBufferLen )
+   ,m_currentWordLen( 0 )
    ,m_maxChannels( 0 )
    ,m_receiveCount( 0 )
+   ,m_crcErrorCount( 0 )
+   ,m_isCrcCheckEnabled( false )
+   ,m_lastCrcErrorReportTime( 0 )
+   ,m_poRecorder( nullptr )
 #ifdef CONFIG_DEBUG_MESSAGES
    ,m_dbgIsFirstCall( true )
 #endif
@@ -207,8 +219,10 @@ DaqAdministration::DaqAdministration( EBC_PTR_T poEtherbone,
 #endif
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
-   m_poBlockBuffer = new BLOCK_BUFFER_T;
-   ::memset( m_poBlockBuffer, 0, sizeof( BLOCK_BUFFER_T ) );
+   m_poBlockBuffer = reinterpret_cast<BLOCK_BUFFER_T*>(m_oBlockArena.acquire());
+   m_poCurrentBlock = m_poBlockBuffer;
+   updateDispatchTable();
+   setRecorder( nullptr );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -219,8 +233,16 @@ DaqAdministration::DaqAdministration( DaqAccess* poEbAccess,
                                     )
    :DaqInterface( poEbAccess, doReset, doSendCommand )
    ,m_poBlockBuffer( nullptr )
+   ,m_poCurrentBlock( nullptr )
+   ,m_drainBlockBudget( c_defaultDrainBlockBudget )
+   ,m_oBlockArena( c_blockBufferLen )
+   ,m_currentWordLen( 0 )
    ,m_maxChannels( 0 )
    ,m_receiveCount( 0 )
+   ,m_crcErrorCount( 0 )
+   ,m_isCrcCheckEnabled( false )
+   ,m_lastCrcErrorReportTime( 0 )
+   ,m_poRecorder( nullptr )
 #ifdef CONFIG_DEBUG_MESSAGES
    ,m_dbgIsFirstCall( true )
 #endif
@@ -229,8 +251,10 @@ DaqAdministration::DaqAdministration( DaqAccess* poEbAccess,
 #endif
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
-   m_poBlockBuffer = new BLOCK_BUFFER_T;
-   ::memset( m_poBlockBuffer, 0, sizeof( BLOCK_BUFFER_T ) );
+   m_poBlockBuffer = reinterpret_cast<BLOCK_BUFFER_T*>(m_oBlockArena.acquire());
+   m_poCurrentBlock = m_poBlockBuffer;
+   updateDispatchTable();
+   setRecorder( nullptr );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -238,11 +262,12 @@ DaqAdministration::DaqAdministration( DaqAccess* poEbAccess,
 DaqAdministration::~DaqAdministration( void )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
-   if( m_poBlockBuffer != nullptr )
-      delete m_poBlockBuffer;
 
-   //for( const auto& dev: *this )
-   //   unregisterDevice( dev );
+   /*
+    * The devices may survive this object.
+    */
+   for( const auto& dev: *this )
+      dev->m_pParent = nullptr;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -289,6 +314,7 @@ bool DaqAdministration::registerDevice( DaqDevice* pDevice )
    m_maxChannels          += pDevice->m_maxChannels;
    pDevice->m_pParent     = this;
    m_devicePtrList.push_back( pDevice );
+   updateDispatchTable();
    pDevice->init();
    pDevice->m_deviceTyp = readDeviceType( pDevice->m_deviceNumber );
 
@@ -302,8 +328,11 @@ bool DaqAdministration::unregisterDevice( DaqDevice* pDevice )
    if( pDevice->m_pParent != this )
       return true;
 
+   m_devicePtrList.remove( pDevice );
+   m_maxChannels -= pDevice->m_maxChannels;
    pDevice->m_pParent = nullptr;
    pDevice->m_deviceTyp = UNKNOWN;
+   updateDispatchTable();
    return false;
 }
 
@@ -317,6 +346,7 @@ int DaqAdministration::redistributeSlotNumbers( void )
       {
          i->m_slot = 0; // Invalidate slot number
       }
+      updateDispatchTable();
       return getLastReturnCode();
    }
 
@@ -324,6 +354,7 @@ int DaqAdministration::redistributeSlotNumbers( void )
    {
       i->m_slot = getSlotNumber( i->m_deviceNumber );
    }
+   updateDispatchTable();
 
    return getLastReturnCode();
 }
@@ -414,11 +445,44 @@ DaqAdministration::getChannelBySlotNumber( const uint slotNumber,
    if( channelNumber > c_maxChannels )
       return nullptr;
 
-   DaqDevice* poDevice = getDeviceBySlot( slotNumber );
-   if( poDevice == nullptr )
-      return nullptr;
+   return m_dispatchTable[slotNumber-1][channelNumber-1];
+}
 
-   return poDevice->getChannel( channelNumber );
+/*! ---------------------------------------------------------------------------
+ */
+void DaqAdministration::updateDispatchTable( void )
+{
+   for( uint slot = 0; slot < c_maxSlots; slot++ )
+      for( uint channel = 0; channel < c_maxChannels; channel++ )
+         m_dispatchTable[slot][channel] = nullptr;
+
+   for( const auto& pDevice: m_devicePtrList )
+   {
+      /*
+       * Unregistered devices and devices with invalidated slot number
+       * don't receive any data.
+       */
+      if( (pDevice->m_pParent != this) ||
+          (pDevice->m_slot == 0) || (pDevice->m_slot > c_maxSlots) )
+         continue;
+
+      for( const auto& pChannel: *pDevice )
+      {
+         if( (pChannel->m_pParent != pDevice) ||
+             (pChannel->getNumber() == 0) ||
+             (pChannel->getNumber() > c_maxChannels) )
+            continue;
+
+         DaqChannel*& rpEntry =
+            m_dispatchTable[pDevice->m_slot-1][pChannel->getNumber()-1];
+         /*
+          * Like getDeviceBySlot() and DaqDevice::getChannel()
+          * the first registered object wins.
+          */
+         if( rpEntry == nullptr )
+            rpEntry = pChannel;
+      }
+   }
 }
 
 /*! ---------------------------------------------------------------------------
@@ -429,18 +493,125 @@ void DaqAdministration::onErrorDescriptor( const DAQ_DESCRIPTOR_T& roDescriptor
 }
 
 /*! ---------------------------------------------------------------------------
- * @see https://www-acc.gsi.de/wiki/bin/viewauth/Hardware/Intern/DataAquisitionMacrof%C3%BCrSCUSlaveBaugruppen#Die_CRC_Pr_252fsumme
  */
-uint16_t DaqAdministration::crcPolynom( uint16_t x )
+void DaqAdministration::onErrorCrc( void )
 {
-   return static_cast<uint16_t>(1 + x * x + x * x * x * x * x);
+   /*
+    * Rate limited, otherwise a CRC mismatch of each block would flood
+    * the output.
+    */
+   const USEC_T now = getSysMicrosecs();
+   if( (m_lastCrcErrorReportTime != 0) &&
+       ((now - m_lastCrcErrorReportTime) < c_crcErrorReportIntervalUs) )
+      return;
+
+   m_lastCrcErrorReportTime = now;
+   std::cerr << "CRC error in block of slot " << descriptorGetSlot()
+             << ", channel " << descriptorGetChannel() + 1
+             << "; rejected blocks since reset: " << m_crcErrorCount
+             << std::endl;
 }
 
 /*! ---------------------------------------------------------------------------
  */
-void DaqAdministration::onErrorCrc( void )
+void DaqAdministration::setDrainBlockBudget( const uint budget )
 {
-   //DEBUG_MESSAGE_M_FUNCTION( "" );
+   m_drainBlockBudget = std::max( budget, 1U );
+   /*
+    * Worst case in the batched mode: all blocks are long blocks.
+    */
+   m_oBlockArena.resize( (m_drainBlockBudget == 1)? c_blockBufferLen :
+                                         m_drainBlockBudget * c_ramBlockLongLen );
+   m_poBlockBuffer = reinterpret_cast<BLOCK_BUFFER_T*>(m_oBlockArena.acquire());
+   m_poCurrentBlock = m_poBlockBuffer;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool DaqAdministration::isDescriptorValid( void )
+{
+   return ::daqDescriptorVerifyMode( &m_poCurrentBlock->descriptor ) &&
+          gsi::isInRange( descriptorGetSlot(),
+                          static_cast<uint>(Bus::SCUBUS_START_SLOT),
+                          static_cast<uint>(Bus::MAX_SCU_SLAVES) ) &&
+          isDevicePresent( descriptorGetSlot() ) &&
+          ( descriptorGetChannel() < DaqDevice::MAX_CHANNELS );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void DaqAdministration::setRecorder( DaqRecorder* poRecorder )
+{
+   m_poRecorder = poRecorder;
+   for( uint slot = 0; slot < c_maxSlots; slot++ )
+      for( uint channel = 0; channel < c_maxChannels; channel++ )
+         m_recordChannel[slot][channel] = -1;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void DaqAdministration::recordBlock( const std::size_t wordLen )
+{
+   const uint slot    = descriptorGetSlot();
+   const uint channel = descriptorGetChannel();
+   if( (slot == 0) || (slot > c_maxSlots) || (channel >= c_maxChannels) )
+      return;
+
+   int& rRecordChannel = m_recordChannel[slot-1][channel];
+   if( rRecordChannel < 0 )
+      rRecordChannel = m_poRecorder->addChannel( DAQ_REC_KIND_ADDAC_DAQ,
+                                          makeRecordAddacName( slot, channel + 1 ) );
+
+   m_poRecorder->writeAddacBlock( rRecordChannel, m_poCurrentBlock->descriptor,
+                                  &m_poCurrentBlock->buffer[c_discriptorWordSize],
+                                  wordLen );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void DaqAdministration::dispatchBlock( const std::size_t wordLen )
+{
+   m_currentWordLen = wordLen;
+
+   /*
+    * The payload follows the descriptor, so the whole block becomes
+    * checked in one pass. Rejected blocks are neither counted as
+    * received nor recorded.
+    * See: daq_crc.hpp
+    */
+   if( m_isCrcCheckEnabled &&
+       (daqDescriptorGetCRC( &m_poCurrentBlock->descriptor ) !=
+        daqBlockCrc( m_poCurrentBlock->buffer, wordLen )) )
+   {
+      m_crcErrorCount++;
+      onErrorCrc();
+      return;
+   }
+
+   m_receiveCount++;
+
+   if( m_poRecorder != nullptr )
+      recordBlock( wordLen );
+
+#ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
+   /*
+    * For statistics only.
+    */
+   onIncomingDescriptor( m_poCurrentBlock->descriptor );
+#endif
+
+   DaqChannel* pChannel = getChannelByDescriptor();
+
+   if( pChannel != nullptr )
+   {
+      pChannel->verifySequence();
+      pChannel->onDataBlock( &m_poCurrentBlock->buffer[c_discriptorWordSize], wordLen );
+   }
+   else
+   {
+      readLastStatus();
+      onUnregistered( m_poCurrentBlock->descriptor );
+   }
 }
 
 /*! ---------------------------------------------------------------------------
@@ -454,7 +625,15 @@ uint DaqAdministration::distributeData( void )
       DEBUG_MESSAGE_M_FUNCTION( "" );
    }
 #endif
-   assert( m_poBlockBuffer != nullptr );
+   if( m_drainBlockBudget > 1 )
+      return distributeDataBatched();
+
+   /*
+    * The previous block could still be referenced by a DaqBlockView.
+    */
+   m_poBlockBuffer = reinterpret_cast<BLOCK_BUFFER_T*>(m_oBlockArena.acquire());
+   m_poCurrentBlock = m_poBlockBuffer;
+
    /*
     * Getting the number of DDR3 memory items which has to be copied
     * in the m_poBlockBuffer buffer.
@@ -475,7 +654,7 @@ uint DaqAdministration::distributeData( void )
    }
 
 #ifdef CONFIG_DAQ_DEBUG
-   ::memset( &m_poBlockBuffer, 0x7f, sizeof( BLOCK_BUFFER_T ) );
+   ::memset( m_poBlockBuffer, 0x7f, sizeof( BLOCK_BUFFER_T ) );
 #endif
 
 #ifdef CONFIG_DAQ_TIME_MEASUREMENT
@@ -485,8 +664,11 @@ uint DaqAdministration::distributeData( void )
    /*
     * Copying via wishbone/etherbone the DDR3-RAM data in the middle buffer.
     * This occupies the wishbone/etherbone bus!
+    * If the LM32 has overwritten the data meanwhile, so the overrun
+    * becomes reported by the next updateMemAdmin().
     */
-   readDaqData( &m_poBlockBuffer->ramItems[0], c_ramBlockShortLen );
+   if( !readDaqData( &m_poBlockBuffer->ramItems[0], c_ramBlockShortLen ) )
+      return toRead;
 
 #ifdef CONFIG_DAQ_TIME_MEASUREMENT
    m_elapsedTime = std::max( getSysMicrosecs() - startTime, m_elapsedTime );
@@ -494,13 +676,7 @@ uint DaqAdministration::distributeData( void )
    /*
     * Rough check of the device descriptors integrity.
     */
-   if( !::daqDescriptorVerifyMode( &m_poBlockBuffer->descriptor ) ||
-       !gsi::isInRange( descriptorGetSlot(),
-                        static_cast<uint>(Bus::SCUBUS_START_SLOT),
-                        static_cast<uint>(Bus::MAX_SCU_SLAVES) ) ||
-       !isDevicePresent( descriptorGetSlot() ) ||
-       ( descriptorGetChannel() >= DaqDevice::MAX_CHANNELS )
-     )
+   if( !isDescriptorValid() )
    {
       sendWasRead( c_ramBlockShortLen );
       onErrorDescriptor( m_poBlockBuffer->descriptor );
@@ -517,15 +693,20 @@ uint DaqAdministration::distributeData( void )
       * Long block has been detected, (high resolution or post mortem)
       * in this case the rest of the data has still to be read
       * from the DAQ-Ram-buffer.
+      * The whole block becomes acknowledged not until the LM32 indexes
+      * has been checked, so overwritten data will not dispatched and
+      * the overrun becomes reported by the next updateMemAdmin().
       */
    #ifdef CONFIG_DAQ_TIME_MEASUREMENT
       startTime = getSysMicrosecs();
    #endif
-      readDaqData( &m_poBlockBuffer->ramItems[c_ramBlockShortLen],
-                   c_ramBlockLongLen - c_ramBlockShortLen );
+      const bool isValid = readDaqData( &m_poBlockBuffer->ramItems[c_ramBlockShortLen],
+                                        c_ramBlockLongLen - c_ramBlockShortLen );
    #ifdef CONFIG_DAQ_TIME_MEASUREMENT
       m_elapsedTime = std::max( getSysMicrosecs() - startTime, m_elapsedTime );
    #endif
+      if( !isValid )
+         return toRead;
       sendWasRead( c_ramBlockLongLen );
       wordLen = c_hiresPmDataLen - c_discriptorWordSize;
    }
@@ -538,47 +719,128 @@ uint DaqAdministration::distributeData( void )
       wordLen = c_contineousDataLen - c_discriptorWordSize;
    }
 
-   /*
-    *  See: https://www-acc.gsi.de/wiki/bin/viewauth/Hardware/Intern/DataAquisitionMacrof%C3%BCrSCUSlaveBaugruppen#Die_CRC_Pr_252fsumme
-    * TODO It doesn't work yet! :-(
-    */
-   uint16_t crc = 0x001F;
-   for( uint i = c_discriptorWordSize; i < wordLen; i++ )
-   {
-      crc += crcPolynom( m_poBlockBuffer->buffer[i] );
-   }
-   for( uint i = 0; i < (c_discriptorWordSize-1); i++ )
-   {
-      crc += crcPolynom( m_poBlockBuffer->buffer[i] );
-   }
-   if( daqDescriptorGetCRC( &m_poBlockBuffer->descriptor ) != static_cast<uint8_t>(crc & 0x00FF) )
+   dispatchBlock( wordLen );
+
+   return getCurrentNumberOfData();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint DaqAdministration::distributeDataBatched( void )
+{
+   assert( m_oBlockArena.getChunkLen() >= m_drainBlockBudget * c_ramBlockLongLen );
+
+   const uint available = getNumberOfNewData();
+   if( available == 0 )
+      return available;
+
+   if( (available % c_ramBlockShortLen) != 0 )
    {
-      onErrorCrc();
+      DEBUG_MESSAGE( available << " items in ADDAC buffer not dividable by " << c_ramBlockShortLen );
+      onDataError();
+      return available;
    }
 
-   m_receiveCount++;
+   const uint toRead = std::min( available, static_cast<uint>(m_oBlockArena.getChunkLen()) );
 
-#ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
    /*
-    * For statistics only.
+    * The chunk of the previous call could still be referenced by
+    * a DaqBlockView.
     */
-   onIncomingDescriptor( m_poBlockBuffer->descriptor );
+   RAM_DAQ_PAYLOAD_T* pBatchBuffer = m_oBlockArena.acquire();
+
+#ifdef CONFIG_DAQ_TIME_MEASUREMENT
+   const USEC_T startTime = getSysMicrosecs();
 #endif
+   /*
+    * Copying all available blocks up to the budget, split in etherbone
+    * cycles of at most m_maxEbCycleDataLen items like the single block
+    * reading. This occupies the wishbone/etherbone bus!
+    * Nothing becomes acknowledged when the LM32 has overwritten the
+    * data meanwhile, the next updateMemAdmin() reports the overrun.
+    */
+   if( !readDaqData( pBatchBuffer, toRead ) )
+      return available;
 
-   DaqChannel* pChannel = getChannelByDescriptor();
+#ifdef CONFIG_DAQ_TIME_MEASUREMENT
+   m_elapsedTime = std::max( getSysMicrosecs() - startTime, m_elapsedTime );
+#endif
 
-   if( pChannel != nullptr )
+   /*
+    * First pass: Walking through the local copy and determining the
+    * number of complete blocks and the total amount of RAM items
+    * which can be acknowledged.
+    */
+   uint consumed = 0;
+   uint blocks   = 0;
+   bool descriptorError = false;
+   while( (consumed + c_ramBlockShortLen) <= toRead )
    {
-      pChannel->verifySequence();
-      pChannel->onDataBlock( &m_poBlockBuffer->buffer[c_discriptorWordSize], wordLen );
+      m_poCurrentBlock = reinterpret_cast<BLOCK_BUFFER_T*>(&pBatchBuffer[consumed]);
+      if( !isDescriptorValid() )
+      {
+         consumed += c_ramBlockShortLen;
+         descriptorError = true;
+         break;
+      }
+      const uint blockLen = ::daqDescriptorIsLongBlock( &m_poCurrentBlock->descriptor )?
+                                                   c_ramBlockLongLen : c_ramBlockShortLen;
+      if( (consumed + blockLen) > toRead )
+      { /*
+         * Incomplete long block at the end of the local copy,
+         * it will be handled by the next call.
+         */
+         break;
+      }
+      consumed += blockLen;
+      blocks++;
    }
-   else
+
+   /*
+    * Second pass: Distributing the complete blocks to its channels.
+    * Like in distributeData() a block whose callback function throws an
+    * exception counts as read, so it becomes not distributed twice.
+    */
+   uint offset = 0;
+   try
    {
-      readLastStatus();
-      onUnregistered( m_poBlockBuffer->descriptor );
+      for( uint i = 0; i < blocks; i++ )
+      {
+         m_poCurrentBlock = reinterpret_cast<BLOCK_BUFFER_T*>(&pBatchBuffer[offset]);
+         if( ::daqDescriptorIsLongBlock( &m_poCurrentBlock->descriptor ) )
+         {
+            offset += c_ramBlockLongLen;
+            dispatchBlock( c_hiresPmDataLen - c_discriptorWordSize );
+         }
+         else
+         {
+            offset += c_ramBlockShortLen;
+            dispatchBlock( c_contineousDataLen - c_discriptorWordSize );
+         }
+      }
+   }
+   catch( ... )
+   {  /*
+       * Acknowledging the blocks distributed so far including the
+       * failed one.
+       */
+      sendWasRead( offset );
+      throw;
    }
 
-   return getCurrentNumberOfData();
+   /*
+    * Acknowledging all blocks by a single write access.
+    */
+   if( consumed > 0 )
+      sendWasRead( consumed );
+
+   if( descriptorError )
+   {
+      m_poCurrentBlock = reinterpret_cast<BLOCK_BUFFER_T*>(&pBatchBuffer[offset]);
+      onErrorDescriptor( m_poCurrentBlock->descriptor );
+   }
+
+   return available - consumed;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -29,7 +29,11 @@
 #define _DAQ_ADMINISTRATION_HPP
 
 #include <list>
+#include <vector>
 #include <daq_interface.hpp>
+#include <daq_crc.hpp>
+#include <daq_block_arena.hpp>
+#include <daq_recorder.hpp>
 namespace Scu
 {
 namespace daq
@@ -404,6 +408,19 @@ public:
     */
    uint descriptorGetTimeBase( void );
 
+   /*!
+    * @ingroup onDataBlock
+    * @brief Returns a reference counted view of the currently received
+    *        block, descriptor and payload.
+    *
+    * Keeping the view instead of copying the payload data keeps the
+    * receive buffer alive beyond the callback function onDataBlock().
+    * @note This function can only be used within the validity range
+    *       of the callback function DaqChannel::onDataBlock!
+    * @see DaqAdministration::getCurrentBlockView
+    */
+   DaqBlockView getBlockView( void );
+
    /*!
     * @ingroup onDataBlock
     * @brief Returns the pointer of the currently used sequence
@@ -606,6 +623,15 @@ public:
     */
    bool registerChannel( DaqChannel* pChannel );
 
+   /*!
+    * @ingroup REGISTRATION
+    * @brief Removes the given channel object from the internal list.
+    *
+    * Counterpart of registerChannel(), becomes invoked by the destructor
+    * of DaqChannel as well.
+    * @retval true No unregistering because object is not registered.
+    * @retval false Object successful unregistered.
+    */
    bool unregisterChannel( DaqChannel* pChannel );
 
    /*!
@@ -764,6 +790,7 @@ private:
 class DaqAdministration: public DaqInterface
 {
    friend class DaqChannel;
+   friend class DaqDevice;
 
    /*!
     * @brief Data type of a complete DAQ- block with the maximum possible length.
@@ -783,9 +810,93 @@ class DaqAdministration: public DaqInterface
                   "sizeof(BLOCK_BUFFER_T) has to be dividable by "
                   "sizeof(RAM_DAQ_PAYLOAD_T) !" );
 
+   /*!
+    * @brief Number of RAM items of BLOCK_BUFFER_T.
+    */
+   constexpr static std::size_t c_blockBufferLen =
+                               sizeof(BLOCK_BUFFER_T) / sizeof(RAM_DAQ_PAYLOAD_T);
+
+   /*!
+    * @brief Buffer for a single block, used by the legacy
+    *        one-block-per-call mode. It's the current chunk of
+    *        m_oBlockArena.
+    */
    BLOCK_BUFFER_T*   m_poBlockBuffer;
+
+   /*!
+    * @brief Pointer to the currently handled block.
+    *
+    * In the one-block-per-call mode it points to m_poBlockBuffer,
+    * in the batched mode it points to the concerning block within
+    * the current chunk of m_oBlockArena.
+    * All descriptor access functions refer to this pointer.
+    */
+   BLOCK_BUFFER_T*   m_poCurrentBlock;
+
+   /*!
+    * @brief Maximum number of blocks which becomes read and distributed
+    *        by one call of distributeData().
+    * @see setDrainBlockBudget
+    */
+   uint              m_drainBlockBudget;
+
+   /*!
+    * @brief Receive buffers of the DDR3- respectively SRAM- data.
+    *
+    * Each read access of distributeData() goes in one chunk: a single
+    * block in the one-block-per-call mode, up to m_drainBlockBudget
+    * blocks in the batched mode.
+    * @see getCurrentBlockView
+    */
+   DaqBlockArena     m_oBlockArena;
+
+   /*!
+    * @brief Number of payload words of the currently handled block.
+    */
+   std::size_t       m_currentWordLen;
+
    uint              m_maxChannels;
    uint              m_receiveCount;
+
+   /*!
+    * @brief Number of blocks rejected because of a CRC error
+    *        since the last reset.
+    */
+   uint              m_crcErrorCount;
+
+   /*!
+    * @see setCrcCheck
+    */
+   bool              m_isCrcCheckEnabled;
+
+   /*!
+    * @brief Time of the last CRC error message of onErrorCrc().
+    */
+   USEC_T            m_lastCrcErrorReportTime;
+
+   /*!
+    * @brief Flat table of the registered DAQ channel objects indexed by
+    *        slot- and channel number minus one, so the demultiplexing
+    *        of a received block is a single indexed load.
+    *
+    * It mirrors the device- and channel lists and becomes rebuilt
+    * on each registering, unregistering and on redistributing of the
+    * slot numbers.
+    * @see updateDispatchTable
+    */
+   DaqChannel*       m_dispatchTable[c_maxSlots][c_maxChannels];
+
+   /*!
+    * @brief Optional recorder of all received blocks.
+    * @see setRecorder
+    */
+   DaqRecorder*      m_poRecorder;
+
+   /*!
+    * @brief Recorder channel numbers indexed like m_dispatchTable,
+    *        negative when not yet defined in the recorder.
+    */
+   int               m_recordChannel[c_maxSlots][c_maxChannels];
 #ifdef CONFIG_DEBUG_MESSAGES
    bool              m_dbgIsFirstCall;
 #endif
@@ -799,6 +910,18 @@ protected:
    DEVICE_LIST_T  m_devicePtrList;
 
 public:
+   /*!
+    * @brief Default block budget of distributeData():
+    *        one block per call, that is the legacy behavior.
+    */
+   constexpr static uint c_defaultDrainBlockBudget = 1;
+
+   /*!
+    * @brief Minimum time in microseconds between two CRC error messages
+    *        of the default implementation of onErrorCrc().
+    */
+   constexpr static USEC_T c_crcErrorReportIntervalUs = 1000000;
+
    DaqAdministration( EBC_PTR_T poEtherbone,
                       const bool doReset = true,
                       const bool doSendCommand = true
@@ -848,13 +971,118 @@ public:
     }
 #endif
 
+   /*!
+    * @brief Sets respectively removes by nullptr a recorder, which
+    *        becomes fed with each received block before the CRC check.
+    *
+    * The blocks of all channels become recorded, registered or not,
+    * so that the recording can be replayed unchanged.
+    * @note The recorder is not owned by this object.
+    */
+   void setRecorder( DaqRecorder* poRecorder );
+
+   /*!
+    * @brief Returns the recorder or nullptr when not recording.
+    */
+   DaqRecorder* getRecorder( void )
+   {
+      return m_poRecorder;
+   }
+
    /*!
     * @brief Resets all existing DAQ's in this SCU.
     */
    void sendReset( void )
    {
       DaqInterface::sendReset();
-      m_receiveCount = 0;
+      m_receiveCount  = 0;
+      m_crcErrorCount = 0;
+   }
+
+   /*!
+    * @brief Enables or disables the CRC check of the received blocks.
+    *
+    * When enabled, blocks with a wrong CRC become rejected:
+    * onErrorCrc() becomes invoked instead of DaqChannel::onDataBlock().
+    * @note Disabled by default, the CRC formula of daq_crc.hpp is
+    *       verified by the simulator only, not yet by blocks captured
+    *       from a real SCU.
+    */
+   void setCrcCheck( const bool enable = true )
+   {
+      m_isCrcCheckEnabled = enable;
+   }
+
+   /*!
+    * @brief Returns true if the CRC check is enabled.
+    * @see setCrcCheck
+    */
+   bool isCrcCheckEnabled( void ) const
+   {
+      return m_isCrcCheckEnabled;
+   }
+
+   /*!
+    * @brief Returns the number of blocks rejected because of a CRC error
+    *        after the last reset.
+    * @see setCrcCheck
+    */
+   uint getCrcErrorCount( void ) const
+   {
+      return m_crcErrorCount;
+   }
+
+   /*!
+    * @brief Sets the maximum number of blocks which becomes read and
+    *        distributed by a single call of distributeData().
+    *
+    * A value greater than one activates the batched mode: All complete
+    * blocks which are present in the DDR3-RAM respectively SRAM
+    * up to this budget becomes copied, split in etherbone cycles by
+    * setMaxEbCycleDataLen() with pauses of onDataReadingPause() in
+    * between. The descriptors becomes evaluated in the local copy and,
+    * after distributing, the whole amount becomes acknowledged by a
+    * single sendWasRead(). If a callback function throws an exception,
+    * the blocks distributed before including the failed one become
+    * acknowledged, like in the one-block-per-call mode.
+    * @note The value of zero will be treated as one.
+    * @param budget Maximum number of blocks per call of distributeData().
+    */
+   void setDrainBlockBudget( const uint budget = c_defaultDrainBlockBudget );
+
+   /*!
+    * @brief Returns the maximum number of blocks per call of
+    *        distributeData().
+    * @see setDrainBlockBudget
+    */
+   uint getDrainBlockBudget( void ) const
+   {
+      return m_drainBlockBudget;
+   }
+
+   /*!
+    * @ingroup onDataBlock
+    * @brief Returns a reference counted view of the currently handled
+    *        block, which stays valid beyond the callback function
+    *        DaqChannel::onDataBlock() without copying the data.
+    * @note This function can only be used within the validity range
+    *       of the callback function DaqChannel::onDataBlock!
+    * @see DaqChannel::getBlockView
+    */
+   DaqBlockView getCurrentBlockView( void ) const
+   {
+      return DaqBlockView( m_oBlockArena.getCurrentChunk(),
+                           m_poCurrentBlock->buffer, m_currentWordLen );
+   }
+
+   /*!
+    * @brief Returns the number of receive buffers (chunks) of the
+    *        block arena, this number grows when block views are kept.
+    * @see getCurrentBlockView
+    */
+   std::size_t getNumberOfBlockBuffers( void ) const
+   {
+      return m_oBlockArena.getNumberOfChunks();
    }
 
    /*!
@@ -892,6 +1120,15 @@ public:
     */
    bool registerDevice( DaqDevice* pDevice );
 
+   /*!
+    * @ingroup REGISTRATION
+    * @brief Removes the given device object from the internal list.
+    *
+    * Counterpart of registerDevice(), becomes invoked by the destructor
+    * of DaqDevice as well.
+    * @retval true No unregistering because object is not registered.
+    * @retval false Object successful unregistered.
+    */
    bool unregisterDevice( DaqDevice* pDevice );
 
    /*!
@@ -989,7 +1226,7 @@ public:
     */
    uint32_t descriptorGetTriggerCondition( void )
    {
-      return daqDescriptorGetTriggerCondition( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetTriggerCondition( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1001,7 +1238,7 @@ public:
     */
    DAQ_REGISTER_T descriptorGetTriggerDelay( void )
    {
-      return daqDescriptorGetTriggerDelay( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetTriggerDelay( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1012,7 +1249,7 @@ public:
     */
    uint8_t descriptorGetSequence( void )
    {
-      return daqDescriptorGetSequence( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetSequence( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1023,7 +1260,7 @@ public:
     */
    uint8_t descriptorGetCrc( void )
    {
-      return daqDescriptorGetCRC( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetCRC( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1034,7 +1271,7 @@ public:
     */
    bool descriptorWasPostMortem( void )
    {
-      return daqDescriptorWasPM( &m_poBlockBuffer->descriptor );
+      return daqDescriptorWasPM( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1045,7 +1282,7 @@ public:
     */
    bool descriptorWasHighResolution( void )
    {
-      return daqDescriptorWasHiRes( &m_poBlockBuffer->descriptor );
+      return daqDescriptorWasHiRes( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1056,7 +1293,7 @@ public:
     */
    bool descriptorWasContinuous( void )
    {
-      return daqDescriptorWasDaq( &m_poBlockBuffer->descriptor );
+      return daqDescriptorWasDaq( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1068,7 +1305,7 @@ public:
     */
    uint64_t descriptorGetTimeStamp( void )
    {
-      return daqDescriptorGetTimeStamp( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetTimeStamp( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1079,7 +1316,7 @@ public:
     */
    uint descriptorGetTimeBase( void )
    {
-      return daqDescriptorGetTimeBase( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetTimeBase( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1097,7 +1334,7 @@ public:
     */
    uint descriptorGetSlot( void )
    {
-      return daqDescriptorGetSlot( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetSlot( &m_poCurrentBlock->descriptor );
    }
 
    /*!
@@ -1106,7 +1343,7 @@ public:
     */
    uint descriptorGetChannel( void )
    {
-      return daqDescriptorGetChannel( &m_poBlockBuffer->descriptor );
+      return daqDescriptorGetChannel( &m_poCurrentBlock->descriptor );
    }
 
 protected:
@@ -1114,6 +1351,11 @@ protected:
    /*!
     * @ingroup onDataBlock
     * @brief Optionel callback function becones invoked if a crc error had detected.
+    *
+    * The descriptor access functions refer to the rejected block.
+    * The default implementation prints a message on stderr, at most
+    * once per c_crcErrorReportIntervalUs.
+    * @see setCrcCheck
     */
    virtual void onErrorCrc( void );
 
@@ -1123,16 +1365,42 @@ protected:
    virtual void onUnregistered( DAQ_DESCRIPTOR_T& roDescriptor ) {}
 
 private:
+   /*!
+    * @brief Batched variant of distributeData().
+    * @see setDrainBlockBudget
+    */
+   uint distributeDataBatched( void );
+
+   /*!
+    * @brief Rough check of the device descriptors integrity of the
+    *        currently handled block.
+    */
+   bool isDescriptorValid( void );
+
+   /*!
+    * @brief Checks the CRC of the currently handled block and
+    *        passes it to the concerning channel object.
+    * @param wordLen Number of received payload data words without descriptor.
+    */
+   void dispatchBlock( const std::size_t wordLen );
+
+   /*!
+    * @brief Hands the currently handled block over to the recorder.
+    * @param wordLen Number of received payload data words without descriptor.
+    */
+   void recordBlock( const std::size_t wordLen );
+
+   /*!
+    * @brief Rebuilds the dispatch table from the device- and channel lists.
+    * @see m_dispatchTable
+    */
+   void updateDispatchTable( void );
+
    DaqChannel* getChannelByDescriptor( void )
    {
       return getChannelBySlotNumber( descriptorGetSlot(),
                                      descriptorGetChannel() + 1 );
    }
-
-   /*!
-    * @brief Calculates the 16-bit value of the CRC polynom: y = 1 + x^2 + x^5
-    */
-   uint16_t crcPolynom( uint16_t x );
 }; // class DaqAdministration
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1480,6 +1748,13 @@ inline uint64_t DaqChannel::descriptorGetTimeStamp( void )
    return getParent()->getParent()->descriptorGetTimeStamp();
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+inline DaqBlockView DaqChannel::getBlockView( void )
+{
+   return getParent()->getParent()->getCurrentBlockView();
+}
+
 /*! ---------------------------------------------------------------------------
  */
 inline uint DaqChannel::descriptorGetTimeBase( void )
@@ -0,0 +1,239 @@
+/*!
+ *  @file daq_block_arena.hpp
+ *  @brief Pool of receive buffers for ADDAC/ACU-DAQ blocks and
+ *         reference counted views into it.
+ *
+ * DaqAdministration reads the DDR3 respectively SRAM data directly in a
+ * chunk of the arena. A channel object which needs the data of a block
+ * beyond its callback function DaqChannel::onDataBlock() can keep a
+ * DaqBlockView instead of copying the payload. As long as a view of a
+ * chunk exists, the chunk will not overwritten by the next read access,
+ * the arena provides a further chunk instead.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _DAQ_BLOCK_ARENA_HPP
+#define _DAQ_BLOCK_ARENA_HPP
+
+#include <memory>
+#include <vector>
+#include <assert.h>
+#include <daq_ramBuffer.h>
+#include <daq_descriptor.h>
+
+namespace Scu
+{
+namespace daq
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*! ---------------------------------------------------------------------------
+ * @brief Pool of equal sized receive buffers (chunks).
+ *
+ * A chunk is free when it is referenced by the arena only.
+ * @note Not thread safe, the arena and all of its views have to be used
+ *       by the receiving thread only.
+ */
+class DaqBlockArena
+{
+public:
+   using CHUNK_T     = std::vector<RAM_DAQ_PAYLOAD_T>;
+   using CHUNK_PTR_T = std::shared_ptr<CHUNK_T>;
+
+private:
+   std::size_t              m_chunkLen;
+   std::vector<CHUNK_PTR_T> m_vChunks;
+   std::size_t              m_current;
+
+public:
+   /*!
+    * @brief Constructor
+    * @param chunkLen Number of RAM items of each chunk.
+    */
+   DaqBlockArena( const std::size_t chunkLen )
+      :m_chunkLen( 0 )
+      ,m_current( 0 )
+   {
+      resize( chunkLen );
+   }
+
+   /*!
+    * @brief Changes the chunk length.
+    *
+    * All chunks become released by the arena, chunks still referenced
+    * by views stay valid until the last view is gone.
+    */
+   void resize( const std::size_t chunkLen )
+   {
+      assert( chunkLen > 0 );
+      m_chunkLen = chunkLen;
+      m_vChunks.clear();
+      m_vChunks.push_back( std::make_shared<CHUNK_T>( m_chunkLen ) );
+      m_current = 0;
+   }
+
+   /*!
+    * @brief Returns the number of RAM items of each chunk.
+    */
+   std::size_t getChunkLen( void ) const
+   {
+      return m_chunkLen;
+   }
+
+   /*!
+    * @brief Returns the number of chunks, free or referenced.
+    */
+   std::size_t getNumberOfChunks( void ) const
+   {
+      return m_vChunks.size();
+   }
+
+   /*!
+    * @brief Makes a free chunk to the current chunk and returns its
+    *        start address.
+    *
+    * That is the current chunk when it isn't referenced by any view,
+    * otherwise a other free chunk or a new one.
+    */
+   RAM_DAQ_PAYLOAD_T* acquire( void )
+   {
+      if( !isFree( m_current ) )
+      {
+         m_current = 0;
+         while( (m_current < m_vChunks.size()) && !isFree( m_current ) )
+            m_current++;
+
+         if( m_current == m_vChunks.size() )
+            m_vChunks.push_back( std::make_shared<CHUNK_T>( m_chunkLen ) );
+      }
+      return m_vChunks[m_current]->data();
+   }
+
+   /*!
+    * @brief Returns the current chunk, that is the chunk returned
+    *        by the last call of acquire().
+    */
+   const CHUNK_PTR_T& getCurrentChunk( void ) const
+   {
+      return m_vChunks[m_current];
+   }
+
+private:
+   bool isFree( const std::size_t i ) const
+   {
+      return m_vChunks[i].use_count() == 1;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*! ---------------------------------------------------------------------------
+ * @brief Reference counted view of a single ADDAC/ACU-DAQ block
+ *        within a chunk of DaqBlockArena.
+ *
+ * An empty view, e.g. a default constructed one, doesn't refer to any block.
+ */
+class DaqBlockView
+{
+   DaqBlockArena::CHUNK_PTR_T m_poChunk;
+   const DAQ_DATA_T*          m_pBlock;
+   std::size_t                m_wordLen;
+
+public:
+   DaqBlockView( void )
+      :m_pBlock( nullptr )
+      ,m_wordLen( 0 )
+   {
+   }
+
+   /*!
+    * @brief Constructor
+    * @param rpChunk Chunk which contains the block.
+    * @param pBlock Start address of the block, that is the descriptor.
+    * @param wordLen Number of payload words following the descriptor.
+    */
+   DaqBlockView( const DaqBlockArena::CHUNK_PTR_T& rpChunk,
+                 const DAQ_DATA_T* pBlock, const std::size_t wordLen )
+      :m_poChunk( rpChunk )
+      ,m_pBlock( pBlock )
+      ,m_wordLen( wordLen )
+   {
+      assert( reinterpret_cast<const void*>(pBlock) >=
+              reinterpret_cast<const void*>(rpChunk->data()) );
+      assert( reinterpret_cast<const void*>(&pBlock[DAQ_DESCRIPTOR_WORD_SIZE + wordLen]) <=
+              reinterpret_cast<const void*>(rpChunk->data() + rpChunk->size()) );
+   }
+
+   /*!
+    * @brief Returns true if this view doesn't refer to a block.
+    */
+   bool empty( void ) const
+   {
+      return m_pBlock == nullptr;
+   }
+
+   /*!
+    * @brief Releases the reference to the block.
+    */
+   void release( void )
+   {
+      m_poChunk.reset();
+      m_pBlock  = nullptr;
+      m_wordLen = 0;
+   }
+
+   /*!
+    * @brief Returns the device descriptor of the block.
+    */
+   const DAQ_DESCRIPTOR_T& getDescriptor( void ) const
+   {
+      assert( !empty() );
+      return *reinterpret_cast<const DAQ_DESCRIPTOR_T*>(m_pBlock);
+   }
+
+   /*!
+    * @brief Returns the start address of the payload words.
+    */
+   const DAQ_DATA_T* getData( void ) const
+   {
+      assert( !empty() );
+      return &m_pBlock[DAQ_DESCRIPTOR_WORD_SIZE];
+   }
+
+   /*!
+    * @brief Returns the number of payload words.
+    */
+   std::size_t size( void ) const
+   {
+      return m_wordLen;
+   }
+
+   DAQ_DATA_T operator[]( const std::size_t i ) const
+   {
+      assert( i < m_wordLen );
+      return getData()[i];
+   }
+};
+
+} /* namespace daq */
+} /* namespace Scu */
+
+#endif /* ifndef _DAQ_BLOCK_ARENA_HPP */
+//================================== EOF ======================================
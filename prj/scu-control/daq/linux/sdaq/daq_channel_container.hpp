@@ -79,12 +79,16 @@ public:
    }
 
    virtual ~DaqChannelContainer( void )
-   {
-      for( auto& itDev: *this )
+   { /*
+      * The destructors of the channels and devices remove them from
+      * the lists, therefore the first object will deleted until empty.
+      */
+      while( !empty() )
       {
-         for( auto& itChannel: *itDev )
-            delete static_cast<CHANNEL_T*>(itChannel);
-         delete static_cast<DEVICE_T*>(itDev);
+         DEVICE_T* pDevice = static_cast<DEVICE_T*>(*begin());
+         while( !pDevice->empty() )
+            delete static_cast<CHANNEL_T*>(*pDevice->begin());
+         delete pDevice;
       }
    }
 
@@ -0,0 +1,196 @@
+/*!
+ *  @file daq_crc.hpp
+ *  @brief Calculation of the CRC check sum of ADDAC/ACU-DAQ data blocks.
+ *
+ * The check sum of a block is the low byte of the 16-bit sum over
+ * y = 1 + x^2 + x^5 of all payload words and of the descriptor words
+ * without the CRC register, beginning with the start value 0x1F.
+ *
+ * The kernel uses SSE2 respectively AVX2 on x86 processors, otherwise
+ * a scalar loop. The AVX2 variant becomes selected at runtime when the
+ * processor supports it.
+ *
+ * @see https://www-acc.gsi.de/wiki/bin/viewauth/Hardware/Intern/DataAquisitionMacrof%C3%BCrSCUSlaveBaugruppen#Die_CRC_Pr_252fsumme
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _DAQ_CRC_HPP
+#define _DAQ_CRC_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <daq_descriptor.h>
+
+#if defined( __SSE2__ ) && !defined( CONFIG_DAQ_CRC_NO_SIMD )
+   #define _DAQ_CRC_USE_SSE2
+   #include <immintrin.h>
+   #ifdef __GNUC__
+      #define _DAQ_CRC_USE_AVX2
+   #endif
+#endif
+
+namespace Scu
+{
+namespace daq
+{
+
+/*!
+ * @brief Start value of the CRC summation.
+ */
+constexpr uint16_t DAQ_CRC_START_VALUE = 0x001F;
+
+/*! ---------------------------------------------------------------------------
+ * @brief Calculates the 16-bit value of the CRC polynom: y = 1 + x^2 + x^5
+ *
+ * All intermediate results are truncated to 16 bit, so the result is
+ * the same as in the 16-bit lanes of the SIMD variants.
+ */
+inline uint16_t daqCrcPolynom( const uint16_t x )
+{
+   const uint32_t x2 = (static_cast<uint32_t>(x) * x) & 0xFFFF;
+   const uint32_t x4 = (x2 * x2) & 0xFFFF;
+   return static_cast<uint16_t>(1 + x2 + x4 * x);
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Scalar reference of daqCrcSum().
+ */
+inline uint16_t daqCrcSumScalar( const DAQ_DATA_T* pData, const size_t len,
+                                 uint16_t sum = 0 )
+{
+   for( size_t i = 0; i < len; i++ )
+      sum += daqCrcPolynom( pData[i] );
+   return sum;
+}
+
+#ifdef _DAQ_CRC_USE_SSE2
+/*! ---------------------------------------------------------------------------
+ * @brief Adds the eight 16-bit lanes of v.
+ */
+inline uint16_t _daqCrcHorizontalSum( __m128i v )
+{
+   v = _mm_add_epi16( v, _mm_srli_si128( v, 8 ) );
+   v = _mm_add_epi16( v, _mm_srli_si128( v, 4 ) );
+   v = _mm_add_epi16( v, _mm_srli_si128( v, 2 ) );
+   return static_cast<uint16_t>(_mm_cvtsi128_si32( v ));
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief SSE2 variant of daqCrcSum(), eight words per step.
+ */
+inline uint16_t daqCrcSumSse2( const DAQ_DATA_T* pData, const size_t len,
+                               uint16_t sum = 0 )
+{
+   __m128i acc = _mm_setzero_si128();
+   size_t i = 0;
+   for( ; (i + 8) <= len; i += 8 )
+   {
+      const __m128i x  = _mm_loadu_si128( reinterpret_cast<const __m128i*>(&pData[i]) );
+      const __m128i x2 = _mm_mullo_epi16( x, x );
+      const __m128i x4 = _mm_mullo_epi16( x2, x2 );
+      acc = _mm_add_epi16( acc, _mm_add_epi16( x2, _mm_mullo_epi16( x4, x ) ) );
+   }
+   /*
+    * The constant term 1 of each of the i words.
+    */
+   sum += static_cast<uint16_t>(_daqCrcHorizontalSum( acc ) + i);
+   return daqCrcSumScalar( &pData[i], len - i, sum );
+}
+#endif /* ifdef _DAQ_CRC_USE_SSE2 */
+
+#ifdef _DAQ_CRC_USE_AVX2
+/*! ---------------------------------------------------------------------------
+ * @brief AVX2 variant of daqCrcSum(), sixteen words per step.
+ * @note The caller has to ensure that the processor supports AVX2.
+ */
+__attribute__((target("avx2")))
+inline uint16_t daqCrcSumAvx2( const DAQ_DATA_T* pData, const size_t len,
+                               uint16_t sum = 0 )
+{
+   __m256i acc = _mm256_setzero_si256();
+   size_t i = 0;
+   for( ; (i + 16) <= len; i += 16 )
+   {
+      const __m256i x  = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(&pData[i]) );
+      const __m256i x2 = _mm256_mullo_epi16( x, x );
+      const __m256i x4 = _mm256_mullo_epi16( x2, x2 );
+      acc = _mm256_add_epi16( acc, _mm256_add_epi16( x2, _mm256_mullo_epi16( x4, x ) ) );
+   }
+   const __m128i acc128 = _mm_add_epi16( _mm256_castsi256_si128( acc ),
+                                         _mm256_extracti128_si256( acc, 1 ) );
+   sum += static_cast<uint16_t>(_daqCrcHorizontalSum( acc128 ) + i);
+   return daqCrcSumScalar( &pData[i], len - i, sum );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns true if the processor supports AVX2, the query becomes
+ *        made once only.
+ */
+inline bool _daqCrcHasAvx2( void )
+{
+   static const bool hasAvx2 = __builtin_cpu_supports( "avx2" );
+   return hasAvx2;
+}
+#endif /* ifdef _DAQ_CRC_USE_AVX2 */
+
+/*! ---------------------------------------------------------------------------
+ * @brief Adds y = 1 + x^2 + x^5 of all given words to sum,
+ *        using the fastest kernel supported by the processor.
+ * @param pData Start address of the 16-bit words, alignment doesn't matter.
+ * @param len Number of 16-bit words.
+ * @param sum Start value.
+ */
+inline uint16_t daqCrcSum( const DAQ_DATA_T* pData, const size_t len,
+                           const uint16_t sum = 0 )
+{
+#ifdef _DAQ_CRC_USE_AVX2
+   if( _daqCrcHasAvx2() )
+      return daqCrcSumAvx2( pData, len, sum );
+#endif
+#ifdef _DAQ_CRC_USE_SSE2
+   return daqCrcSumSse2( pData, len, sum );
+#else
+   return daqCrcSumScalar( pData, len, sum );
+#endif
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Calculates the CRC check sum of a block which begins with the
+ *        descriptor followed by the payload words.
+ * @param pBlock Start address of the block, that is the descriptor.
+ * @param payloadLen Number of payload words following the descriptor.
+ * @return CRC which has to be equal to daqDescriptorGetCRC().
+ */
+inline uint8_t daqBlockCrc( const DAQ_DATA_T* pBlock, const size_t payloadLen )
+{
+   uint16_t crc = daqCrcSum( &pBlock[DAQ_DESCRIPTOR_WORD_SIZE], payloadLen,
+                             DAQ_CRC_START_VALUE );
+   /*
+    * Descriptor without the last word, which contains the CRC.
+    */
+   crc = daqCrcSum( pBlock, DAQ_DESCRIPTOR_WORD_SIZE - 1, crc );
+   return static_cast<uint8_t>(crc & 0x00FF);
+}
+
+} /* namespace daq */
+} /* namespace Scu */
+
+#endif /* ifndef _DAQ_CRC_HPP */
+//================================== EOF ======================================
@@ -199,7 +199,8 @@ bool DaqInterface::isFgIntegrated( void ) const
 void DaqInterface::readSharedTotal( void )
 {
    initRingAdmin( &m_oSharedData.ringAdmin,
-                  getEbAccess()->getAddacDaqOffset() + offsetof( DAQ_SHARED_IO_T, ringAdmin ));
+                  getEbAccess()->getAddacDaqOffset() + offsetof( DAQ_SHARED_IO_T, ringAdmin ),
+                  DaqAccess::ADDAC_RING_SEQUENCE_OFFSET );
    DAQ_SHARED_IO_T temp;
    readLM32( &temp, sizeof(DAQ_SHARED_IO_T) );
    CONV_ENDIAN( m_oSharedData, temp, magicNumber );
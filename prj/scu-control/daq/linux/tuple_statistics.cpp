@@ -72,7 +72,7 @@ void TupleStatistics::clear( void )
 
 /*!----------------------------------------------------------------------------
  */
-void TupleStatistics::add( FgFeedbackTuple* pChannel, const TUPLE_T& rTuple )
+void TupleStatistics::add( FgFeedbackChannel* pChannel, const TUPLE_T& rTuple )
 {
    for( auto& i: m_tupleList )
    {
@@ -123,6 +123,69 @@ void TupleStatistics::add( FgFeedbackTuple* pChannel, const TUPLE_T& rTuple )
    }
 }
 
+/*!----------------------------------------------------------------------------
+ */
+void TupleStatistics::add( FgFeedbackChannel* pChannel,
+                           const TIMESTAMP_SPAN_T& rTimestamps,
+                           const DAQ_SPAN_T& rActValues,
+                           const DAQ_SPAN_T& rSetValues )
+{
+   assert( rTimestamps.size() == rActValues.size() );
+   assert( rTimestamps.size() == rSetValues.size() );
+
+   if( rTimestamps.empty() )
+      return;
+
+   auto it = find_if( m_tupleList.begin(), m_tupleList.end(),
+                      [pChannel]( const TUPLE_ITEM_T& rItem ) -> bool
+                      {
+                         return rItem.m_pChannel == pChannel;
+                      });
+
+   std::size_t first = 0;
+   if( it == m_tupleList.end() )
+   { /*
+      * First tuple of this channel, it inserts the channel in the list.
+      */
+      add( pChannel, { .m_timestamp = rTimestamps[0],
+                       .m_actValue  = rActValues[0],
+                       .m_setValue  = rSetValues[0] } );
+      it = find_if( m_tupleList.begin(), m_tupleList.end(),
+                    [pChannel]( const TUPLE_ITEM_T& rItem ) -> bool
+                    {
+                       return rItem.m_pChannel == pChannel;
+                    });
+      assert( it != m_tupleList.end() );
+      first = 1;
+   }
+
+   const std::size_t len = rTimestamps.size();
+   if( first < len )
+   { /*
+      * Detecting whether a function generator has stopped:
+      * Only the run of equal set values at the end of the block
+      * is relevant for the stop counter.
+      */
+      const auto lastSetValue = rSetValues[len-1];
+      std::size_t i = len - 1;
+      while( (i > first) && (rSetValues[i-1] == lastSetValue) )
+         i--;
+
+      uint stopCount;
+      if( (i == first) && (it->m_oTuple.m_setValue == lastSetValue) )
+         stopCount = it->m_stopCount + (len - first);
+      else
+         stopCount = len - 1 - i;
+
+      it->m_stopCount = (stopCount < MAX_SET_CONSTANT_TIMES)?
+                                     stopCount : MAX_SET_CONSTANT_TIMES;
+      it->m_oTuple = { .m_timestamp = rTimestamps[len-1],
+                       .m_actValue  = rActValues[len-1],
+                       .m_setValue  = lastSetValue };
+      it->m_count += len - first;
+   }
+}
+
 /*!----------------------------------------------------------------------------
  */
 void TupleStatistics::print( void )
@@ -42,7 +42,9 @@ namespace Scu
 class TupleStatistics
 {
    static constexpr uint MAX_SET_CONSTANT_TIMES = 1000;
-   using TUPLE_T = FgFeedbackTuple::TUPLE_T;
+   using TUPLE_T          = FgFeedbackTuple::TUPLE_T;
+   using TIMESTAMP_SPAN_T = FgFeedbackChannel::TIMESTAMP_SPAN_T;
+   using DAQ_SPAN_T       = FgFeedbackChannel::DAQ_SPAN_T;
 
    class FrqencyAverage: public TAverageBuilder<uint>
    {
@@ -52,7 +54,7 @@ class TupleStatistics
    
    struct TUPLE_ITEM_T
    {
-      FgFeedbackTuple*  m_pChannel;
+      FgFeedbackChannel* m_pChannel;
       TUPLE_T           m_oTuple;
       uint              m_stopCount;
       uint              m_count;
@@ -77,7 +79,16 @@ public:
 
    void clear( void );
 
-   void add( FgFeedbackTuple* pChannel, const TUPLE_T& rTuple );
+   void add( FgFeedbackChannel* pChannel, const TUPLE_T& rTuple );
+
+   /*!
+    * @brief Takes a whole block of tuples in account, same result as
+    *        add() for each tuple, but without a per-tuple search.
+    */
+   void add( FgFeedbackChannel* pChannel,
+             const TIMESTAMP_SPAN_T& rTimestamps,
+             const DAQ_SPAN_T& rActValues,
+             const DAQ_SPAN_T& rSetValues );
 
    void print( void );
 };
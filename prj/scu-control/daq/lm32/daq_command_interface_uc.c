@@ -72,7 +72,7 @@ STATIC void printFunctionName( const char* str )
  */
 int initBuffer( RAM_SCU_T* poRam )
 {
-   return ramInit( poRam, &GET_SHARED().ringAdmin );
+   return ramInit( poRam, &GET_SHARED().ringAdmin, GET_RING_SEQUENCE() );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -154,7 +154,10 @@ DAQ_RETURN_CODE_T opReset( DAQ_ADMIN_T* pDaqAdmin,
 {
    DBG_FUNCTION_INFO();
    daqBusReset( &pDaqAdmin->oDaqDevs );
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( pDaqAdmin->oRam.pSharedObj );
    ramRingSharedReset( pDaqAdmin->oRam.pSharedObj );
+   ramRingSequenceUpdate( pDaqAdmin->oRam.pSequence, size,
+                          &pDaqAdmin->oRam.pSharedObj->indexes );
 #ifndef CONFIG_DAQ_SINGLE_APP
    resetAllActiveBySaftlib();
 #endif
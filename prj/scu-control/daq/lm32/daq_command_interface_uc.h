@@ -55,10 +55,12 @@ extern "C" {
 
 #ifdef CONFIG_DAQ_SINGLE_APP
    #define GET_SHARED() g_shared
+   #define GET_RING_SEQUENCE() NULL
 #endif
 #ifdef CONFIG_SCU_DAQ_INTEGRATION
    extern SCU_SHARED_DATA_T g_shared;
    #define GET_SHARED() g_shared.sDaq
+   #define GET_RING_SEQUENCE() (&g_shared.sdaqRingSequence)
 #endif
 
 
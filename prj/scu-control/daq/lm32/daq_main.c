@@ -31,6 +31,9 @@
 #ifdef CONFIG_DAQ_SINGLE_APP
  #include <lm32Interrupts.h>
 #endif
+#ifdef CONFIG_DAQ_SERVICE_BUDGET_US
+ #include <scu_wr_time.h>
+#endif
 
 #ifndef CONFIG_DAQ_SINGLE_APP
  extern void* g_pScub_base;
@@ -215,33 +218,56 @@ bool addacDaqQueuePop( SCU_BUS_IRQ_QUEUE_T* pQueueScuBusIrq )
 /*! ---------------------------------------------------------------------------
  * @ingroup DAQ
  * @ingroup TASK
- * @brief Non - blocking function. Handles all detected ADDAC-DAQs. One DAQ-channel per function call.
- * @see schedule
+ * @brief Copies a DAQ block of the given channel in the RAM buffer, if its
+ *        interrupt is pending.
+ * @param pChannel Pointer to the DAQ channel object.
+ * @param continuousPending Pending bits of the continuous mode of the device.
+ * @param highResPending Pending bits of the high resolution mode of the device.
  */
-void addacDaqTask( void )
+STATIC inline void daqServiceChannel( DAQ_CANNEL_T* pChannel,
+                                      const DAQ_REGISTER_T continuousPending,
+                                      const DAQ_REGISTER_T highResPending )
 {
-   FG_ASSERT( pThis->pTaskData == NULL );
-   if( daqBusGetFoundDevices( &g_scuDaqAdmin.oDaqDevs ) == 0 )
-   { /*
-      * Maybe only MIL-DAQs present.
-      */
-      return;
+   if( (continuousPending & pChannel->intMask) != 0 )
+   {
+   #ifdef CONFIG_DAQ_SW_SEQUENCE
+      pChannel->sequenceContinuous++;
+   #endif
+      if( daqChannelGetDaqFifoWords( pChannel ) == 0 )
+      {
+         DBPRINT1( ESC_BOLD ESC_FG_RED
+                   "DBG: WARNING: Discarding continuous block: "
+                   "Slot: %d, Channel: %d !\n" ESC_NORMAL,
+                   daqChannelGetSlot( pChannel ),
+                   daqChannelGetNumber( pChannel )
+                 );
+      }
+      else
+      {
+         ramPushDaqDataBlock( &g_scuDaqAdmin.oRam, pChannel, true );
+         daqChannelDecrementBlockCounter( pChannel );
+      }
    }
 
-   /*
-    * Removing old data which has been possibly read and evaluated by the
-    * Linux client
-    * NOTE: This has to be made in any cases here independently whether one or more
-    *       MIL FG are active or not.
-    *       Because only in this way it becomes possible to continuing the
-    *       handshake transfer at reading the possible remaining data from
-    *       the DDR3 memory by the Linux client.
-    * See daq_base_interface.cpp  function: DaqBaseInterface::getNumberOfNewData
-    * See daq_base_interface.cpp  function: DaqBaseInterface::sendWasRead
-    * See daq_administration.cpp  function: DaqAdministration::distributeData
-    */
-   ramRingSharedSynchonizeReadIndex( &GET_SHARED().ringAdmin );
+   if( (highResPending & pChannel->intMask) != 0 )
+   {
+      daqChannelDisableHighResolution( pChannel );
+   #ifdef CONFIG_DAQ_SW_SEQUENCE
+      pChannel->sequencePmHires++;
+   #endif
+      ramPushDaqDataBlock( &g_scuDaqAdmin.oRam, pChannel, false );
+   }
+}
 
+#ifndef CONFIG_DAQ_SERVICE_BUDGET_US
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Handles one DAQ-channel of the device of the oldest SCU-bus
+ *        interrupt per function call.
+ */
+STATIC inline void daqServiceNextChannel( void )
+{
    static DAQ_DEVICE_T* s_pDaqDevice  = NULL;
    static DAQ_REGISTER_T s_continuousPending;
    static DAQ_REGISTER_T s_highResPending;
@@ -272,37 +298,8 @@ void addacDaqTask( void )
    
    if( s_pDaqDevice != NULL )
    {
-      DAQ_CANNEL_T* pChannel = daqDeviceGetChannelObject( s_pDaqDevice, s_channelNumber );
-      
-      if( (s_continuousPending & pChannel->intMask) != 0 )
-      {
-      #ifdef CONFIG_DAQ_SW_SEQUENCE
-         pChannel->sequenceContinuous++;
-      #endif
-         if( daqChannelGetDaqFifoWords( pChannel ) == 0 )
-         {
-            DBPRINT1( ESC_BOLD ESC_FG_RED
-                      "DBG: WARNING: Discarding continuous block: "
-                      "Slot: %d, Channel: %d !\n" ESC_NORMAL,
-                      daqChannelGetSlot( pChannel ),
-                      daqChannelGetNumber( pChannel )
-                    );
-         }
-         else
-         {
-            ramPushDaqDataBlock( &g_scuDaqAdmin.oRam, pChannel, true );
-            daqChannelDecrementBlockCounter( pChannel );
-         }
-      }
-      
-      if( (s_highResPending & pChannel->intMask) != 0 )
-      {
-         daqChannelDisableHighResolution( pChannel );
-      #ifdef CONFIG_DAQ_SW_SEQUENCE
-         pChannel->sequencePmHires++;
-      #endif
-         ramPushDaqDataBlock( &g_scuDaqAdmin.oRam, pChannel, false );
-      }
+      daqServiceChannel( daqDeviceGetChannelObject( s_pDaqDevice, s_channelNumber ),
+                         s_continuousPending, s_highResPending );
 
       s_channelNumber++;
       if( s_channelNumber >= daqDeviceGetMaxChannels( s_pDaqDevice ) )
@@ -319,6 +316,256 @@ void addacDaqTask( void )
    }
 }
 
+#else /* ifndef CONFIG_DAQ_SERVICE_BUDGET_US */
+
+/*!
+ * @ingroup DAQ
+ * @brief Interrupt pending bits of a DAQ device which are not serviced yet.
+ */
+typedef struct
+{
+   DAQ_REGISTER_T continuous;
+   DAQ_REGISTER_T highRes;
+#ifdef CONFIG_SCUBUS_INT_RESET_AFTER__
+   /*!
+    * @brief SCU-bus interrupts to reset after servicing all channels.
+    */
+   uint16_t       irqsToReset;
+#endif
+} DAQ_PENDING_T;
+
+/*!
+ * @ingroup DAQ
+ * @brief Item of the service list of a sweep, sorted by the FiFo level.
+ */
+typedef struct
+{
+   DAQ_CANNEL_T*  pChannel;
+   unsigned int   deviceNumber;
+   DAQ_REGISTER_T level;
+} DAQ_SERVICE_ITEM_T;
+
+STATIC DAQ_PENDING_T      mg_aDaqPending[DAQ_MAX];
+STATIC DAQ_SERVICE_ITEM_T mg_aServiceList[DAQ_MAX * DAQ_MAX_CHANNELS];
+
+DAQ_SERVICE_STAT_T g_daqServiceStat;
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Takes the pending bits of all queued SCU-bus interrupts over
+ *        into mg_aDaqPending.
+ * @retval true At least one channel is pending.
+ */
+STATIC inline bool daqCollectPending( void )
+{
+   SCU_BUS_IRQ_QUEUE_T queueScuBusIrq;
+   while( addacDaqQueuePop( &queueScuBusIrq ) )
+   {
+      DAQ_DEVICE_T* pDaqDevice =
+         daqBusGetDeviceBySlotNumber( &g_scuDaqAdmin.oDaqDevs, queueScuBusIrq.slot );
+      if( pDaqDevice == NULL )
+         continue;
+
+      DAQ_PENDING_T* pPending = &mg_aDaqPending[pDaqDevice->n];
+      if( (queueScuBusIrq.pendingIrqs & (1 << DAQ_IRQ_DAQ_FIFO_FULL)) != 0 )
+      {
+         const DAQ_REGISTER_T pending = daqDeviceGetAndResetContinuousIntPendingBits( pDaqDevice );
+         pPending->continuous |= pending;
+      #ifdef CONFIG_SCUBUS_INT_RESET_AFTER__
+         if( pending != 0 )
+            pPending->irqsToReset |= (1 << DAQ_IRQ_DAQ_FIFO_FULL);
+      #endif
+      }
+      if( (queueScuBusIrq.pendingIrqs & (1 << DAQ_IRQ_HIRES_FINISHED)) != 0 )
+      {
+         const DAQ_REGISTER_T pending = daqDeviceGetAndResetHighresIntPendingBits( pDaqDevice );
+         pPending->highRes |= pending;
+      #ifdef CONFIG_SCUBUS_INT_RESET_AFTER__
+         if( pending != 0 )
+            pPending->irqsToReset |= (1 << DAQ_IRQ_HIRES_FINISHED);
+      #endif
+      }
+   }
+
+   for( unsigned int i = 0; i < daqBusGetFoundDevices( &g_scuDaqAdmin.oDaqDevs ); i++ )
+   {
+      if( (mg_aDaqPending[i].continuous | mg_aDaqPending[i].highRes) != 0 )
+         return true;
+   }
+   return false;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Builds the list of all pending channels, the fullest continuous
+ *        FiFo first. High resolution blocks follow the continuous blocks,
+ *        because their sampling is already stopped.
+ * @return Number of list items.
+ */
+STATIC inline unsigned int daqBuildServiceList( void )
+{
+   unsigned int n = 0;
+   for( unsigned int i = 0; i < daqBusGetFoundDevices( &g_scuDaqAdmin.oDaqDevs ); i++ )
+   {
+      const DAQ_PENDING_T* pPending = &mg_aDaqPending[i];
+      if( (pPending->continuous | pPending->highRes) == 0 )
+         continue;
+
+      DAQ_DEVICE_T* pDaqDevice = daqBusGetDeviceObject( &g_scuDaqAdmin.oDaqDevs, i );
+      for( unsigned int channelNumber = 0;
+           channelNumber < daqDeviceGetMaxChannels( pDaqDevice ); channelNumber++ )
+      {
+         DAQ_CANNEL_T* pChannel = daqDeviceGetChannelObject( pDaqDevice, channelNumber );
+         if( ((pPending->continuous | pPending->highRes) & pChannel->intMask) == 0 )
+            continue;
+
+         const DAQ_REGISTER_T level = ((pPending->continuous & pChannel->intMask) != 0)?
+                                       daqChannelGetDaqFifoWords( pChannel ) + 1 : 0;
+         /*
+          * Insertion sort, the list is short.
+          */
+         unsigned int j = n++;
+         while( (j > 0) && (mg_aServiceList[j-1].level < level) )
+         {
+            mg_aServiceList[j] = mg_aServiceList[j-1];
+            j--;
+         }
+         mg_aServiceList[j].pChannel     = pChannel;
+         mg_aServiceList[j].deviceNumber = i;
+         mg_aServiceList[j].level        = level;
+      }
+   }
+   return n;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Services the given channel and removes its pending bits.
+ */
+STATIC inline void daqServicePendingChannel( const DAQ_SERVICE_ITEM_T* pItem )
+{
+   DAQ_CANNEL_T*  pChannel = pItem->pChannel;
+   DAQ_PENDING_T* pPending = &mg_aDaqPending[pItem->deviceNumber];
+
+   daqServiceChannel( pChannel, pPending->continuous, pPending->highRes );
+   pPending->continuous &= ~pChannel->intMask;
+   pPending->highRes    &= ~pChannel->intMask;
+
+#ifdef CONFIG_SCUBUS_INT_RESET_AFTER__
+   if( ((pPending->continuous | pPending->highRes) != 0) || (pPending->irqsToReset == 0) )
+      return;
+   scuBusResetInterruptPendingFlags( g_pScub_base, daqChannelGetSlot( pChannel ),
+                                     pPending->irqsToReset );
+   pPending->irqsToReset = 0;
+#endif
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Services all pending channels, the fullest FiFo first, until all
+ *        are done or the budget of CONFIG_DAQ_SERVICE_BUDGET_US is exhausted.
+ *
+ * A sweep begins with the first pending channel and ends when no channel
+ * is pending anymore, so it can spread over several calls.
+ * @see DAQ_SERVICE_STAT_T
+ */
+STATIC inline void daqServiceBudgeted( void )
+{
+   if( !daqCollectPending() )
+      return;
+
+   const uint64_t start = getWrSysTimeSafe();
+   if( g_daqServiceStat.sweepStart == 0 )
+   {
+      g_daqServiceStat.sweepStart = start;
+      g_daqServiceStat.channels   = 0;
+   }
+
+   const unsigned int n = daqBuildServiceList();
+   for( unsigned int i = 0; i < n; i++ )
+   {
+      if( (i > 0) &&
+          ((getWrSysTimeSafe() - start) >= (CONFIG_DAQ_SERVICE_BUDGET_US * 1000ULL)) )
+      { /*
+         * Budget exhausted, the remaining channels become serviced in the
+         * next call after a new priority ranking.
+         */
+         g_daqServiceStat.yields++;
+         return;
+      }
+      daqServicePendingChannel( &mg_aServiceList[i] );
+      g_daqServiceStat.channels++;
+   }
+
+   if( daqCollectPending() )
+      return;
+
+   /*
+    * Sweep completed.
+    */
+   const uint32_t sweepTime =
+                  (uint32_t)((getWrSysTimeSafe() - g_daqServiceStat.sweepStart) / 1000);
+   g_daqServiceStat.sweepStart = 0;
+   g_daqServiceStat.sweeps++;
+   g_daqServiceStat.lastSweepTime = sweepTime;
+   if( sweepTime <= g_daqServiceStat.maxSweepTime )
+      return;
+
+   g_daqServiceStat.maxSweepTime = sweepTime;
+   lm32Log( LM32_LOG_DEBUG, ESC_DEBUG
+            "DAQ sweep: %u us, %u channels, %u yields, sweep %u" ESC_NORMAL,
+            sweepTime, g_daqServiceStat.channels,
+            g_daqServiceStat.yields, g_daqServiceStat.sweeps );
+}
+#endif /* else ifndef CONFIG_DAQ_SERVICE_BUDGET_US */
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @ingroup TASK
+ * @brief Non - blocking function. Handles all detected ADDAC-DAQs.
+ *
+ * One DAQ-channel per function call, or all pending channels within the
+ * time budget of CONFIG_DAQ_SERVICE_BUDGET_US if defined.
+ * @see schedule
+ */
+void addacDaqTask( void )
+{
+   FG_ASSERT( pThis->pTaskData == NULL );
+   if( daqBusGetFoundDevices( &g_scuDaqAdmin.oDaqDevs ) == 0 )
+   { /*
+      * Maybe only MIL-DAQs present.
+      */
+      return;
+   }
+
+   /*
+    * Removing old data which has been possibly read and evaluated by the
+    * Linux client
+    * NOTE: This has to be made in any cases here independently whether one or more
+    *       MIL FG are active or not.
+    *       Because only in this way it becomes possible to continuing the
+    *       handshake transfer at reading the possible remaining data from
+    *       the DDR3 memory by the Linux client.
+    * See daq_base_interface.cpp  function: DaqBaseInterface::getNumberOfNewData
+    * See daq_base_interface.cpp  function: DaqBaseInterface::sendWasRead
+    * See daq_administration.cpp  function: DaqAdministration::distributeData
+    * See circular_index.h         macro:    RAM_RING_PROTOCOL_FLAG
+    */
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( &GET_SHARED().ringAdmin );
+   ramRingSharedSynchonizeReadIndex( &GET_SHARED().ringAdmin );
+   ramRingSequenceUpdate( GET_RING_SEQUENCE(), size, &GET_SHARED().ringAdmin.indexes );
+
+#ifdef CONFIG_DAQ_SERVICE_BUDGET_US
+   daqServiceBudgeted();
+#else
+   daqServiceNextChannel();
+#endif
+}
+
 #endif /* ifndef CONFIG_DAQ_SINGLE_APP */
 
 /*================================= main ====================================*/
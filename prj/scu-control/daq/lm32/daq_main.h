@@ -60,11 +60,62 @@ typedef uint32_t DAQ_QUEUE_SLOT_T;
  */
 extern SW_QUEUE_T g_queueAddacDaq;
 
+#ifdef CONFIG_DAQ_SERVICE_BUDGET_US
+/*! ---------------------------------------------------------------------------
+ * @ingroup DAQ
+ * @brief Service statistics of addacDaqTask for tuning the budget
+ *        CONFIG_DAQ_SERVICE_BUDGET_US.
+ *
+ * A sweep begins with the first pending channel and ends when no channel
+ * is pending anymore. Each new maximum becomes logged by lm32Log.
+ */
+typedef struct
+{  /*!
+    * @brief White rabbit time of the begin of the running sweep,
+    *        zero when no sweep is running.
+    */
+   uint64_t sweepStart;
+
+   /*!
+    * @brief Duration of the last completed sweep in microseconds.
+    */
+   uint32_t lastSweepTime;
+
+   /*!
+    * @brief Longest sweep in microseconds.
+    */
+   uint32_t maxSweepTime;
+
+   /*!
+    * @brief Number of serviced channels of the running respectively
+    *        last sweep.
+    */
+   uint32_t channels;
+
+   /*!
+    * @brief Number of completed sweeps.
+    */
+   uint32_t sweeps;
+
+   /*!
+    * @brief Number of returns to the scheduler due to an exhausted budget.
+    */
+   uint32_t yields;
+} DAQ_SERVICE_STAT_T;
+
+/*!
+ * @ingroup DAQ
+ * @brief Service statistics of addacDaqTask.
+ */
+extern DAQ_SERVICE_STAT_T g_daqServiceStat;
+#endif
+
 /*! ---------------------------------------------------------------------------
  * @ingroup DAQ
  * @ingroup TASK
  * @brief Handles all detected ADDAC-DAQs
  * @see schedule
+ * @see CONFIG_DAQ_SERVICE_BUDGET_US
  */
 void addacDaqTask( void );
 
@@ -56,10 +56,14 @@
 /*! ---------------------------------------------------------------------------
  * @see scu_ramBuffer.h
  */
-int ramInit( RAM_SCU_T* pThis, RAM_RING_SHARED_INDEXES_T* pSharedObj )
+int ramInit( RAM_SCU_T* pThis, RAM_RING_SHARED_INDEXES_T* pSharedObj,
+             RAM_RING_SEQUENCE_T* pSequence )
 {
    pThis->pSharedObj = pSharedObj;
+   pThis->pSequence  = pSequence;
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( pSharedObj );
    ramRingSharedReset( pSharedObj );
+   ramRingSequenceUpdate( pSequence, size, &pSharedObj->indexes );
 
  #ifdef CONFIG_SCU_USE_DDR3
    return ddr3init();
@@ -83,17 +87,6 @@ void ramRreadAddacDaqItem( const RAM_RING_INDEX_T index,
 #endif
 }
 
-/*! ---------------------------------------------------------------------------
- * @brief Generalized function to write a ADDAC-DAQ-item in the shared
- *        date buffer.
- */
-STATIC inline ALWAYS_INLINE
-void ramWriteAddacDaqItem( const RAM_RING_INDEX_T index,
-                           RAM_DAQ_PAYLOAD_T* pItem )
-{
-   ramWriteItem( index, pItem );
-}
-
 /*! ---------------------------------------------------------------------------
  * @brief Macro ease the read access to the channel mode register in the
  *        device descriptor storing as data block in the DAQ-RAM.
@@ -184,6 +177,7 @@ RAM_DAQ_BLOCK_T ramRingGetTypeOfOldestBlock( register RAM_SCU_T* pThis )
 STATIC inline
 void ramRemoveOldestBlock( register RAM_SCU_T* pThis )
 {
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( pThis->pSharedObj );
    switch( ramRingGetTypeOfOldestBlock( pThis ) )
    {
       case RAM_DAQ_UNDEFINED:
@@ -205,6 +199,10 @@ void ramRemoveOldestBlock( register RAM_SCU_T* pThis )
       }
       default: break;
    }
+   /*
+    * Publishing the removing before the space becomes overwritten.
+    */
+   ramRingSequenceUpdate( pThis->pSequence, size, &pThis->pSharedObj->indexes );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -262,15 +260,186 @@ void publishWrittenData( register RAM_SCU_T* pThis,
                  ramRingSharedGetSize( &pThis->pSharedObj->ringAdmin ) );
 }
 
-//#define CONFIG_DAQ_DECREMENT
+#ifndef CONFIG_DAQ_RAM_WRITE_CHUNK
+  /*!
+   * @brief Number of RAM items which will collected before they becomes
+   *        written in the RAM by a single lock acquisition.
+   *
+   * Small enough to keep the window with disabled interrupts short.
+   */
+  #define CONFIG_DAQ_RAM_WRITE_CHUNK 8
+#endif
+
+/*
+ * The device descriptor plus the first received data words have to fill
+ * the reserved RAM items at the begin of the block exactly.
+ */
+STATIC_ASSERT( (DAQ_DESCRIPTOR_WORD_SIZE + RAM_DAQ_DESCRIPTOR_COMPLETION) ==
+               (RAM_DAQ_DATA_START_OFFSET * RAM_DAQ_DATA_WORDS_PER_RAM_INDEX) );
+STATIC_ASSERT( RAM_DAQ_DATA_WORDS_PER_RAM_INDEX == 4 );
+
+/*!
+ * @brief Function type of the FiFo-read out function for either continuous
+ *        data or post-mortem and high resolution.
+ */
+typedef volatile DAQ_DATA_T (*DAQ_POP_FT)( register DAQ_CANNEL_T* );
 
 /*! ---------------------------------------------------------------------------
- * @brief Copies the data of the given DAQ-channel in to the RAM and
+ * @brief Pops the data words of a whole RAM item from the FiFo.
+ *
+ * The critical section becomes entered once per RAM item only and not
+ * per data word.
+ */
+STATIC inline ALWAYS_INLINE
+void ramPopItem( RAM_DAQ_PAYLOAD_T* pItem, DAQ_CANNEL_T* pDaqChannel,
+                 const DAQ_POP_FT pop )
+{
+   DAQ_ATOMIC_ENTER();
+   ramFillItem( pItem, 0, pop( pDaqChannel ) );
+   ramFillItem( pItem, 1, pop( pDaqChannel ) );
+   ramFillItem( pItem, 2, pop( pDaqChannel ) );
+   ramFillItem( pItem, 3, pop( pDaqChannel ) );
+   DAQ_ATOMIC_EXIT();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Pops a given number of data words from the FiFo.
+ */
+STATIC inline ALWAYS_INLINE
+void ramPopWords( DAQ_DATA_T* pTarget, const unsigned int len,
+                  DAQ_CANNEL_T* pDaqChannel, const DAQ_POP_FT pop )
+{
+   DAQ_ATOMIC_ENTER();
+   for( unsigned int i = 0; i < len; i++ )
+      pTarget[i] = pop( pDaqChannel );
+   DAQ_ATOMIC_EXIT();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Drains a complete DAQ block from the FiFo in to the RAM and
  *        exchanges the order of DAQ data with device descriptor.
  *
  * That means, the device descriptor, which will received at last,
  * becomes copied in the ring buffer at the begin of the data block, following
  * by the payload data.
+ *
+ * This function will always inlined with constant arguments for the FiFo
+ * type and the block length, so that the compiler generates a specialized
+ * drain loop for continuous blocks and for PM/HiRes blocks
+ * without any runtime dispatching.
+ *
+ * @param pThis Pointer to the RAM object object.
+ * @param pDaqChannel Pointer of the concerning DAQ-channel-object.
+ * @param pop FiFo-read out function.
+ * @param blockWords Expected block length in data words inclusive
+ *                   descriptor and CRC.
+ * @param pDescriptor Target for the received device descriptor.
+ * @param poDataIndexes Ring indexes which will be valid after success.
+ */
+STATIC inline ALWAYS_INLINE
+void ramDrainDaqFifo( register RAM_SCU_T* pThis,
+                      DAQ_CANNEL_T* pDaqChannel,
+                      const DAQ_POP_FT pop,
+                      const unsigned int blockWords,
+                   #ifdef CONFIG_DAQ_SW_SEQUENCE
+                      const uint8_t sequence,
+                   #endif
+                      DAQ_DESCRIPTOR_T* pDescriptor,
+                      RAM_RING_INDEXES_T* poDataIndexes )
+{
+   /*
+    * Number of payload data words which will stored behind the
+    * descriptor, the first words are stored in the descriptor items.
+    */
+   const unsigned int payloadWords = blockWords - DAQ_DESCRIPTOR_WORD_SIZE -
+                                     RAM_DAQ_DESCRIPTOR_COMPLETION;
+   const unsigned int fullItems = payloadWords / RAM_DAQ_DATA_WORDS_PER_RAM_INDEX;
+   const unsigned int restWords = payloadWords % RAM_DAQ_DATA_WORDS_PER_RAM_INDEX;
+
+   RAM_DAQ_PAYLOAD_T  aRamItems[CONFIG_DAQ_RAM_WRITE_CHUNK];
+   DAQ_DATA_T         firstData[RAM_DAQ_DESCRIPTOR_COMPLETION];
+   RAM_RING_INDEXES_T oDescriptorIndexes = pThis->pSharedObj->indexes;
+
+   *poDataIndexes = oDescriptorIndexes;
+
+   /*
+    * Skipping over the intended place of the device descriptor
+    * which will received at last.
+    */
+   ramRingAddToWriteIndex( poDataIndexes, RAM_DAQ_DATA_START_OFFSET );
+
+   /*
+    * The first received data words will stored in a temporary buffer.
+    * They will copied in the place immediately after the device
+    * descriptor. This manner making the intended RAM- place
+    * of the device descriptor dividable by RAM_DAQ_PAYLOAD_T.
+    */
+   ramPopWords( firstData, ARRAY_SIZE( firstData ), pDaqChannel, pop );
+
+   /*
+    * Payload in chunks of RAM items.
+    */
+   unsigned int i = fullItems;
+   while( i > 0 )
+   {
+      const unsigned int chunk = min( i, (unsigned int)ARRAY_SIZE( aRamItems ) );
+      for( unsigned int j = 0; j < chunk; j++ )
+         ramPopItem( &aRamItems[j], pDaqChannel, pop );
+      ramWriteItems( poDataIndexes, aRamItems, chunk );
+      i -= chunk;
+   }
+
+   if( restWords != 0 )
+   { /*
+      * Completion of the last RAM item, this will be the case when
+      * the total length isn't dividable by RAM_DAQ_PAYLOAD_T.
+      */
+      DAQ_DATA_T rest[RAM_DAQ_DATA_WORDS_PER_RAM_INDEX];
+      ramPopWords( rest, restWords, pDaqChannel, pop );
+      for( unsigned int j = 0; j < RAM_DAQ_DATA_WORDS_PER_RAM_INDEX; j++ )
+         ramFillItem( &aRamItems[0], j, (j < restWords)? rest[j] : 0xCAFE );
+      ramWriteItems( poDataIndexes, aRamItems, 1 );
+   }
+
+   /*
+    * Device descriptor.
+    */
+   ramPopWords( pDescriptor->index, DAQ_DESCRIPTOR_WORD_SIZE, pDaqChannel, pop );
+#ifdef CONFIG_DAQ_SW_SEQUENCE
+   /*
+    * Setting of the sequence number in the device descriptor.
+    * Sequence number has been already incremented before in
+    * functions handleHiresMode(), handleContinuousMode(),
+    * and handlePostMortemMode() in daq_main.c therefore the 1
+    * must be deducted here again.
+    */
+   pDescriptor->name.crcReg.sequence = sequence - 1;
+#endif
+
+   /*
+    * Writing the device descriptor completed by the first data words
+    * at the begin of the block.
+    */
+   for( unsigned int j = 0; j < DAQ_DESCRIPTOR_WORD_SIZE; j++ )
+   {
+      ramFillItem( &aRamItems[j / RAM_DAQ_DATA_WORDS_PER_RAM_INDEX],
+                   j % RAM_DAQ_DATA_WORDS_PER_RAM_INDEX,
+                   pDescriptor->index[j] );
+   }
+   for( unsigned int j = 0; j < ARRAY_SIZE( firstData ); j++ )
+   {
+      const unsigned int k = DAQ_DESCRIPTOR_WORD_SIZE + j;
+      ramFillItem( &aRamItems[k / RAM_DAQ_DATA_WORDS_PER_RAM_INDEX],
+                   k % RAM_DAQ_DATA_WORDS_PER_RAM_INDEX,
+                   firstData[j] );
+   }
+   ramWriteItems( &oDescriptorIndexes, aRamItems, RAM_DAQ_DATA_START_OFFSET );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Copies the data of the given DAQ-channel in to the RAM and
+ *        exchanges the order of DAQ data with device descriptor.
+ * @see ramDrainDaqFifo
  */
 STATIC inline
 void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
@@ -281,47 +450,18 @@ void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
     *        of continuous data or post-mortem and high resolution.
     */
    DAQ_REGISTER_T (*getRemaining)( register DAQ_CANNEL_T* );
-
-   /*!
-    * @brief Function pointer keeps the FiFo-read out function for
-    *        either continuous data or post-mortem and high resolution.
-    */
-   volatile DAQ_DATA_T (*pop)( register DAQ_CANNEL_T* );
-
-#ifdef CONFIG_DAQ_SW_SEQUENCE
-   uint8_t*     pSequence;
-#endif
-   DAQ_REGISTER_T remainingDataWords;
-   unsigned int dataWordCounter;
-   unsigned int payloadIndex = 0;
    DAQ_REGISTER_T expectedWords;
 
    /*
     * A local object of the current descriptor will use for verifying purposes
     * to check the block integrity.
     */
-   DAQ_DESCRIPTOR_T    oDescriptor;
-   unsigned int        descriptorIndex;
-   RAM_RING_INDEXES_T  oDescriptorIndexes;
-
-   RAM_RING_INDEXES_T  oDataIndexes;
-   RAM_RING_INDEXES_T* poIndexes;
+   DAQ_DESCRIPTOR_T   oDescriptor;
+   RAM_RING_INDEXES_T oDataIndexes;
 
-   RAM_DAQ_PAYLOAD_T ramItem;
-   DAQ_DATA_T        firstData[RAM_DAQ_DESCRIPTOR_COMPLETION];
-
-   oDescriptorIndexes = pThis->pSharedObj->indexes;
-   oDataIndexes       = oDescriptorIndexes;
-   poIndexes          = &oDataIndexes;
-
-   /*
-    * Skipping over the intended place of the device descriptor
-    * which will received at last.
-    */
-   ramRingAddToWriteIndex( poIndexes, RAM_DAQ_DATA_START_OFFSET );
+   STATIC_ASSERT( CONFIG_DAQ_RAM_WRITE_CHUNK >= RAM_DAQ_DATA_START_OFFSET );
 
    ramRingDbgPrintIndexes( &pThis->pSharedObj->ringIndexes, "Origin indexes:");
-   ramRingDbgPrintIndexes( poIndexes, "Data indexes:" );
 
    DBG_RAM_INFO( "DBG: %s(): "
                  ESC_BOLD " Slot: %d, Channel: %d\n" ESC_NORMAL,
@@ -330,36 +470,22 @@ void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
                  daqChannelGetNumber( pDaqChannel ) + 1 );
 
    if( isShort )
-   { /*
-      * Initialization for receiving of continuous DAQ-data block.
-      */
+   {
       getRemaining  = daqChannelGetDaqFifoWords;
-      pop           = daqChannelPopDaqFifo;
       expectedWords = DAQ_FIFO_DAQ_WORD_SIZE_CRC;
-   #ifdef CONFIG_DAQ_SW_SEQUENCE
-      pSequence     = &pDaqChannel->sequenceContinuous;
-   #endif
    }
    else
-   { /*
-      * Initialization for receiving of high resolution or post mortem
-      * DAQ-data block,
-      */
+   {
       getRemaining  = daqChannelGetPmFifoWords;
-      pop           = daqChannelPopPmFifo;
       expectedWords = DAQ_FIFO_PM_HIRES_WORD_SIZE_CRC;
-   #ifdef CONFIG_DAQ_SW_SEQUENCE
-      pSequence     = &pDaqChannel->sequencePmHires;
-   #endif
    }
 
-#ifndef CONFIG_DAQ_DECREMENT
    /*
     * The data word which includes the CRC isn't a part of the fifo content,
     * therefore we have to add it here.
     */
    DAQ_ATOMIC_ENTER();
-   remainingDataWords = getRemaining( pDaqChannel ) + 1;
+   const DAQ_REGISTER_T remainingDataWords = getRemaining( pDaqChannel ) + 1;
    DAQ_ATOMIC_EXIT();
    if( remainingDataWords != expectedWords )
    {
@@ -373,140 +499,34 @@ void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
       daqChannelSetStatus( pDaqChannel, DAQ_RECEIVE_STATE_DATA_LOST );
       return;
    }
-#endif
 
-   descriptorIndex = 0;
-   dataWordCounter = 0;
-   do
+   /*
+    * Specialized drain loops for continuous data and for
+    * post-mortem and high resolution.
+    */
+   if( isShort )
    {
-      DAQ_ATOMIC_ENTER();
-   #ifdef CONFIG_DAQ_DECREMENT
-      remainingDataWords = getRemaining( pDaqChannel );
-   #else
-      remainingDataWords--;
-   #endif
-      DAQ_DATA_T data = pop( pDaqChannel );
-      DAQ_ATOMIC_EXIT();
-      if( dataWordCounter < ARRAY_SIZE( firstData ) )
-      { /*
-         * The first two received data words will stored in a temporary buffer.
-         * They will copied in the place immediately after the device
-         * descriptor. This manner making the intended RAM- place
-         * of the device descriptor dividable by RAM_DAQ_PAYLOAD_T.
-         */
-         firstData[dataWordCounter] = data;
-      #ifdef CONFIG_DAQ_DECREMENT
-         DBG_RAM_INFO( "DBG: Words in Fifo: %d\n", remainingDataWords );
-      #endif
-      }
-      else
-      {
-         if( dataWordCounter == ARRAY_SIZE( firstData ) )
-         { /*
-            * The first two data words making the device descriptor dividable
-            * by RAM_DAQ_PAYLOAD_T has been received. The filling of the
-            * ring buffer starts here.
-            */
-            payloadIndex = 0;
-         }
-
-         if( poIndexes == &oDescriptorIndexes )
-         { /*
-            * Descriptor becomes received.
-            */
-            RAM_ASSERT( descriptorIndex < ARRAY_SIZE(oDescriptor.index) );
-         #ifdef CONFIG_DAQ_SW_SEQUENCE
-            if( descriptorIndex == offsetof(_DAQ_DISCRIPTOR_STRUCT_T, crcReg ) /
-                               sizeof(DAQ_DATA_T) )
-            { /*
-               * Setting of the sequence number in the device descriptor.
-               * Sequence number has been already incremented before in
-               * functions handleHiresMode(), handleContinuousMode(),
-               * and handlePostMortemMode() in daq_main.c therefore the 1
-               * must be deducted here again.
-               */
-               ((_DAQ_BF_CRC_REG*)&data)->sequence = *pSequence - 1;
-            }
-         #endif
-           oDescriptor.index[descriptorIndex++] = data;
-         }
-
-         ramFillItem( &ramItem, payloadIndex, data );
-
-         /*
-          * Was the last data word of payload received?
-          */
-         if( remainingDataWords == DAQ_DESCRIPTOR_WORD_SIZE )
-         { /*
-            * Yes, possibly completion of the last RAM item if necessary.
-            * This will be the case, by receiving a short block its
-            * total length isn't dividable by RAM_DAQ_PAYLOAD_T.
-            */
-            while( payloadIndex < (RAM_DAQ_DATA_WORDS_PER_RAM_INDEX-1) )
-            {
-               payloadIndex++;
-               DBG_RAM_INFO( "DBG: Complete with dummy data %d\n",
-                             payloadIndex );
-               ramFillItem( &ramItem, payloadIndex, 0xCAFE );
-            }
-         }
-         /*
-          * Has the block been received completely?
-          */
-         else if( remainingDataWords == 0 )
-         { /*
-            * Yes, but because the length of the device descriptor isn't
-            * dividable by RAM_DAQ_PAYLOAD_T so the rest becomes filled with
-            * the first received data words.
-            */
-            for( unsigned int i = 0; i < ARRAY_SIZE( firstData ); i++ )
-            {
-               DBG_RAM_INFO( "DBG: Finalize with first data %d\n", i );
-               payloadIndex++;
-               RAM_ASSERT( payloadIndex < RAM_DAQ_DATA_WORDS_PER_RAM_INDEX );
-               ramFillItem( &ramItem, payloadIndex, firstData[i] );
-            }
-         }
-
-         /*
-          * Next RAM item completed?
-          */
-         if( payloadIndex == (RAM_DAQ_DATA_WORDS_PER_RAM_INDEX-1) )
-         {
-            payloadIndex = 0;
-            /*
-             * Store item in RAM.
-             */
-            ramWriteAddacDaqItem( ramRingGetWriteIndex(poIndexes), &ramItem );
-            ramRingIncWriteIndex( poIndexes );
-
-            /*
-             * Is the next data word the first word of the device descriptor?
-             */
-            if( remainingDataWords == DAQ_DESCRIPTOR_WORD_SIZE )
-            { /*
-               * Yes, skipping back at the begin.
-               */
-               poIndexes = &oDescriptorIndexes;
-            }
-         }
-         else
-            payloadIndex++;
-      }
-
-      dataWordCounter++;
-      if( dataWordCounter > expectedWords )
-         break;
+      ramDrainDaqFifo( pThis, pDaqChannel, daqChannelPopDaqFifo,
+                       DAQ_FIFO_DAQ_WORD_SIZE_CRC,
+                    #ifdef CONFIG_DAQ_SW_SEQUENCE
+                       pDaqChannel->sequenceContinuous,
+                    #endif
+                       &oDescriptor, &oDataIndexes );
+   }
+   else
+   {
+      ramDrainDaqFifo( pThis, pDaqChannel, daqChannelPopPmFifo,
+                       DAQ_FIFO_PM_HIRES_WORD_SIZE_CRC,
+                    #ifdef CONFIG_DAQ_SW_SEQUENCE
+                       pDaqChannel->sequencePmHires,
+                    #endif
+                       &oDescriptor, &oDataIndexes );
    }
-   while( remainingDataWords > 0 );
 
    /*
     * Is the block integrity given?
     */
-   if( (dataWordCounter == expectedWords)
-#ifndef CONFIG_DAQ_DECREMENT
-       && (getRemaining( pDaqChannel ) == 0)
-#endif
+   if( (getRemaining( pDaqChannel ) == 0)
        && daqDescriptorVerifyMode( &oDescriptor )
        && (isShort == daqDescriptorIsShortBlock( &oDescriptor )) )
    { /*
@@ -514,9 +534,6 @@ void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
       * Making the new received data block in ring buffer valid.
       */
       publishWrittenData( pThis, &oDataIndexes );
-   #ifdef CONFIG_DAQ_SW_SEQUENCE
-      DBG_RAM_INFO( "DBG: Sequence: %d\n", *pSequence - 1 );
-   #endif
       if( pDaqChannel->properties.restart )
       {
          if( daqDescriptorWasHiRes( &oDescriptor ) )
@@ -536,24 +553,9 @@ void ramWriteDaqData( register RAM_SCU_T* pThis, DAQ_CANNEL_T* pDaqChannel,
       * Block integrity is corrupt!
       */
       daqChannelSetStatus( pDaqChannel, DAQ_RECEIVE_STATE_CORRUPT_BLOCK );
-#ifdef DEBUGLEVEL
-   #ifndef CONFIG_DAQ_DECREMENT
-      if( getRemaining( pDaqChannel ) != 0 )
-      {
-         DBPRINT1( ESC_BOLD ESC_FG_RED
-                   "DBG ERROR: PmHires fifo: %d\n"
-                   ESC_NORMAL, getRemaining( pDaqChannel ) );
-      }
-      else
-   #endif
-         DBPRINT1( ESC_BOLD ESC_FG_RED
-                   "DBG ERROR: dataWordCounter > expectedWords\n"
-                   "           dataWordCounter: %d\n"
-                   "           expectedWords:   %d\n"
-                   ESC_NORMAL,
-                   dataWordCounter,
-                   expectedWords );
-#endif /* ifdef DEBUGLEVEL */
+      DBPRINT1( ESC_BOLD ESC_FG_RED
+                "DBG ERROR: Corrupt block, remaining words in fifo: %d\n"
+                ESC_NORMAL, getRemaining( pDaqChannel ) );
    }
    ramRingDbgPrintIndexes( &pThis->pSharedObj->ringIndexes,
                            ESC_FG_WHITE ESC_BOLD "Final indexes" ESC_NORMAL );
@@ -81,16 +81,25 @@ typedef struct
    *       Therefore its a pointer in this object.
    */
    RAM_RING_SHARED_INDEXES_T* volatile pSharedObj;
+
+   /*!
+    * @brief Read sequence of the ring buffer in the shared memory,
+    *        NULL if not published.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   RAM_RING_SEQUENCE_T* pSequence;
 } RAM_SCU_T;
 
 /*! ---------------------------------------------------------------------------
  * @brief Initializing SCU RAM buffer ready to use.
  * @param pThis Pointer to the RAM object.
  * @param pSharedObj Pointer to the fifo administration in shared memory.
+ * @param pSequence Pointer to the read sequence in shared memory or NULL.
  * @retval 0 Initializing was successful
  * @retval <0 Error
  */
-int ramInit( RAM_SCU_T* pThis, RAM_RING_SHARED_INDEXES_T* pSharedObj );
+int ramInit( RAM_SCU_T* pThis, RAM_RING_SHARED_INDEXES_T* pSharedObj,
+             RAM_RING_SEQUENCE_T* pSequence );
 
 /*! ----------------------------------------------------------------------------
  * @brief Exchanges the order of devicedeskriptor and payload so that the
@@ -123,6 +132,32 @@ void ramWriteItem( const RAM_RING_INDEX_T index,
 #endif
 }
 
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a block of items in the ring buffer at the current write
+ *        index and advances the write index.
+ *
+ * The RAM becomes locked once only for the whole block, a wrap around at the
+ * upper border of the ring buffer will handled.
+ * @param pIndexes Pointer to the ring indexes, usually a local copy.
+ * @param pItems Pointer to the first item to write.
+ * @param len Number of items to write.
+ */
+STATIC inline
+void ramWriteItems( RAM_RING_INDEXES_T* pIndexes,
+                    const RAM_DAQ_PAYLOAD_T* pItems,
+                    const unsigned int len )
+{
+   RAM_ASSERT( ramRingGetRemainingCapacity( pIndexes ) >= len );
+#if defined( CONFIG_SCU_USE_DDR3 ) || defined(__DOXYGEN__)
+   ddr3WriteRing64( pIndexes->offset, pIndexes->capacity,
+                    ramRingGetWriteIndex( pIndexes ) - pIndexes->offset,
+                    pItems, len );
+#else
+   #error Nothing implemented in function ramWriteItems()!
+#endif
+   ramRingAddToWriteIndex( pIndexes, len );
+}
+
 /*! @} */ //End of group DAQ_RAM_BUFFER
 #ifdef __cplusplus
 } /* namespace daq */
@@ -150,6 +150,39 @@ bool cbRead( volatile FG_CHANNEL_BUFFER_T* pCb, volatile FG_CHANNEL_REG_T* pCr,
    return true;
 }
 
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a parameter set in a channel buffer.
+ *
+ * Normally the buffer becomes written by the host, this function is for
+ * the case that the LM32 refills the buffer from the deep polynomial
+ * buffer in the external RAM.
+ * @see fgDeepPrefetch
+ * @param pCb pointer to the first channel buffer
+ * @param pCr pointer to the first channel register
+ * @param channel number of the channel
+ * @param pPset the data to write
+ * @retval false Buffer is full no data written.
+ * @retval true Data successful written.
+ */
+STATIC inline
+bool cbWrite( volatile FG_CHANNEL_BUFFER_T* pCb, volatile FG_CHANNEL_REG_T* pCr,
+              const unsigned int channel, const FG_PARAM_SET_T* pPset )
+{
+   const uint32_t wptr = pCr[channel].wr_ptr;
+   const uint32_t next = (wptr + 1) % (BUFFER_SIZE);
+
+   /* check full */
+   if( next == pCr[channel].rd_ptr )
+      return false;
+
+   /* write element */
+   pCb[channel].pset[wptr] = *pPset;
+
+   /* move write pointer forward */
+   pCr[channel].wr_ptr = next;
+   return true;
+}
+
 /*! ---------------------------------------------------------------------------
  * @brief Thread safe version of cbRead
  * @see cbRead
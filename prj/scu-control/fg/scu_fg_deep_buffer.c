@@ -0,0 +1,308 @@
+/*!
+ * @file scu_fg_deep_buffer.c
+ * @brief Deep polynomial buffers of the function generators in the
+ *        external RAM (DDR3 of SCU3 respectively SRAM of SCU4).
+ *
+ * @note This source code is suitable for LM32 only.
+ * @see scu_fg_deep_buffer.h
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <scu_mmu_tag.h>
+#include <scu_lm32_common.h>
+#include "scu_fg_deep_buffer.h"
+
+#ifndef CONFIG_USE_MMU
+ #error "Module needs the MMU: CONFIG_USE_MMU!"
+#endif
+
+#ifndef CONFIG_FG_DEEP_PREFETCH_MAX
+ /*!
+  * @brief Maximum number of polynomials which becomes moved from the ring
+  *        in the small buffer by a single call of fgDeepPrefetch(), that
+  *        limits the time within the interrupt respectively task context.
+  */
+ #define CONFIG_FG_DEEP_PREFETCH_MAX 16
+#endif
+
+/*!
+ * @brief Access adapter for FG_DEEP_RING_ADMIN_T.
+ */
+typedef union
+{
+   FG_DEEP_RING_ADMIN_T admin;
+   RAM_PAYLOAD_T        payload[FG_DEEP_ADMIN_SIZE64];
+} FG_DEEP_ADMIN_ACCESS_T;
+
+/*!
+ * @brief Access adapter for FG_DEEP_BUFFER_HEADER_T.
+ */
+typedef union
+{
+   FG_DEEP_BUFFER_HEADER_T header;
+   RAM_PAYLOAD_T           payload;
+} FG_DEEP_HEADER_ACCESS_T;
+
+/*!
+ * @brief LM32 local state of the ring of a single channel.
+ */
+typedef struct
+{
+   /*!
+    * @brief Master copy of FG_DEEP_RING_ADMIN_T::lm32::rdIndex.
+    */
+   uint32_t rdIndex;
+
+   /*!
+    * @brief Master copy of FG_DEEP_RING_ADMIN_T::lm32::fetchCount.
+    */
+   uint32_t fetchCount;
+
+   /*!
+    * @brief Becomes taken from FG_DEEP_RING_ADMIN_T::host::enabled
+    *        when the channel becomes enabled.
+    */
+   bool     enabled;
+
+   /*!
+    * @brief Becomes true when the level of the ring has fallen below
+    *        FG_DEEP_REFILL_THRESHOLD.
+    */
+   bool     refillDue;
+} FG_DEEP_CHANNEL_T;
+
+/*!
+ * @brief Start index of the memory block given by the MMU.
+ */
+STATIC MMU_ADDR_T mg_blockStart = 0;
+
+/*!
+ * @brief Becomes true when the memory block has been successful allocated.
+ */
+STATIC bool mg_isPresent = false;
+
+STATIC FG_DEEP_CHANNEL_T mg_aChannel[MAX_FG_CHANNELS];
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads the part of the ring administration written by the host.
+ */
+STATIC inline
+void fgDeepReadHostAdmin( const unsigned int channel,
+                          FG_DEEP_ADMIN_ACCESS_T* pAccess )
+{
+   mmuRead( fgDeepGetAdminIndex( mg_blockStart, channel ),
+            &pAccess->payload[0], 1 );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes the part of the ring administration owned by the LM32.
+ */
+STATIC void fgDeepWriteLm32Admin( const unsigned int channel )
+{
+   FG_DEEP_ADMIN_ACCESS_T access;
+   access.admin.lm32.rdIndex    = mg_aChannel[channel].rdIndex;
+   access.admin.lm32.fetchCount = mg_aChannel[channel].fetchCount;
+   mmuWrite( fgDeepGetAdminIndex( mg_blockStart, channel ) + 1,
+             &access.payload[1], 1 );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+void fgDeepBufferInit( void )
+{
+   size_t len = fgDeepGetBlockSize64();
+
+   const MMU_STATUS_T status = mmuAlloc( TAG_FG_BUFFER, &mg_blockStart,
+                                         &len, true );
+   scuLog( LM32_LOG_INFO, "MMU-Tag 0x%04X for FG-deep-buffer:    %s\n",
+           TAG_FG_BUFFER, mmuStatus2String( status ) );
+   if( !mmuIsOkay( status ) )
+      return;
+
+   FG_DEEP_HEADER_ACCESS_T head;
+   if( status == ALREADY_PRESENT )
+   { /*
+      * LM32 has been restarted, the block has to have the same format.
+      */
+      mmuRead( mg_blockStart, &head.payload, 1 );
+      if( (head.header.magicNumber != FG_DEEP_BUFFER_MAGIC) ||
+          (head.header.itemsPerChannel != FG_DEEP_BUFFER_ITEMS) ||
+          (len < fgDeepGetBlockSize64()) )
+      {
+         scuLog( LM32_LOG_ERROR, ESC_ERROR
+                 "ERROR: FG-deep-buffer has a different format!\n" ESC_NORMAL );
+         return;
+      }
+   }
+   else
+   {
+      FG_DEEP_ADMIN_ACCESS_T access;
+      access.admin.host.wrIndex    = 0;
+      access.admin.host.enabled    = 0;
+      access.admin.lm32.rdIndex    = 0;
+      access.admin.lm32.fetchCount = 0;
+      for( unsigned int channel = 0; channel < MAX_FG_CHANNELS; channel++ )
+      {
+         mmuWrite( fgDeepGetAdminIndex( mg_blockStart, channel ),
+                   access.payload, FG_DEEP_ADMIN_SIZE64 );
+      }
+      head.header.magicNumber     = FG_DEEP_BUFFER_MAGIC;
+      head.header.itemsPerChannel = FG_DEEP_BUFFER_ITEMS;
+      mmuWrite( mg_blockStart, &head.payload, 1 );
+   }
+
+   mg_isPresent = true;
+   for( unsigned int channel = 0; channel < MAX_FG_CHANNELS; channel++ )
+      fgDeepFlush( channel );
+
+   scuLog( LM32_LOG_INFO, "FG-deep-buffer offset:     %5u item\n",
+           mg_blockStart );
+   scuLog( LM32_LOG_INFO, "FG-deep-buffer polynomials per channel: %u\n",
+           FG_DEEP_BUFFER_ITEMS );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Moves at most maxItems polynomials from the ring of the
+ *        given channel in the small buffer.
+ */
+STATIC void fgDeepMove( const unsigned int channel, unsigned int maxItems )
+{
+   FG_DEEP_CHANNEL_T* pThis = &mg_aChannel[channel];
+   volatile FG_CHANNEL_REG_T* pCr = &g_shared.oSaftLib.oFg.aRegs[0];
+
+   const unsigned int windowFree = (BUFFER_SIZE - 1) - cbgetCount( pCr, channel );
+   if( maxItems > windowFree )
+      maxItems = windowFree;
+
+   FG_DEEP_ADMIN_ACCESS_T access;
+   fgDeepReadHostAdmin( channel, &access );
+   const uint32_t wrIndex = access.admin.host.wrIndex;
+   if( wrIndex >= FG_DEEP_BUFFER_ITEMS )
+      return;
+
+   const unsigned int levelBefore = fgDeepGetLevel( wrIndex, pThis->rdIndex );
+   if( maxItems > levelBefore )
+      maxItems = levelBefore;
+
+   if( maxItems == 0 )
+      return;
+
+   for( unsigned int i = 0; i < maxItems; i++ )
+   {
+      FG_DEEP_ITEM_ACCESS_T item;
+      mmuRead( fgDeepGetItemIndex( mg_blockStart, channel, pThis->rdIndex ),
+               item.payload, FG_DEEP_ITEM_SIZE64 );
+
+      FG_PARAM_SET_T pset;
+      pset.coeff_a     = item.item.coeff_a;
+      pset.coeff_b     = item.item.coeff_b;
+      pset.coeff_c     = item.item.coeff_c;
+      pset.control.i32 = item.item.control;
+      cbWrite( &g_shared.oSaftLib.oFg.aChannelBuffers[0], pCr, channel, &pset );
+
+      pThis->rdIndex++;
+      if( pThis->rdIndex >= FG_DEEP_BUFFER_ITEMS )
+         pThis->rdIndex = 0;
+   }
+   pThis->fetchCount += maxItems;
+   fgDeepWriteLm32Admin( channel );
+
+   if( (levelBefore > FG_DEEP_REFILL_THRESHOLD) &&
+       ((levelBefore - maxItems) <= FG_DEEP_REFILL_THRESHOLD) )
+      pThis->refillDue = true;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+void fgDeepPrefetch( const unsigned int channel )
+{
+   if( !mg_isPresent || (channel >= MAX_FG_CHANNELS) || !mg_aChannel[channel].enabled )
+      return;
+
+   if( cbgetCount( &g_shared.oSaftLib.oFg.aRegs[0], channel ) > FG_DEEP_PREFETCH_THRESHOLD )
+      return;
+
+   fgDeepMove( channel, CONFIG_FG_DEEP_PREFETCH_MAX );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+void fgDeepArm( const unsigned int channel )
+{
+   if( !mg_isPresent || (channel >= MAX_FG_CHANNELS) )
+      return;
+
+   FG_DEEP_ADMIN_ACCESS_T access;
+   fgDeepReadHostAdmin( channel, &access );
+   mg_aChannel[channel].enabled = (access.admin.host.enabled == FG_DEEP_RING_ENABLED);
+   if( !mg_aChannel[channel].enabled )
+      return;
+
+   /*
+    * Filling the entire small buffer before the start of the
+    * function generator.
+    */
+   fgDeepMove( channel, BUFFER_SIZE );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+void fgDeepFlush( const unsigned int channel )
+{
+   if( !mg_isPresent || (channel >= MAX_FG_CHANNELS) )
+      return;
+
+   FG_DEEP_ADMIN_ACCESS_T access;
+   fgDeepReadHostAdmin( channel, &access );
+
+   FG_DEEP_CHANNEL_T* pThis = &mg_aChannel[channel];
+   pThis->rdIndex    = (access.admin.host.wrIndex < FG_DEEP_BUFFER_ITEMS)?
+                                          access.admin.host.wrIndex : 0;
+   pThis->fetchCount = 0;
+   pThis->enabled    = false;
+   pThis->refillDue  = false;
+   fgDeepWriteLm32Admin( channel );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+bool fgDeepIsEnabled( const unsigned int channel )
+{
+   return mg_isPresent && (channel < MAX_FG_CHANNELS) && mg_aChannel[channel].enabled;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_fg_deep_buffer.h
+ */
+bool fgDeepIsRefillDue( const unsigned int channel )
+{
+   if( !fgDeepIsEnabled( channel ) || !mg_aChannel[channel].refillDue )
+      return false;
+
+   mg_aChannel[channel].refillDue = false;
+   return true;
+}
+
+/*================================== EOF ====================================*/
@@ -0,0 +1,336 @@
+/*!
+ * @file scu_fg_deep_buffer.h
+ * @brief Deep polynomial buffers of the function generators in the
+ *        external RAM (DDR3 of SCU3 respectively SRAM of SCU4).
+ *
+ * Each function generator channel gets a large polynomial ring in the
+ * external RAM in addition to its small buffer of BUFFER_SIZE polynomials
+ * in the LM32 shared memory. The host writes big batches of polynomials
+ * in this ring, and the LM32 moves them chunk-wise in the small buffer,
+ * which becomes a prefetch window of the ring this way.
+ *
+ * The memory block is allocated by the MMU with the tag TAG_FG_BUFFER and
+ * has the following layout in units of RAM_PAYLOAD_T:
+ * @code
+ * +--------------------------------------+
+ * | FG_DEEP_BUFFER_HEADER_T              |
+ * +--------------------------------------+
+ * | FG_DEEP_RING_ADMIN_T [channel 0]     |
+ * | ...                                  |
+ * | FG_DEEP_RING_ADMIN_T [channel n-1]   |
+ * +--------------------------------------+
+ * | FG_DEEP_ITEM_T [itemsPerChannel]     | ring of channel 0
+ * +--------------------------------------+
+ * | ...                                  |
+ * +--------------------------------------+
+ * | FG_DEEP_ITEM_T [itemsPerChannel]     | ring of channel n-1
+ * +--------------------------------------+
+ * @endcode
+ * Protocol for the host:
+ * -# Writing polynomials at the write index of the ring of the concerning
+ *    channel, and after that the new write index and
+ *    FG_DEEP_RING_ENABLED in FG_DEEP_RING_ADMIN_T::host.
+ * -# After the first filling of the ring since the reset of the channel,
+ *    the channel can become enabled, the LM32 fills the small buffer
+ *    before starting the function generator.
+ * -# The signal IRQ_DAT_REFILL becomes sent when the level of the ring
+ *    falls below FG_DEEP_REFILL_THRESHOLD, instead of the threshold of the
+ *    small buffer.
+ *
+ * A host which doesn't know the deep buffer never sets FG_DEEP_RING_ENABLED,
+ * so it writes in the small buffer as before.
+ *
+ * @note This file is suitable for LM32 and Linux.
+ * @see scu_fg_deep_buffer.c
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _SCU_FG_DEEP_BUFFER_H
+#define _SCU_FG_DEEP_BUFFER_H
+
+#include <scu_function_generator.h>
+#include <scu_mmu.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+namespace Scu
+{
+namespace FG
+{
+using namespace mmu;
+#endif
+
+#ifndef CONFIG_FG_DEEP_BUFFER_ITEMS
+  /*!
+   * @brief Number of polynomials of the ring of each channel.
+   */
+  #define CONFIG_FG_DEEP_BUFFER_ITEMS 4096
+#endif
+
+/*!
+ * @brief Identifier of a valid FG_DEEP_BUFFER_HEADER_T.
+ */
+STATIC const uint32_t FG_DEEP_BUFFER_MAGIC = 0xFDB00001;
+
+/*!
+ * @brief Value of FG_DEEP_RING_ADMIN_T::host::enabled, when the
+ *        host uses the ring of this channel.
+ */
+STATIC const uint32_t FG_DEEP_RING_ENABLED = 0xE4AB1ED0;
+
+/*!
+ * @brief Constants of the deep polynomial buffers.
+ */
+typedef enum
+{
+  /*!
+   * @brief Number of polynomials of the ring of each channel.
+   */
+   FG_DEEP_BUFFER_ITEMS      = CONFIG_FG_DEEP_BUFFER_ITEMS,
+
+  /*!
+   * @brief Level of the ring on which the signal IRQ_DAT_REFILL
+   *        becomes sent to the host.
+   */
+   FG_DEEP_REFILL_THRESHOLD  = FG_DEEP_BUFFER_ITEMS * 40 / 100,
+
+  /*!
+   * @brief Level of the small buffer in the LM32 shared memory
+   *        up to which it becomes refilled from the ring.
+   */
+   FG_DEEP_PREFETCH_THRESHOLD = BUFFER_SIZE / 2
+} FG_DEEP_BUFFER_CONSTANT_T;
+
+/*!
+ * @brief Head of the memory block of the deep polynomial buffers.
+ */
+typedef struct PACKED_SIZE
+{
+   /*!
+    * @brief Becomes FG_DEEP_BUFFER_MAGIC by the LM32.
+    */
+   uint32_t magicNumber;
+
+   /*!
+    * @brief Number of polynomials of the ring of each channel.
+    */
+   uint32_t itemsPerChannel;
+} FG_DEEP_BUFFER_HEADER_T;
+
+STATIC_ASSERT( sizeof( FG_DEEP_BUFFER_HEADER_T ) == sizeof( RAM_PAYLOAD_T ) );
+
+/*!
+ * @brief Administration of the ring of a single channel.
+ *
+ * Each side writes its own RAM_PAYLOAD_T only, so no read-modify-write
+ * conflicts can occur.
+ */
+typedef struct PACKED_SIZE
+{
+   /*!
+    * @brief Written by the host only.
+    */
+   struct PACKED_SIZE
+   {
+      /*!
+       * @brief Index of the next polynomial to write in the ring.
+       */
+      uint32_t wrIndex;
+
+      /*!
+       * @brief FG_DEEP_RING_ENABLED when the host uses this ring,
+       *        otherwise the small buffer in the shared memory.
+       */
+      uint32_t enabled;
+   } host;
+
+   /*!
+    * @brief Written by the LM32 only.
+    */
+   struct PACKED_SIZE
+   {
+      /*!
+       * @brief Index of the next polynomial to read from the ring.
+       */
+      uint32_t rdIndex;
+
+      /*!
+       * @brief Number of the moved polynomials in the small buffer
+       *        since the last reset of the channel, for diagnosis only.
+       */
+      uint32_t fetchCount;
+   } lm32;
+} FG_DEEP_RING_ADMIN_T;
+
+STATIC_ASSERT( sizeof( FG_DEEP_RING_ADMIN_T ) == 2 * sizeof( RAM_PAYLOAD_T ) );
+STATIC_ASSERT( offsetof( FG_DEEP_RING_ADMIN_T, lm32 ) == sizeof( RAM_PAYLOAD_T ) );
+
+/*!
+ * @brief Polynomial in the ring.
+ * @note Because of the different byte order between x86 and LM32 and the
+ *       32-bit byte-swap of libetherbone, the order of the coefficients
+ *       a and b has to be different between x86 and LM32, like the
+ *       members tag and flags of MMU_ITEM_T.
+ * @see FG_PARAM_SET_T
+ */
+typedef struct PACKED_SIZE
+{
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+   int16_t  coeff_a;
+   int16_t  coeff_b;
+#else
+   int16_t  coeff_b;
+   int16_t  coeff_a;
+#endif
+   int32_t  coeff_c;
+   uint32_t control;
+   uint32_t __padding__;
+} FG_DEEP_ITEM_T;
+
+STATIC_ASSERT( sizeof( FG_DEEP_ITEM_T ) == 2 * sizeof( RAM_PAYLOAD_T ) );
+
+/*!
+ * @brief Access adapter for FG_DEEP_ITEM_T.
+ */
+typedef union
+{
+   FG_DEEP_ITEM_T item;
+   RAM_PAYLOAD_T  payload[sizeof(FG_DEEP_ITEM_T)/sizeof(RAM_PAYLOAD_T)];
+} FG_DEEP_ITEM_ACCESS_T;
+
+/*!
+ * @brief Size in RAM_PAYLOAD_T units of a single polynomial in the ring.
+ */
+#define FG_DEEP_ITEM_SIZE64 (sizeof(FG_DEEP_ITEM_T) / sizeof(RAM_PAYLOAD_T))
+
+/*!
+ * @brief Size in RAM_PAYLOAD_T units of the administration of a
+ *        single ring.
+ */
+#define FG_DEEP_ADMIN_SIZE64 (sizeof(FG_DEEP_RING_ADMIN_T) / sizeof(RAM_PAYLOAD_T))
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns the size in RAM_PAYLOAD_T units of the entire memory
+ *        block which has to be allocated by the MMU.
+ */
+STATIC inline unsigned int fgDeepGetBlockSize64( void )
+{
+   return sizeof(FG_DEEP_BUFFER_HEADER_T) / sizeof(RAM_PAYLOAD_T) +
+          MAX_FG_CHANNELS * (FG_DEEP_ADMIN_SIZE64 +
+                             FG_DEEP_BUFFER_ITEMS * FG_DEEP_ITEM_SIZE64);
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns the RAM index of the ring administration of the
+ *        given channel.
+ * @param blockStart Start index of the memory block given by the MMU.
+ * @param channel Function generator channel.
+ */
+STATIC inline
+unsigned int fgDeepGetAdminIndex( const unsigned int blockStart,
+                                  const unsigned int channel )
+{
+   return blockStart + sizeof(FG_DEEP_BUFFER_HEADER_T) / sizeof(RAM_PAYLOAD_T) +
+          channel * FG_DEEP_ADMIN_SIZE64;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns the RAM index of a polynomial in the ring of the
+ *        given channel.
+ * @param blockStart Start index of the memory block given by the MMU.
+ * @param channel Function generator channel.
+ * @param index Index of the polynomial within the ring.
+ */
+STATIC inline
+unsigned int fgDeepGetItemIndex( const unsigned int blockStart,
+                                 const unsigned int channel,
+                                 const unsigned int index )
+{
+   return fgDeepGetAdminIndex( blockStart, MAX_FG_CHANNELS ) +
+          (channel * FG_DEEP_BUFFER_ITEMS + index) * FG_DEEP_ITEM_SIZE64;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns the number of polynomials in a ring.
+ */
+STATIC inline
+unsigned int fgDeepGetLevel( const uint32_t wrIndex, const uint32_t rdIndex )
+{
+   return (wrIndex >= rdIndex)? (wrIndex - rdIndex) :
+                                (FG_DEEP_BUFFER_ITEMS - rdIndex + wrIndex);
+}
+
+#if defined(__lm32__) || defined(__DOXYGEN__)
+
+/*! ---------------------------------------------------------------------------
+ * @brief Allocates respectively finds the memory block of the deep
+ *        polynomial buffers by the MMU.
+ * @note Has to be invoked once after the initialization of the MMU.
+ */
+void fgDeepBufferInit( void );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Takes over whether the host uses the ring of the given channel
+ *        and fills the small buffer in the LM32 shared memory from it.
+ *
+ * Has to be invoked when the channel becomes enabled, before the first
+ * polynomial becomes read from the small buffer.
+ */
+void fgDeepArm( const unsigned int channel );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Refills the small buffer in the LM32 shared memory from the ring
+ *        of the given channel, when its level has reached
+ *        FG_DEEP_PREFETCH_THRESHOLD and the host uses the ring.
+ *
+ * Has to be invoked in the same context which reads the small buffer
+ * of this channel.
+ */
+void fgDeepPrefetch( const unsigned int channel );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Discards all polynomials in the ring of the given channel,
+ *        the channel uses the small buffer only until the next call
+ *        of fgDeepArm().
+ */
+void fgDeepFlush( const unsigned int channel );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns "true" when the host uses the ring of the given channel.
+ */
+bool fgDeepIsEnabled( const unsigned int channel );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns "true" once, when the level of the ring of the given
+ *        channel has fallen below FG_DEEP_REFILL_THRESHOLD since the last
+ *        call.
+ */
+bool fgDeepIsRefillDue( const unsigned int channel );
+
+#endif /* if defined(__lm32__) || defined(__DOXYGEN__) */
+
+#ifdef __cplusplus
+} /* namespace FG */
+} /* namespace Scu */
+} /* extern "C" */
+#endif
+#endif /* ifndef _SCU_FG_DEEP_BUFFER_H */
+/*================================== EOF ====================================*/
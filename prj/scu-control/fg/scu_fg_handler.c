@@ -12,6 +12,9 @@
  */
 #include <scu_fg_macros.h>
 #include "scu_fg_handler.h"
+#ifdef CONFIG_FG_DEEP_BUFFER
+  #include <scu_fg_deep_buffer.h>
+#endif
 
 /*!
  * @see scu_main.c
@@ -367,9 +370,13 @@ ONE_TIME_CALL bool feedAdacFg( FG_REGISTER_T* pThis )
 {
    FG_PARAM_SET_T pset;
 
-   /*!
-    * @todo Move the FG-buffer into the DDR3-RAM!
+#ifdef CONFIG_FG_DEEP_BUFFER
+   /*
+    * Refilling the buffer from the deep buffer in the DDR3-RAM
+    * respectively SRAM if necessary.
     */
+   fgDeepPrefetch( pThis->cntrl_reg.bv.number );
+#endif
    if( !cbReadPolynom( &g_shared.oSaftLib.oFg.aChannelBuffers[0],
                        &g_shared.oSaftLib.oFg.aRegs[0],
                        pThis->cntrl_reg.bv.number,
@@ -33,6 +33,9 @@
  #endif
 #endif
 #include "scu_fg_list.h"
+#ifdef CONFIG_FG_DEEP_BUFFER
+  #include <scu_fg_deep_buffer.h>
+#endif
 
 /*! ---------------------------------------------------------------------------
  * @brief Prints all found function generators.
@@ -260,6 +263,9 @@ void fgResetAndInit( const unsigned int channel )
    }
    g_shared.oSaftLib.oFg.aRegs[channel].wr_ptr = 0;
    g_shared.oSaftLib.oFg.aRegs[channel].rd_ptr = 0;
+#ifdef CONFIG_FG_DEEP_BUFFER
+   fgDeepFlush( channel );
+#endif
    g_shared.oSaftLib.oFg.aRegs[channel].state = STATE_STOPPED;
    g_shared.oSaftLib.oFg.aRegs[channel].ramp_count = 0;
 
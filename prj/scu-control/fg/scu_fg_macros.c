@@ -19,6 +19,9 @@
 #ifdef CONFIG_SCU_DAQ_INTEGRATION
    #include <daq_fg_switch.h>
 #endif
+#ifdef CONFIG_FG_DEEP_BUFFER
+   #include <scu_fg_deep_buffer.h>
+#endif
 
 #define CONFIG_DISABLE_FEEDBACK_IN_DISABLE_IRQ
 
@@ -336,6 +339,13 @@ void fgEnableChannel( const unsigned int channel )
    }
 #endif
 
+#ifdef CONFIG_FG_DEEP_BUFFER
+   /*
+    * Filling the buffer from the deep buffer if the host uses it.
+    */
+   fgDeepArm( channel );
+#endif
+
    FG_PARAM_SET_T pset;
   /*
    * Fetch first parameter set from buffer
@@ -419,6 +429,9 @@ void fgDisableChannel( const unsigned int channel )
                "Flush circular buffer of fg-%u-%u channel: %u\n" ESC_NORMAL,
                socket, dev, channel );
       flushCircularBuffer( pFgRegs );
+   #ifdef CONFIG_FG_DEEP_BUFFER
+      fgDeepFlush( channel );
+   #endif
    }
    pFgRegs->state = STATE_STOPPED;
    sendSignal( IRQ_DAT_DISARMED, channel );
@@ -512,6 +525,17 @@ void makeStop( const unsigned int channel )
  */
 void sendRefillSignalIfThreshold( const unsigned int channel )
 {
+#ifdef CONFIG_FG_DEEP_BUFFER
+   if( fgDeepIsEnabled( channel ) )
+   { /*
+      * The host fills the deep buffer, so the level of the deep buffer
+      * is the relevant one.
+      */
+      if( fgDeepIsRefillDue( channel ) )
+         sendSignal( IRQ_DAT_REFILL, channel );
+      return;
+   }
+#endif
    if( cbgetCountSafe( &g_shared.oSaftLib.oFg.aRegs[0], channel ) == FG_REFILL_THRESHOLD )
    {
      // mprintf( "*" ); //!!
@@ -20,6 +20,9 @@
   #endif
 #endif
 #include "scu_mil_fg_handler.h"
+#ifdef CONFIG_FG_DEEP_BUFFER
+  #include <scu_fg_deep_buffer.h>
+#endif
 #ifdef CONFIG_MIL_DAQ_USE_RAM
 extern DAQ_ADMIN_T g_scuDaqAdmin;
 #endif
@@ -645,7 +648,10 @@ void milInitTasks( void )
       }
    }
 #ifdef CONFIG_MIL_DAQ_USE_RAM
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( &g_shared.mDaq.memAdmin );
    ramRingSharedReset( &g_shared.mDaq.memAdmin );
+   ramRingSequenceUpdate( &g_shared.mdaqRingSequence, size,
+                          &g_shared.mDaq.memAdmin.indexes );
 #endif
 #ifdef CONFIG_READ_MIL_TIME_GAP
    for( unsigned int i = 0; i < ARRAY_SIZE( mg_aReadGap ); i++ )
@@ -893,18 +899,19 @@ STATIC inline void pushDaqData( FG_MACRO_T fgMacro,
       * Yes, removing the oldest item. 
       * Maybe the Linux-client doesn't run or is to slow.  
       */
+      const RAM_RING_INDEX_T size = ramRingGetSize( &indexes );
       ramRingAddToReadIndex( &indexes, ARRAY_SIZE(pl.ramPayload) );
+      /*
+       * Publishing the removing before the item becomes overwritten.
+       */
+      ramRingSequenceUpdate( &g_shared.mdaqRingSequence, size, &indexes );
    }
 
    /*
     * Writing the prepared data set into the DDR3-RAM organized
     * as circular buffer.
     */
-   for( unsigned int i = 0; i < ARRAY_SIZE(pl.ramPayload); i++ )
-   {
-      ramWriteItem( ramRingGetWriteIndex( &indexes ), &pl.ramPayload[i] );
-      ramRingIncWriteIndex( &indexes );
-   }
+   ramWriteItems( &indexes, pl.ramPayload, ARRAY_SIZE(pl.ramPayload) );
 
    /*
     * Making the modified memory indexes known for the Linux client.
@@ -1076,6 +1083,13 @@ void feedMilFg( const unsigned int channel,
    const unsigned int devNum = getDevice( channel );
 
    FG_PARAM_SET_T pset;
+#ifdef CONFIG_FG_DEEP_BUFFER
+   /*
+    * Refilling the circular buffer from the deep buffer in the DDR3-RAM
+    * respectively SRAM if necessary.
+    */
+   fgDeepPrefetch( channel );
+#endif
    /*
     * Reading circular buffer with new FG-data.
     */
@@ -1900,8 +1914,12 @@ void milExecuteTasks( void )
     * See daq_base_interface.cpp  function: DaqBaseInterface::getNumberOfNewData
     * See daq_base_interface.cpp  function: DaqBaseInterface::sendWasRead
     * See mdaq_administration.cpp function: DaqAdministration::distributeDataNew
+    * See circular_index.h         macro:    RAM_RING_PROTOCOL_FLAG
     */
+   const RAM_RING_INDEX_T size = ramRingSharedGetSize( &g_shared.mDaq.memAdmin );
    ramRingSharedSynchonizeReadIndex( &g_shared.mDaq.memAdmin );
+   ramRingSequenceUpdate( &g_shared.mdaqRingSequence, size,
+                          &g_shared.mDaq.memAdmin.indexes );
 #endif
 
    for( unsigned int i = 0; i < ARRAY_SIZE(mg_aMilTaskData); i++ )
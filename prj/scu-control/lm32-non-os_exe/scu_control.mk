@@ -21,6 +21,9 @@ ifdef SCU_MIL
 endif
  ADDAC_DAQ := 1
  DIOB_WITH_DAQ := 1
+# Time budget in microseconds for servicing all pending ADDAC-DAQ channels
+# per call of addacDaqTask, otherwise one channel per call.
+# ADDAC_DAQ_BUDGET_US := 200
 # DEFINES += _CONFIG_DBG_MIL_TASK
 #------------------------------------------------------------------------------
 
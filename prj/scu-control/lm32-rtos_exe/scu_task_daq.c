@@ -120,8 +120,11 @@ STATIC void taskDaq( void* pTaskData UNUSED )
        * See daq_base_interface.cpp  function: DaqBaseInterface::getNumberOfNewData
        * See daq_base_interface.cpp  function: DaqBaseInterface::sendWasRead
        * See daq_administration.cpp  function: DaqAdministration::distributeData
+       * See circular_index.h         macro:    RAM_RING_PROTOCOL_FLAG
        */
+      const RAM_RING_INDEX_T size = ramRingSharedGetSize( &GET_SHARED().ringAdmin );
       ramRingSharedSynchonizeReadIndex( &GET_SHARED().ringAdmin );
+      ramRingSequenceUpdate( GET_RING_SEQUENCE(), size, &GET_SHARED().ringAdmin.indexes );
 
       daqHandlePostMortem();
 
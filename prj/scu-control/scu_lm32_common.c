@@ -26,6 +26,9 @@
  */
 #include "scu_temperature.h"
 #include "scu_lm32_common.h"
+#ifdef CONFIG_FG_DEEP_BUFFER
+  #include <scu_fg_deep_buffer.h>
+#endif
 
 /*!
  * @brief Base pointer of SCU bus.
@@ -220,6 +223,10 @@ void mmuAllocateDaqBuffer( void )
    scuLog( LM32_LOG_INFO, "MIL-DAQ buffer capacity:   %5u item\n",
            g_shared.mDaq.memAdmin.indexes.capacity );
 #endif /* if defined( CONFIG_MIL_FG ) && defined( CONFIG_MIL_DAQ_USE_RAM ) */
+
+#ifdef CONFIG_FG_DEEP_BUFFER
+   fgDeepBufferInit();
+#endif
 }
 
 /*================================== EOF ====================================*/
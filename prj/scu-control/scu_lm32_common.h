@@ -218,7 +218,8 @@ void scanFgs( void );
 void initAndScan( void );
 
 /*! ---------------------------------------------------------------------------
- * @brief Allocates memory for MIL- and  ADDAC- DAQs
+ * @brief Allocates memory for MIL- and  ADDAC- DAQs and if configured
+ *        for the deep buffers of the function generators.
  */
 void mmuAllocateDaqBuffer( void );
 
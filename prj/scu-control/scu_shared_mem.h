@@ -448,6 +448,25 @@ typedef struct PACKED_SIZE
     */
    ADD_NAMESPACE( Scu::daq, DAQ_SHARED_IO_T ) sDaq;
 #endif
+
+   /*!
+    * @brief Capability of the handshake protocol of the MIL-DAQ and
+    *        ADDAC-DAQ ring buffers.
+    * @see RAM_RING_DIRECT_CAPABILITY
+    */
+   uint32_t    ringCapabilities;
+
+   /*!
+    * @brief Read sequence of the MIL-DAQ ring buffer.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   RAM_RING_SEQUENCE_T mdaqRingSequence;
+
+   /*!
+    * @brief Read sequence of the ADDAC-DAQ ring buffer.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   RAM_RING_SEQUENCE_T sdaqRingSequence;
 } SCU_SHARED_DATA_T;
 
 #if !defined(__DOXYGEN__) && defined(__lm32__)
@@ -531,12 +550,12 @@ STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, oSaftLib ) == 0 );
   #else
    STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, sDaq ) == DAQ_SHM_OFFET );
   #endif
-  STATIC_ASSERT( sizeof( SCU_SHARED_DATA_T ) ==
+  STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, ringCapabilities ) ==
                  offsetof( SCU_SHARED_DATA_T, sDaq ) +
                  sizeof( ADD_NAMESPACE( Scu::daq, DAQ_SHARED_IO_T ) ));
  #else /* ifdef CONFIG_SCU_DAQ_INTEGRATION */
   #ifdef CONFIG_MIL_DAQ_USE_RAM
-    STATIC_ASSERT( sizeof( SCU_SHARED_DATA_T ) ==
+    STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, ringCapabilities ) ==
                    offsetof( SCU_SHARED_DATA_T, ADD_NAMESPACE( Scu::MiLdaq, mDaq ) ) +
                    sizeof( ADD_NAMESPACE( Scu::MiLdaq, MIL_DAQ_ADMIN_T ) ));
   #else
@@ -545,6 +564,12 @@ STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, oSaftLib ) == 0 );
    //                sizeof( uint32_t ));
   #endif
  #endif /* / ifdef CONFIG_SCU_DAQ_INTEGRATION */
+STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, mdaqRingSequence ) ==
+               offsetof( SCU_SHARED_DATA_T, ringCapabilities ) + sizeof( uint32_t ));
+STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, sdaqRingSequence ) ==
+               offsetof( SCU_SHARED_DATA_T, mdaqRingSequence ) + sizeof( RAM_RING_SEQUENCE_T ));
+STATIC_ASSERT( sizeof( SCU_SHARED_DATA_T ) ==
+               offsetof( SCU_SHARED_DATA_T, sdaqRingSequence ) + sizeof( RAM_RING_SEQUENCE_T ));
 
 /* ++++++++++++++ Initializer ++++++++++++++++++++++++++++++++++++++++++++++ */
 /*!
@@ -599,6 +624,9 @@ STATIC_ASSERT( offsetof( SCU_SHARED_DATA_T, oSaftLib ) == 0 );
    .oSaftLib.oFg.busy                       = 0                       \
    __MIL_DAQ_SHARAD_MEM_INITIALIZER_ITEM                              \
    __DAQ_SHARAD_MEM_INITIALIZER_ITEM                                  \
+   , .ringCapabilities = RAM_RING_DIRECT_CAPABILITY                   \
+   , .mdaqRingSequence = 0                                            \
+   , .sdaqRingSequence = 0                                            \
 }
 
 /* ++++++++++ End  Initializer +++++++++++++++++++++++++++++++++++++++++++++ */
@@ -189,6 +189,193 @@ RAM_RING_INDEX_T ramRingGetUpperWriteSize( const RAM_RING_INDEXES_T* pThis )
    return pThis->capacity - pThis->end;
 }
 
+/*! ---------------------------------------------------------------------------
+ * @see circular_index.h
+ */
+RAM_RING_INDEX_T ramRingSharedGetDirectRequest( const RAM_RING_SHARED_INDEXES_T* pThis )
+{
+   const RAM_RING_INDEX_T capacity = pThis->indexes.capacity;
+
+   RAM_ASSERT( (capacity > 0) && (capacity < RAM_RING_DIRECT_FLAG) );
+   /*
+    * Smallest multiple of the capacity which is not smaller than bit 31.
+    * It stays below RAM_RING_HANDSHAKE_MASK because the capacity is smaller
+    * than bit 30.
+    */
+   return ((RAM_RING_PROTOCOL_FLAG + capacity - 1) / capacity) * capacity;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see circular_index.h
+ */
+bool ramRingSharedSynchonizeReadIndex( RAM_RING_SHARED_INDEXES_T* pThis )
+{
+   if( ramRingSharedIsDirect( pThis ) )
+   {
+      const RAM_RING_INDEX_T readIndex = ramRingSharedGetConsumerIndex( pThis );
+      if( (readIndex >= pThis->indexes.capacity) || ramRingIsFull( &pThis->indexes ) )
+         return false;
+
+      const RAM_RING_INDEX_T consumed = (readIndex + pThis->indexes.capacity
+                                         - pThis->indexes.start)
+                                        % pThis->indexes.capacity;
+      /*
+       * Is the read index of the client outside of the valid payload,
+       * then the server has overwritten it in the meantime.
+       */
+      if( consumed <= ramRingGetSize( &pThis->indexes ) )
+         ramRingAddToReadIndex( &pThis->indexes, consumed );
+      return false;
+   }
+
+   if( ramRingSharedIsDirectRequest( pThis ) )
+   { /*
+      * Accepting the direct protocol, the client continues at the
+      * current read index.
+      */
+      ramRingSharedSetConsumerIndex( pThis, pThis->indexes.start );
+      return true;
+   }
+
+   if( pThis->wasRead == 0 )
+      return false;
+
+   ramRingAddToReadIndex( &pThis->indexes, pThis->wasRead );
+   pThis->wasRead = 0;
+   return true;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see circular_index.h
+ */
+void ramRingClientInit( RAM_RING_CLIENT_T* pThis,
+                        const RAM_RING_SHARED_INDEXES_T* pShared,
+                        const RAM_RING_SEQUENCE_T* pSequence )
+{
+   pThis->readIndex     = ramRingSharedGetConsumerIndex( pShared );
+   pThis->serverStart   = pShared->indexes.start;
+   pThis->serverFull    = false;
+   pThis->wholeRingRead = false;
+   pThis->hasSequence   = (pSequence != NULL);
+   pThis->sequence      = 0;
+   if( pThis->hasSequence && (pShared->indexes.capacity > 0) )
+   { /*
+      * Items between the read index of the server and the own one has been
+      * already consumed in a previous session.
+      */
+      pThis->sequence = *pSequence + (pThis->readIndex + pShared->indexes.capacity
+                                      - pShared->indexes.start)
+                                     % pShared->indexes.capacity;
+   }
+   pThis->viewSequence  = pThis->sequence;
+   pThis->viewSize      = 0;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see circular_index.h
+ */
+bool ramRingClientGetView( RAM_RING_CLIENT_T* pThis,
+                           RAM_RING_INDEXES_T* pView,
+                           const RAM_RING_SHARED_INDEXES_T* pShared,
+                           const RAM_RING_SEQUENCE_T* pSequence )
+{
+   const RAM_RING_INDEX_T capacity = pShared->indexes.capacity;
+
+   *pView = pShared->indexes;
+
+   if( pThis->hasSequence && (pSequence != NULL) )
+   { /*
+      * The positions become taken from the indexes only, because the
+      * server can't modify them and the read sequence at once. The read
+      * sequence detects the overrun and distinguishes a full ring read
+      * completely by the client from an unread one.
+      */
+      const RAM_RING_SEQUENCE_T behind = *pSequence - pThis->sequence;
+      RAM_RING_INDEX_T ahead = (pThis->readIndex + capacity - pView->start) % capacity;
+
+      pThis->serverStart = pView->start;
+      if( (pThis->readIndex >= capacity) || ((int32_t)behind > 0) ||
+          (ahead > ramRingGetSize( pView )) )
+      { /*
+         * Server has overwritten unread items, continuing at the oldest one.
+         */
+         pThis->readIndex    = pView->start;
+         pThis->sequence     = *pSequence;
+         pThis->viewSequence = pThis->sequence;
+         pThis->viewSize     = ramRingGetSize( pView );
+         return false;
+      }
+
+      if( (ahead == 0) && (behind != 0) && ramRingIsFull( pView ) )
+         ahead = capacity;
+
+      ramRingAddToReadIndex( pView, ahead );
+      pThis->viewSequence = pThis->sequence;
+      pThis->viewSize     = ramRingGetSize( pView );
+      return true;
+   }
+
+   /*
+    * Distance of the own read index to the read index of the server
+    * at the last view, and the distance the server has moved its
+    * read index since then.
+    */
+   const RAM_RING_INDEX_T distance = pThis->wholeRingRead? capacity :
+                      (pThis->readIndex + capacity - pThis->serverStart) % capacity;
+   const RAM_RING_INDEX_T moved =
+                      (pView->start + capacity - pThis->serverStart) % capacity;
+
+   RAM_RING_INDEX_T ahead = (pThis->readIndex + capacity - pView->start) % capacity;
+
+   pThis->serverStart = pView->start;
+   pThis->serverFull  = ramRingIsFull( pView );
+
+   if( (pThis->readIndex >= capacity) || (moved > distance) ||
+       (ahead > ramRingGetSize( pView )) )
+   { /*
+      * Server has overwritten unread items, continuing at the oldest one.
+      */
+      pThis->readIndex     = pView->start;
+      pThis->wholeRingRead = false;
+      return false;
+   }
+
+   pThis->wholeRingRead = pThis->wholeRingRead && (ahead == 0) && pThis->serverFull;
+   if( pThis->wholeRingRead )
+      ahead = capacity;
+
+   ramRingAddToReadIndex( pView, ahead );
+   return true;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see circular_index.h
+ */
+RAM_RING_INDEX_T ramRingClientRelease( RAM_RING_CLIENT_T* pThis,
+                                       const RAM_RING_INDEXES_T* pView,
+                                       const RAM_RING_SEQUENCE_T* pSequence )
+{
+   if( pThis->hasSequence )
+   {
+      if( (pSequence != NULL) && ((int32_t)(*pSequence - pThis->viewSequence) > 0) )
+      { /*
+         * Server has removed items of the view which the client hasn't
+         * released yet, they are possibly overwritten.
+         */
+         return pThis->readIndex;
+      }
+      /*
+       * The write index of the view stays unchanged by reading.
+       */
+      pThis->sequence = pThis->viewSequence + pThis->viewSize - ramRingGetSize( pView );
+   }
+
+   pThis->readIndex = pView->start;
+   if( pThis->serverFull && ramRingIsEmpty( pView ) )
+      pThis->wholeRingRead = true;
+   return pThis->readIndex;
+}
+
 #ifdef CONFIG_CIRCULAR_DEBUG
 /*! ---------------------------------------------------------------------------
  * @brief Prints the values of the members of RAM_RING_INDEXES_T
@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <helper_macros.h>
 
 #ifdef CONFIG_RAM_PEDANTIC_CHECK
@@ -209,6 +210,10 @@ typedef struct PACKED_SIZE
     * @brief Holds the number of memory items which has been read by the
     *        client.
     * This will also need for a handshaking transfer.
+    *
+    * When the flags RAM_RING_PROTOCOL_FLAG and RAM_RING_DIRECT_FLAG are set,
+    * then this word holds the read index published by the client itself.
+    * @see RAM_RING_PROTOCOL_FLAG
     */
    RAM_RING_INDEX_T   wasRead;
 } RAM_RING_SHARED_INDEXES_T;
@@ -216,6 +221,98 @@ typedef struct PACKED_SIZE
 STATIC_ASSERT( offsetof( RAM_RING_SHARED_INDEXES_T, indexes ) == 0 );
 STATIC_ASSERT( offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ) == sizeof( RAM_RING_INDEXES_T ));
 
+/*!
+ * @ingroup SHARED_MEMORY
+ * @brief Handshake flag in RAM_RING_SHARED_INDEXES_T::wasRead.
+ *
+ * A legacy "was read" value can never exceed the capacity, so a set
+ * bit 31 marks a value of the direct handshake protocol:
+ *
+ * - Only RAM_RING_PROTOCOL_FLAG set: Request of the client to switch into the
+ *   direct protocol. The value is a multiple of the capacity, so that
+ *   a legacy server which adds it to the read index will not move the read
+ *   index and clears this word, which the client recognizes as refusal.
+ * - RAM_RING_PROTOCOL_FLAG and RAM_RING_DIRECT_FLAG set: The remaining bits
+ *   are the read index owned and published by the client. The server takes
+ *   it over without any acknowledge and never writes this word anymore.
+ *
+ * The server remains the owner of the members start and end of
+ * RAM_RING_SHARED_INDEXES_T::indexes, start is the oldest item which is
+ * still reserved for the client.
+ */
+#define RAM_RING_PROTOCOL_FLAG ((RAM_RING_INDEX_T)0x80000000)
+
+/*!
+ * @ingroup SHARED_MEMORY
+ * @brief Flag of protocol version one: client publishes its read index.
+ * @see RAM_RING_PROTOCOL_FLAG
+ */
+#define RAM_RING_DIRECT_FLAG   ((RAM_RING_INDEX_T)0x40000000)
+
+/*!
+ * @ingroup SHARED_MEMORY
+ * @brief Mask of the handshake flags in RAM_RING_SHARED_INDEXES_T::wasRead.
+ */
+#define RAM_RING_HANDSHAKE_MASK (RAM_RING_PROTOCOL_FLAG | RAM_RING_DIRECT_FLAG)
+
+/*!
+ * @ingroup SHARED_MEMORY
+ * @brief Capability word published by a server which supports the direct
+ *        protocol.
+ *
+ * The client may request the direct protocol only when the server publishes
+ * this value outside of RAM_RING_SHARED_INDEXES_T. A legacy server adds the
+ * request to its read index, that would destroy a ring buffer which has
+ * become full between the check of the client and the synchronization of
+ * the server.
+ * @see RAM_RING_PROTOCOL_FLAG
+ */
+#define RAM_RING_DIRECT_CAPABILITY ((uint32_t)0x52494E47)
+
+/*!
+ * @ingroup SHARED_MEMORY
+ * @brief Data type of the read sequence of a ring buffer.
+ *
+ * Counts all items which the server has removed from the ring buffer,
+ * acknowledged by the client or overwritten, modulo 2^32. It becomes
+ * published by a server supporting RAM_RING_DIRECT_CAPABILITY beside the
+ * capability word.
+ *
+ * Unlike the read index it is unambiguous even for a full ring buffer:
+ * the items beginning at the absolute sequence of the client are intact as
+ * long as the sequence of the server hasn't passed it. Because the server
+ * increments it before it overwrites the removed items, a client which
+ * reads it after the data within the same bus cycle recognizes torn reads
+ * as well.
+ * @see ramRingSequenceUpdate
+ */
+typedef uint32_t RAM_RING_SEQUENCE_T;
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Counts the items which the server has removed from the ring buffer
+ *        since the given size, in the read sequence.
+ * @note The server has to call it after each modification of the read
+ *       index and before writing new items.
+ * @param pSequence Pointer to the read sequence, NULL if the server
+ *                  doesn't publish any.
+ * @param sizeBefore Number of items before the read index has been moved.
+ * @param pIndexes Indexes after the read index has been moved.
+ */
+STATIC inline
+void ramRingSequenceUpdate( RAM_RING_SEQUENCE_T* pSequence,
+                            const RAM_RING_INDEX_T sizeBefore,
+                            const RAM_RING_INDEXES_T* pIndexes )
+{
+   if( pSequence == NULL )
+      return;
+   /*
+    * Volatile access so the compiler can't defer it behind the
+    * writing of the new items.
+    */
+   *((volatile RAM_RING_SEQUENCE_T*)pSequence) += sizeBefore - ramRingGetSize( pIndexes );
+}
+
 /*! ---------------------------------------------------------------------------
  * @ingroup SHARED_MEMORY
  * @brief Returns the number of currently used memory items
@@ -277,23 +374,211 @@ void ramRingSharedAddToReadIndex( RAM_RING_SHARED_INDEXES_T* pThis,
    ramRingAddToReadIndex( &pThis->indexes, toAdd );
 }
 
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Returns "true" when the client publishes its read index directly.
+ * @see RAM_RING_PROTOCOL_FLAG
+ * @param pThis Pointer to the shared ring indexes object.
+ */
+STATIC inline
+bool ramRingSharedIsDirect( const RAM_RING_SHARED_INDEXES_T* pThis )
+{
+   return (pThis->wasRead & RAM_RING_HANDSHAKE_MASK) == RAM_RING_HANDSHAKE_MASK;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Returns "true" when the client requests the direct protocol and
+ *        the server has not answered yet.
+ * @see RAM_RING_PROTOCOL_FLAG
+ * @param pThis Pointer to the shared ring indexes object.
+ */
+STATIC inline
+bool ramRingSharedIsDirectRequest( const RAM_RING_SHARED_INDEXES_T* pThis )
+{
+   return (pThis->wasRead & RAM_RING_HANDSHAKE_MASK) == RAM_RING_PROTOCOL_FLAG;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Returns the read index published by the client in the direct
+ *        protocol.
+ * @param pThis Pointer to the shared ring indexes object.
+ */
+STATIC inline
+RAM_RING_INDEX_T ramRingSharedGetConsumerIndex( const RAM_RING_SHARED_INDEXES_T* pThis )
+{
+   return pThis->wasRead & ~RAM_RING_HANDSHAKE_MASK;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Sets the read index which the client publishes in the direct
+ *        protocol.
+ * @param pThis Pointer to the shared ring indexes object.
+ * @param index Relative read index in the range of 0 to capacity - 1.
+ */
+STATIC inline
+void ramRingSharedSetConsumerIndex( RAM_RING_SHARED_INDEXES_T* pThis,
+                                    const RAM_RING_INDEX_T index )
+{
+   RAM_ASSERT( index < pThis->indexes.capacity );
+   pThis->wasRead = RAM_RING_HANDSHAKE_MASK | index;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Returns the value which the client has to write in
+ *        RAM_RING_SHARED_INDEXES_T::wasRead to request the direct protocol.
+ *
+ * The value is the smallest multiple of the capacity with bit 31 set.
+ * A legacy server adds it to the read index, which doesn't move the read
+ * index as long as the ring buffer is not full.
+ * @note Therefore the client shall send the request only when it has
+ *       seen a not full ring buffer.
+ * @param pThis Pointer to the shared ring indexes object.
+ */
+RAM_RING_INDEX_T ramRingSharedGetDirectRequest( const RAM_RING_SHARED_INDEXES_T* pThis );
+
 /*! ---------------------------------------------------------------------------
  * @ingroup SHARED_MEMORY
  * @brief Synchronizes the read index of the number of items which has been
  *        read by the client.
  * @note This shall be the job of the server only, to prevent possible
  *       race conditions.
- * 
- * In this way a handshaking transfer becomes possible.
+ *
+ * Legacy protocol: The read index becomes incremented by the value of
+ * wasRead and wasRead becomes cleared as acknowledge for the client.
+ *
+ * Direct protocol: The read index becomes moved to the read index
+ * published by the client, if it is within the valid payload and the ring
+ * buffer is not full. A full ring buffer doesn't allow to distinguish
+ * whether the client is ahead or has been overtaken, in this case the
+ * server makes space by removing the oldest items as before and the client
+ * detects an overrun by itself. The member wasRead stays untouched.
+ *
+ * A request for the direct protocol becomes answered by publishing the
+ * current read index in wasRead, that is the only case the server
+ * writes wasRead in the direct protocol.
  *
  * @param pThis Pointer to the shared ring indexes object.
+ * @retval true The member wasRead has been modified.
+ * @retval false The member wasRead is unchanged, the server doesn't need to
+ *               write it back.
  */
-STATIC inline
-void ramRingSharedSynchonizeReadIndex( RAM_RING_SHARED_INDEXES_T* pThis )
-{
-   ramRingSharedAddToReadIndex( pThis, pThis->wasRead );
-   pThis->wasRead = 0;
-}
+bool ramRingSharedSynchonizeReadIndex( RAM_RING_SHARED_INDEXES_T* pThis );
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief State of a client of the direct protocol.
+ * @see RAM_RING_PROTOCOL_FLAG
+ */
+typedef struct
+{  /*!
+    * @brief Own relative read index of the client.
+    */
+   RAM_RING_INDEX_T readIndex;
+
+   /*!
+    * @brief Read index of the server seen by the last view.
+    *
+    * The server moves its read index forward only, so the client
+    * recognizes by it whether the server has overwritten unread items.
+    */
+   RAM_RING_INDEX_T serverStart;
+
+   /*!
+    * @brief The server indexes of the last view indicated a full ring.
+    */
+   bool             serverFull;
+
+   /*!
+    * @brief The client has read the whole full ring buffer.
+    *
+    * In this case the read index of the client is equal to the read index
+    * of the server, like in the case the server has filled the whole
+    * ring buffer.
+    */
+   bool             wholeRingRead;
+
+   /*!
+    * @brief The server publishes a read sequence, the members below
+    *        are valid.
+    * @see RAM_RING_SEQUENCE_T
+    */
+   bool             hasSequence;
+
+   /*!
+    * @brief Absolute sequence of the own read index.
+    */
+   RAM_RING_SEQUENCE_T sequence;
+
+   /*!
+    * @brief Absolute sequence of the first item of the last view.
+    */
+   RAM_RING_SEQUENCE_T viewSequence;
+
+   /*!
+    * @brief Number of items of the last view.
+    */
+   RAM_RING_INDEX_T    viewSize;
+} RAM_RING_CLIENT_T;
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Initializes the client state by the answer of the server,
+ *        respectively by the read index published in a previous session.
+ * @param pThis Pointer to the client state.
+ * @param pShared Indexes read from the server.
+ * @param pSequence Read sequence read from the server together with the
+ *                  indexes, NULL if the server doesn't publish any.
+ */
+void ramRingClientInit( RAM_RING_CLIENT_T* pThis,
+                        const RAM_RING_SHARED_INDEXES_T* pShared,
+                        const RAM_RING_SEQUENCE_T* pSequence );
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Builds the view of the client in the direct protocol.
+ *
+ * The view is a copy of the server indexes beginning at the own read index
+ * of the client, so all ring functions for reading can be used on it.
+ *
+ * When the server publishes a read sequence, the overrun and a completely
+ * read full ring become detected by it, otherwise by the movement of the
+ * read index of the server.
+ *
+ * @param pThis Pointer to the client state.
+ * @param pView Target for the view of the client.
+ * @param pShared Indexes read from the server.
+ * @param pSequence Read sequence read from the server together with the
+ *                  indexes, NULL if the server doesn't publish any.
+ * @retval true View is valid.
+ * @retval false The server has overwritten unread items of the client,
+ *               the view begins at the oldest valid item of the server.
+ */
+bool ramRingClientGetView( RAM_RING_CLIENT_T* pThis,
+                           RAM_RING_INDEXES_T* pView,
+                           const RAM_RING_SHARED_INDEXES_T* pShared,
+                           const RAM_RING_SEQUENCE_T* pSequence );
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SHARED_MEMORY
+ * @brief Takes over the read index of the view after reading.
+ *
+ * When the given read sequence of the server has passed the begin of the
+ * last view, the server has overwritten items of it. In this case the
+ * read index stays unchanged and the next view reports the overrun.
+ * @param pThis Pointer to the client state.
+ * @param pView View of the client after reading.
+ * @param pSequence Latest read sequence read from the server, NULL if
+ *                  the server doesn't publish any.
+ * @return Relative read index to publish.
+ * @see ramRingSharedSetConsumerIndex
+ */
+RAM_RING_INDEX_T ramRingClientRelease( RAM_RING_CLIENT_T* pThis,
+                                       const RAM_RING_INDEXES_T* pView,
+                                       const RAM_RING_SEQUENCE_T* pSequence );
 
 /*! ---------------------------------------------------------------------------
  * @ingroup SHARED_MEMORY
@@ -309,6 +594,8 @@ void ramRingSharedIncReadIndex( RAM_RING_SHARED_INDEXES_T* pThis )
 /*! ---------------------------------------------------------------------------
  * @ingroup SHARED_MEMORY
  * @brief Resets respectively clears the ring buffer
+ * @note The handshake falls back to the legacy protocol, so a client of the
+ *       direct protocol has to request it again.
  * @param pThis Pointer to the shared ring indexes object.
  */
 STATIC inline void ramRingSharedReset( RAM_RING_SHARED_INDEXES_T* pThis )
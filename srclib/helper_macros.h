@@ -688,8 +688,65 @@
    __FUNCTION_BODY_CONVERT_BYTE_ENDIAN( TYP )
 
 #if defined(__cplusplus ) || defined(__DOXYGEN__)
+#include <stdint.h>
+
 namespace gsi
 {
+/*!
+ * @brief Helper for template convertByteEndian, reverses the bytes
+ *        one by one for types of any size.
+ * @note For C++ only!
+ */
+template <typename TYP, size_t SIZE = sizeof(TYP)>
+struct ByteEndianConverter
+{
+   static TYP convert( const TYP value )
+      __FUNCTION_BODY_CONVERT_BYTE_ENDIAN( TYP )
+};
+
+/*!
+ * @brief Single byte, nothing to do.
+ */
+template <typename TYP>
+struct ByteEndianConverter<TYP, sizeof(uint8_t)>
+{
+   static TYP convert( const TYP value )
+   {
+      return value;
+   }
+};
+
+#if defined( __GNUC__ ) && \
+   ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)))
+/*!
+ * @brief Generates a specialization of ByteEndianConverter for the size
+ *        of the given unsigned integer type, using the byte-swap
+ *        instruction of the processor.
+ *
+ * The copy by __builtin_memcpy makes it usable for non integer types
+ * of the same size as well, the compiler removes it.
+ */
+#define __BYTE_ENDIAN_CONVERTER_BUILTIN( UTYP, BITS )                       \
+template <typename TYP>                                                      \
+struct ByteEndianConverter<TYP, sizeof(UTYP)>                                \
+{                                                                            \
+   static TYP convert( const TYP value )                                     \
+   {                                                                         \
+      UTYP v;                                                                \
+      __builtin_memcpy( &v, &value, sizeof(v) );                             \
+      v = __builtin_bswap##BITS( v );                                        \
+      TYP result;                                                            \
+      __builtin_memcpy( &result, &v, sizeof(result) );                       \
+      return result;                                                         \
+   }                                                                         \
+};
+
+__BYTE_ENDIAN_CONVERTER_BUILTIN( uint16_t, 16 )
+__BYTE_ENDIAN_CONVERTER_BUILTIN( uint32_t, 32 )
+__BYTE_ENDIAN_CONVERTER_BUILTIN( uint64_t, 64 )
+#undef __BYTE_ENDIAN_CONVERTER_BUILTIN
+#endif
+
 /*!
  * @brief Template converts the given value from little to big endian
  *        or vice versa.
@@ -698,7 +755,9 @@ namespace gsi
  * @return Converted value.
  */
 template <typename TYP> TYP convertByteEndian( const TYP value )
-   __FUNCTION_BODY_CONVERT_BYTE_ENDIAN( TYP )
+{
+   return ByteEndianConverter<TYP>::convert( value );
+}
 
 /*!
  * @brief Checks whether a number is within the given range of
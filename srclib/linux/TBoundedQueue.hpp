@@ -0,0 +1,200 @@
+/*!
+ * @file TBoundedQueue.hpp
+ * @brief Template of a blocking queue with a limited number of items,
+ *        for connecting the stages of a thread pipeline.
+ *
+ * @note  Header only.
+ *
+ * @copyright GSI Helmholtz Centre for Heavy Ion Research GmbH
+ * @author    Ulrich Becker <u.becker@gsi.de>
+ * @date      16.10.2026
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _TBOUNDEDQUEUE_HPP
+#define _TBOUNDEDQUEUE_HPP
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <assert.h>
+
+namespace Scu
+{
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Blocking queue for one or more producers and one consumer.
+ *
+ * A producer becomes blocked as long as the queue is full, that means
+ * a slow consumer throttles its producers (back pressure) instead of
+ * consuming unlimited memory.
+ * The consumer becomes blocked as long as the queue is empty.
+ *
+ * After close() the consumer receives the remaining items and afterwards
+ * pop() returns false, and all producers will released.
+ *
+ * @note In contrast to the lock-free rings TSpscRing and TSpmcRing the
+ *       payload can be any movable type, e.g. std::vector or std::string.
+ * @param PL_T Payload type.
+ */
+template <typename PL_T>
+class TBoundedQueue
+{
+   std::deque<PL_T>        m_queue;
+   const std::size_t       m_capacity;
+   std::size_t             m_maxSize;
+   bool                    m_closed;
+   mutable std::mutex      m_oMutex;
+   std::condition_variable m_notEmpty;
+   std::condition_variable m_notFull;
+
+public:
+   /*!
+    * @brief Constructor
+    * @param capacity Maximum number of items.
+    */
+   TBoundedQueue( const std::size_t capacity )
+      :m_capacity( capacity )
+      ,m_maxSize( 0 )
+      ,m_closed( false )
+   {
+      assert( capacity > 0 );
+   }
+
+   /*!
+    * @brief Returns the maximum number of items.
+    */
+   std::size_t getCapacity( void ) const
+   {
+      return m_capacity;
+   }
+
+   /*!
+    * @brief Returns the number of currently queued items.
+    */
+   std::size_t size( void ) const
+   {
+      std::lock_guard<std::mutex> lock( m_oMutex );
+      return m_queue.size();
+   }
+
+   /*!
+    * @brief Returns the maximum number of items which has been queued
+    *        at the same time (high water mark).
+    */
+   std::size_t getMaxSize( void ) const
+   {
+      std::lock_guard<std::mutex> lock( m_oMutex );
+      return m_maxSize;
+   }
+
+   bool isClosed( void ) const
+   {
+      std::lock_guard<std::mutex> lock( m_oMutex );
+      return m_closed;
+   }
+
+   /*!
+    * @brief Producer: Appends the given item, waits as long as the queue
+    *        is full.
+    * @retval true  Item has been queued.
+    * @retval false Queue has been closed, the item has been dropped.
+    */
+   bool push( PL_T&& rPl )
+   {
+      std::unique_lock<std::mutex> lock( m_oMutex );
+      m_notFull.wait( lock, [this]{ return m_closed || (m_queue.size() < m_capacity); } );
+      if( m_closed )
+         return false;
+
+      m_queue.push_back( std::move( rPl ) );
+      if( m_queue.size() > m_maxSize )
+         m_maxSize = m_queue.size();
+      lock.unlock();
+      m_notEmpty.notify_one();
+      return true;
+   }
+
+   /*!
+    * @brief Consumer: Removes the oldest item, waits as long as the queue
+    *        is empty.
+    * @retval true  Item has been removed and moved in rPl.
+    * @retval false Queue has been closed and is empty.
+    */
+   bool pop( PL_T& rPl )
+   {
+      std::unique_lock<std::mutex> lock( m_oMutex );
+      m_notEmpty.wait( lock, [this]{ return m_closed || !m_queue.empty(); } );
+      if( m_queue.empty() )
+         return false;
+
+      rPl = std::move( m_queue.front() );
+      m_queue.pop_front();
+      lock.unlock();
+      m_notFull.notify_all();
+      return true;
+   }
+
+   /*!
+    * @brief Consumer: Removes all queued items at once and appends them
+    *        to rvPl, waits as long as the queue is empty.
+    * @retval true  At least one item has been removed.
+    * @retval false Queue has been closed and is empty.
+    */
+   bool popAll( std::vector<PL_T>& rvPl )
+   {
+      std::unique_lock<std::mutex> lock( m_oMutex );
+      m_notEmpty.wait( lock, [this]{ return m_closed || !m_queue.empty(); } );
+      if( m_queue.empty() )
+         return false;
+
+      for( auto& rPl: m_queue )
+         rvPl.push_back( std::move( rPl ) );
+      m_queue.clear();
+      lock.unlock();
+      m_notFull.notify_all();
+      return true;
+   }
+
+   /*!
+    * @brief Closes the queue: Further items will rejected and all
+    *        waiting threads become released.
+    */
+   void close( void )
+   {
+      {
+         std::lock_guard<std::mutex> lock( m_oMutex );
+         m_closed = true;
+      }
+      m_notEmpty.notify_all();
+      m_notFull.notify_all();
+   }
+
+   /*!
+    * @brief Reopens a closed queue and removes possible remaining items.
+    */
+   void reopen( void )
+   {
+      std::lock_guard<std::mutex> lock( m_oMutex );
+      m_queue.clear();
+      m_closed = false;
+   }
+}; /* class TBoundedQueue */
+
+} /* End namespace Scu */
+#endif /* ifndef _TBOUNDEDQUEUE_HPP */
+//================================== EOF ======================================
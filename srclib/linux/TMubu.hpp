@@ -2,7 +2,7 @@
  * @file TMubu.hpp
  * @brief Template managing circular thread-safe buffers (FiFos) which
  *        has one data source but could have one or more data sinks.
- *        Based on boost::circular_buffer.
+ *        Based on the lock-free broadcast ring TSpmcRing.
  *
  * @note  Header only.
  *
@@ -27,11 +27,14 @@
 #ifndef _TMUBU_HPP
 #define _TMUBU_HPP
 
-#include <boost/circular_buffer.hpp>
+#include <TSpmcRing.hpp>
 #include <list>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <exception>
+#include <stdexcept>
+#include <algorithm>
 
 namespace mubu
 {
@@ -39,125 +42,100 @@ namespace mubu
 /*!
  * @brief Template-class managing circular thread-safe buffers (FiFos)
  *        which has one data source but could have one or more data sinks.
- *        Based on boost::circular_buffer.
- * @param PL_T Payload type.
+ *
+ * Facade of the lock-free broadcast ring TSpmcRing: All buffers share
+ * one ring, each buffer is a read cursor of a consumer. Therefore a push
+ * doesn't take any mutex and its effort doesn't depend on the number
+ * of buffers. The mutex protects the list of buffers only.
+ * As before the oldest items of a full buffer become overwritten,
+ * they are counted by Buffer::getOverrunCount().
+ *
+ * @note CAUTION: Only one thread may push and only one thread per buffer
+ *       may read respectively remove items of this buffer!
+ * @param PL_T Payload type, it has to be trivially copyable.
  * @param ID_T Buffer-Identification type.
  */
 template <typename PL_T, typename ID_T=uint>
 class TMultiBuffer
 {
 public:
-   using CB_T     = boost::circular_buffer<PL_T>;
+   using RING_T   = TSpmcRing<PL_T>;
    using VECTOR_T = std::vector<PL_T>;
    using MUTEX_T  = std::lock_guard<std::mutex>;
 
    /*!
     * @brief Class for a single circular buffer of multi- buffer.
     */
-   class Buffer: public CB_T
+   class Buffer: public RING_T::Cursor
    {
+      using CURSOR_T = typename RING_T::Cursor;
+
       TMultiBuffer* m_pParent;
-      std::mutex    m_mutex;
       const ID_T    m_id;
 
    public:
       Buffer( TMultiBuffer* pParent, ID_T id, std::size_t size ):
-         CB_T( size ),
+         CURSOR_T( pParent->m_oRing, size ),
          m_pParent( pParent ),
          m_id( id )
       {}
 
-      std::size_t erase( std::size_t max )
-      {
-         MUTEX_T lock(m_mutex);
-
-         max = std::min( CB_T::size(), max );
-         CB_T::erase( CB_T::begin(), CB_T::begin() + max );
-
-         return max;
-      }
-
-      void push( const PL_T& rPl )
-      {
-         MUTEX_T lock(m_mutex);
-         CB_T::push_back( rPl );
-      }
-
-      void push( const VECTOR_T& rvPl )
+      std::size_t capacity()
       {
-         MUTEX_T lock(m_mutex);
-      #if 1
-         CB_T::insert( CB_T::end(), rvPl.begin(), rvPl.end() );
-      #else
-         for( const auto& rPl: rvPl )
-            CB_T::push_back( rPl );
-      #endif
+         return CURSOR_T::getCapacity();
       }
 
+      /*!
+       * @brief Returns the effective capacity of this buffer.
+       * @see TMultiBuffer::createBuffer
+       */
       std::size_t getCapacity()
       {
-         return CB_T::capacity();
+         return CURSOR_T::getCapacity();
       }
 
-      std::size_t copy( PL_T* pPl, const std::size_t max )
+      /*!
+       * @brief Producer: Appends a item.
+       * @note All buffers share one ring, so the item becomes appended
+       *       to all buffers of the multi-buffer.
+       */
+      void push( const PL_T& rPl )
       {
-         MUTEX_T lock(m_mutex);
-
-         auto array1 = CB_T::array_one();
-         std::size_t toCopy = std::min( array1.second, max );
-         if( toCopy > 0 )
-            std::copy( array1.first, array1.first + toCopy, pPl );
-
-         if( toCopy == max )
-            return max;
-
-         const std::size_t copied = toCopy;
-         auto array2 = CB_T::array_two();
-         toCopy = std::min( array2.second, max - copied );
-         if( toCopy > 0 )
-            std::copy( array2.first, array2.first + toCopy, pPl + copied );
-
-         return copied + toCopy;
+         m_pParent->push( rPl );
       }
 
-      std::size_t copy( VECTOR_T& rvPl, const std::size_t max )
+      /*!
+       * @brief Producer: Appends the items of the vector.
+       * @note All buffers share one ring, so the items become appended
+       *       to all buffers of the multi-buffer.
+       */
+      void push( const VECTOR_T& rvPl )
       {
-         rvPl.reserve( max );
-
-         MUTEX_T lock(m_mutex);
-
-         auto array1 = CB_T::array_one();
-         std::size_t toCopy = std::min( array1.second, max );
-         if( toCopy > 0 )
-            rvPl.insert( rvPl.end(), array1.first, array1.first + toCopy );
-
-         if( toCopy == max )
-            return max;
-
-         const std::size_t copied = toCopy;
-         auto array2 = CB_T::array_two();
-         toCopy = std::min( array2.second, max - copied );
-         if( toCopy > 0 )
-            rvPl.insert( rvPl.end(), array2.first, array2.first + toCopy );
-
-         return copied + toCopy;
+         m_pParent->push( rvPl );
       }
 
+      using CURSOR_T::copy;
 
-      void clear()
+      std::size_t copy( VECTOR_T& rvPl, const std::size_t max )
       {
-         MUTEX_T lock(m_mutex);
-         CB_T::clear();
+         const std::size_t len = std::min( CURSOR_T::size(), max );
+         const std::size_t offset = rvPl.size();
+         rvPl.resize( offset + len );
+         const std::size_t ret = CURSOR_T::copy( rvPl.data() + offset, len );
+         rvPl.resize( offset + ret );
+         return ret;
       }
 
-      std::size_t pull( PL_T* pPl, const std::size_t max )
-      {
-         return erase( copy( pPl, max ) );
-      }
+      using CURSOR_T::pull;
 
       std::size_t pull( VECTOR_T& rvPl, const std::size_t max )
       {
-         return erase( copy( rvPl, max ) );
+         const std::size_t len = std::min( CURSOR_T::size(), max );
+         const std::size_t offset = rvPl.size();
+         rvPl.resize( offset + len );
+         const std::size_t ret = CURSOR_T::pull( rvPl.data() + offset, len );
+         rvPl.resize( offset + ret );
+         return ret;
       }
 
       ID_T getId()
@@ -174,13 +152,16 @@ public:
 private:
    using LIST_T = std::list<Buffer*>;
 
-
-   std::mutex  m_mutex;
-   LIST_T      m_bufferList;
+   RING_T            m_oRing;
+   std::mutex        m_mutex;
+   LIST_T            m_bufferList;
+   std::atomic<uint> m_numOfBuffers;
    const std::size_t m_capacity;
 
 public:
    TMultiBuffer( std::size_t capacity ):
+      m_oRing( capacity ),
+      m_numOfBuffers( 0 ),
       m_capacity( capacity ) {}
 
    ~TMultiBuffer()
@@ -192,28 +173,36 @@ public:
       }
    }
 
+   /*!
+    * @brief Producer: Appends a item to all buffers.
+    * @return Number of buffers.
+    */
    uint push( const PL_T& rPl )
    {
-      uint ret = 0;
-      MUTEX_T lock(m_mutex);
-      for( auto& pLe: m_bufferList )
-      {
-         pLe->push( rPl );
-         ret++;
-      }
-      return ret;
+      m_oRing.push( rPl );
+      return m_numOfBuffers.load( std::memory_order_relaxed );
    }
 
+   /*!
+    * @brief Producer: Appends the items of the vector to all buffers
+    *        at once.
+    * @return Number of buffers.
+    */
    uint push( const VECTOR_T& rvPl )
    {
-      uint ret = 0;
-      MUTEX_T lock(m_mutex);
-      for( auto& pLe: m_bufferList )
-      {
-         pLe->push( rvPl );
-         ret++;
-      }
-      return ret;
+      m_oRing.push( rvPl.data(), rvPl.size() );
+      return m_numOfBuffers.load( std::memory_order_relaxed );
+   }
+
+   /*!
+    * @brief Producer: Appends len items of the array pointed by pPl
+    *        to all buffers at once.
+    * @return Number of buffers.
+    */
+   uint push( const PL_T* pPl, const std::size_t len )
+   {
+      m_oRing.push( pPl, len );
+      return m_numOfBuffers.load( std::memory_order_relaxed );
    }
 
    Buffer* findBuffer( ID_T id )
@@ -237,14 +226,30 @@ public:
       return pBuffer;
    }
 
+   /*!
+    * @brief Creates a new buffer which receives the items pushed after
+    *        its creation.
+    * @param id Identification of the new buffer.
+    * @param capacity Capacity of the new buffer, zero means the capacity
+    *                 of the multi-buffer.
+    * @note All buffers share one ring, whose capacity is the capacity of
+    *       the multi-buffer rounded up to the next power of two. A greater
+    *       capacity becomes limited to the one of the ring, see
+    *       Buffer::getCapacity().
+    */
    Buffer* createBuffer( ID_T id, std::size_t capacity = 0 )
    {
+      if( capacity == 0 )
+         capacity = m_capacity;
+      capacity = std::min( capacity, m_oRing.getCapacity() );
+
       Buffer* pBuffer = findBuffer( id );
       if( pBuffer == nullptr )
       {
          MUTEX_T lock(m_mutex);
-         pBuffer = new Buffer( this, id, (capacity==0)? m_capacity : capacity );
+         pBuffer = new Buffer( this, id, capacity );
          m_bufferList.push_front( pBuffer );
+         m_numOfBuffers = m_bufferList.size();
       }
       return pBuffer;
    }
@@ -256,8 +261,9 @@ public:
       {
          if( (*it)->getId() == id )
          {
+            delete *it;
             m_bufferList.erase( it );
-            delete *(it);
+            m_numOfBuffers = m_bufferList.size();
             return true;
          }
       }
@@ -274,6 +280,7 @@ public:
          delete pLe;
       }
       m_bufferList.clear();
+      m_numOfBuffers = 0;
       return true;
    }
 
@@ -303,6 +310,7 @@ public:
 
    std::size_t getMaxSize()
    {
+      MUTEX_T lock(m_mutex);
       std::size_t size = 0;
       for( auto& pLe: m_bufferList )
       {
@@ -316,6 +324,15 @@ public:
       return getBuffer( id )->size();
    }
 
+   /*!
+    * @brief Returns the number of items of the given buffer which has been
+    *        overwritten before they were read.
+    */
+   uint64_t getOverrunCount( ID_T id )
+   {
+      return getBuffer( id )->getOverrunCount();
+   }
+
    std::size_t copy( ID_T id, PL_T* pPl, const std::size_t max )
    {
       return getBuffer( id )->copy( pPl, max );
@@ -345,4 +362,3 @@ public:
 } /* End namespace mubu */
 #endif /* ifndef _TMUBU_HPP */
 //================================== EOF ======================================
-
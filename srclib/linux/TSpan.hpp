@@ -0,0 +1,123 @@
+/*!
+ * @file TSpan.hpp
+ * @brief Template of a non-owning read only view of a contiguous array,
+ *        a lightweight replacement of std::span which is not available
+ *        before C++20.
+ *
+ * @note  Header only.
+ *
+ * @copyright GSI Helmholtz Centre for Heavy Ion Research GmbH
+ * @author    Ulrich Becker <u.becker@gsi.de>
+ * @date      16.10.2026
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _TSPAN_HPP
+#define _TSPAN_HPP
+
+#include <cstddef>
+#include <assert.h>
+
+namespace Scu
+{
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Read only view of a contiguous array, the data will not copied.
+ *
+ * @note CAUTION: The viewed array has to exist as long as the view
+ *       becomes used!
+ * @param T Type of the array elements.
+ */
+template <typename T>
+class TSpan
+{
+   const T*    m_pData;
+   std::size_t m_size;
+
+public:
+   using value_type     = T;
+   using const_iterator = const T*;
+
+   TSpan( void )
+      :m_pData( nullptr )
+      ,m_size( 0 )
+   {
+   }
+
+   /*!
+    * @brief Constructor
+    * @param pData Start address of the array.
+    * @param size Number of elements.
+    */
+   TSpan( const T* pData, const std::size_t size )
+      :m_pData( pData )
+      ,m_size( size )
+   {
+      assert( (pData != nullptr) || (size == 0) );
+   }
+
+   /*!
+    * @brief Returns the start address of the viewed array.
+    */
+   const T* data( void ) const
+   {
+      return m_pData;
+   }
+
+   /*!
+    * @brief Returns the number of elements.
+    */
+   std::size_t size( void ) const
+   {
+      return m_size;
+   }
+
+   bool empty( void ) const
+   {
+      return m_size == 0;
+   }
+
+   const T& operator[]( const std::size_t i ) const
+   {
+      assert( i < m_size );
+      return m_pData[i];
+   }
+
+   const T& front( void ) const
+   {
+      assert( m_size > 0 );
+      return m_pData[0];
+   }
+
+   const T& back( void ) const
+   {
+      assert( m_size > 0 );
+      return m_pData[m_size-1];
+   }
+
+   const_iterator begin( void ) const
+   {
+      return m_pData;
+   }
+
+   const_iterator end( void ) const
+   {
+      return m_pData + m_size;
+   }
+}; /* class TSpan */
+
+} /* End namespace Scu */
+#endif /* ifndef _TSPAN_HPP */
+//================================== EOF ======================================
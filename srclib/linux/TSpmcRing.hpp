@@ -0,0 +1,359 @@
+/*!
+ * @file TSpmcRing.hpp
+ * @brief Template of a lock-free circular broadcast buffer with exactly one
+ *        producer thread and one or more consumers, each consumer reads
+ *        all items by its own cursor.
+ *
+ * @note  Header only.
+ *
+ * @copyright GSI Helmholtz Centre for Heavy Ion Research GmbH
+ * @author    Ulrich Becker <u.becker@gsi.de>
+ * @date      16.10.2026
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _TSPMCRING_HPP
+#define _TSPMCRING_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <assert.h>
+
+namespace mubu
+{
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Lock-free single producer multiple consumer broadcast ring.
+ *
+ * The producer never waits: When the ring is full the oldest items become
+ * overwritten, like boost::circular_buffer::push_back() does.
+ * Each consumer has its own read cursor of type TSpmcRing::Cursor,
+ * therefore the effort of the producer is independent of the number
+ * of consumers. A consumer which has been overtaken by the producer
+ * skips the overwritten items and counts them as overrun.
+ *
+ * The producer announces the range which it will overwrite in a
+ * claim index before it writes the items, and publishes them in the
+ * write index afterwards. A consumer copies the items first and verifies
+ * by the claim index afterwards that they haven't been overwritten
+ * meanwhile, like a sequence lock. Therefore the payload
+ * type has to be trivially copyable.
+ *
+ * The capacity becomes rounded up to the next power of two, so the
+ * indexes can be masked instead of divided.
+ *
+ * @note CAUTION: Only one thread may invoke push() and only one thread
+ *       per cursor may read by this cursor!
+ * @param PL_T Payload type, it has to be trivially copyable.
+ */
+template <typename PL_T>
+class TSpmcRing
+{
+   static_assert( std::is_trivially_copyable<PL_T>::value,
+                  "Payload type of TSpmcRing has to be trivially copyable!" );
+
+   /*!
+    * @brief Size of a cache line for separating the indexes,
+    *        in order to avoid false sharing between producer and consumers.
+    * @see TSpscRing
+    */
+   static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+   std::vector<PL_T>        m_vBuffer;
+   const std::size_t        m_mask;
+
+   char                     m_padding1[CACHE_LINE_SIZE];
+
+   /*!
+    * @brief Index up to which the producer is writing.
+    */
+   std::atomic<std::size_t> m_claimIndex;
+
+   /*!
+    * @brief Index up to which the items are valid.
+    */
+   std::atomic<std::size_t> m_writeIndex;
+   char                     m_padding2[CACHE_LINE_SIZE - 2 * sizeof(std::atomic<std::size_t>)];
+
+   static std::size_t roundUp( std::size_t size )
+   {
+      std::size_t ret = 1;
+      while( ret < size )
+         ret <<= 1;
+      return ret;
+   }
+
+public:
+   ////////////////////////////////////////////////////////////////////////////
+   /*!
+    * @brief Read cursor of a single consumer.
+    *
+    * A new cursor starts at the current write index of the ring,
+    * that means it receives the items which becomes pushed after
+    * its construction.
+    */
+   class Cursor
+   {
+      const TSpmcRing*         m_pRing;
+
+      /*!
+       * @brief Maximum number of items which this consumer can hold back,
+       *        older items counts as overrun.
+       */
+      const std::size_t        m_capacity;
+
+      std::atomic<std::size_t> m_readIndex;
+      std::atomic<uint64_t>    m_overrunCount;
+
+      /*!
+       * @brief Skips the items which are older than the capacity of this
+       *        cursor and returns the current read index.
+       */
+      std::size_t sync( const std::size_t wi )
+      {
+         std::size_t ri = m_readIndex.load( std::memory_order_relaxed );
+         if( (wi - ri) > m_capacity )
+         {
+            const std::size_t lost = wi - ri - m_capacity;
+            m_overrunCount.fetch_add( lost, std::memory_order_relaxed );
+            ri += lost;
+            m_readIndex.store( ri, std::memory_order_relaxed );
+         }
+         return ri;
+      }
+
+   public:
+      /*!
+       * @brief Constructor
+       * @param rRing Ring to read from.
+       * @param capacity Maximum number of items which can be held back
+       *                 by this consumer, zero means the capacity of the
+       *                 ring. It can't be greater than the capacity
+       *                 of the ring.
+       */
+      Cursor( const TSpmcRing& rRing, const std::size_t capacity = 0 )
+         :m_pRing( &rRing )
+         ,m_capacity( (capacity == 0)? rRing.getCapacity() : capacity )
+         ,m_readIndex( rRing.m_writeIndex.load( std::memory_order_acquire ) )
+         ,m_overrunCount( 0 )
+      {
+         assert( m_capacity <= rRing.getCapacity() );
+      }
+
+      /*!
+       * @brief Returns the maximum number of items which can be held back.
+       */
+      std::size_t getCapacity( void ) const
+      {
+         return m_capacity;
+      }
+
+      /*!
+       * @brief Returns the number of items which can be read.
+       * @note If invoked by a other thread the value is a snapshot only.
+       */
+      std::size_t size( void ) const
+      {
+         const std::size_t size = m_pRing->m_writeIndex.load( std::memory_order_acquire ) -
+                                  m_readIndex.load( std::memory_order_relaxed );
+         return (size < m_capacity)? size : m_capacity;
+      }
+
+      bool empty( void ) const
+      {
+         return size() == 0;
+      }
+
+      /*!
+       * @brief Returns the number of items which has been overwritten by
+       *        the producer before this consumer has read them.
+       * @note Includes the items which are overwritten already but not
+       *       skipped yet by this consumer.
+       */
+      uint64_t getOverrunCount( void ) const
+      {
+         const std::size_t pending = m_pRing->m_writeIndex.load( std::memory_order_acquire ) -
+                                     m_readIndex.load( std::memory_order_relaxed );
+         return m_overrunCount.load( std::memory_order_relaxed ) +
+                ((pending > m_capacity)? (pending - m_capacity) : 0);
+      }
+
+      /*!
+       * @brief Sets the overrun counter to zero.
+       * @note CAUTION: Has to be invoked by the thread of this consumer.
+       */
+      void resetOverrunCount( void )
+      {
+         sync( m_pRing->m_writeIndex.load( std::memory_order_acquire ) );
+         m_overrunCount.store( 0, std::memory_order_relaxed );
+      }
+
+      /*!
+       * @brief Skips all currently readable items.
+       */
+      void clear( void )
+      {
+         m_readIndex.store( m_pRing->m_writeIndex.load( std::memory_order_acquire ),
+                            std::memory_order_relaxed );
+      }
+
+      /*!
+       * @brief Copies up to max of the oldest items in the array pointed
+       *        by pPl without removing them.
+       * @return Number of copied items.
+       */
+      std::size_t copy( PL_T* pPl, const std::size_t max )
+      {
+         const std::size_t wi = m_pRing->m_writeIndex.load( std::memory_order_acquire );
+         std::size_t ri = sync( wi );
+         std::size_t toCopy = wi - ri;
+         if( toCopy > max )
+            toCopy = max;
+         if( toCopy == 0 )
+            return 0;
+
+         /*
+          * Copying in at most two contiguous pieces.
+          */
+         const std::size_t begin = ri & m_pRing->m_mask;
+         const std::size_t first = ((begin + toCopy) <= m_pRing->m_vBuffer.size())?
+                                   toCopy : (m_pRing->m_vBuffer.size() - begin);
+         ::memcpy( pPl, &m_pRing->m_vBuffer[begin], first * sizeof(PL_T) );
+         if( first < toCopy )
+            ::memcpy( pPl + first, &m_pRing->m_vBuffer[0], (toCopy - first) * sizeof(PL_T) );
+
+         /*
+          * Verifying that the producer hasn't begun to overwrite
+          * copied items meanwhile, otherwise they are lost.
+          */
+         std::atomic_thread_fence( std::memory_order_acquire );
+         const std::size_t ci = m_pRing->m_claimIndex.load( std::memory_order_relaxed );
+         if( (ci - ri) > m_pRing->m_vBuffer.size() )
+         {
+            std::size_t lost = ci - ri - m_pRing->m_vBuffer.size();
+            if( lost > toCopy )
+               lost = toCopy;
+            m_overrunCount.fetch_add( lost, std::memory_order_relaxed );
+            ri += lost;
+            m_readIndex.store( ri, std::memory_order_relaxed );
+            toCopy -= lost;
+            ::memmove( pPl, pPl + lost, toCopy * sizeof(PL_T) );
+         }
+         return toCopy;
+      }
+
+      /*!
+       * @brief Removes up to max of the oldest items.
+       * @return Number of removed items.
+       */
+      std::size_t erase( const std::size_t max )
+      {
+         const std::size_t wi = m_pRing->m_writeIndex.load( std::memory_order_acquire );
+         const std::size_t ri = sync( wi );
+         std::size_t toErase = wi - ri;
+         if( toErase > max )
+            toErase = max;
+         m_readIndex.store( ri + toErase, std::memory_order_relaxed );
+         return toErase;
+      }
+
+      /*!
+       * @brief Removes up to max of the oldest items and copies them
+       *        in the array pointed by pPl.
+       * @return Number of copied items.
+       */
+      std::size_t pull( PL_T* pPl, const std::size_t max )
+      {
+         const std::size_t n = copy( pPl, max );
+         m_readIndex.store( m_readIndex.load( std::memory_order_relaxed ) + n,
+                            std::memory_order_relaxed );
+         return n;
+      }
+   }; /* class Cursor */
+
+   TSpmcRing( const std::size_t capacity )
+      :m_vBuffer( roundUp( capacity ) )
+      ,m_mask( m_vBuffer.size() - 1 )
+      ,m_claimIndex( 0 )
+      ,m_writeIndex( 0 )
+   {
+      assert( capacity > 0 );
+   }
+
+   /*!
+    * @brief Returns the maximum number of items which can be stored.
+    */
+   std::size_t getCapacity( void ) const
+   {
+      return m_vBuffer.size();
+   }
+
+   /*!
+    * @brief Returns the number of items which has been pushed since
+    *        the construction.
+    */
+   std::size_t getWriteIndex( void ) const
+   {
+      return m_writeIndex.load( std::memory_order_acquire );
+   }
+
+   /*!
+    * @brief Producer: Stores a copy of the given item, overwrites the
+    *        oldest item when the ring is full.
+    */
+   void push( const PL_T& rPl )
+   {
+      push( &rPl, 1 );
+   }
+
+   /*!
+    * @brief Producer: Stores copies of len items of the array pointed by
+    *        pPl, they become visible to the consumers at once.
+    */
+   void push( const PL_T* pPl, std::size_t len )
+   {
+      std::size_t wi = m_writeIndex.load( std::memory_order_relaxed );
+
+      /*
+       * Only the newest items can survive a batch greater than the ring.
+       */
+      if( len > m_vBuffer.size() )
+      {
+         pPl += len - m_vBuffer.size();
+         wi  += len - m_vBuffer.size();
+         len  = m_vBuffer.size();
+      }
+
+      m_claimIndex.store( wi + len, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_release );
+
+      const std::size_t begin = wi & m_mask;
+      const std::size_t first = ((begin + len) <= m_vBuffer.size())?
+                                len : (m_vBuffer.size() - begin);
+      ::memcpy( &m_vBuffer[begin], pPl, first * sizeof(PL_T) );
+      if( first < len )
+         ::memcpy( &m_vBuffer[0], pPl + first, (len - first) * sizeof(PL_T) );
+
+      m_writeIndex.store( wi + len, std::memory_order_release );
+   }
+}; /* class TSpmcRing */
+
+} /* End namespace mubu */
+#endif /* ifndef _TSPMCRING_HPP */
+//================================== EOF ======================================
@@ -0,0 +1,165 @@
+/*!
+ * @file TSpscRing.hpp
+ * @brief Template of a lock-free circular buffer (FiFo) with exactly one
+ *        producer thread and exactly one consumer thread.
+ *
+ * @note  Header only.
+ *
+ * @copyright GSI Helmholtz Centre for Heavy Ion Research GmbH
+ * @author    Ulrich Becker <u.becker@gsi.de>
+ * @date      16.10.2026
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _TSPSCRING_HPP
+#define _TSPSCRING_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <assert.h>
+
+namespace mubu
+{
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Lock-free single producer single consumer circular buffer.
+ *
+ * The capacity becomes rounded up to the next power of two, so the
+ * indexes can be masked instead of divided.
+ * The write index becomes modified by the producer only and the read index
+ * by the consumer only, therefore no mutex is necessary.
+ *
+ * @note CAUTION: Only one thread may invoke push() and only one
+ *       (other) thread may invoke pop() respectively pull()!
+ * @param PL_T Payload type, it has to be copyable.
+ */
+template <typename PL_T>
+class TSpscRing
+{
+   /*!
+    * @brief Size of a cache line for separating the indexes,
+    *        in order to avoid false sharing between producer and consumer.
+    * @note The separation is made by padding instead of alignas(),
+    *       because operator new doesn't respect extended alignments
+    *       before C++17.
+    */
+   static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+   std::vector<PL_T>        m_vBuffer;
+   const std::size_t        m_mask;
+
+   char                     m_padding1[CACHE_LINE_SIZE];
+   std::atomic<std::size_t> m_writeIndex;
+   char                     m_padding2[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+   std::atomic<std::size_t> m_readIndex;
+   char                     m_padding3[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+
+   static std::size_t roundUp( std::size_t size )
+   {
+      std::size_t ret = 1;
+      while( ret < size )
+         ret <<= 1;
+      return ret;
+   }
+
+public:
+   TSpscRing( const std::size_t capacity )
+      :m_vBuffer( roundUp( capacity ) )
+      ,m_mask( m_vBuffer.size() - 1 )
+      ,m_writeIndex( 0 )
+      ,m_readIndex( 0 )
+   {
+      assert( capacity > 0 );
+   }
+
+   /*!
+    * @brief Returns the maximum number of items which can be stored.
+    */
+   std::size_t getCapacity( void ) const
+   {
+      return m_vBuffer.size();
+   }
+
+   /*!
+    * @brief Returns the number of currently stored items.
+    * @note If invoked by a third thread the value is a snapshot only.
+    */
+   std::size_t size( void ) const
+   {
+      return m_writeIndex.load( std::memory_order_acquire ) -
+             m_readIndex.load( std::memory_order_acquire );
+   }
+
+   bool empty( void ) const
+   {
+      return size() == 0;
+   }
+
+   /*!
+    * @brief Producer: Stores a copy of the given item.
+    * @retval true  Item has been stored.
+    * @retval false Buffer is full, item has been dropped.
+    */
+   bool push( const PL_T& rPl )
+   {
+      const std::size_t wi = m_writeIndex.load( std::memory_order_relaxed );
+      if( (wi - m_readIndex.load( std::memory_order_acquire )) >= m_vBuffer.size() )
+         return false;
+
+      m_vBuffer[wi & m_mask] = rPl;
+      m_writeIndex.store( wi + 1, std::memory_order_release );
+      return true;
+   }
+
+   /*!
+    * @brief Consumer: Removes the oldest item and copies it in rPl.
+    * @retval true  Item has been copied.
+    * @retval false Buffer was empty.
+    */
+   bool pop( PL_T& rPl )
+   {
+      const std::size_t ri = m_readIndex.load( std::memory_order_relaxed );
+      if( ri == m_writeIndex.load( std::memory_order_acquire ) )
+         return false;
+
+      rPl = m_vBuffer[ri & m_mask];
+      m_readIndex.store( ri + 1, std::memory_order_release );
+      return true;
+   }
+
+   /*!
+    * @brief Consumer: Removes up to max of the oldest items and copies them
+    *        in the array pointed by pPl.
+    * @return Number of copied items.
+    */
+   std::size_t pull( PL_T* pPl, const std::size_t max )
+   {
+      const std::size_t ri = m_readIndex.load( std::memory_order_relaxed );
+      std::size_t toCopy = m_writeIndex.load( std::memory_order_acquire ) - ri;
+      if( toCopy > max )
+         toCopy = max;
+
+      for( std::size_t i = 0; i < toCopy; i++ )
+         pPl[i] = m_vBuffer[(ri + i) & m_mask];
+
+      m_readIndex.store( ri + toCopy, std::memory_order_release );
+      return toCopy;
+   }
+}; /* class TSpscRing */
+
+} /* End namespace mubu */
+#endif /* ifndef _TSPSCRING_HPP */
+//================================== EOF ======================================
@@ -26,7 +26,10 @@
 #endif
 
 #include <sstream>
+#include <mutex>
 #include <stdexcept>
+#include <chrono>
+#include <thread>
 #include <netdb.h>
 
 namespace FeSupport {
@@ -51,10 +54,24 @@ std::string EtherboneConnection::c_mutexName;
  * @param rName Net address e.g.: "tcp/scuxl4711" or "dev/wbm0"
  * @retval "wbm0_Mutex" In the case the application runs in the SCU's IPC
  * @retval "scuxl4711.acc.gsi.de_Mutex" In the case of remote.
+ * @retval "sim_addac_2_Mutex" In the case of the simulator "sim://addac=2".
  */
 inline
 const char* EtherboneConnection::__makeMutexName( const std::string& rName )
-{  /*
+{
+   if( isSimulatorAddress( rName ) )
+   { /*
+      * Slashes and other special characters are not allowed in the
+      * name of a named mutex.
+      */
+      c_mutexName = "sim_";
+      for( const char c: rName.substr( sizeof( EB_SIMULATOR_PREFIX ) - 1 ) )
+         c_mutexName += ::isalnum( c )? c : '_';
+      c_mutexName += "_Mutex";
+      return c_mutexName.c_str();
+   }
+
+   /*
     * Removing prefix "tcp/" or "dev/"
     */
    c_mutexName = rName.substr( rName.find_first_of( '/' ) + 1 );
@@ -74,70 +91,91 @@ const char* EtherboneConnection::__makeMutexName( const std::string& rName )
 #endif // ifndef CONFIG_EB_USE_NORMAL_MUTEX
 
 
-EtherboneConnection::OBJ_ADMIN_T EtherboneConnection::c_oAdmin =
-{
-   .ptr_   = nullptr,
-   .count_ = 0
-};
+std::map<std::string, EtherboneConnection::OBJ_ADMIN_T> EtherboneConnection::c_instanceMap;
+
+/*!
+ * @brief Protects EtherboneConnection::c_instanceMap against concurrent
+ *        accesses of several threads.
+ */
+static std::mutex g_instanceMapMutex;
+
+SIMULATOR_FACTORY_T EtherboneConnection::c_simulatorFactory = nullptr;
 
 /* ----------------------------------------------------------------------------
  */
 EtherboneConnection::EBC_PTR_T EtherboneConnection::getInstance( const std::string& netaddress,
                                                              uint timeout )
 {
-   if( c_oAdmin.count_ == 0 )
+   std::lock_guard<std::mutex> lock( g_instanceMapMutex );
+
+   OBJ_ADMIN_T& rAdmin = c_instanceMap[netaddress];
+   if( rAdmin.count_ == 0 )
    {
-      assert( c_oAdmin.ptr_ == nullptr );
-      c_oAdmin.ptr_ = new EtherboneConnection( netaddress, timeout );
+      assert( rAdmin.ptr_ == nullptr );
+      try
+      {
+         rAdmin.ptr_ = new EtherboneConnection( netaddress, timeout );
+      }
+      catch( ... )
+      {
+         c_instanceMap.erase( netaddress );
+         throw;
+      }
    }
    else
    {
-      assert( c_oAdmin.ptr_ != nullptr );
-      if( c_oAdmin.ptr_->getNetAddress() != netaddress )
-      {
-         std::stringstream stream;
-         stream << __FILE__ << "::" << __FUNCTION__ << "::" << std::dec
-                << __LINE__ << " Different net-addresses -> current: "
-                << c_oAdmin.ptr_->getNetAddress()
-                << ", requested: "
-                << netaddress;
-         throw BusException( stream.str() );
-      }
-
-      if( c_oAdmin.ptr_->timeout_ != timeout )
+      assert( rAdmin.ptr_ != nullptr );
+      if( rAdmin.ptr_->timeout_ != timeout )
       {
          std::stringstream stream;
          stream << __FILE__ << "::" << __FUNCTION__ << "::" << std::dec
                 << __LINE__ << " Different timeout values -> current: "
-                << c_oAdmin.ptr_->timeout_
+                << rAdmin.ptr_->timeout_
                 << ", requested: "
                 << timeout;
          throw BusException( stream.str() );
       }
    }
 
-   c_oAdmin.count_++;
-   return c_oAdmin.ptr_;
+   rAdmin.count_++;
+   return rAdmin.ptr_;
 }
 
 /* ----------------------------------------------------------------------------
  */
 void EtherboneConnection::releaseInstance( EBC_PTR_T ptr )
 {
-   assert( c_oAdmin.ptr_ == ptr );
+   assert( ptr != nullptr );
+   std::lock_guard<std::mutex> lock( g_instanceMapMutex );
+
+   const auto it = c_instanceMap.find( ptr->getNetAddress() );
+   if( it == c_instanceMap.end() )
+      return;
 
-   if( c_oAdmin.count_ > 0 )
+   assert( it->second.ptr_ == ptr );
+   if( it->second.count_ > 0 )
    {
-      assert( c_oAdmin.ptr_ != nullptr );
-      c_oAdmin.count_--;
-      if( c_oAdmin.count_ == 0 )
+      it->second.count_--;
+      if( it->second.count_ == 0 )
       {
-         delete c_oAdmin.ptr_;
-         c_oAdmin.ptr_ = nullptr;
+         delete it->second.ptr_;
+         c_instanceMap.erase( it );
       }
    }
 }
 
+/* ----------------------------------------------------------------------------
+ */
+uint EtherboneConnection::getNumberOfInstances( void )
+{
+   std::lock_guard<std::mutex> lock( g_instanceMapMutex );
+
+   uint count = 0;
+   for( const auto& item: c_instanceMap )
+      count += item.second.count_;
+   return count;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /* ----------------------------------------------------------------------------
  */
@@ -151,7 +189,11 @@ EtherboneConnection::EtherboneConnection( const std::string& netaddress,
 #endif
    ,timeout_( timeout )
    ,connectionOpenCount_(0)
+   ,userCount_( 0 )
    ,debug_(false)
+   ,asyncWindowDepth_( EB_DEFAULT_ASYNC_WINDOW )
+   ,asyncSequence_( c_newAsyncBatch )
+   ,simulator_( nullptr )
 {
    // check if mutex is already locked
 #ifndef CONFIG_EB_USE_NORMAL_MUTEX
@@ -221,7 +263,19 @@ void EtherboneConnection::connect()
 {
    SCOPED_MUTEX_T lock(_sysMu);
 
-   if( connectionOpenCount_ == 0 )
+   if( (connectionOpenCount_ == 0) && isSimulatorAddress( netaddress_ ) )
+   {
+      if( c_simulatorFactory == nullptr )
+      {
+         std::stringstream stream;
+         stream << __FILE__ << "::" << __FUNCTION__ << "::" << std::dec
+                << __LINE__ << ": No wishbone simulator linked for: "
+                << netaddress_;
+         throw BusException(stream.str());
+      }
+      simulator_ = c_simulatorFactory( netaddress_ );
+   }
+   else if( connectionOpenCount_ == 0 )
    {
       eb_status_t status = eb_socket_.open(0, EB_ADDRX|EB_DATAX);
       if( status != EB_OK )
@@ -256,8 +310,22 @@ void EtherboneConnection::disconnect()
       connectionOpenCount_--;
       if( connectionOpenCount_ == 0 )
       {
+         discardAsync();
+         if( simulator_ != nullptr )
+         {
+            dropAsync();
+            delete simulator_;
+            simulator_ = nullptr;
+            return;
+         }
+         /*
+          * Closing the device completes the cycles which are still in
+          * flight with EB_TIMEOUT, therefore they can be released
+          * not before.
+          */
          eb_device_.close();
          eb_socket_.close();
+         dropAsync();
       }
    }
 }
@@ -270,6 +338,9 @@ uint32_t EtherboneConnection::getSlaveMacroVersion( VendorId vendorId,
    std::vector<sdb_device> foundDevs;
 
    SCOPED_MUTEX_T lock(_sysMu);
+   if( simulator_ != nullptr )
+      return simulator_->getMacroVersion( vendorId, deviceId );
+
    eb_device_.sdb_find_by_identity(vendorId, deviceId, foundDevs);
 
    if (foundDevs.size() > 1)
@@ -303,6 +374,26 @@ uint64_t EtherboneConnection::findDeviceBaseAddress( VendorId vendorId,
 //   sdb_device device = {0};        // Dummy object isn't necessary because vector::resize(32)
 //   deviceVector.push_back(device); // will called in function sdb_find_by_identity(). UB
 
+   if( simulator_ != nullptr )
+   {
+      uint64_t address;
+      bool     found;
+      {
+         SCOPED_MUTEX_T lock(_sysMu);
+         found = simulator_->findDevice( vendorId, deviceId, ind, address );
+      }
+      if( !found )
+      {
+         std::stringstream stream;
+         stream << __FILE__ << "::" << __FUNCTION__ << "::" << std::dec
+                << __LINE__ << ": Error searching for a device address:"
+                " VendorId 0x" << std::hex << vendorId << " deviceId 0x"
+                << deviceId << " Not present in simulator: " << netaddress_;
+         throw BusException(stream.str());
+      }
+      return address;
+   }
+
    {
       SCOPED_MUTEX_T lock(_sysMu);
       status = eb_device_.sdb_find_by_identity( vendorId, deviceId,
@@ -575,6 +666,22 @@ void EtherboneConnection::write( const address_t eb_address,
    if( modWbAddrOfs == 0 )
        modWbAddrOfs = wide * size;
 
+   if( simulator_ != nullptr )
+   {
+      EtherboneBatch batch;
+      batch.write( eb_address, pData, format, size, modWbAddrOfs );
+      eb_status_t status;
+      {
+         SCOPED_MUTEX_T lock(_sysMu);
+         status = simExecute( batch.ops_ );
+      }
+      if( status != EB_OK )
+      {
+         EB_THROW_CB_ERROR( status );
+      }
+      return;
+   }
+
    { // Begin of mutex scope
       SCOPED_MUTEX_T lock(_sysMu);
 
@@ -640,6 +747,29 @@ void EtherboneConnection::ddr3Write( const etherbone::address_t eb_address,
    if( modWbAddrOfs == 0 )
       modWbAddrOfs = userObj.m_len;
 
+   if( simulator_ != nullptr )
+   {
+      std::vector<EtherboneBatch::OP_T> ops;
+      ops.reserve( userObj.m_len );
+      for( uint i = 0; i < userObj.m_len; i++ )
+      {
+         const uint j = ((i % 2) == 0)? i+1 : i-1;
+         ops.push_back( { eb_address + (j % modWbAddrOfs) * sizeof(uint32_t),
+                          sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                          reinterpret_cast<const uint32_t*>(pData)[j], nullptr } );
+      }
+      eb_status_t status;
+      {
+         SCOPED_MUTEX_T lock(_sysMu);
+         status = simExecute( ops );
+      }
+      if( status != EB_OK )
+      {
+         EB_THROW_CB_ERROR( status );
+      }
+      return;
+   }
+
 
    { // Begin of mutex scope
       SCOPED_MUTEX_T lock(_sysMu);
@@ -711,6 +841,14 @@ void EtherboneConnection::read( const address_t eb_address,
    if( modWbAddrOfs == 0 )
       modWbAddrOfs = wide * size;
 
+   if( simulator_ != nullptr )
+   {
+      EtherboneBatch batch;
+      batch.read( eb_address, pData, format, size, modWbAddrOfs );
+      SCOPED_MUTEX_T lock(_sysMu);
+      userObj.m_status = simExecute( batch.ops_ );
+   }
+   else
    { // Begin of mutex scope
       SCOPED_MUTEX_T lock(_sysMu);
 
@@ -758,6 +896,658 @@ void EtherboneConnection::read( const address_t eb_address,
    }
 }
 
+/*! ---------------------------------------------------------------------------
+ * @brief Administration object of a single asynchronous cycle used by
+ *        EtherboneConnection::readAsync and EtherboneConnection::writeAsync.
+ *
+ * In contrast to the synchronous functions this object becomes allocated
+ * on the heap, because it has to survive the calling function.
+ * @author Ulrich Becker
+ */
+struct EtherboneConnection::ASYNC_CYCLE_T: public EB_USER_CB_T
+{
+   /*!
+    * @brief Optional completion callback function.
+    */
+   const ASYNC_CALLBACK_T m_callback;
+
+   /*!
+    * @brief Batch which this cycle belongs to.
+    */
+   const ASYNC_TOKEN_T m_token;
+
+   /*!
+    * @brief Completion time in the case of a simulated bus.
+    */
+   std::chrono::steady_clock::time_point m_dueTime;
+
+   ASYNC_CYCLE_T( uint len, eb_user_data_t pUserAddress,
+                  const ASYNC_CALLBACK_T& callback,
+                  const ASYNC_TOKEN_T token )
+      :EB_USER_CB_T( len, pUserAddress )
+      ,m_callback( callback )
+      ,m_token( token )
+   {}
+};
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+eb_status_t EtherboneConnection::simExecute( const std::vector<EtherboneBatch::OP_T>& rOps,
+                                             const bool doWait )
+{
+   assert( simulator_ != nullptr );
+
+   eb_status_t status = EB_OK;
+   simulator_->beginCycle();
+   for( const auto& op: rOps )
+   {
+      if( op.pTarget != nullptr )
+      {
+         data_t data = 0;
+         if( !simulator_->read( op.address, op.format, data ) )
+         {
+            status = EB_SEGFAULT;
+            break;
+         }
+         ::memcpy( op.pTarget, &data, op.format & EB_DATAX );
+      }
+      else if( !simulator_->write( op.address, op.format, op.data ) )
+      {
+         status = EB_SEGFAULT;
+         break;
+      }
+      if( debug_ )
+         std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << std::dec
+                   << __LINE__ << ": addr 0x" << std::hex << op.address
+                   << ((op.pTarget != nullptr)? " read" : " write 0x")
+                   << ((op.pTarget != nullptr)? 0 : op.data)
+                   << std::dec << std::endl;
+   }
+   simulator_->endCycle();
+
+   if( doWait && (simulator_->getLatencyUs() > 0) )
+      std::this_thread::sleep_for( std::chrono::microseconds( simulator_->getLatencyUs() ) );
+
+   return status;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::simRun( const bool doWait )
+{
+   assert( simulator_ != nullptr );
+
+   if( asyncPending_.empty() )
+      return;
+
+   /*
+    * The cycles becomes completed in the order of opening, like on the
+    * real etherbone connection.
+    */
+   if( doWait && !asyncPending_.front()->isFinished() )
+      std::this_thread::sleep_until( asyncPending_.front()->m_dueTime );
+
+   const auto now = std::chrono::steady_clock::now();
+   for( auto& pCycle: asyncPending_ )
+   {
+      if( pCycle->m_dueTime > now )
+         break;
+      pCycle->m_finished = true;
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+uint EtherboneConnection::discardAsync()
+{
+   /*
+    * A unreachable device shall not block the disconnecting for ever,
+    * because the caller holds the mutex.
+    */
+   const auto deadline = std::chrono::steady_clock::now() +
+                         std::chrono::milliseconds( EB_DISCARD_ASYNC_TIMEOUT_MS );
+   while( !asyncPending_.empty() &&
+          (std::chrono::steady_clock::now() < deadline) )
+   {
+      if( simulator_ != nullptr )
+         simRun( true );
+      else
+         run();
+      for( auto it = asyncPending_.begin(); it != asyncPending_.end(); )
+      {
+         if( !(*it)->isFinished() )
+         {
+            ++it;
+            continue;
+         }
+         delete *it;
+         it = asyncPending_.erase( it );
+      }
+   }
+   asyncErrors_.clear();
+   return asyncPending_.size();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::dropAsync()
+{
+   for( const auto& pCycle: asyncPending_ )
+      delete pCycle;
+   asyncPending_.clear();
+   asyncErrors_.clear();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+bool EtherboneConnection::isAsyncPending( const ASYNC_TOKEN_T token )
+{
+   SCOPED_MUTEX_T lock(_sysMu);
+   for( const auto& pCycle: asyncPending_ )
+   {
+      if( pCycle->m_token == token )
+         return true;
+   }
+   return false;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+uint EtherboneConnection::getNumberOfPendingCycles() const
+{
+   SCOPED_MUTEX_T lock(_sysMu);
+   return asyncPending_.size();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+uint EtherboneConnection::serviceAsync( const bool doWait )
+{
+   std::list<ASYNC_CYCLE_T*> finished;
+   uint pending;
+
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+
+      if( asyncPending_.empty() )
+         return 0;
+
+      if( simulator_ != nullptr )
+         simRun( doWait );
+      else if( doWait )
+         run();
+      else
+         eb_socket_.run( 0 );
+
+      for( auto it = asyncPending_.begin(); it != asyncPending_.end(); )
+      {
+         auto next = it;
+         ++next;
+         if( (*it)->isFinished() )
+         {
+            /*
+             * Only the first error of each batch will kept,
+             * emplace() doesn't overwrite a existing one.
+             */
+            if( ((*it)->getStatus() != EB_OK) && !(*it)->m_callback )
+               asyncErrors_.emplace( (*it)->m_token, (*it)->getStatus() );
+            finished.splice( finished.end(), asyncPending_, it );
+         }
+         it = next;
+      }
+      pending = asyncPending_.size();
+   } // End of mutex scope.
+
+   /*
+    * Invoking the callback functions outside of the mutex scope,
+    * so they can make further etherbone accesses.
+    */
+   for( const auto& pCycle: finished )
+   {
+      if( pCycle->m_callback )
+         pCycle->m_callback( pCycle->getStatus() );
+      delete pCycle;
+   }
+
+   return pending;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::waitForAsyncWindow()
+{
+   /*
+    * Called without holding the mutex, getNumberOfPendingCycles()
+    * takes it.
+    */
+   while( getNumberOfPendingCycles() >= asyncWindowDepth_ )
+   {
+      if( !onSockedPoll() )
+         break;
+      serviceAsync( true );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::waitForAsync()
+{
+   while( serviceAsync( true ) > 0 )
+   {
+      if( !onSockedPoll() )
+         break;
+   }
+
+   eb_status_t status = EB_OK;
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+      if( !asyncErrors_.empty() )
+         status = asyncErrors_.begin()->second;
+      asyncErrors_.clear();
+   } // End of mutex scope.
+
+   if( status != EB_OK )
+   {
+      EB_THROW_CB_ERROR( status );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::waitForAsync( const ASYNC_TOKEN_T token )
+{
+   while( isAsyncPending( token ) )
+   {
+      serviceAsync( true );
+      if( !onSockedPoll() )
+         break;
+   }
+
+   eb_status_t status = EB_OK;
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+      const auto it = asyncErrors_.find( token );
+      if( it != asyncErrors_.end() )
+      {
+         status = it->second;
+         asyncErrors_.erase( it );
+      }
+   } // End of mutex scope.
+
+   if( status != EB_OK )
+   {
+      EB_THROW_CB_ERROR( status );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+EtherboneConnection::ASYNC_TOKEN_T
+EtherboneConnection::readAsync( const address_t eb_address,
+                                     eb_user_data_t pData,
+                                     const format_t format,
+                                     const uint size,
+                                     const ASYNC_CALLBACK_T& callback,
+                                     uint modWbAddrOfs,
+                                     ASYNC_TOKEN_T token )
+{
+   if( token == c_newAsyncBatch )
+      token = openAsyncBatch();
+
+   /*
+    * A size of zero is legal but there is nothing to do.
+    */
+   if( size == 0 )
+   {
+      if( callback )
+         callback( EB_OK );
+      return token;
+   }
+
+   const std::size_t wide = format & EB_DATAX;
+   if( modWbAddrOfs == 0 )
+      modWbAddrOfs = wide * size;
+
+   waitForAsyncWindow();
+
+   /*
+    * Initializing the argument object of the callback function "__onEbSocked"
+    */
+   ASYNC_CYCLE_T* pCycle = new ASYNC_CYCLE_T( size, pData, callback, token );
+
+   if( simulator_ != nullptr )
+   { /*
+      * The data becomes transferred immediately, but the completion
+      * will reported after the injected latency, so several cycles
+      * overlap like on the real etherbone connection.
+      */
+      EtherboneBatch batch;
+      batch.read( eb_address, pData, format, size, modWbAddrOfs );
+      SCOPED_MUTEX_T lock(_sysMu);
+      pCycle->m_status  = simExecute( batch.ops_, false );
+      pCycle->m_dueTime = std::chrono::steady_clock::now() +
+                          std::chrono::microseconds( simulator_->getLatencyUs() );
+      asyncPending_.push_back( pCycle );
+      return token;
+   }
+
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+
+      eb_status_t status;
+      Cycle       eb_cycle;
+      if( (status = eb_cycle.open( eb_device_, pCycle, __onEbSocked )) != EB_OK )
+      {
+         delete pCycle;
+         EB_THROW_CYC_OPEN_ERROR( status );
+      }
+
+      for( uint i = 0, j = 0; i < size; i++, j = (j + wide) % modWbAddrOfs )
+      {
+         eb_cycle.read( eb_address + j, format, nullptr );
+      }
+
+      if( (status = eb_cycle.close()) != EB_OK )
+      {
+         delete pCycle;
+         EB_THROW_CYC_CLOSE_ERROR( status );
+      }
+
+      asyncPending_.push_back( pCycle );
+   } // End of mutex scope.
+   return token;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+EtherboneConnection::ASYNC_TOKEN_T
+EtherboneConnection::writeAsync( const address_t eb_address,
+                                      const eb_user_data_t pData,
+                                      const format_t format,
+                                      const uint size,
+                                      const ASYNC_CALLBACK_T& callback,
+                                      uint modWbAddrOfs,
+                                      ASYNC_TOKEN_T token )
+{
+   if( token == c_newAsyncBatch )
+      token = openAsyncBatch();
+
+   /*
+    * A size of zero is legal but there is nothing to do.
+    */
+   if( size == 0 )
+   {
+      if( callback )
+         callback( EB_OK );
+      return token;
+   }
+
+   const std::size_t wide = format & EB_DATAX;
+   if( modWbAddrOfs == 0 )
+      modWbAddrOfs = wide * size;
+
+   waitForAsyncWindow();
+
+   /*
+    * Initializing the argument object of the callback function "__onEbSocked"
+    */
+   ASYNC_CYCLE_T* pCycle = new ASYNC_CYCLE_T( size, nullptr, callback, token );
+
+   if( simulator_ != nullptr )
+   {
+      EtherboneBatch batch;
+      batch.write( eb_address, pData, format, size, modWbAddrOfs );
+      SCOPED_MUTEX_T lock(_sysMu);
+      pCycle->m_status  = simExecute( batch.ops_, false );
+      pCycle->m_dueTime = std::chrono::steady_clock::now() +
+                          std::chrono::microseconds( simulator_->getLatencyUs() );
+      asyncPending_.push_back( pCycle );
+      return token;
+   }
+
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+
+      eb_status_t status;
+      Cycle       eb_cycle;
+      if( (status = eb_cycle.open( eb_device_, pCycle, __onEbSocked )) != EB_OK )
+      {
+         delete pCycle;
+         EB_THROW_CYC_OPEN_ERROR( status );
+      }
+
+      for( uint i = 0, j = 0; i < size; i++, j = (j + wide) % modWbAddrOfs )
+      {
+         eb_cycle.write( eb_address + j, format,
+                         getValueByFormat( pData, wide, i ));
+         if( debug_ )
+            EB_DEBUG_INFO( eb_address, j, i, pData, wide );
+      }
+
+      if( (status = eb_cycle.close()) != EB_OK )
+      {
+         delete pCycle;
+         EB_THROW_CYC_CLOSE_ERROR( status );
+      }
+
+      asyncPending_.push_back( pCycle );
+   } // End of mutex scope.
+   return token;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneBatch::read( const address_t eb_address,
+                           eb_user_data_t pData,
+                           const format_t format,
+                           const uint size,
+                           uint modWbAddrOfs )
+{
+   const std::size_t wide = format & EB_DATAX;
+   if( modWbAddrOfs == 0 )
+      modWbAddrOfs = wide * size;
+
+   for( uint i = 0, j = 0; i < size; i++, j = (j + wide) % modWbAddrOfs )
+   {
+      ops_.push_back( { eb_address + j, format, 0,
+                        &static_cast<uint8_t*>(pData)[i * wide] } );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneBatch::write( const address_t eb_address,
+                            const eb_user_data_t pData,
+                            const format_t format,
+                            const uint size,
+                            uint modWbAddrOfs )
+{
+   const std::size_t wide = format & EB_DATAX;
+   if( modWbAddrOfs == 0 )
+      modWbAddrOfs = wide * size;
+
+   for( uint i = 0, j = 0; i < size; i++, j = (j + wide) % modWbAddrOfs )
+   {
+      ops_.push_back( { eb_address + j, format,
+                        getValueByFormat( pData, wide, i ), nullptr } );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneBatch::ddr3Write( const address_t eb_address,
+                                const uint64_t* pData,
+                                const uint size )
+{
+   const uint len = size * sizeof(uint64_t) / sizeof(uint32_t);
+   for( uint i = 0; i < len; i++ )
+   { /*
+      * The upper 32 bit has to be written first.
+      */
+      const uint j = ((i % 2) == 0)? i+1 : i-1;
+      ops_.push_back( { eb_address + j * sizeof(uint32_t),
+                        sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                        reinterpret_cast<const uint32_t*>(pData)[j], nullptr } );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Type of data-object used by callback function __onEbBatch
+ * @see __onEbBatch
+ * @author Ulrich Becker
+ */
+struct EB_BATCH_CB_T
+{
+   bool                                    m_finished; //!<@brief becomes true when transfer finished.
+   eb_status_t                             m_status;   //!<@brief etherbone status
+   const std::vector<EtherboneBatch::OP_T>& m_rOps;    //!<@brief queued operations
+
+   EB_BATCH_CB_T( const std::vector<EtherboneBatch::OP_T>& rOps )
+      :m_finished( false )
+      ,m_status( EB_OK )
+      ,m_rOps( rOps )
+   {}
+};
+
+extern "C"
+{
+
+/*! ---------------------------------------------------------------------------
+ * @brief Callback function becomes invoked by member function
+ *        EtherboneConnection::execute
+ * @see EtherboneConnection::execute
+ * @author Ulrich Becker
+ */
+static void  __onEbBatch( eb_user_data_t pUser, eb_device_t dev,
+                          eb_operation_t op, eb_status_t status )
+{
+   EB_BATCH_CB_T* pThis = static_cast<EB_BATCH_CB_T*>(pUser);
+   pThis->m_finished = true;
+   pThis->m_status = status;
+   if( status != EB_OK )
+      return;
+
+   uint i = 0;
+   while( (op != EB_NULL) && (i < pThis->m_rOps.size()) )
+   {
+      if( ::eb_operation_had_error( op ) )
+      {
+         pThis->m_status = EB_SEGFAULT;
+         return;
+      }
+
+      if( ::eb_operation_is_read( op ) )
+      {
+         assert( pThis->m_rOps[i].pTarget != nullptr );
+         const data_t data = ::eb_operation_data( op );
+         ::memcpy( pThis->m_rOps[i].pTarget, &data,
+                   ::eb_operation_format( op ) & EB_DATAX );
+      }
+      op = ::eb_operation_next( op );
+      i++;
+   }
+   if( (op != EB_NULL) || (i != pThis->m_rOps.size()) )
+      pThis->m_status = EB_FAIL;
+}
+
+} // extern "c"
+
+/*! ---------------------------------------------------------------------------
+ * @author Ulrich Becker
+ * @see EtherboneConnection.hpp
+ */
+void EtherboneConnection::execute( EtherboneBatch& rBatch )
+{
+   if( rBatch.empty() )
+      return;
+
+   /*
+    * Initializing the argument object of the callback function "__onEbBatch"
+    */
+   EB_BATCH_CB_T userObj( rBatch.ops_ );
+
+   if( simulator_ != nullptr )
+   {
+      SCOPED_MUTEX_T lock(_sysMu);
+      userObj.m_status = simExecute( rBatch.ops_ );
+   }
+   else
+   { // Begin of mutex scope
+      SCOPED_MUTEX_T lock(_sysMu);
+
+      eb_status_t status;
+      Cycle       eb_cycle;
+      if( (status = eb_cycle.open( eb_device_, &userObj, __onEbBatch )) != EB_OK )
+      {
+         rBatch.clear();
+         EB_THROW_CYC_OPEN_ERROR( status );
+      }
+
+      for( const auto& op: rBatch.ops_ )
+      {
+         if( op.pTarget != nullptr )
+            eb_cycle.read( op.address, op.format, nullptr );
+         else
+            eb_cycle.write( op.address, op.format, op.data );
+      }
+
+      if( (status = eb_cycle.close()) != EB_OK )
+      {
+         rBatch.clear();
+         EB_THROW_CYC_CLOSE_ERROR( status );
+      }
+
+      do
+      {
+         run();
+         if( userObj.m_finished )
+            break;
+      }
+      while( onSockedPoll() );
+   } // End of mutex scope.
+
+   rBatch.clear();
+
+   /*
+    * Checking whether an error in the callback function "__onEbBatch"
+    * has occurred.
+    */
+   if( userObj.m_status != EB_OK )
+   {
+      EB_THROW( userObj.m_status, "Callback function __onEbBatch failed!" );
+   }
+}
+
 /* ----------------------------------------------------------------------------
  */
 void EtherboneConnection::doRead(etherbone::address_t eb_address,
@@ -765,6 +1555,23 @@ void EtherboneConnection::doRead(etherbone::address_t eb_address,
                                  etherbone::format_t format,
                                  const uint16_t size) {
 
+  if ( simulator_ != nullptr ) {
+    std::vector<EtherboneBatch::OP_T> ops;
+    for(uint i = 0; i < size; i++) {
+      data[i] = 0;
+      ops.push_back( { eb_address+(i*(format & EB_DATAX)), format, 0,
+                       reinterpret_cast<uint8_t*>(&data[i]) } );
+    }
+    eb_status_t status;
+    {
+      SCOPED_MUTEX_T lock(_sysMu);
+      status = simExecute( ops );
+    }
+    if (status != EB_OK)
+      EB_THROW_CB_ERROR(status);
+    return;
+  }
+
   if ( size == 1 ) {
     {
       SCOPED_MUTEX_T lock(_sysMu);
@@ -816,6 +1623,24 @@ void EtherboneConnection::doVectorRead( const etherbone::address_t &eb_address,
    etherbone::Cycle eb_cycle;
    eb_status_t status;
 
+   if( simulator_ != nullptr )
+   {
+      std::vector<EtherboneBatch::OP_T> ops;
+      for( uint i = 0; i < v.size(); i++ )
+      {
+         v[i].second = 0;
+         ops.push_back( { eb_address+v[i].first, format, 0,
+                          reinterpret_cast<uint8_t*>(&v[i].second) } );
+      }
+      {
+         SCOPED_MUTEX_T lock(_sysMu);
+         status = simExecute( ops );
+      }
+      if( status != EB_OK )
+         EB_THROW_CB_ERROR( status );
+      return;
+   }
+
    {
       SCOPED_MUTEX_T lock(_sysMu);
       if ((status = eb_cycle.open(eb_device_, this, eb_block)) != EB_OK) {
@@ -862,6 +1687,21 @@ void EtherboneConnection::doWrite(const etherbone::address_t &eb_address,
                                   etherbone::format_t format,
                                   const uint16_t size) {
 
+  if ( simulator_ != nullptr ) {
+    std::vector<EtherboneBatch::OP_T> ops;
+    for(uint i = 0; i < size; i++) {
+      ops.push_back( { eb_address+(i*(format & EB_DATAX)), format, data[i], nullptr } );
+    }
+    eb_status_t status;
+    {
+      SCOPED_MUTEX_T lock(_sysMu);
+      status = simExecute( ops );
+    }
+    if (status != EB_OK)
+      EB_THROW_CB_ERROR(status);
+    return;
+  }
+
   if ( size == 1 ) {
     {
       SCOPED_MUTEX_T lock(_sysMu);
@@ -910,6 +1750,20 @@ void EtherboneConnection::doVectorWrite(const etherbone::address_t &eb_address,
    etherbone::Cycle eb_cycle;
    eb_status_t status;
 
+   if( simulator_ != nullptr )
+   {
+      std::vector<EtherboneBatch::OP_T> ops;
+      for( uint i = 0; i < v.size(); i++ )
+         ops.push_back( { eb_address+v[i].first, format, v[i].second, nullptr } );
+      {
+         SCOPED_MUTEX_T lock(_sysMu);
+         status = simExecute( ops );
+      }
+      if( status != EB_OK )
+         EB_THROW_CB_ERROR( status );
+      return;
+   }
+
    {
       SCOPED_MUTEX_T lock(_sysMu);
       if ((status = eb_cycle.open(eb_device_, this, eb_block)) != EB_OK)
@@ -10,6 +10,12 @@
 #include <etherbone.h>
 #include <utility>      // std::pair, std::make_pair
 #include <string>
+#include <functional>
+#include <list>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <cassert>
 
 #define CONFIG_IMPLEMENT_DDR3_WRITE
 
@@ -22,8 +28,10 @@
 
 #ifdef CONFIG_NO_INCLUDE_PATHS
   #include "Constants.hpp"
+  #include "WishboneSimulator.hpp"
 #else
   #include "feSupport/scu/etherbone/Constants.hpp"
+  #include "feSupport/scu/etherbone/WishboneSimulator.hpp"
 #endif
 
 #ifndef EB_DEFAULT_TIMEOUT
@@ -34,6 +42,19 @@
   #define EB_DEFAULT_CONNECTION "dev/wbm0"
 #endif
 
+#ifndef EB_DEFAULT_ASYNC_WINDOW
+  #define EB_DEFAULT_ASYNC_WINDOW 8
+#endif
+
+/*!
+ * @brief Maximum time in milliseconds which disconnect() waits for the
+ *        completion of still pending asynchronous cycles before they
+ *        become dropped.
+ */
+#ifndef EB_DISCARD_ASYNC_TIMEOUT_MS
+  #define EB_DISCARD_ASYNC_TIMEOUT_MS 1000
+#endif
+
 namespace FeSupport {
   namespace Scu {
     /*!
@@ -44,6 +65,124 @@ namespace FeSupport {
 #ifndef CONFIG_EB_USE_NORMAL_MUTEX
       namespace IPC = boost::interprocess;
 #endif
+      /*!
+       * @brief Container of wishbone read- and write- operations which
+       *        becomes executed by EtherboneConnection::execute() within a
+       *        single etherbone cycle.
+       *
+       * The operations can address different wishbone devices, e.g. the
+       * LM32 shared memory and the DDR3-RAM. They becomes executed in the
+       * order of queuing, so a acknowledge written after a read will
+       * reach the device after the read has been made.
+       * @author Ulrich Becker
+       */
+      class EtherboneBatch {
+          friend class EtherboneConnection;
+        public:
+          /*!
+           * @brief Single wishbone operation.
+           */
+          struct OP_T
+          {
+             /*!
+              * @brief Wishbone address.
+              */
+             etherbone::address_t address;
+
+             /*!
+              * @brief Or-link of endian convention and data format.
+              */
+             etherbone::format_t  format;
+
+             /*!
+              * @brief Value to write, not used in the case of reading.
+              */
+             etherbone::data_t    data;
+
+             /*!
+              * @brief Target address of the read value or nullptr
+              *        in the case of writing.
+              */
+             uint8_t*             pTarget;
+          };
+
+        private:
+          std::vector<OP_T> ops_;
+
+        public:
+          /*!
+           * @brief Queues the reading of a data array.
+           * @note The destination pData has to stay valid until the
+           *       batch has been executed.
+           * @param eb_address Address to read from
+           * @param pData Destination address to store data
+           * @param format Or-link of endian convention and data format
+           *               (8, 16, 32 or 64) bit.
+           * @param size Length of data array.
+           * @param modWbAddrOfs Modulo value for increment the wb-address offset.
+           *                     @see EtherboneConnection::read
+           */
+          void read( const etherbone::address_t eb_address,
+                     eb_user_data_t pData,
+                     const etherbone::format_t format,
+                     const uint size = 1,
+                     uint modWbAddrOfs = 0 );
+
+          /*!
+           * @brief Queues the writing of a data array.
+           *
+           * The data becomes copied by this function, therefore pData
+           * may be released after returning.
+           * @param eb_address Address to write to
+           * @param pData Array of data to write
+           * @param format Or-link of endian convention and data format
+           *               (8, 16, 32 or 64) bit.
+           * @param size Length of data array.
+           * @param modWbAddrOfs Modulo value for increment the wb-address offset.
+           *                     @see EtherboneConnection::write
+           */
+          void write( const etherbone::address_t eb_address,
+                      const eb_user_data_t pData,
+                      const etherbone::format_t format,
+                      const uint size = 1,
+                      uint modWbAddrOfs = 0 );
+
+          /*!
+           * @brief Queues the writing of 64 bit items in the DDR3-RAM.
+           * @see EtherboneConnection::ddr3Write
+           * @param eb_address Address to write to
+           * @param pData Array of data to write
+           * @param size Length in 64 bit items of data array.
+           */
+          void ddr3Write( const etherbone::address_t eb_address,
+                          const uint64_t* pData,
+                          const uint size = 1 );
+
+          /*!
+           * @brief Removes all queued operations.
+           */
+          void clear()
+          {
+             ops_.clear();
+          }
+
+          /*!
+           * @brief Returns true if no operation is queued.
+           */
+          bool empty() const
+          {
+             return ops_.empty();
+          }
+
+          /*!
+           * @brief Returns the number of queued wishbone operations.
+           */
+          std::size_t getNumberOfOperations() const
+          {
+             return ops_.size();
+          }
+      };
+
       /*!
        * \brief Connection abstraction for an etherbone bus.
        */
@@ -69,19 +208,48 @@ namespace FeSupport {
            */
           using EBC_PTR_T  = EtherboneConnection*;
 
+          /*!
+           * @brief Type of the optional completion callback function of
+           *        readAsync() and writeAsync().
+           *
+           * The callback becomes invoked by pollAsync() or waitForAsync()
+           * respectively by readAsync() or writeAsync() when the window
+           * is full, but never within the etherbone library itself.
+           * Therefore it is allowed to invoke further etherbone accesses
+           * within this callback.
+           * @param status Etherbone status of the completed cycle.
+           * @author Ulrich Becker
+           */
+          using ASYNC_CALLBACK_T = std::function<void( const eb_status_t status )>;
+
+          /*!
+           * @brief Identifier of a group of asynchronous cycles whose
+           *        completion and errors becomes tracked together.
+           * @see openAsyncBatch
+           * @see waitForAsync
+           * @author Ulrich Becker
+           */
+          using ASYNC_TOKEN_T = uint64_t;
+
+          /*!
+           * @brief Argument value for readAsync() and writeAsync() which
+           *        opens a new batch for the cycle.
+           */
+          constexpr static ASYNC_TOKEN_T c_newAsyncBatch = 0;
+
           /*!
            * @brief Object for administrating a singelton object of the type
-           *        "EtherboneConnection".
+           *        "EtherboneConnection" per net address.
            *
-           * In the case that in the future there are more than one wishbone
-           * interfaces on a FEC, so this object becomes to a item-type of
-           * a linked list.
+           * A process can be connected to several SCUs at the same time,
+           * e.g. a acquisition daemon, therefore this object is the
+           * item-type of a map with the net address as key.
            * @author Ulrich Becker
            */
           struct OBJ_ADMIN_T
           {  /*!
               * @brief Pointer of the single object of type
-              *        "EtherboneConnection*".
+              *        "EtherboneConnection*" of this net address.
               */
              EBC_PTR_T ptr_;
 
@@ -92,8 +260,10 @@ namespace FeSupport {
           };
 
           /*!
-           * @brief Static class-function creates a single instance if not already created
-           *        and/or gives the pointer to this instance back.
+           * @brief Static class-function creates a single instance per net address
+           *        if not already created and/or gives the pointer to this
+           *        instance back.
+           * @note This function is thread safe.
            * @return Pointer to the object of type "EtherboneConnection".
            * @author Ulrich Becker
            */
@@ -101,23 +271,36 @@ namespace FeSupport {
                                         uint timeout = EB_DEFAULT_TIMEOUT );
 
           /*!
-           * @brief Counterpart of getInstance(), invokes the destructor if the instance has existed.
-           * @param ptr Return-value of getInstance(), at the moment only for debug purposes meaningful.
-           *            It becomes eventually necessary in the future when more than one wishbone-ports
-           *            are present.
+           * @brief Counterpart of getInstance(), invokes the destructor if the
+           *        instance of its net address has existed.
+           * @param ptr Return-value of getInstance().
            * @author Ulrich Becker
            */
           static void releaseInstance( EBC_PTR_T ptr );
 
           /*!
-           * @brief Class-function returns the current number of by getInstance created instances.
+           * @brief Class-function returns the current number of by getInstance created
+           *        instances of all net addresses.
            * @note This is for debug purposes only.
            * @see getInstance
            * @author Ulrich Becker
            */
-          static uint getNumberOfInstances( void )
+          static uint getNumberOfInstances( void );
+
+          /*!
+           * @brief Registers the factory function of the wishbone simulator
+           *        which becomes used when the net address begins with
+           *        EB_SIMULATOR_PREFIX.
+           * @param factory Factory function.
+           * @param override If false then a already registered factory
+           *                 function will not replaced.
+           * @author Ulrich Becker
+           */
+          static void setSimulatorFactory( const SIMULATOR_FACTORY_T factory,
+                                           const bool override = true )
           {
-             return c_oAdmin.count_;
+             if( override || (c_simulatorFactory == nullptr) )
+                c_simulatorFactory = factory;
           }
 
      private:
@@ -242,6 +425,157 @@ namespace FeSupport {
                           uint modWbAddrOfs = 0 );
 #endif
 
+          /*!
+           * @brief Executes all operations of the given batch object within
+           *        a single etherbone cycle and makes it empty.
+           * @author Ulrich Becker
+           * @param rBatch Batch object with the queued operations.
+           */
+          void execute( EtherboneBatch& rBatch );
+
+          /*!
+           * @brief Non blocking counterpart of read().
+           *
+           * Opens and closes a etherbone cycle without waiting for its
+           * completion, so that several cycles can be in flight at the same
+           * time on the same device. When the number of pending cycles has
+           * reached the window depth, then this function waits until the
+           * oldest cycle has been completed.
+           * @note The destination pData has to stay valid until the
+           *       completion of the cycle.
+           * @see setAsyncWindowDepth
+           * @see pollAsync
+           * @see waitForAsync
+           * @author Ulrich Becker
+           * @param eb_address Address to read from
+           * @param pData Destination address to store data
+           * @param format Or-link of endian convention and data format
+           *               (8, 16, 32 or 64) bit.
+           * @param size Length of data array.
+           * @param callback Optional completion callback function.
+           *                 If not given, then a error becomes thrown
+           *                 by waitForAsync().
+           * @param modWbAddrOfs Modulo value for increment the wb-address offset.
+           *                     @see read
+           * @param token Batch which the cycle belongs to, by default
+           *              a new batch becomes opened.
+           * @return Token of the batch which the cycle belongs to.
+           */
+          ASYNC_TOKEN_T readAsync( const etherbone::address_t eb_address,
+                                   eb_user_data_t pData,
+                                   const etherbone::format_t format,
+                                   const uint size = 1,
+                                   const ASYNC_CALLBACK_T& callback = nullptr,
+                                   uint modWbAddrOfs = 0,
+                                   const ASYNC_TOKEN_T token = c_newAsyncBatch );
+
+          /*!
+           * @brief Non blocking counterpart of write().
+           *
+           * The data becomes copied in the etherbone cycle by this function,
+           * therefore pData may be released after returning.
+           * @see readAsync
+           * @author Ulrich Becker
+           * @param eb_address Address to write to
+           * @param pData Array of data to write
+           * @param format Or-link of endian convention and data format
+           *               (8, 16, 32 or 64) bit.
+           * @param size Length of data array.
+           * @param callback Optional completion callback function.
+           * @param modWbAddrOfs Modulo value for increment the wb-address offset.
+           *                     @see write
+           * @param token Batch which the cycle belongs to, by default
+           *              a new batch becomes opened.
+           * @return Token of the batch which the cycle belongs to.
+           */
+          ASYNC_TOKEN_T writeAsync( const etherbone::address_t eb_address,
+                                    const eb_user_data_t pData,
+                                    const etherbone::format_t format,
+                                    const uint size = 1,
+                                    const ASYNC_CALLBACK_T& callback = nullptr,
+                                    uint modWbAddrOfs = 0,
+                                    const ASYNC_TOKEN_T token = c_newAsyncBatch );
+
+          /*!
+           * @brief Returns a new token for grouping several asynchronous
+           *        cycles, so that they can be awaited together by
+           *        waitForAsync( token ).
+           * @note This function is thread safe.
+           * @author Ulrich Becker
+           */
+          ASYNC_TOKEN_T openAsyncBatch()
+          {
+             return ++asyncSequence_;
+          }
+
+          /*!
+           * @brief Handles the already completed asynchronous cycles
+           *        without blocking.
+           * @return Number of still pending cycles.
+           * @author Ulrich Becker
+           */
+          uint pollAsync()
+          {
+             return serviceAsync( false );
+          }
+
+          /*!
+           * @brief Waits until all asynchronous cycles of all callers
+           *        has been completed.
+           * @note If one or more cycles without callback function has been
+           *       failed, then a exception of type BusException becomes
+           *       thrown after all cycles has been completed.
+           *       The errors of all batches becomes cleared.
+           * @author Ulrich Becker
+           */
+          void waitForAsync();
+
+          /*!
+           * @brief Waits until all asynchronous cycles of the given batch
+           *        has been completed.
+           *
+           * Cycles of other batches, e.g. of other threads, neither
+           * prolong the waiting nor their errors become reported here.
+           * @note If one or more cycles of this batch without callback
+           *       function has been failed, then a exception of type
+           *       BusException with the status of the first failed cycle
+           *       becomes thrown after all cycles of the batch has been
+           *       completed.
+           * @param token Return value of readAsync(), writeAsync() or
+           *              openAsyncBatch().
+           * @author Ulrich Becker
+           */
+          void waitForAsync( const ASYNC_TOKEN_T token );
+
+          /*!
+           * @brief Returns the number of asynchronous cycles which are
+           *        still in flight.
+           * @note The caller must not hold the system mutex.
+           * @author Ulrich Becker
+           */
+          uint getNumberOfPendingCycles() const;
+
+          /*!
+           * @brief Sets the maximum number of asynchronous cycles which can
+           *        be in flight at the same time.
+           * @note The value of zero will be treated as one.
+           * @author Ulrich Becker
+           */
+          void setAsyncWindowDepth( const uint depth = EB_DEFAULT_ASYNC_WINDOW )
+          {
+             asyncWindowDepth_ = (depth == 0)? 1 : depth;
+          }
+
+          /*!
+           * @brief Returns the maximum number of asynchronous cycles which
+           *        can be in flight at the same time.
+           * @author Ulrich Becker
+           */
+          uint getAsyncWindowDepth() const
+          {
+             return asyncWindowDepth_;
+          }
+
           /*!
            * \brief Writes a single etherbone value to the bus.
            *
@@ -290,6 +624,30 @@ namespace FeSupport {
              return connectionOpenCount_;
           }
 
+          /*!
+           * @brief Increments the user counter of this connection.
+           * @note Counted per connection, so users of different
+           *       SCUs don't influence each other.
+           * @return Number of users including the new one.
+           * @author UB
+           */
+          uint addUser()
+          {
+             return ++userCount_;
+          }
+
+          /*!
+           * @brief Counterpart of addUser(), decrements the user counter
+           *        of this connection.
+           * @return Number of remaining users.
+           * @author UB
+           */
+          uint removeUser()
+          {
+             assert( userCount_ > 0 );
+             return --userCount_;
+          }
+
           /*!
            * @brief Returns the net address given as first argument of
            *        the constructor.
@@ -300,6 +658,28 @@ namespace FeSupport {
              return netaddress_;
           }
 
+          /*!
+           * @brief Returns true if the connection is established to a
+           *        simulated wishbone bus instead of a real device.
+           * @see EB_SIMULATOR_PREFIX
+           * @author UB
+           */
+          bool isSimulated() const
+          {
+             return simulator_ != nullptr;
+          }
+
+          /*!
+           * @brief Returns the number of etherbone cycles handled by the
+           *        simulated wishbone bus since connecting, or zero if
+           *        the connection is not simulated.
+           * @author UB
+           */
+          uint64_t getSimulatedCycleCount() const
+          {
+             return (simulator_ == nullptr)? 0 : simulator_->getCycleCount();
+          }
+
         protected:
           /*!
            * @brief Function will used from EtherboneConnection::write
@@ -335,10 +715,77 @@ namespace FeSupport {
           }
 
         private:
+          /*!
+           * @brief Administration object of a single asynchronous cycle.
+           * @see EtherboneConnection.cpp
+           */
+          struct ASYNC_CYCLE_T;
+
+          /*!
+           * @brief Runs the etherbone socket and invokes the callback
+           *        functions of all completed asynchronous cycles.
+           * @param doWait If true then the socket waits for activity.
+           * @return Number of still pending cycles.
+           */
+          uint serviceAsync( const bool doWait );
+
+          /*!
+           * @brief Waits until a further asynchronous cycle can be opened.
+           */
+          void waitForAsyncWindow();
+
+          /*!
+           * @brief Returns true if at least one cycle of the given batch
+           *        is still in flight.
+           */
+          bool isAsyncPending( const ASYNC_TOKEN_T token );
+
+          /*!
+           * @brief Waits at most EB_DISCARD_ASYNC_TIMEOUT_MS milliseconds
+           *        until all pending asynchronous cycles has been
+           *        completed and releases the completed cycles without
+           *        invoking its callback functions.
+           * @note The mutex has to be locked by the caller.
+           * @return Number of cycles which are still in flight after the
+           *         deadline, they has to be released by dropAsync()
+           *         after closing the device.
+           */
+          uint discardAsync();
+
+          /*!
+           * @brief Releases all remaining asynchronous cycles without
+           *        invoking its callback functions.
+           * @note The mutex has to be locked by the caller, and the
+           *       etherbone device has to be closed already, because the
+           *       etherbone library refers to the cycles until then.
+           */
+          void dropAsync();
+
+          /*!
+           * @brief Executes the given operations on the simulated bus
+           *        within a single cycle.
+           * @note The mutex has to be locked by the caller.
+           * @param rOps Operations to execute.
+           * @param doWait If true then the injected latency of the
+           *               simulator becomes awaited.
+           * @return Etherbone status of the cycle.
+           */
+          eb_status_t simExecute( const std::vector<EtherboneBatch::OP_T>& rOps,
+                                  const bool doWait = true );
+
+          /*!
+           * @brief Marks the asynchronous cycles on the simulated bus as
+           *        completed whose latency has been elapsed.
+           * @note The mutex has to be locked by the caller.
+           * @param doWait If true then it waits until the oldest pending
+           *               cycle has been completed.
+           */
+          void simRun( const bool doWait );
+
           /*!
            * @brief System mutex
            */
-          MUTEX_T _sysMu;
+          mutable MUTEX_T _sysMu;
           // EB-Device to talk to
           //
           std::string netaddress_;
@@ -361,6 +808,15 @@ namespace FeSupport {
            */
           uint connectionOpenCount_;
 
+          /*!
+           * @brief Number of users of this connection, e.g. objects of
+           *        type Scu::EtherboneAccess.
+           * @note Atomic because the users can be created and destroyed
+           *       by different threads.
+           * @see addUser
+           */
+          std::atomic<uint> userCount_;
+
           // Contains the error Message in case the operation fails
           std::string errorMessage_;
 
@@ -369,9 +825,43 @@ namespace FeSupport {
           bool debug_;
 
           /*!
-           * @brief Stores the pointer of an instance from itself.
+           * @brief List of asynchronous cycles which are in flight.
+           */
+          std::list<ASYNC_CYCLE_T*> asyncPending_;
+
+          /*!
+           * @brief Maximum number of asynchronous cycles in flight.
+           */
+          uint asyncWindowDepth_;
+
+          /*!
+           * @brief Last given batch token.
+           * @see openAsyncBatch
+           */
+          std::atomic<ASYNC_TOKEN_T> asyncSequence_;
+
+          /*!
+           * @brief First error status of a asynchronous cycle without
+           *        callback function per batch, becomes reported by
+           *        waitForAsync().
+           */
+          std::map<ASYNC_TOKEN_T, eb_status_t> asyncErrors_;
+
+          /*!
+           * @brief Simulated wishbone bus, nullptr in the case of a real
+           *        etherbone device.
+           */
+          WishboneSimulator* simulator_;
+
+          /*!
+           * @brief Stores the pointers of the instances by its net addresses.
+           */
+          static std::map<std::string, OBJ_ADMIN_T> c_instanceMap;
+
+          /*!
+           * @brief Factory function of the wishbone simulator.
            */
-          static OBJ_ADMIN_T c_oAdmin;
+          static SIMULATOR_FACTORY_T c_simulatorFactory;
 
           static std::string c_mutexName;
           static const char* __makeMutexName( const std::string& rName );
@@ -0,0 +1,153 @@
+/*
+ * WishboneSimulator.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ulrich Becker
+ */
+#pragma once
+
+#include <etherbone.h>
+#include <string>
+
+#ifdef CONFIG_NO_INCLUDE_PATHS
+  #include "Constants.hpp"
+#else
+  #include "feSupport/scu/etherbone/Constants.hpp"
+#endif
+
+/*!
+ * @brief Prefix of the net address which selects a in-process simulated
+ *        wishbone bus instead of a real etherbone device.
+ *
+ * All characters following the prefix are passed to the simulator factory,
+ * e.g.: "sim://addac=2,mil=1,latency=300"
+ */
+#ifndef EB_SIMULATOR_PREFIX
+  #define EB_SIMULATOR_PREFIX "sim://"
+#endif
+
+namespace FeSupport {
+  namespace Scu {
+    namespace Etherbone {
+
+      /*!
+       * @brief Returns true if the given net address selects a simulated
+       *        wishbone bus.
+       * @see EB_SIMULATOR_PREFIX
+       */
+      inline bool isSimulatorAddress( const std::string& rNetAddress )
+      {
+         return rNetAddress.compare( 0, sizeof( EB_SIMULATOR_PREFIX ) - 1,
+                                     EB_SIMULATOR_PREFIX ) == 0;
+      }
+
+      /*!
+       * @brief Interface of a in-process simulated wishbone bus.
+       *
+       * When the net address of EtherboneConnection begins with
+       * EB_SIMULATOR_PREFIX, then all wishbone accesses will forwarded
+       * to an object of this type instead of the etherbone library.
+       * The object becomes created by the factory function registered
+       * by EtherboneConnection::setSimulatorFactory() during connecting
+       * and destroyed during disconnecting.
+       *
+       * Each etherbone cycle becomes bracketed by beginCycle() and
+       * endCycle(), so the implementation can handle the operations of
+       * one cycle atomically like the real hardware.
+       * @author Ulrich Becker
+       */
+      class WishboneSimulator {
+        public:
+          virtual ~WishboneSimulator() {}
+
+          /*!
+           * @brief Searches the base address of the device with the given
+           *        identity.
+           * @param vendorId Vendor identifier.
+           * @param deviceId Device identifier.
+           * @param ind Index in the case the device is present more than once.
+           * @param rAddress Returns the wishbone base address if found.
+           * @retval true Device found.
+           * @retval false Device not present.
+           */
+          virtual bool findDevice( const VendorId vendorId,
+                                   const DeviceId deviceId,
+                                   const uint32_t ind,
+                                   uint64_t& rAddress ) = 0;
+
+          /*!
+           * @brief Returns the version of the VHDL macro of the given device.
+           */
+          virtual uint32_t getMacroVersion( const VendorId vendorId,
+                                            const DeviceId deviceId )
+          {
+             return 0;
+          }
+
+          /*!
+           * @brief Becomes invoked before the first operation of a
+           *        etherbone cycle.
+           */
+          virtual void beginCycle() = 0;
+
+          /*!
+           * @brief Becomes invoked after the last operation of a
+           *        etherbone cycle.
+           */
+          virtual void endCycle() = 0;
+
+          /*!
+           * @brief Reads a single value from the simulated bus.
+           * @param address Wishbone address.
+           * @param format Or-link of endian convention and data format.
+           * @param rData Returns the read value.
+           * @retval true Success.
+           * @retval false Address not mapped, corresponds to a bus error.
+           */
+          virtual bool read( const etherbone::address_t address,
+                             const etherbone::format_t format,
+                             etherbone::data_t& rData ) = 0;
+
+          /*!
+           * @brief Writes a single value on the simulated bus.
+           * @param address Wishbone address.
+           * @param format Or-link of endian convention and data format.
+           * @param data Value to write.
+           * @retval true Success.
+           * @retval false Address not mapped, corresponds to a bus error.
+           */
+          virtual bool write( const etherbone::address_t address,
+                              const etherbone::format_t format,
+                              const etherbone::data_t data ) = 0;
+
+          /*!
+           * @brief Returns the round trip time of a single etherbone cycle
+           *        in microseconds which becomes injected by
+           *        EtherboneConnection.
+           */
+          virtual uint getLatencyUs() const
+          {
+             return 0;
+          }
+
+          /*!
+           * @brief Returns the number of etherbone cycles handled so far.
+           * @note For benchmark purposes.
+           */
+          virtual uint64_t getCycleCount() const
+          {
+             return 0;
+          }
+      };
+
+      /*!
+       * @brief Type of the factory function which creates the simulator
+       *        object.
+       * @param rNetAddress Complete net address including
+       *                    EB_SIMULATOR_PREFIX.
+       */
+      using SIMULATOR_FACTORY_T = WishboneSimulator* (*)( const std::string& rNetAddress );
+
+    } // namespace Etherbone
+  } // namespace Scu
+} // namepace FeSupport
@@ -25,12 +25,33 @@
  * License along with this library. If not, see <http://www.gnu.org/licenses/>.
  ******************************************************************************
  */
+#include <chrono>
+#include <cstring>
 #include <helper_macros.h>
+#include <message_macros.hpp>
 #include <scu_ddr3.h>
 #include "scu_ddr3_access.hpp"
 
 using namespace Scu;
 
+/*!
+ * @brief Number of measurements of each read mode of a size class before
+ *        the cheapest one becomes chosen.
+ */
+constexpr uint AUTO_MIN_SAMPLES     = 4;
+
+/*!
+ * @brief Every AUTO_PROBE_INTERVAL read accesses of a size class, one of
+ *        the read modes becomes measured again, so that the cost model
+ *        follows changes of the bus load.
+ */
+constexpr uint AUTO_PROBE_INTERVAL  = 64;
+
+/*!
+ * @brief Weight of a new measurement in the moving average.
+ */
+constexpr double AUTO_AVERAGE_WEIGHT = 1.0 / 8.0;
+
 
 /*!----------------------------------------------------------------------------
  */
@@ -87,9 +108,34 @@ void Ddr3Access::init( void )
    m_if2Addr = findDeviceBaseAddress( EBC::gsiId, EBC::wb_ddr3ram2 );
    DEBUG_MESSAGE( "DDR3 IF2: 0x" << std::hex << std::uppercase << m_if2Addr << std::dec );
 
+   resetCostModel();
    flushFiFo();
 }
 
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::resetCostModel( void )
+{
+   std::lock_guard<std::mutex> lock( m_oCostModelMutex );
+   ::memset( m_aCostModel, 0, sizeof( m_aCostModel ) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+Ddr3Access::SIZE_CLASS_T Ddr3Access::getCostModel( const uint len )
+{
+   std::lock_guard<std::mutex> lock( m_oCostModelMutex );
+   return m_aCostModel[getSizeClass( len )];
+}
+
+/*!----------------------------------------------------------------------------
+ */
+Ddr3Access::READ_MODE_T Ddr3Access::getPreferredReadMode( const uint len )
+{
+   std::lock_guard<std::mutex> lock( m_oCostModelMutex );
+   return getCheapestMode( m_aCostModel[getSizeClass( len )], len );
+}
+
 /*-----------------------------------------------------------------------------
  */
 void Ddr3Access::flushFiFo( void )
@@ -158,38 +204,110 @@ void Ddr3Access::read( uint index64, uint64_t* pData, uint len )
 {
    assert( (index64 + len) <= DDR3_MAX_INDEX64 );
 
+   if( m_burstLimit == AUTO_BURST )
+   {
+      readAuto( index64, pData, len );
+      return;
+   }
+
    if( (m_burstLimit == NEVER_BURST) || (static_cast<int>(len) < m_burstLimit) )
+   {
+      readTransparent( index64, pData, len );
+      return;
+   }
+
+   readBurst( index64, pData, len );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::readTransparentAsync( const ASYNC_TOKEN_T token,
+                                       uint index64, uint64_t* pData, uint len )
+{
+   uint partLen = 0;
+   while( len > 0 )
+   {
+      pData   += partLen;
+      index64 += partLen;
+      partLen =  std::min( len, MAX_PART_LEN );
+      len     -= partLen;
+      EtherboneAccess::readAsync( m_if1Addr + index64 * sizeof(uint64_t),
+                                  pData,
+                                  sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                                  partLen * sizeof(uint64_t)/sizeof(uint32_t),
+                                  nullptr, 0, token
+                                );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::awaitAfterError( const ASYNC_TOKEN_T token )
+{
+   try
+   {
+      EtherboneAccess::waitForAsync( token );
+   }
+   catch( std::exception& e )
    { /*
-      * +++ Reading the DDR3-RAM in transparent mode. +++
+      * The exception of the caller becomes rethrown, so this secondary
+      * error would get lost without notice.
       */
-   #ifdef CONFIG_DDR3_PARTITIONED_RW
-      uint partLen = 0;
-      while( len > 0 )
-      {
-         pData   += partLen;
-         index64 += partLen;
-         partLen =  std::min( len, MAX_PART_LEN );
-         len     -= partLen;
-         EtherboneAccess::read( m_if1Addr + index64 * sizeof(uint64_t),
-                                pData,
-                                sizeof(uint32_t) | EB_LITTLE_ENDIAN,
-                                partLen * sizeof(uint64_t)/sizeof(uint32_t)
-                              );
-      }
-   #else
+      ERROR_MESSAGE( "DDR3: pending read cycle failed as well: " << e.what() );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::readTransparent( uint index64, uint64_t* pData, uint len )
+{
+   WbLatencyTimer oTimer;
+#ifdef CONFIG_DDR3_PARTITIONED_RW
+   if( len <= MAX_PART_LEN )
+   {
       EtherboneAccess::read( m_if1Addr + index64 * sizeof(uint64_t),
                              pData,
                              sizeof(uint32_t) | EB_LITTLE_ENDIAN,
                              len * sizeof(uint64_t)/sizeof(uint32_t)
                            );
-   #endif
+      oTimer.stop( WbHistogram::DDR3_READ, len * sizeof(uint64_t) );
       return;
    }
-
    /*
-    * +++ Reading the DDR3-RAM in burst mode. +++
+    * The partial cycles are independent of each other, therefore
+    * they becomes pipelined, so that the round trip time of the
+    * etherbone connection occurs only once per window.
     */
-   assert( m_burstLimit != NEVER_BURST );
+   const ASYNC_TOKEN_T token = EtherboneAccess::openAsyncBatch();
+   try
+   {
+      readTransparentAsync( token, index64, pData, len );
+   }
+   catch( ... )
+   { /*
+      * The already opened cycles refer to pData, so they has to be
+      * completed before leaving this function.
+      */
+      awaitAfterError( token );
+      throw;
+   }
+   EtherboneAccess::waitForAsync( token );
+#else
+   EtherboneAccess::read( m_if1Addr + index64 * sizeof(uint64_t),
+                          pData,
+                          sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                          len * sizeof(uint64_t)/sizeof(uint32_t)
+                        );
+#endif
+   oTimer.stop( WbHistogram::DDR3_READ, len * sizeof(uint64_t) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::readBurst( uint index64, uint64_t* pData, uint len )
+{
+   WbLatencyTimer oTimer;
+   const std::size_t bytes = len * sizeof(uint64_t);
    uint partLen = 0;
    while( len > 0 )
    {
@@ -247,6 +365,154 @@ void Ddr3Access::read( uint index64, uint64_t* pData, uint len )
                               );
       } /* End of mutex scope */
    }
+   oTimer.stop( WbHistogram::DDR3_BURST_READ, bytes );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::readSplit( uint index64, uint64_t* pData, uint len,
+                            const uint transparentLen )
+{
+   assert( transparentLen <= len );
+   WbLatencyTimer oTimer;
+   /*
+    * The transparent cycles of interface 1 are still on the way while
+    * the FiFo of interface 2 becomes read.
+    */
+   const ASYNC_TOKEN_T token = EtherboneAccess::openAsyncBatch();
+   try
+   {
+      readTransparentAsync( token, index64, pData, transparentLen );
+      readBurst( index64 + transparentLen, pData + transparentLen,
+                 len - transparentLen );
+   }
+   catch( ... )
+   {
+      awaitAfterError( token );
+      throw;
+   }
+   EtherboneAccess::waitForAsync( token );
+   oTimer.stop( WbHistogram::DDR3_SPLIT_READ, len * sizeof(uint64_t) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+uint Ddr3Access::getSizeClass( const uint len )
+{
+   if( len == 0 )
+      return 0;
+   return (SIZE_CLASSES - 1) - __builtin_clz( len );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+Ddr3Access::READ_MODE_T
+Ddr3Access::getCheapestMode( const SIZE_CLASS_T& rClass, const uint len )
+{
+   const uint modes = (len >= SPLIT_MIN_LEN)? READ_MODES : SPLIT;
+   uint cheapest = TRANSPARENT;
+   for( uint mode = TRANSPARENT; mode < modes; mode++ )
+   {
+      if( rClass.m_aCost[mode].m_samples == 0 )
+         continue;
+      if( (rClass.m_aCost[cheapest].m_samples == 0) ||
+          (rClass.m_aCost[mode].m_nsPerWord < rClass.m_aCost[cheapest].m_nsPerWord) )
+         cheapest = mode;
+   }
+   return static_cast<READ_MODE_T>(cheapest);
+}
+
+/*!----------------------------------------------------------------------------
+ */
+Ddr3Access::READ_MODE_T
+Ddr3Access::selectMode( SIZE_CLASS_T& rClass, const uint len )
+{
+   /*
+    * Splitting makes sense only when the costs of both interfaces are known.
+    */
+   const uint modes = (len >= SPLIT_MIN_LEN)? READ_MODES : SPLIT;
+
+   for( uint mode = TRANSPARENT; mode < modes; mode++ )
+   {
+      if( rClass.m_aCost[mode].m_samples < AUTO_MIN_SAMPLES )
+         return static_cast<READ_MODE_T>(mode);
+   }
+
+   rClass.m_calls++;
+   if( (rClass.m_calls % AUTO_PROBE_INTERVAL) == 0 )
+      return static_cast<READ_MODE_T>((rClass.m_calls / AUTO_PROBE_INTERVAL) % modes);
+
+   return getCheapestMode( rClass, len );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+uint Ddr3Access::getSplitLen( const SIZE_CLASS_T& rClass, const uint len )
+{
+   const double transparentCost = rClass.m_aCost[TRANSPARENT].m_nsPerWord;
+   const double burstCost       = rClass.m_aCost[BURST].m_nsPerWord;
+   if( (rClass.m_aCost[TRANSPARENT].m_samples == 0) ||
+       (rClass.m_aCost[BURST].m_samples == 0) ||
+       ((transparentCost + burstCost) <= 0.0) )
+      return len / 2;
+
+   /*
+    * Both parts will take the same time when:
+    * transparentLen * transparentCost == (len - transparentLen) * burstCost
+    */
+   const uint transparentLen = static_cast<uint>( static_cast<double>(len) *
+                                 burstCost / (transparentCost + burstCost) + 0.5 );
+   return std::max( 1U, std::min( transparentLen, len - 1 ) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::readAuto( uint index64, uint64_t* pData, uint len )
+{
+   if( len == 0 )
+      return;
+
+   const uint sizeClass = getSizeClass( len );
+   READ_MODE_T mode;
+   uint transparentLen = 0;
+   {
+      std::lock_guard<std::mutex> lock( m_oCostModelMutex );
+      mode = selectMode( m_aCostModel[sizeClass], len );
+      if( mode == SPLIT )
+         transparentLen = getSplitLen( m_aCostModel[sizeClass], len );
+   }
+
+   const auto start = std::chrono::steady_clock::now();
+   switch( mode )
+   {
+      case TRANSPARENT:
+      {
+         readTransparent( index64, pData, len );
+         break;
+      }
+      case BURST:
+      {
+         readBurst( index64, pData, len );
+         break;
+      }
+      case SPLIT:
+      {
+         readSplit( index64, pData, len, transparentLen );
+         break;
+      }
+   }
+   const double nsPerWord =
+      static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>
+                           ( std::chrono::steady_clock::now() - start ).count() )
+      / static_cast<double>( len );
+
+   std::lock_guard<std::mutex> lock( m_oCostModelMutex );
+   COST_T& rCost = m_aCostModel[sizeClass].m_aCost[mode];
+   if( rCost.m_samples == 0 )
+      rCost.m_nsPerWord = nsPerWord;
+   else
+      rCost.m_nsPerWord += (nsPerWord - rCost.m_nsPerWord) * AUTO_AVERAGE_WEIGHT;
+   rCost.m_samples++;
 }
 
 /*!----------------------------------------------------------------------------
@@ -273,4 +539,76 @@ void Ddr3Access::write( const uint index64, const uint64_t* pData, const uint le
 #endif
 }
 
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::read( EB_BATCH_T& rBatch, uint index64, uint64_t* pData, uint len )
+{
+   assert( (index64 + len) <= DDR3_MAX_INDEX64 );
+
+   bool burst;
+   if( m_burstLimit == AUTO_BURST )
+   { /*
+      * The queued accesses can't be measured individually, therefore
+      * the mode is chosen by the cost model only.
+      */
+      burst = getPreferredReadMode( len ) != TRANSPARENT;
+   }
+   else
+   {
+      burst = (m_burstLimit != NEVER_BURST) && (static_cast<int>(len) >= m_burstLimit);
+   }
+
+   if( burst )
+   { /*
+      * Burst mode can't be queued.
+      */
+      RamAccess::read( rBatch, index64, pData, len );
+      return;
+   }
+
+   /*
+    * Keeping the cycle length limit of the partitioned transparent mode.
+    * When the batch becomes too long, the already queued accesses
+    * becomes executed.
+    */
+   constexpr uint MAX_OPS = MAX_PART_LEN * sizeof(uint64_t)/sizeof(uint32_t);
+   uint partLen = 0;
+   while( len > 0 )
+   {
+      pData   += partLen;
+      index64 += partLen;
+      partLen =  std::min( len, MAX_PART_LEN );
+      len     -= partLen;
+      if( (rBatch.getNumberOfOperations() + partLen * sizeof(uint64_t)/sizeof(uint32_t)) > MAX_OPS )
+         execute( rBatch );
+      rBatch.read( m_if1Addr + index64 * sizeof(uint64_t),
+                   pData,
+                   sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                   partLen * sizeof(uint64_t)/sizeof(uint32_t)
+                 );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void Ddr3Access::write( EB_BATCH_T& rBatch, const uint index64, const uint64_t* pData, const uint len )
+{
+   assert( (index64 + len) <= DDR3_MAX_INDEX64 );
+
+   constexpr uint MAX_OPS = MAX_PART_LEN * sizeof(uint64_t)/sizeof(uint32_t);
+   uint workLen = len;
+   uint workIndex = index64;
+   uint partLen = 0;
+   while( workLen > 0 )
+   {
+      pData     += partLen;
+      workIndex += partLen;
+      partLen   =  std::min( workLen, MAX_PART_LEN );
+      workLen   -= partLen;
+      if( (rBatch.getNumberOfOperations() + partLen * sizeof(uint64_t)/sizeof(uint32_t)) > MAX_OPS )
+         execute( rBatch );
+      rBatch.ddr3Write( m_if1Addr + workIndex * sizeof(uint64_t), pData, partLen );
+   }
+}
+
 //================================== EOF ======================================
@@ -27,6 +27,8 @@
  */
 #ifndef _SCU_DDR3_ACCESS_HPP
 #define _SCU_DDR3_ACCESS_HPP
+#include <mutex>
+#include <helper_macros.h>
 #include <scu_memory.hpp>
 #include <scu_mutex.hpp>
 #include <message_macros.hpp>
@@ -67,6 +69,86 @@ class Ddr3Access: public RamAccess
     */
    int  m_burstLimit;
 
+public:
+   /*!
+    * @brief Read modes of the self tuning mode AUTO_BURST.
+    */
+   enum READ_MODE_T
+   {
+      /*!
+       * @brief Reading via interface 1 in transparent mode.
+       */
+      TRANSPARENT = 0,
+
+      /*!
+       * @brief Reading via the FiFo of interface 2 in burst mode.
+       */
+      BURST       = 1,
+
+      /*!
+       * @brief Reading the first part via interface 1 in transparent mode
+       *        and concurrently the rest via interface 2 in burst mode.
+       */
+      SPLIT       = 2
+   };
+
+   /*!
+    * @brief Number of read modes.
+    */
+   constexpr static uint READ_MODES = SPLIT + 1;
+
+   /*!
+    * @brief Number of size classes of the cost model, the size class of a
+    *        read access is the binary logarithm of its length.
+    */
+   constexpr static uint SIZE_CLASSES = BIT_SIZEOF( uint );
+
+   /*!
+    * @brief Minimum number of 64-bit words at which a read access can be split.
+    */
+   constexpr static uint SPLIT_MIN_LEN = 64;
+
+   /*!
+    * @brief Measured cost of a read mode.
+    */
+   struct COST_T
+   {
+      /*!
+       * @brief Exponential moving average of the read time
+       *        in nanoseconds per 64-bit word.
+       */
+      double m_nsPerWord;
+
+      /*!
+       * @brief Number of measurements.
+       */
+      uint   m_samples;
+   };
+
+   /*!
+    * @brief Cost model of a size class.
+    */
+   struct SIZE_CLASS_T
+   {
+      COST_T m_aCost[READ_MODES];
+
+      /*!
+       * @brief Number of read accesses of this size class.
+       */
+      uint   m_calls;
+   };
+
+private:
+   /*!
+    * @brief Cost model of the self tuning mode AUTO_BURST.
+    */
+   SIZE_CLASS_T m_aCostModel[SIZE_CLASSES];
+
+   /*!
+    * @brief Protects the cost model for concurrent read accesses.
+    */
+   std::mutex   m_oCostModelMutex;
+
    /*!
     * @brief Named mutex will used to protect the burst-transfer for
     *        concurrent accesses.
@@ -77,6 +159,13 @@ public:
    constexpr static int ALWAYS_BURST = 0;
    constexpr static int NEVER_BURST  = -1;
 
+   /*!
+    * @brief Self tuning mode: Each read access becomes measured and
+    *        the cheapest read mode becomes chosen per size class.
+    * @see READ_MODE_T
+    */
+   constexpr static int AUTO_BURST   = -2;
+
    /*!
     * @brief Constructor which uses a shared object of EtherboneConnection.
     *        It establishes a connection if not already done.
@@ -84,7 +173,8 @@ public:
     * @param burstLimit Number of 64-bit words in transparent-mode until
     *                   reading in burst-mode.\n
     *                   Value of -1 (default) means never reading in burst-mode.\n
-    *                   Value of 0 means always reading in in burst-mode.
+    *                   Value of 0 means always reading in in burst-mode.\n
+    *                   Value of -2 means self tuning, see AUTO_BURST.
     */
    Ddr3Access( EBC_PTR_T pEbc, int burstLimit = NEVER_BURST );
 
@@ -96,7 +186,8 @@ public:
     * @param burstLimit Number of 64-bit words in transparent-mode until
     *                   reading in burst-mode.\n
     *                   Value of -1 (default) means never reading in burst-mode.\n
-    *                   Value of 0 means always reading in in burst-mode.
+    *                   Value of 0 means always reading in in burst-mode.\n
+    *                   Value of -2 means self tuning, see AUTO_BURST.
     * @param timeout Etherbone response timeout.
     */
    Ddr3Access( const std::string& rScuName = EB_DEFAULT_CONNECTION,
@@ -144,6 +235,27 @@ public:
       m_burstLimit = burstLimit;
    }
 
+   /*!
+    * @brief Returns a copy of the cost model of the size class to which
+    *        a read access of the given length belongs.
+    * @note Relevant in the mode AUTO_BURST only.
+    * @param len Length of the read access in 64-bit units.
+    */
+   SIZE_CLASS_T getCostModel( const uint len );
+
+   /*!
+    * @brief Returns the read mode which will chosen in the mode AUTO_BURST
+    *        for a read access of the given length, provided that the
+    *        cost model of its size class is complete.
+    * @param len Length of the read access in 64-bit units.
+    */
+   READ_MODE_T getPreferredReadMode( const uint len );
+
+   /*!
+    * @brief Discards all measurements of the cost model.
+    */
+   void resetCostModel( void );
+
    /*!
     * @brief Returns the maximum addressable capacity in 64-bit units
     *        of DDR3-RAM.
@@ -166,6 +278,26 @@ public:
     */
    void write( const uint index64, const uint64_t* pData, const uint len ) override;
 
+   /*!
+    * @brief Queues the reading of the DDR3 memory in the given batch object.
+    * @note In burst mode the reading can not be queued, in this case
+    *       the batch becomes executed and the reading will made immediately.
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words.
+    * @param pData Target address in 64 bit units
+    * @param len Length of the data array to read in 64-bit units.
+    */
+   void read( EB_BATCH_T& rBatch, uint index64, uint64_t* pData, uint len ) override;
+
+   /*!
+    * @brief Queues the writing of the DDR3 memory in the given batch object.
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words..
+    * @param pData Source address in 64 bit units.
+    * @param len Length of the data array to write in 64-bit units.
+    */
+   void write( EB_BATCH_T& rBatch, const uint index64, const uint64_t* pData, const uint len ) override;
+
 protected:
    /*!
     * @brief Optional callback function becomes invoked while waiting for the transfer of
@@ -183,6 +315,70 @@ private:
     */
    void init( void );
 
+   /*!
+    * @brief Opens the pipelined etherbone cycles for reading in
+    *        transparent mode via interface 1 without waiting for their
+    *        completion.
+    * @note The caller has to invoke EtherboneAccess::waitForAsync( token ).
+    * @param token Batch of the cycles.
+    */
+   void readTransparentAsync( const ASYNC_TOKEN_T token,
+                              uint index64, uint64_t* pData, uint len );
+
+   /*!
+    * @brief Waits for the still pending cycles of the given batch when
+    *        a exception has been occurred, a further error of these
+    *        cycles becomes reported but not thrown.
+    */
+   void awaitAfterError( const ASYNC_TOKEN_T token );
+
+   /*!
+    * @brief Reads in transparent mode via interface 1.
+    */
+   void readTransparent( uint index64, uint64_t* pData, uint len );
+
+   /*!
+    * @brief Reads in burst mode via the FiFo of interface 2.
+    */
+   void readBurst( uint index64, uint64_t* pData, uint len );
+
+   /*!
+    * @brief Reads the first part in transparent mode and concurrently
+    *        the rest in burst mode.
+    * @param transparentLen Length of the first part.
+    */
+   void readSplit( uint index64, uint64_t* pData, uint len,
+                   const uint transparentLen );
+
+   /*!
+    * @brief Reading in the mode AUTO_BURST.
+    */
+   void readAuto( uint index64, uint64_t* pData, uint len );
+
+   /*!
+    * @brief Returns the size class of a read access.
+    */
+   static uint getSizeClass( const uint len );
+
+   /*!
+    * @brief Returns the cheapest measured read mode of the given size class.
+    */
+   static READ_MODE_T getCheapestMode( const SIZE_CLASS_T& rClass,
+                                       const uint len );
+
+   /*!
+    * @brief Chooses the read mode for the next read access of the given
+    *        size class, including the exploration of read modes
+    *        with too few measurements.
+    */
+   static READ_MODE_T selectMode( SIZE_CLASS_T& rClass, const uint len );
+
+   /*!
+    * @brief Returns the length of the transparent part of a split
+    *        read access, so that both parts will take the same time.
+    */
+   static uint getSplitLen( const SIZE_CLASS_T& rClass, const uint len );
+
    /*!
     * @brief Returns the value of the FiFo status register.
     */
@@ -32,8 +32,6 @@
 
 using namespace Scu;
 
-uint EtherboneAccess::c_useCount = 0;
-
 /*!----------------------------------------------------------------------------
  */
 EtherboneAccess::EtherboneAccess( EBC_PTR_T pEbc )
@@ -49,7 +47,7 @@ EtherboneAccess::EtherboneAccess( EBC_PTR_T pEbc )
       m_pEbc->connect();
       m_selfConnected = true;
    }
-   c_useCount++;
+   m_pEbc->addUser();
 }
 
 /*!----------------------------------------------------------------------------
@@ -66,7 +64,7 @@ EtherboneAccess::EtherboneAccess( const std::string& rScuName, uint timeout )
       DEBUG_MESSAGE( "m_pEbc->connect();" );
       m_pEbc->connect();
    }
-   c_useCount++;
+   m_pEbc->addUser();
 }
 
 /*!----------------------------------------------------------------------------
@@ -74,10 +72,12 @@ EtherboneAccess::EtherboneAccess( const std::string& rScuName, uint timeout )
 EtherboneAccess::~EtherboneAccess( void )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
-   assert( c_useCount > 0 );
-
-   c_useCount--;
-   if( m_selfConnected && m_pEbc->isConnected() && (c_useCount == 0) )
+   /*
+    * The users are counted per connection, so the connection of a SCU
+    * becomes closed independently of the objects of other SCUs.
+    */
+   const uint useCount = m_pEbc->removeUser();
+   if( m_selfConnected && m_pEbc->isConnected() && (useCount == 0) )
    {
       DEBUG_MESSAGE( "m_pEbc->disconnect();" );
       m_pEbc->disconnect();
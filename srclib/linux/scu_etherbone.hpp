@@ -29,6 +29,7 @@
 #ifndef _SCU_ETHERBONE_HPP
 #define _SCU_ETHERBONE_HPP
 #include <EtherboneConnection.hpp>
+#include <scu_wb_histogram.hpp>
 #include <assert.h>
 
 
@@ -59,12 +60,20 @@ public:
     */
    using EBC_PTR_T = EBC::EtherboneConnection::EBC_PTR_T;
 
-private:
    /*!
-    * @brief Class variable is the instances counter of this class.
+    * @brief Batch-type for queuing several wishbone accesses in one
+    *        etherbone cycle.
+    * @see EtherboneConnection.hpp
+    */
+   using EB_BATCH_T = EBC::EtherboneBatch;
+
+   /*!
+    * @brief Identifier of a group of asynchronous cycles.
+    * @see EtherboneConnection::openAsyncBatch
     */
-   static uint c_useCount;
+   using ASYNC_TOKEN_T = EBC::EtherboneConnection::ASYNC_TOKEN_T;
 
+private:
    /*!
     * @brief Pointer to the object of type EtherboneConnection
     */
@@ -147,6 +156,20 @@ public:
       return m_pEbc->getNetAddress();
    }
 
+   /*!
+    * @brief Executes all queued accesses of the given batch object
+    *        within a single etherbone cycle and makes it empty.
+    * @param rBatch Batch object with the queued accesses.
+    */
+   void execute( EB_BATCH_T& rBatch )
+   {
+      assert( m_pEbc->isConnected() );
+      const std::size_t bytes = rBatch.getNumberOfOperations() * sizeof(uint32_t);
+      WbLatencyTimer oTimer;
+      m_pEbc->execute( rBatch );
+      oTimer.stop( WbHistogram::BATCH, bytes );
+   }
+
 protected:
    /*!
     * @brief Searches for a particular device address
@@ -206,6 +229,72 @@ protected:
        m_pEbc->write( eb_address, pData, format, size, modWbAddrOfs );
     }
 
+   /*!
+    * @brief Non blocking counterpart of read().
+    *
+    * Several cycles can be in flight at the same time, the completion
+    * has to be awaited by waitForAsync().
+    * @note The destination pData has to stay valid until the completion.
+    * @see EtherboneConnection::readAsync
+    */
+   ASYNC_TOKEN_T readAsync( const etherbone::address_t eb_address,
+                            eb_user_data_t pData,
+                            const etherbone::format_t format,
+                            const uint size = 1,
+                            const EBC::EtherboneConnection::ASYNC_CALLBACK_T& callback = nullptr,
+                            uint modWbAddrOfs = 0,
+                            const ASYNC_TOKEN_T token = EBC::EtherboneConnection::c_newAsyncBatch )
+   {
+      assert( m_pEbc->isConnected() );
+      return m_pEbc->readAsync( eb_address, pData, format, size, callback,
+                                modWbAddrOfs, token );
+   }
+
+   /*!
+    * @brief Non blocking counterpart of write().
+    * @see EtherboneConnection::writeAsync
+    */
+   ASYNC_TOKEN_T writeAsync( const etherbone::address_t eb_address,
+                             const eb_user_data_t pData,
+                             const etherbone::format_t format,
+                             const uint size = 1,
+                             const EBC::EtherboneConnection::ASYNC_CALLBACK_T& callback = nullptr,
+                             uint modWbAddrOfs = 0,
+                             const ASYNC_TOKEN_T token = EBC::EtherboneConnection::c_newAsyncBatch )
+   {
+      assert( m_pEbc->isConnected() );
+      return m_pEbc->writeAsync( eb_address, pData, format, size, callback,
+                                 modWbAddrOfs, token );
+   }
+
+   /*!
+    * @brief Returns a new token for grouping several asynchronous cycles.
+    * @see EtherboneConnection::openAsyncBatch
+    */
+   ASYNC_TOKEN_T openAsyncBatch( void )
+   {
+      return m_pEbc->openAsyncBatch();
+   }
+
+   /*!
+    * @brief Waits until all asynchronous cycles has been completed.
+    * @see EtherboneConnection::waitForAsync
+    */
+   void waitForAsync( void )
+   {
+      m_pEbc->waitForAsync();
+   }
+
+   /*!
+    * @brief Waits until all asynchronous cycles of the given batch
+    *        has been completed.
+    * @see EtherboneConnection::waitForAsync
+    */
+   void waitForAsync( const ASYNC_TOKEN_T token )
+   {
+      m_pEbc->waitForAsync( token );
+   }
+
 #ifdef CONFIG_IMPLEMENT_DDR3_WRITE
    /*!
     * @brief Copies a data array of 64 bit items on the DDR3-RAM
@@ -64,14 +64,18 @@ Lm32Access::~Lm32Access( void )
  */
 void Lm32Access::write( uint addr, const void* pData, uint len, uint format )
 {
+   WbLatencyTimer oTimer;
    EtherboneAccess::write( m_baseAddress + addr, eb_user_data_t(pData), format, len );
+   oTimer.stop( WbHistogram::LM32_WRITE, len * (format & EB_DATAX) );
 }
 
 /*!----------------------------------------------------------------------------
  */
 void Lm32Access::read( uint addr, void* pData, uint len, uint format )
 {
+   WbLatencyTimer oTimer;
    EtherboneAccess::read( m_baseAddress + addr, pData, format, len );
+   oTimer.stop( WbHistogram::LM32_READ, len * (format & EB_DATAX) );
 }
 
 //================================== EOF ======================================
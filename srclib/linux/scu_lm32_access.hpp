@@ -114,6 +114,37 @@ public:
       read( addr, pData, len, sizeof( TYPE ) | EB_BIG_ENDIAN );
    }
 
+   /*!
+    * @brief Queues the writing of data in the LM32-memory in the given
+    *        batch object.
+    * @see EtherboneAccess::execute
+    * @param rBatch Batch object.
+    * @param addr Relative target-memory address seen from LM32 perspective
+    * @param pData Pointer to data source.
+    * @param len Number of data units to write.
+    * @param format Or-link of data element size in bytes and byte-order.
+    */
+   void write( EB_BATCH_T& rBatch, uint addr, const void* pData, uint len, uint format )
+   {
+      rBatch.write( m_baseAddress + addr, eb_user_data_t(pData), format, len );
+   }
+
+   /*!
+    * @brief Queues the reading of data from the LM32-memory in the given
+    *        batch object.
+    * @see EtherboneAccess::execute
+    * @param rBatch Batch object.
+    * @param addr Relative source-memory address seen from LM32 perspective
+    * @param pData Pointer to the target memory, it has to stay valid
+    *              until the batch has been executed.
+    * @param len Number of data units to read.
+    * @param format Or-link of data element size in bytes and byte-order.
+    */
+   void read( EB_BATCH_T& rBatch, uint addr, void* pData, uint len, uint format )
+   {
+      rBatch.read( m_baseAddress + addr, pData, format, len );
+   }
+
    /*!
     * @brief Returns the etherbone/wishbone base address of LM32
     */
@@ -93,6 +93,42 @@ public:
     */
    virtual void write( const uint index64, const uint64_t* pData, const uint len ) = 0;
 
+   /*!
+    * @brief Queues the reading from DDR3 of SCU3 or from SRAM of SCU4
+    *        in the given batch object.
+    *
+    * If the concerning memory can not be read within a batch, then the
+    * already queued accesses becomes executed and the reading will made
+    * immediately, so the order of accesses remains unchanged.
+    * This is the default behavior of this base class.
+    * @see EtherboneAccess::execute
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words.
+    * @param pData Pointer to target memory, it has to stay valid
+    *              until the batch has been executed.
+    * @param len Length of data to read in 64-bit units.
+    */
+   virtual void read( EB_BATCH_T& rBatch, uint index64, uint64_t* pData, uint len )
+   {
+      execute( rBatch );
+      read( index64, pData, len );
+   }
+
+   /*!
+    * @brief Queues the writing in DDR3 of SCU3 or in SRAM of SCU4
+    *        in the given batch object.
+    * @see RamAccess::read( EB_BATCH_T&, uint, uint64_t*, uint )
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words.
+    * @param pData Pointer to source memory.
+    * @param len Length of data to write in 64-bit units.
+    */
+   virtual void write( EB_BATCH_T& rBatch, const uint index64, const uint64_t* pData, const uint len )
+   {
+      execute( rBatch );
+      write( index64, pData, len );
+   }
+
 };
 
 }
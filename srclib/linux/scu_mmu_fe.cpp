@@ -29,21 +29,48 @@
 #define _SCU_MMU_FE_CPP
 #include <scu_mmu_fe.hpp>
 
+#include <mutex>
 #include <lm32_hexdump.h>
 #include <message_macros.hpp>
 
 using namespace Scu::mmu;
 
+/*!
+ * @brief Target object of the C-functions invoked by scu_mmu.c.
+ * @see Mmu::Context
+ */
 static Mmu* mg_pMmu = nullptr;
 
+/*!
+ * @brief Serializes the accesses of several MMU objects.
+ * @see Mmu::Context
+ */
+static std::recursive_mutex mg_oMmuMutex;
+
+/*! ---------------------------------------------------------------------------
+ */
+Mmu::Context::Context( Mmu* pMmu )
+{
+   mg_oMmuMutex.lock();
+   m_pPrevious = mg_pMmu;
+   mg_pMmu = pMmu;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+Mmu::Context::~Context( void )
+{
+   mg_pMmu = m_pPrevious;
+   mg_oMmuMutex.unlock();
+}
+
 /*! ---------------------------------------------------------------------------
  */
 Mmu::Mmu( RamAccess* poRam )
    :m_poRam( poRam )
+   ,m_generation( MMU_NO_GENERATION )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
-   assert( mg_pMmu == nullptr );
-   mg_pMmu = this;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -51,8 +78,83 @@ Mmu::Mmu( RamAccess* poRam )
 Mmu::~Mmu( void )
 {
    DEBUG_MESSAGE_M_FUNCTION( "" );
+   assert( mg_pMmu != this );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool Mmu::updateDirectory( void )
+{
    assert( mg_pMmu == this );
-   mg_pMmu = nullptr;
+
+   uint32_t generation = mmuGetGeneration();
+   if( (generation != MMU_NO_GENERATION) && (generation == m_generation) )
+      return true;
+
+   m_directory.clear();
+   m_generation = MMU_NO_GENERATION;
+
+   const uint maxItems = getMaxCapacity64() / MMU_ITEMSIZE;
+   for( uint attempt = 0; attempt < MAX_DIRECTORY_ATTEMPTS; attempt++ )
+   {
+      if( generation == MMU_NO_GENERATION )
+         return false;
+
+      MMU_ITEM_T item;
+      item.iNext = 0;
+      mmuReadNextItem( &item );
+      uint count = 0;
+      while( (item.iNext != 0) && (count < maxItems) )
+      {
+         mmuReadNextItem( &item );
+         m_directory[item.tag] = item;
+         count++;
+      }
+
+      if( item.iNext != 0 )
+      { /*
+         * No end of list found, the list could be corrupt.
+         */
+         m_directory.clear();
+         return false;
+      }
+
+      /*
+       * The directory is consistent only when the LM32 hasn't modified
+       * the list during reading it.
+       */
+      const uint32_t lastGeneration = generation;
+      generation = mmuGetGeneration();
+      if( generation == lastGeneration )
+      {
+         m_generation = generation;
+         return true;
+      }
+      m_directory.clear();
+   }
+   return false;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+MMU_STATUS_T Mmu::allocate( const MMU_TAG_T tag, MMU_ADDR_T& rStartAddr,
+                            size_t& rLen, const bool create )
+{
+   assert( m_poRam->isConnected() );
+   Context oContext( this );
+
+   if( updateDirectory() )
+   {
+      const auto it = m_directory.find( tag );
+      if( it != m_directory.end() )
+      {
+         rStartAddr = it->second.iStart;
+         rLen       = it->second.length;
+         return create? ALREADY_PRESENT : OK;
+      }
+   }
+
+   return mmuAlloc( tag, &rStartAddr, &rLen, create );
 }
 
 extern "C"
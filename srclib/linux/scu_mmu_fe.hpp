@@ -31,6 +31,7 @@
 
 #include <scu_mmu.h>
 #include <scu_memory.hpp>
+#include <unordered_map>
 #include <assert.h>
 
 namespace Scu
@@ -42,10 +43,65 @@ namespace mmu
 /*!
  * @ingroup SCU_MMU
  * @brief C++ wrapper class for SCU Memory Management Unit 
+ *
+ * The found memory blocks becomes held in a directory indexed by its tags,
+ * which remains valid as long as the generation counter of the partition
+ * table doesn't change, so a repeated lookup costs a single etherbone
+ * access only instead of climbing through the list item by item.
+ * @see mmuGetGeneration
  */
 class Mmu
 {
-   RamAccess* m_poRam;
+   /*!
+    * @brief Maximum number of attempts to read a consistent partition
+    *        table, when the LM32 modifies it meanwhile.
+    */
+   static constexpr uint MAX_DIRECTORY_ATTEMPTS = 3;
+
+   using DIRECTORY_T = std::unordered_map<MMU_TAG_T, MMU_ITEM_T>;
+
+   RamAccess*  m_poRam;
+
+   /*!
+    * @brief Cached copy of the partition table.
+    */
+   DIRECTORY_T m_directory;
+
+   /*!
+    * @brief Generation counter belonging to m_directory,
+    *        MMU_NO_GENERATION when m_directory is invalid.
+    */
+   uint32_t    m_generation;
+
+   /*!
+    * @brief Actualizes the directory if the generation counter of the
+    *        partition table has been changed.
+    * @note Has to be invoked within a context of this object only.
+    * @retval true Directory is valid.
+    * @retval false No partition table present or it doesn't support the
+    *               generation counter, the directory can not be used.
+    */
+   bool updateDirectory( void );
+
+protected:
+   /*!
+    * @brief Makes the given object to the target of the C-functions
+    *        mmuRead(), mmuWrite() and mmuGetMaxCapacity64() as long as
+    *        the instance of this class exists.
+    *
+    * The C-implementation of the MMU in scu_mmu.c has no context
+    * parameter, therefore the accesses of several objects of type Mmu,
+    * e.g. of several SCUs in different threads, becomes serialized by
+    * a global recursive mutex.
+    */
+   class Context
+   {
+      Mmu* m_pPrevious;
+
+   public:
+      Context( Mmu* pMmu );
+      ~Context( void );
+   };
 
 public:
    /*!
@@ -65,6 +121,7 @@ public:
    bool isPresent( void )
    {
       assert( m_poRam->isConnected() );
+      Context oContext( this );
       return mmuIsPresent();
    }
 
@@ -74,7 +131,10 @@ public:
    void clear( void )
    {
       assert( m_poRam->isConnected() );
+      Context oContext( this );
       mmuDelete();
+      m_directory.clear();
+      m_generation = MMU_NO_GENERATION;
    }
 
    /*!
@@ -83,6 +143,9 @@ public:
    uint getNumberOfBlocks( void )
    {
       assert( m_poRam->isConnected() );
+      Context oContext( this );
+      if( updateDirectory() )
+         return m_directory.size();
       return mmuGetNumberOfBlocks();
    }
 
@@ -96,14 +159,13 @@ public:
    *            memory items. 
    * @param create If true then a new memory block will created,
    *               else a existing block will found only.
+   * @note An already existing memory block becomes found in the directory,
+   *       otherwise mmuAlloc() climbs through the list, so a block appended
+   *       by a LM32 firmware without generation counter becomes found too.
    * @return @see MMU_STATUS_T
    */
    MMU_STATUS_T allocate( const MMU_TAG_T tag, MMU_ADDR_T& rStartAddr,
-                          size_t& rLen, const bool create = false )
-   {
-      assert( m_poRam->isConnected() );
-      return mmuAlloc( tag, &rStartAddr, &rLen, create );
-   }
+                          size_t& rLen, const bool create = false );
 
   /*!
    * @brief Converts the status which returns the function mmuAlloc() in a
@@ -181,6 +243,7 @@ protected:
 
    void readNextItem( MMU_ITEM_T& rItem )
    {
+      Context oContext( this );
       mmuReadNextItem( &rItem );
    }
 }; // class Mmu
@@ -32,6 +32,7 @@
 #include <errno.h>
 #include <string.h>
 #include <string>
+#include <algorithm>
 #include <message_macros.hpp>
 
 namespace Scu
@@ -61,9 +62,11 @@ public:
    {
       /*
        * Replacing possible prefix "tcp/" or "dev/" because slashes '/' are not
-       * allowed in semaphore names.
+       * allowed in semaphore names. Further slashes, e.g. of a file name
+       * in the options of a simulator address, become replaced by '_'.
        */
       name = name.substr( name.find_first_of( '/' ) + 1 );
+      std::replace( name.begin(), name.end(), '/', '_' );
       DEBUG_MESSAGE_M_FUNCTION( name );
 
       m_pSem = ::sem_open( name.c_str(), oflag, perm, count );
@@ -0,0 +1,719 @@
+/*!
+ * @file scu_simulator.cpp
+ * @brief In-process simulation of the wishbone devices of a SCU which are
+ *        accessed by the Linux tools.
+ *
+ * @see scu_simulator.hpp
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <message_macros.hpp>
+#include <BusException.hpp>
+#include <scu_ddr3.h>
+#include <scu_sram.h>
+#include <scu_mmu_tag.h>
+#include <scu_lm32_access.hpp>
+#include <sdb_ids.h>
+#include <lm32/scu_mailbox.h>
+#ifdef CONFIG_SCU_USE_DDR3
+ #include <lm32_syslog_common.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "scu_simulator.hpp"
+
+using namespace Scu;
+using namespace FeSupport::Scu::Etherbone;
+
+namespace
+{
+/*!
+ * @brief Magic number of the start block of the MMU list.
+ * @see scu_mmu.c
+ */
+constexpr uint32_t MMU_MAGIC = 0xAAFF0055;
+
+/*!
+ * @brief Item of the MMU list which is the start block.
+ * @see START_BLOCK_T in scu_mmu.c
+ */
+constexpr uint MMU_LIST_START = 0;
+
+/*!
+ * @brief Byte offset of the build-ID in the LM32 memory.
+ */
+constexpr uint BUILD_ID_OFFSET = 0x100;
+
+/*!
+ * @brief Byte offset of the format string of the simulated log messages,
+ *        at the end of the LM32 memory.
+ */
+constexpr uint LOG_FORMAT_OFFSET = Lm32Access::MEM_SIZE - 0x100;
+
+const char* BUILD_ID_TEXT = "Simulated SCU: " EB_SIMULATOR_PREFIX "\n";
+const char* LOG_FORMAT_TEXT = "Simulated log message %u\n";
+
+} /* anonymous namespace */
+
+/*!----------------------------------------------------------------------------
+ * @brief Registers ScuSimulator as default simulator without replacing
+ *        a simulator of a higher software layer.
+ */
+static struct SIM_REGISTRAR
+{
+   SIM_REGISTRAR( void )
+   {
+      EtherboneConnection::setSimulatorFactory( ScuSimulator::create, false );
+   }
+} mg_simRegistrar;
+
+/*!----------------------------------------------------------------------------
+ */
+WishboneSimulator* ScuSimulator::create( const std::string& rNetAddress )
+{
+   ScuSimulator* pSimulator = new ScuSimulator( rNetAddress );
+   pSimulator->start();
+   return pSimulator;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+ScuSimulator::ScuSimulator( const std::string& rNetAddress )
+   :m_lm32Mem( Lm32Access::MEM_SIZE, 0 )
+   ,m_pRam( nullptr )
+   ,m_burstStart( 0 )
+   ,m_nextLogTime( 0 )
+   ,m_logCount( 0 )
+   ,m_pProducer( nullptr )
+   ,m_stop( false )
+   ,m_cycleCount( 0 )
+{
+   DEBUG_MESSAGE_M_FUNCTION( rNetAddress );
+
+   parseOptions( rNetAddress, m_options );
+   m_latencyUs = getOption( "latency", 0 );
+   m_tickUs    = std::max( getOption( "tick", DEFAULT_TICK_US ), 1U );
+   m_logRate   = getOption( "log", 0 );
+
+   const auto ram = m_options.find( "ram" );
+   m_isSram = (ram != m_options.end()) && (ram->second == "sram");
+   m_ramSize = m_isSram? _32MB_IN_BYTE : DDR3_MAX_SIZE;
+
+   /*
+    * The pages will mapped by the operating system on first access only.
+    */
+   m_pRam = static_cast<uint8_t*>(::calloc( m_ramSize, sizeof(uint8_t) ));
+   if( m_pRam == nullptr )
+      throw BusException( "Simulator: Can't allocate RAM!" );
+
+   lm32Write( BUILD_ID_OFFSET, BUILD_ID_TEXT, ::strlen( BUILD_ID_TEXT ) + 1 );
+   lm32Write( LOG_FORMAT_OFFSET, LOG_FORMAT_TEXT, ::strlen( LOG_FORMAT_TEXT ) + 1 );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+ScuSimulator::~ScuSimulator( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+   stop();
+   ::free( m_pRam );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::parseOptions( const std::string& rNetAddress, OPTION_MAP_T& rMap )
+{
+   std::string options = rNetAddress.substr( sizeof( EB_SIMULATOR_PREFIX ) - 1 );
+   std::size_t pos = 0;
+   while( pos < options.size() )
+   {
+      std::size_t end = options.find_first_of( ",&?", pos );
+      if( end == std::string::npos )
+         end = options.size();
+      const std::string option = options.substr( pos, end - pos );
+      pos = end + 1;
+      if( option.empty() )
+         continue;
+      const std::size_t eq = option.find( '=' );
+      if( eq == std::string::npos )
+         rMap[option] = "";
+      else
+         rMap[option.substr( 0, eq )] = option.substr( eq + 1 );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::hasOption( const std::string& rName ) const
+{
+   return m_options.find( rName ) != m_options.end();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+uint ScuSimulator::getOption( const std::string& rName, const uint def ) const
+{
+   const auto it = m_options.find( rName );
+   if( (it == m_options.end()) || it->second.empty() )
+      return def;
+
+   char* pEnd;
+   const unsigned long value = ::strtoul( it->second.c_str(), &pEnd, 0 );
+   if( *pEnd != '\0' )
+   {
+      std::string errorMessage = "Simulator: Invalid value of option \"";
+      errorMessage += rName;
+      errorMessage += "\": ";
+      errorMessage += it->second;
+      throw BusException( errorMessage );
+   }
+   return static_cast<uint>(value);
+}
+
+/*!----------------------------------------------------------------------------
+ */
+std::string ScuSimulator::getOptionText( const std::string& rName,
+                                         const std::string& rDef ) const
+{
+   const auto it = m_options.find( rName );
+   if( it == m_options.end() )
+      return rDef;
+   return it->second;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::start( void )
+{
+   if( m_pProducer != nullptr )
+      return;
+   m_stop = false;
+   m_pProducer = new std::thread( &ScuSimulator::producerThread, this );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::stop( void )
+{
+   if( m_pProducer == nullptr )
+      return;
+   m_stop = true;
+   m_pProducer->join();
+   delete m_pProducer;
+   m_pProducer = nullptr;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::producerThread( void )
+{
+   while( !m_stop )
+   {
+      {
+         std::lock_guard<std::mutex> lock( m_mutex );
+         onProduce( daq::getSysMicrosecs() );
+      }
+      std::this_thread::sleep_for( std::chrono::microseconds( m_tickUs ) );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::findDevice( const VendorId vendorId,
+                               const DeviceId deviceId,
+                               const uint32_t ind,
+                               uint64_t& rAddress )
+{
+   if( (vendorId != gsiId) || (ind != 0) )
+      return false;
+
+   switch( static_cast<uint32_t>(deviceId) )
+   {
+      case lm32_ram_user:
+      {
+         rAddress = LM32_RAM_BASE;
+         return true;
+      }
+      case MSI_MSG_BOX:
+      {
+         rAddress = MSI_BOX_BASE;
+         return true;
+      }
+      case wb_ddr3ram:
+      {
+         rAddress = RAM_BASE;
+         return !m_isSram;
+      }
+      case wb_ddr3ram2:
+      {
+         rAddress = DDR3_IF2_BASE;
+         return !m_isSram;
+      }
+      case wb_pseudo_sram:
+      {
+         rAddress = RAM_BASE;
+         return m_isSram;
+      }
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::beginCycle( void )
+{
+   m_mutex.lock();
+   m_cycleCount++;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::endCycle( void )
+{
+   for( const auto& signal: m_signals )
+      onSoftwareInterrupt( signal.first, signal.second );
+   m_signals.clear();
+   onCycleEnd();
+   m_mutex.unlock();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::read( const ADDRESS_T address, const FORMAT_T format,
+                         DATA_T& rData )
+{
+   const uint width = format & EB_DATAX;
+
+   /*
+    * The LM32 memory becomes mapped twice: From the host perspective
+    * and from the LM32 perspective with the offset Lm32Access::OFFSET.
+    */
+   if( (address >= LM32_RAM_BASE) &&
+       (((address - LM32_RAM_BASE) & ~static_cast<ADDRESS_T>(Lm32Access::OFFSET))
+                                             + width <= m_lm32Mem.size()) )
+   {
+      const uint offset = (address - LM32_RAM_BASE) & ~Lm32Access::OFFSET;
+      rData = 0;
+      for( uint i = 0; i < width; i++ )
+         rData = (rData << 8) | m_lm32Mem[offset + i];
+      return true;
+   }
+
+   if( (address >= MSI_BOX_BASE) && (address < MSI_BOX_BASE + sizeof( gsi::MSI_BOX_T )) )
+   {
+      rData = 0;
+      return true;
+   }
+
+   if( !m_isSram && (address >= DDR3_IF2_BASE) &&
+       (address < DDR3_IF2_BASE + (DDR3_FIFO_STATUS_OFFSET_ADDR + 1) * sizeof(uint32_t)) )
+   {
+      switch( (address - DDR3_IF2_BASE) / sizeof(uint32_t) )
+      {
+         case DDR3_FIFO_STATUS_OFFSET_ADDR:
+         {
+            rData = DDR3_FIFO_STATUS_MASK_INIT_DONE |
+                    (m_burstFifo.size() & DDR3_FIFO_STATUS_MASK_USED_WORDS);
+            if( m_burstFifo.empty() )
+               rData |= DDR3_FIFO_STATUS_MASK_EMPTY;
+            return true;
+         }
+         case DDR3_FIFO_LOW_WORD_OFFSET_ADDR:
+         {
+            rData = m_burstFifo.empty()? 0 : static_cast<uint32_t>(m_burstFifo.front());
+            return true;
+         }
+         case DDR3_FIFO_HIGH_WORD_OFFSET_ADDR:
+         { /*
+            * Reading the upper word removes the item from the FiFo.
+            */
+            if( m_burstFifo.empty() )
+            {
+               rData = 0;
+               return true;
+            }
+            rData = static_cast<uint32_t>(m_burstFifo.front() >> BIT_SIZEOF(uint32_t));
+            m_burstFifo.pop_front();
+            return true;
+         }
+      }
+      rData = 0;
+      return true;
+   }
+
+   return ramAccess( address, format, rData, false );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::write( const ADDRESS_T address, const FORMAT_T format,
+                          const DATA_T data )
+{
+   const uint width = format & EB_DATAX;
+
+   if( (address >= LM32_RAM_BASE) &&
+       (((address - LM32_RAM_BASE) & ~static_cast<ADDRESS_T>(Lm32Access::OFFSET))
+                                             + width <= m_lm32Mem.size()) )
+   {
+      const uint offset = (address - LM32_RAM_BASE) & ~Lm32Access::OFFSET;
+      for( uint i = 0; i < width; i++ )
+         m_lm32Mem[offset + i] = static_cast<uint8_t>( data >> ((width - 1 - i) * 8) );
+      return true;
+   }
+
+   if( (address >= MSI_BOX_BASE) && (address < MSI_BOX_BASE + sizeof( gsi::MSI_BOX_T )) )
+   {
+      const uint index = (address - MSI_BOX_BASE) / sizeof( gsi::MSI_SLOT_T );
+      if( (address - MSI_BOX_BASE) % sizeof( gsi::MSI_SLOT_T ) == offsetof( gsi::MSI_SLOT_T, signal ) )
+         m_signals.push_back( std::make_pair( index, static_cast<uint32_t>(data) ) );
+      return true;
+   }
+
+   if( !m_isSram && (address >= RAM_BASE + DDR3_BURST_START_ADDR_REG_OFFSET * sizeof(uint32_t)) &&
+       (address <= RAM_BASE + DDR3_BURST_XFER_CNT_REG_OFFSET * sizeof(uint32_t)) )
+   {
+      burstWrite( (address - RAM_BASE) / sizeof(uint32_t), static_cast<uint32_t>(data) );
+      return true;
+   }
+
+   DATA_T value = data;
+   return ramAccess( address, format, value, true );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::ramAccess( const ADDRESS_T address, const FORMAT_T format,
+                              DATA_T& rData, const bool isWrite )
+{
+   const uint width = format & EB_DATAX;
+   if( (address < RAM_BASE) || ((address - RAM_BASE + width) > m_ramSize) )
+      return false;
+
+   uint8_t* pCell = &m_pRam[address - RAM_BASE];
+   if( isWrite )
+   {
+      for( uint i = 0; i < width; i++ )
+         pCell[i] = static_cast<uint8_t>( rData >> (i * 8) );
+      return true;
+   }
+
+   rData = 0;
+   for( uint i = width; i > 0; i-- )
+      rData = (rData << 8) | pCell[i-1];
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::burstWrite( const uint reg, const uint32_t value )
+{
+   if( reg == DDR3_BURST_START_ADDR_REG_OFFSET )
+   {
+      m_burstStart = value;
+      return;
+   }
+
+   /*
+    * Writing the transfer count starts the burst: the FiFo becomes filled
+    * immediately.
+    */
+   const uint len = std::min( value, static_cast<uint32_t>(DDR3_XFER_FIFO_SIZE - 1) );
+   for( uint i = 0; (i < len) && ((m_burstStart + i) < getRamCapacity64()); i++ )
+   {
+      uint64_t item;
+      ::memcpy( &item, &m_pRam[(m_burstStart + i) * sizeof(uint64_t)], sizeof(item) );
+      m_burstFifo.push_back( item );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::lm32Write( const uint offset, const void* pData, const std::size_t size )
+{
+   assert( (offset + size) <= m_lm32Mem.size() );
+   ::memcpy( &m_lm32Mem[offset], pData, size );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::lm32PutRingAdmin( const uint offset,
+                                     const RAM_RING_SHARED_INDEXES_T& rAdmin )
+{
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.offset ), rAdmin.indexes.offset );
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.capacity ), rAdmin.indexes.capacity );
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ), rAdmin.indexes.start );
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.end ), rAdmin.indexes.end );
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ), rAdmin.wasRead );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::lm32PutRingIndexes( const uint offset,
+                                       const RAM_RING_SHARED_INDEXES_T& rAdmin )
+{
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ), rAdmin.indexes.start );
+   lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.end ), rAdmin.indexes.end );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::lm32GetRingAdmin( const uint offset,
+                                     RAM_RING_SHARED_INDEXES_T& rAdmin ) const
+{
+   using INDEX_T = RAM_RING_INDEX_T;
+   rAdmin.indexes.offset   = lm32Get<INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.offset ) );
+   rAdmin.indexes.capacity = lm32Get<INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.capacity ) );
+   rAdmin.indexes.start    = lm32Get<INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.start ) );
+   rAdmin.indexes.end      = lm32Get<INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, indexes.end ) );
+   rAdmin.wasRead          = lm32Get<INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::lm32SyncRingAdmin( const uint offset, RAM_RING_SHARED_INDEXES_T& rAdmin )
+{
+   rAdmin.wasRead = lm32Get<RAM_RING_INDEX_T>( offset + offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ) );
+   if( rAdmin.wasRead == 0 )
+      return false;
+
+   if( (rAdmin.wasRead & RAM_RING_HANDSHAKE_MASK) == 0 )
+   { /*
+      * Legacy protocol:
+      * The host can't acknowledge more than present.
+      */
+      rAdmin.wasRead = std::min( rAdmin.wasRead, ramRingSharedGetSize( &rAdmin ) );
+      ramRingSharedSynchonizeReadIndex( &rAdmin );
+      lm32PutRingAdmin( offset, rAdmin );
+      return true;
+   }
+
+   /*
+    * Direct protocol respectively its request.
+    */
+   const RAM_RING_INDEXES_T indexes = rAdmin.indexes;
+   if( ramRingSharedSynchonizeReadIndex( &rAdmin ) )
+      lm32Put( offset + offsetof( RAM_RING_SHARED_INDEXES_T, wasRead ), rAdmin.wasRead );
+
+   if( (rAdmin.indexes.start == indexes.start) && (rAdmin.indexes.end == indexes.end) )
+      return false;
+
+   lm32PutRingIndexes( offset, rAdmin );
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::ramWrite( const uint index64, const void* pData, const uint len )
+{
+   assert( (index64 + len) <= getRamCapacity64() );
+   ::memcpy( &m_pRam[index64 * sizeof(uint64_t)], pData, len * sizeof(uint64_t) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::ramRead( const uint index64, void* pData, const uint len ) const
+{
+   assert( (index64 + len) <= getRamCapacity64() );
+   ::memcpy( pData, &m_pRam[index64 * sizeof(uint64_t)], len * sizeof(uint64_t) );
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::ramRingWrite( RAM_RING_SHARED_INDEXES_T& rAdmin,
+                                 const void* pData, const uint len )
+{
+   assert( ramRingSharedGetRemainingCapacity( &rAdmin ) >= len );
+
+   const uint64_t* pSource = static_cast<const uint64_t*>(pData);
+   uint toWrite = len;
+   while( toWrite > 0 )
+   { /*
+      * Possibly the data becomes fragmented at the end of the ring buffer.
+      */
+      const uint index = ramRingGetWriteIndex( &rAdmin.indexes );
+      const uint partLen = std::min( toWrite,
+                                     rAdmin.indexes.capacity - rAdmin.indexes.end );
+      ramWrite( index, pSource, partLen );
+      ramRingSharedAddToWriteIndex( &rAdmin, partLen );
+      pSource += partLen;
+      toWrite -= partLen;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::mmuFind( const mmu::MMU_TAG_T tag, uint& rStart, uint& rLen ) const
+{
+   mmu::MMU_ITEM_T item;
+   static_assert( sizeof( item ) == mmu::MMU_ITEMSIZE * sizeof(uint64_t), "" );
+
+   ramRead( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   if( *reinterpret_cast<uint32_t*>(&item) != MMU_MAGIC )
+      return false;
+
+   while( item.iNext != 0 )
+   {
+      ramRead( item.iNext, &item, mmu::MMU_ITEMSIZE );
+      if( item.tag == tag )
+      {
+         rStart = item.iStart;
+         rLen   = item.length;
+         return true;
+      }
+   }
+   return false;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+bool ScuSimulator::mmuAllocate( const mmu::MMU_TAG_T tag, uint& rStart, const uint len )
+{
+   uint foundLen;
+   if( mmuFind( tag, rStart, foundLen ) )
+      return true;
+
+   mmu::MMU_ITEM_T item;
+   ramRead( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   if( *reinterpret_cast<uint32_t*>(&item) != MMU_MAGIC )
+   { /*
+      * List has not yet been created.
+      */
+      ::memset( &item, 0, sizeof( item ) );
+      *reinterpret_cast<uint32_t*>(&item) = MMU_MAGIC;
+      ramWrite( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   }
+
+   /*
+    * Climbing to the end of the already allocated area, like mmuAlloc().
+    * The padding of the start block appears as length of zero.
+    */
+   uint last  = MMU_LIST_START;
+   ramRead( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   uint level = mmu::MMU_ITEMSIZE + item.length;
+   while( item.iNext != 0 )
+   {
+      last = item.iNext;
+      ramRead( last, &item, mmu::MMU_ITEMSIZE );
+      level += mmu::MMU_ITEMSIZE + item.length;
+   }
+
+   if( (level + len + mmu::MMU_ITEMSIZE) >= getRamCapacity64() )
+      return false;
+
+   item.iNext = level;
+   ramWrite( last, &item, mmu::MMU_ITEMSIZE );
+
+   item.tag    = tag;
+   item.flags  = 0;
+   item.iNext  = 0;
+   item.iStart = level + mmu::MMU_ITEMSIZE;
+   item.length = len;
+   ramWrite( level, &item, mmu::MMU_ITEMSIZE );
+   rStart = item.iStart;
+
+   /*
+    * Incrementing the generation counter in the start block like mmuAlloc(),
+    * it overlays the member iStart.
+    */
+   ramRead( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   item.iStart++;
+   if( item.iStart == MMU_NO_GENERATION )
+      item.iStart++;
+   ramWrite( MMU_LIST_START, &item, mmu::MMU_ITEMSIZE );
+   return true;
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void ScuSimulator::onProduce( const USEC_T now )
+{
+   if( m_logRate == 0 )
+      return;
+
+   if( m_nextLogTime == 0 )
+      m_nextLogTime = now;
+
+   while( now >= m_nextLogTime )
+   {
+      produceLog( now );
+      m_nextLogTime += daq::MICROSECS_PER_SEC / m_logRate;
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ * @brief Writes a log message in the syslog FiFo like the function
+ *        syslog() of the LM32, when lm32-logd has allocated and initialized
+ *        the FiFo.
+ */
+void ScuSimulator::produceLog( const USEC_T now )
+{
+#ifdef CONFIG_SCU_USE_DDR3
+   uint start, len;
+   if( !mmuFind( mmu::TAG_LM32_LOG, start, len ) || (len <= SYSLOG_FIFO_ADMIN_SIZE) )
+      return;
+
+   SYSLOG_FIFO_ADMIN_T fifoAdmin;
+   ramRead( start, &fifoAdmin, SYSLOG_FIFO_ADMIN_SIZE );
+   if( (fifoAdmin.admin.indexes.offset != start + SYSLOG_FIFO_ADMIN_SIZE) ||
+       (fifoAdmin.admin.indexes.capacity < SYSLOG_FIFO_ITEM_SIZE) )
+   { /*
+      * FiFo not yet initialized by lm32-logd.
+      */
+      return;
+   }
+
+   /*
+    * Like on the LM32, the member wasRead becomes written back only when
+    * it has been modified.
+    */
+   uint adminLen = SYSLOG_FIFO_SERVER_ADMIN_SIZE;
+   if( fifoAdmin.capabilities != RAM_RING_DIRECT_CAPABILITY )
+   { /*
+      * Publishing the support of the direct handshake like lm32LogInit().
+      */
+      fifoAdmin.capabilities = RAM_RING_DIRECT_CAPABILITY;
+      adminLen = SYSLOG_FIFO_ADMIN_SIZE;
+   }
+   if( (fifoAdmin.admin.wasRead != 0) &&
+       ((fifoAdmin.admin.wasRead & RAM_RING_HANDSHAKE_MASK) == 0) )
+   {
+      fifoAdmin.admin.wasRead = std::min( fifoAdmin.admin.wasRead,
+                                          sysLogFifoGetSize( &fifoAdmin ) );
+      adminLen = SYSLOG_FIFO_ADMIN_SIZE;
+   }
+   if( sysLogFifoSynchonizeReadIndex( &fifoAdmin ) )
+      adminLen = SYSLOG_FIFO_ADMIN_SIZE;
+
+   if( sysLogFifoGetRemainingItemCapacity( &fifoAdmin ) > 0 )
+   {
+      SYSLOG_FIFO_ITEM_T item;
+      ::memset( &item, 0, sizeof( item ) );
+      item.timestamp = now * 1000;
+      item.filter    = LM32_LOG_INFO;
+      item.format    = Lm32Access::OFFSET + LOG_FORMAT_OFFSET;
+      item.param[0]  = m_logCount++;
+      ramRingWrite( fifoAdmin.admin, &item, SYSLOG_FIFO_ITEM_SIZE );
+   }
+   ramWrite( start, &fifoAdmin, adminLen );
+#endif
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,361 @@
+/*!
+ * @file scu_simulator.hpp
+ * @brief In-process simulation of the wishbone devices of a SCU which are
+ *        accessed by the Linux tools: LM32 memory, DDR3-RAM respectively
+ *        SRAM, MMU and the mailbox of software interrupts.
+ *
+ * The simulator becomes selected by a net address beginning with
+ * EB_SIMULATOR_PREFIX, e.g.: "sim://latency=300,ram=sram,log=10" \n
+ * Options are separated by ',', '&' or '?':
+ * - latency=<us> Injected round trip time of each etherbone cycle.
+ * - ram=sram     Simulates the pseudo SRAM instead of the DDR3-RAM.
+ * - log=<Hz>     Rate of the generated LM32 log messages.
+ * - tick=<us>    Period of the producer thread, default 1000.
+ *
+ * @date 16.10.2026
+ * @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ * @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _SCU_SIMULATOR_HPP
+#define _SCU_SIMULATOR_HPP
+
+#include <EtherboneConnection.hpp>
+#include <scu_mmu.h>
+#include <circular_index.h>
+#include <daq_calculations.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <assert.h>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Simulated wishbone bus of a SCU.
+ *
+ * The LM32 firmware is modeled on the level of the shared memory protocol
+ * only: Derived classes initialize the shared memory in the constructor,
+ * handle the commands of the host in onCycleEnd() and onSoftwareInterrupt()
+ * and produce data in onProduce().
+ *
+ * All accesses of the bus and of the producer thread are serialized by
+ * a mutex, which will hold for the whole etherbone cycle, so a cycle
+ * becomes handled atomically like on the real hardware.
+ *
+ * @note The LM32 memory becomes stored in big endian like on the LM32,
+ *       the DDR3-RAM respectively SRAM in the byte order of the host.
+ */
+class ScuSimulator: public FeSupport::Scu::Etherbone::WishboneSimulator
+{
+public:
+   using VendorId  = FeSupport::Scu::Etherbone::VendorId;
+   using DeviceId  = FeSupport::Scu::Etherbone::DeviceId;
+   using ADDRESS_T = etherbone::address_t;
+   using FORMAT_T  = etherbone::format_t;
+   using DATA_T    = etherbone::data_t;
+   using USEC_T    = daq::USEC_T;
+
+   /*!
+    * @brief Simulated wishbone base addresses.
+    */
+   constexpr static ADDRESS_T MSI_BOX_BASE  = 0x00080000;
+   constexpr static ADDRESS_T LM32_RAM_BASE = 0x00100000;
+   constexpr static ADDRESS_T RAM_BASE      = 0x20000000;
+   constexpr static ADDRESS_T DDR3_IF2_BASE = 0x30000000;
+
+   /*!
+    * @brief Default period of the producer thread in microseconds.
+    */
+   constexpr static uint DEFAULT_TICK_US = 1000;
+
+protected:
+   using OPTION_MAP_T = std::map<std::string, std::string>;
+
+private:
+   OPTION_MAP_T          m_options;
+   uint                  m_latencyUs;
+   uint                  m_tickUs;
+   bool                  m_isSram;
+
+   /*!
+    * @brief Image of the LM32 memory in big endian.
+    */
+   std::vector<uint8_t>  m_lm32Mem;
+
+   /*!
+    * @brief Image of the DDR3-RAM respectively SRAM.
+    */
+   uint8_t*              m_pRam;
+   std::size_t           m_ramSize;
+
+   /*!
+    * @brief DDR3 burst registers and the transfer FiFo of interface 2.
+    */
+   uint32_t              m_burstStart;
+   std::deque<uint64_t>  m_burstFifo;
+
+   /*!
+    * @brief Mailbox signals received within the current cycle:
+    *        first: slot, second: signal value.
+    */
+   std::vector<std::pair<uint, uint32_t>> m_signals;
+
+   uint                  m_logRate;
+   USEC_T                m_nextLogTime;
+   uint                  m_logCount;
+
+   std::mutex            m_mutex;
+   std::thread*          m_pProducer;
+   std::atomic<bool>     m_stop;
+   std::atomic<uint64_t> m_cycleCount;
+
+public:
+   /*!
+    * @brief Constructor
+    * @param rNetAddress Complete net address including EB_SIMULATOR_PREFIX.
+    */
+   ScuSimulator( const std::string& rNetAddress );
+
+   /*!
+    * @brief Destructor, stops the producer thread.
+    * @note A derived class has to invoke stop() in its destructor
+    *       before its members becomes destroyed.
+    */
+   virtual ~ScuSimulator( void );
+
+   /*!
+    * @brief Starts the producer thread.
+    * @note It has to be invoked by the factory function after the object
+    *       has been completely constructed.
+    */
+   void start( void );
+
+   /*!
+    * @brief Stops the producer thread.
+    */
+   void stop( void );
+
+   bool findDevice( const VendorId vendorId,
+                    const DeviceId deviceId,
+                    const uint32_t ind,
+                    uint64_t& rAddress ) override;
+
+   void beginCycle( void ) override;
+
+   void endCycle( void ) override;
+
+   bool read( const ADDRESS_T address, const FORMAT_T format,
+              DATA_T& rData ) override;
+
+   bool write( const ADDRESS_T address, const FORMAT_T format,
+               const DATA_T data ) override;
+
+   uint getLatencyUs( void ) const override
+   {
+      return m_latencyUs;
+   }
+
+   uint64_t getCycleCount( void ) const override
+   {
+      return m_cycleCount;
+   }
+
+   bool isSram( void ) const
+   {
+      return m_isSram;
+   }
+
+   /*!
+    * @brief Returns the maximum capacity of the simulated RAM in
+    *        64-bit items.
+    */
+   uint getRamCapacity64( void ) const
+   {
+      return static_cast<uint>(m_ramSize / sizeof(uint64_t));
+   }
+
+   /*!
+    * @brief Factory function which becomes registered in
+    *        EtherboneConnection by default.
+    */
+   static FeSupport::Scu::Etherbone::WishboneSimulator*
+                                   create( const std::string& rNetAddress );
+
+protected:
+   /*!
+    * @brief Returns true if the option of the given name has been
+    *        given in the net address.
+    */
+   bool hasOption( const std::string& rName ) const;
+
+   /*!
+    * @brief Returns the numeric value of the given option or the default
+    *        value if the option was not given.
+    * @throws FeSupport::Scu::Etherbone::BusException if not numeric.
+    */
+   uint getOption( const std::string& rName, const uint def ) const;
+
+   /*!
+    * @brief Returns the textual value of the given option or the default
+    *        value if the option was not given.
+    */
+   std::string getOptionText( const std::string& rName,
+                              const std::string& rDef = "" ) const;
+
+   /*!
+    * @brief Becomes invoked at the end of each etherbone cycle while
+    *        the mutex is locked. Here the LM32 model can react on
+    *        the modifications of the shared memory made by the host.
+    */
+   virtual void onCycleEnd( void ) {}
+
+   /*!
+    * @brief Becomes invoked at the end of the cycle in which the host
+    *        has written a signal in the mailbox of the given slot.
+    */
+   virtual void onSoftwareInterrupt( const uint slot, const uint32_t signal ) {}
+
+   /*!
+    * @brief Becomes invoked periodically by the producer thread while
+    *        the mutex is locked.
+    * @param now Current system time in microseconds.
+    */
+   virtual void onProduce( const USEC_T now );
+
+   /*!
+    * @brief Copies raw bytes in the LM32 memory.
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   void lm32Write( const uint offset, const void* pData, const std::size_t size );
+
+   /*!
+    * @brief Writes a value in big endian in the LM32 memory.
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   template<typename TYPE>
+   void lm32Put( const uint offset, const TYPE value )
+   {
+      assert( (offset + sizeof(TYPE)) <= m_lm32Mem.size() );
+      for( uint i = 0; i < sizeof(TYPE); i++ )
+         m_lm32Mem[offset + i] = static_cast<uint8_t>(
+                     static_cast<uint64_t>(value) >> ((sizeof(TYPE) - 1 - i) * 8) );
+   }
+
+   /*!
+    * @brief Reads a value in big endian from the LM32 memory.
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   template<typename TYPE>
+   TYPE lm32Get( const uint offset ) const
+   {
+      assert( (offset + sizeof(TYPE)) <= m_lm32Mem.size() );
+      uint64_t value = 0;
+      for( uint i = 0; i < sizeof(TYPE); i++ )
+         value = (value << 8) | m_lm32Mem[offset + i];
+      return static_cast<TYPE>(value);
+   }
+
+   /*!
+    * @brief Writes a ring buffer administration in the LM32 memory.
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   void lm32PutRingAdmin( const uint offset, const RAM_RING_SHARED_INDEXES_T& rAdmin );
+
+   /*!
+    * @brief Writes the read and write index of a ring buffer administration
+    *        in the LM32 memory only.
+    *
+    * The member wasRead stays untouched, because it is owned by the host
+    * in the direct protocol.
+    * @see RAM_RING_PROTOCOL_FLAG
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   void lm32PutRingIndexes( const uint offset, const RAM_RING_SHARED_INDEXES_T& rAdmin );
+
+   /*!
+    * @brief Reads a ring buffer administration from the LM32 memory.
+    * @param offset Byte offset seen from the LM32 perspective.
+    */
+   void lm32GetRingAdmin( const uint offset, RAM_RING_SHARED_INDEXES_T& rAdmin ) const;
+
+   /*!
+    * @brief Takes over the number of items acknowledged by the host
+    *        in the ring buffer administration located in the LM32 memory,
+    *        like ramRingSharedSynchonizeReadIndex() on the LM32.
+    *
+    * The legacy protocol as well as the direct protocol will be handled.
+    * @retval true The read index has been moved.
+    */
+   bool lm32SyncRingAdmin( const uint offset, RAM_RING_SHARED_INDEXES_T& rAdmin );
+
+   /*!
+    * @brief Writes 64-bit payload items in the simulated RAM.
+    */
+   void ramWrite( const uint index64, const void* pData, const uint len );
+
+   /*!
+    * @brief Reads 64-bit payload items from the simulated RAM.
+    */
+   void ramRead( const uint index64, void* pData, const uint len ) const;
+
+   /*!
+    * @brief Writes payload items in a ring buffer of the simulated RAM
+    *        and moves its write index.
+    * @note The caller has to ensure that enough space is present.
+    */
+   void ramRingWrite( RAM_RING_SHARED_INDEXES_T& rAdmin,
+                      const void* pData, const uint len );
+
+   /*!
+    * @brief Searches the memory block of the given tag in the list of
+    *        the memory management unit.
+    * @retval true Block found.
+    */
+   bool mmuFind( const mmu::MMU_TAG_T tag, uint& rStart, uint& rLen ) const;
+
+   /*!
+    * @brief Allocates a memory block in the list of the memory management
+    *        unit like mmuAlloc() on the LM32.
+    * @retval true Block allocated or already present.
+    */
+   bool mmuAllocate( const mmu::MMU_TAG_T tag, uint& rStart, const uint len );
+
+private:
+   static void parseOptions( const std::string& rNetAddress, OPTION_MAP_T& rMap );
+
+   bool ramAccess( const ADDRESS_T address, const FORMAT_T format,
+                   DATA_T& rData, const bool isWrite );
+
+   void burstWrite( const uint reg, const uint32_t value );
+
+   void produceLog( const USEC_T now );
+
+   void producerThread( void );
+};
+
+} /* namespace Scu */
+
+#endif /* ifndef _SCU_SIMULATOR_HPP */
+//================================== EOF ======================================
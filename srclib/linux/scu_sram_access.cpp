@@ -78,6 +78,8 @@ void SramAccess::read( uint index64, uint64_t* pData, uint len )
 {
    assert( (index64 + len) <= SRAM_MAX_INDEX64 );
 
+   WbLatencyTimer oTimer;
+   const std::size_t bytes = len * sizeof(uint64_t);
    uint partLen = 0;
    while( len > 0 )
    {
@@ -91,6 +93,7 @@ void SramAccess::read( uint index64, uint64_t* pData, uint len )
                              partLen * sizeof(uint64_t)/sizeof(uint32_t)
                            );
    }
+   oTimer.stop( WbHistogram::SRAM_READ, bytes );
 }
 
 /*!----------------------------------------------------------------------------
@@ -116,4 +119,54 @@ void SramAccess::write( const uint index64, const uint64_t* pData, const uint le
    }
 }
 
+constexpr uint MAX_CYCLE_OPS = MAX_CYCLE_LEN * sizeof(uint64_t)/sizeof(uint32_t);
+
+/*!----------------------------------------------------------------------------
+ */
+void SramAccess::read( EB_BATCH_T& rBatch, uint index64, uint64_t* pData, uint len )
+{
+   assert( (index64 + len) <= SRAM_MAX_INDEX64 );
+
+   uint partLen = 0;
+   while( len > 0 )
+   {
+      pData   += partLen;
+      index64 += partLen;
+      partLen =  std::min( len, MAX_CYCLE_LEN );
+      len     -= partLen;
+      if( (rBatch.getNumberOfOperations() + partLen * sizeof(uint64_t)/sizeof(uint32_t)) > MAX_CYCLE_OPS )
+         execute( rBatch );
+      rBatch.read( m_baseAddress + index64 * sizeof(uint64_t),
+                   pData,
+                   sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                   partLen * sizeof(uint64_t)/sizeof(uint32_t)
+                 );
+   }
+}
+
+/*!----------------------------------------------------------------------------
+ */
+void SramAccess::write( EB_BATCH_T& rBatch, const uint index64, const uint64_t* pData, const uint len )
+{
+   assert( (index64 + len) <= SRAM_MAX_INDEX64 );
+
+   uint partLen = 0;
+   uint workLen = len;
+   uint index = index64;
+   while( workLen > 0 )
+   {
+      pData   += partLen;
+      index   += partLen;
+      partLen =  std::min( workLen, MAX_CYCLE_LEN );
+      workLen -= partLen;
+      if( (rBatch.getNumberOfOperations() + partLen * sizeof(uint64_t)/sizeof(uint32_t)) > MAX_CYCLE_OPS )
+         execute( rBatch );
+      rBatch.write( m_baseAddress + index * sizeof(uint64_t),
+                    eb_user_data_t(pData),
+                    sizeof(uint32_t) | EB_LITTLE_ENDIAN,
+                    partLen * sizeof(uint64_t)/sizeof(uint32_t)
+                  );
+   }
+}
+
 //================================== EOF ======================================
@@ -94,6 +94,24 @@ public:
     */
    void write( const uint index64, const uint64_t* pData, const uint len ) override;
 
+   /*!
+    * @brief Queues the reading of the SRAM memory in the given batch object.
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words.
+    * @param pData Target address in 64 bit units
+    * @param len Length of the data array to read in 64-bit units.
+    */
+   void read( EB_BATCH_T& rBatch, uint index64, uint64_t* pData, uint len ) override;
+
+   /*!
+    * @brief Queues the writing of the SRAM memory in the given batch object.
+    * @param rBatch Batch object.
+    * @param index64 Start-index (offset) in 64-bit words..
+    * @param pData Source address in 64 bit units.
+    * @param len Length of the data array to write in 64-bit units.
+    */
+   void write( EB_BATCH_T& rBatch, const uint index64, const uint64_t* pData, const uint len ) override;
+
 private:
    /*!
     * @brief Makes the common initialization for both constructors.
@@ -0,0 +1,515 @@
+/*!
+ * @file scu_wb_histogram.hpp
+ * @brief Process wide log-linear latency histograms of the wishbone
+ *        accesses via etherbone.
+ *
+ * Each access class (WbHistogram::WB_ACCESS_T) has its own histograms per
+ * transfer size class. The recording is lock-free and switched on by
+ * default, it costs two reads of the steady clock and two relaxed
+ * atomic additions per access. Taking a snapshot doesn't reset the histograms.
+ *
+ * @note  Header only.
+ *
+ * @copyright GSI Helmholtz Centre for Heavy Ion Research GmbH
+ * @author    Ulrich Becker <u.becker@gsi.de>
+ * @date      16.10.2026
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _SCU_WB_HISTOGRAM_HPP
+#define _SCU_WB_HISTOGRAM_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <cstdlib>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Latency histograms of all wishbone accesses of this process.
+ *
+ * The latency in nanoseconds becomes sorted in log-linear buckets:
+ * each power of two is divided in SUB_BUCKETS equal sized buckets,
+ * so the relative resolution is 1/SUB_BUCKETS.
+ */
+class WbHistogram
+{
+public:
+   /*!
+    * @brief Access classes.
+    */
+   enum WB_ACCESS_T
+   {
+      LM32_READ        = 0,
+      LM32_WRITE       = 1,
+      DDR3_READ        = 2, /*!<@brief DDR3 transparent mode via interface 1 */
+      DDR3_BURST_READ  = 3, /*!<@brief DDR3 burst mode via interface 2 */
+      DDR3_SPLIT_READ  = 4, /*!<@brief DDR3 via both interfaces concurrently */
+      SRAM_READ        = 5,
+      BATCH            = 6, /*!<@brief Execution of a etherbone batch */
+      WB_ACCESS_COUNT  = 7
+   };
+
+   /*!
+    * @brief Number of buckets per power of two is 2^SUB_BUCKET_BITS.
+    */
+   constexpr static uint SUB_BUCKET_BITS = 3;
+   constexpr static uint SUB_BUCKETS     = 1 << SUB_BUCKET_BITS;
+
+   /*!
+    * @brief Latencies of 2^(MAX_EXPONENT+1) nanoseconds and more
+    *        (about 37 minutes) are sorted in the last bucket.
+    */
+   constexpr static uint MAX_EXPONENT    = 40;
+
+   constexpr static uint LATENCY_BUCKETS =
+                         (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+   /*!
+    * @brief The size class of a access is the binary logarithm of
+    *        the number of transferred bytes, accesses of
+    *        2^(SIZE_CLASSES-1) bytes and more are in the last size class.
+    */
+   constexpr static uint SIZE_CLASSES    = 16;
+
+   /*!
+    * @brief Histogram of a single access- and size class.
+    */
+   struct HISTOGRAM_T
+   {
+      uint64_t m_aBucket[LATENCY_BUCKETS];
+      uint64_t m_count;
+      uint64_t m_sumNs;
+      uint64_t m_maxNs;
+   };
+
+   /*!
+    * @brief Non atomic copy of all histograms.
+    */
+   class Snapshot
+   {
+      friend class WbHistogram;
+      std::vector<HISTOGRAM_T> m_vHistogram;
+
+      Snapshot( void )
+         :m_vHistogram( WB_ACCESS_COUNT * SIZE_CLASSES )
+      {
+      }
+
+   public:
+      /*!
+       * @brief Returns the histogram of the given access- and size class.
+       */
+      const HISTOGRAM_T& get( const WB_ACCESS_T access,
+                              const uint sizeClass ) const
+      {
+         return m_vHistogram[access * SIZE_CLASSES + sizeClass];
+      }
+
+      /*!
+       * @brief Returns the upper bound in nanoseconds of the bucket which
+       *        contains the given quantile, e.g. 0.99 for p99.
+       */
+      uint64_t getQuantile( const WB_ACCESS_T access, const uint sizeClass,
+                            const double quantile ) const
+      {
+         const HISTOGRAM_T& rHist = get( access, sizeClass );
+         if( rHist.m_count == 0 )
+            return 0;
+
+         const uint64_t rank = static_cast<uint64_t>( quantile *
+                                      static_cast<double>(rHist.m_count - 1) ) + 1;
+         uint64_t n = 0;
+         for( uint i = 0; i < LATENCY_BUCKETS; i++ )
+         {
+            n += rHist.m_aBucket[i];
+            if( n >= rank )
+               return std::min( getBucketUpperBound( i ), rHist.m_maxNs );
+         }
+         return rHist.m_maxNs;
+      }
+
+      /*!
+       * @brief Prints all non empty histograms as human readable table
+       *        in microseconds.
+       */
+      void print( std::ostream& rOut ) const;
+
+      /*!
+       * @brief Writes all non empty histograms in JSON-lines format,
+       *        one line per access- and size class.
+       *
+       * Each line contains the non empty buckets as pairs of the lower
+       * bound in nanoseconds and the count, so that files of different
+       * runs can be compared offline.
+       */
+      void dump( std::ostream& rOut ) const;
+   };
+
+private:
+   /*!
+    * @brief Lock-free counterpart of HISTOGRAM_T, the number of
+    *        accesses is the sum of the buckets.
+    */
+   struct ATOMIC_HISTOGRAM_T
+   {
+      std::atomic<uint64_t> m_aBucket[LATENCY_BUCKETS];
+      std::atomic<uint64_t> m_sumNs;
+      std::atomic<uint64_t> m_maxNs;
+   };
+
+   std::atomic<bool>  m_enabled;
+   ATOMIC_HISTOGRAM_T m_aHistogram[WB_ACCESS_COUNT][SIZE_CLASSES];
+
+   WbHistogram( void )
+      :m_enabled( true )
+   {
+      reset();
+   }
+
+public:
+   WbHistogram( const WbHistogram& ) = delete;
+   WbHistogram& operator=( const WbHistogram& ) = delete;
+
+   /*!
+    * @brief Returns the process wide object.
+    */
+   static WbHistogram& get( void )
+   {
+      static WbHistogram s_oInstance;
+      return s_oInstance;
+   }
+
+   /*!
+    * @brief Switches the recording on or off.
+    */
+   void setEnabled( const bool enable )
+   {
+      m_enabled.store( enable, std::memory_order_relaxed );
+   }
+
+   /*!
+    * @brief Returns true when the recording is switched on.
+    */
+   bool isEnabled( void ) const
+   {
+      return m_enabled.load( std::memory_order_relaxed );
+   }
+
+   /*!
+    * @brief Clears all histograms.
+    */
+   void reset( void )
+   {
+      for( auto& rAccess: m_aHistogram )
+         for( auto& rHist: rAccess )
+         {
+            for( auto& rBucket: rHist.m_aBucket )
+               rBucket.store( 0, std::memory_order_relaxed );
+            rHist.m_sumNs.store( 0, std::memory_order_relaxed );
+            rHist.m_maxNs.store( 0, std::memory_order_relaxed );
+         }
+   }
+
+   /*!
+    * @brief Records a single access.
+    * @param access Access class.
+    * @param bytes Number of transferred bytes.
+    * @param ns Latency in nanoseconds.
+    */
+   void record( const WB_ACCESS_T access, const std::size_t bytes,
+                const uint64_t ns )
+   {
+      ATOMIC_HISTOGRAM_T& rHist = m_aHistogram[access][getSizeClass( bytes )];
+      rHist.m_aBucket[getBucket( ns )].fetch_add( 1, std::memory_order_relaxed );
+      rHist.m_sumNs.fetch_add( ns, std::memory_order_relaxed );
+      uint64_t maxNs = rHist.m_maxNs.load( std::memory_order_relaxed );
+      while( (ns > maxNs) &&
+             !rHist.m_maxNs.compare_exchange_weak( maxNs, ns, std::memory_order_relaxed ) )
+      {}
+   }
+
+   /*!
+    * @brief Returns a copy of all histograms, the histograms stay unchanged.
+    */
+   Snapshot snapshot( void ) const
+   {
+      Snapshot oSnapshot;
+      for( uint a = 0; a < WB_ACCESS_COUNT; a++ )
+         for( uint s = 0; s < SIZE_CLASSES; s++ )
+         {
+            const ATOMIC_HISTOGRAM_T& rSrc = m_aHistogram[a][s];
+            HISTOGRAM_T& rDst = oSnapshot.m_vHistogram[a * SIZE_CLASSES + s];
+            rDst.m_count = 0;
+            for( uint i = 0; i < LATENCY_BUCKETS; i++ )
+            {
+               rDst.m_aBucket[i] = rSrc.m_aBucket[i].load( std::memory_order_relaxed );
+               rDst.m_count += rDst.m_aBucket[i];
+            }
+            rDst.m_sumNs = rSrc.m_sumNs.load( std::memory_order_relaxed );
+            rDst.m_maxNs = rSrc.m_maxNs.load( std::memory_order_relaxed );
+         }
+      return oSnapshot;
+   }
+
+   /*!
+    * @brief Writes a snapshot in JSON-lines format in the given file.
+    * @param rFileName Name of the file, the file will overwritten.
+    */
+   void dumpToFile( const std::string& rFileName ) const
+   {
+      std::ofstream file( rFileName );
+      if( !file.is_open() )
+         throw std::runtime_error( "Unable to open histogram file: \"" + rFileName + '"' );
+      snapshot().dump( file );
+   }
+
+   /*!
+    * @brief Prints respectively writes the histograms at the end of
+    *        the process.
+    * @param rFileName Name of the file in which the histograms becomes
+    *                  written in JSON-lines format. If empty, the
+    *                  histograms becomes printed on stdout.
+    */
+   static void showAtExit( const std::string& rFileName = "" );
+
+   /*!
+    * @brief Returns the text of the given access class.
+    */
+   static const char* accessToString( const WB_ACCESS_T access )
+   {
+      static const char* names[WB_ACCESS_COUNT] =
+      {
+         "LM32_READ",
+         "LM32_WRITE",
+         "DDR3_READ",
+         "DDR3_BURST_READ",
+         "DDR3_SPLIT_READ",
+         "SRAM_READ",
+         "BATCH"
+      };
+      return (access < WB_ACCESS_COUNT)? names[access] : "UNKNOWN";
+   }
+
+   /*!
+    * @brief Returns the size class of the given number of bytes.
+    */
+   static uint getSizeClass( const std::size_t bytes )
+   {
+      if( bytes == 0 )
+         return 0;
+      const uint log2 = BIT_SIZEOF_ULL - 1 - __builtin_clzll( bytes );
+      return std::min( log2, SIZE_CLASSES - 1 );
+   }
+
+   /*!
+    * @brief Returns the bucket index of the given latency.
+    */
+   static uint getBucket( const uint64_t ns )
+   {
+      if( ns < SUB_BUCKETS )
+         return static_cast<uint>(ns);
+      const uint exponent = BIT_SIZEOF_ULL - 1 - __builtin_clzll( ns );
+      if( exponent > MAX_EXPONENT )
+         return LATENCY_BUCKETS - 1;
+      return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+             + static_cast<uint>(ns >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+   }
+
+   /*!
+    * @brief Returns the smallest latency in nanoseconds of the given bucket.
+    */
+   static uint64_t getBucketLowerBound( const uint bucket )
+   {
+      if( bucket < SUB_BUCKETS )
+         return bucket;
+      const uint exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+      return static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS)
+                                             << (exponent - SUB_BUCKET_BITS);
+   }
+
+   /*!
+    * @brief Returns the greatest latency in nanoseconds of the given bucket.
+    */
+   static uint64_t getBucketUpperBound( const uint bucket )
+   {
+      if( bucket >= (LATENCY_BUCKETS - 1) )
+         return ~static_cast<uint64_t>(0);
+      return getBucketLowerBound( bucket + 1 ) - 1;
+   }
+
+private:
+   constexpr static uint BIT_SIZEOF_ULL = sizeof(unsigned long long) * 8;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/*!----------------------------------------------------------------------------
+ * @brief Measures the latency of a single wishbone access.
+ *
+ * The access becomes recorded by stop() only, so failed accesses which
+ * leave the scope by a exception are not recorded.
+ */
+class WbLatencyTimer
+{
+   using CLOCK_T = std::chrono::steady_clock;
+
+   CLOCK_T::time_point m_start;
+   const bool          m_enabled;
+
+public:
+   WbLatencyTimer( void )
+      :m_enabled( WbHistogram::get().isEnabled() )
+   {
+      if( m_enabled )
+         m_start = CLOCK_T::now();
+   }
+
+   /*!
+    * @brief Records the time since construction.
+    * @param access Access class.
+    * @param bytes Number of transferred bytes.
+    */
+   void stop( const WbHistogram::WB_ACCESS_T access, const std::size_t bytes )
+   {
+      if( !m_enabled )
+         return;
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>
+                                                ( CLOCK_T::now() - m_start ).count();
+      WbHistogram::get().record( access, bytes, static_cast<uint64_t>(ns) );
+   }
+};
+
+/*!----------------------------------------------------------------------------
+ */
+inline void WbHistogram::Snapshot::print( std::ostream& rOut ) const
+{
+   rOut << "Access           size [bytes]       count   mean[us]    p50[us]"
+           "    p99[us]  p99.9[us]    max[us]\n";
+   const auto toUs = []( const uint64_t ns ) -> double
+   {
+      return static_cast<double>(ns) / 1000.0;
+   };
+   const std::ios::fmtflags flags = rOut.flags();
+   rOut << std::fixed << std::setprecision( 1 );
+   for( uint a = 0; a < WB_ACCESS_COUNT; a++ )
+   {
+      const WB_ACCESS_T access = static_cast<WB_ACCESS_T>(a);
+      for( uint s = 0; s < SIZE_CLASSES; s++ )
+      {
+         const HISTOGRAM_T& rHist = get( access, s );
+         if( rHist.m_count == 0 )
+            continue;
+         const std::string size = (s == (SIZE_CLASSES - 1))?
+                                  (std::to_string( 1ULL << s ) + "..") :
+                                  (std::to_string( 1ULL << s ) + ".." +
+                                   std::to_string( (2ULL << s) - 1 ));
+         rOut << std::left  << std::setw( 16 ) << accessToString( access ) << ' '
+              << std::setw( 13 ) << size
+              << std::right << std::setw( 12 ) << rHist.m_count
+              << std::setw( 11 ) << toUs( rHist.m_sumNs / rHist.m_count )
+              << std::setw( 11 ) << toUs( getQuantile( access, s, 0.5 ) )
+              << std::setw( 11 ) << toUs( getQuantile( access, s, 0.99 ) )
+              << std::setw( 11 ) << toUs( getQuantile( access, s, 0.999 ) )
+              << std::setw( 11 ) << toUs( rHist.m_maxNs ) << '\n';
+      }
+   }
+   rOut.flags( flags );
+   rOut.flush();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+inline void WbHistogram::Snapshot::dump( std::ostream& rOut ) const
+{
+   for( uint a = 0; a < WB_ACCESS_COUNT; a++ )
+   {
+      const WB_ACCESS_T access = static_cast<WB_ACCESS_T>(a);
+      for( uint s = 0; s < SIZE_CLASSES; s++ )
+      {
+         const HISTOGRAM_T& rHist = get( access, s );
+         if( rHist.m_count == 0 )
+            continue;
+         rOut << "{\"access\":\"" << accessToString( access ) << "\""
+                 ",\"size_class\":" << s <<
+                 ",\"min_bytes\":" << (1ULL << s) <<
+                 ",\"count\":" << rHist.m_count <<
+                 ",\"sum_ns\":" << rHist.m_sumNs <<
+                 ",\"max_ns\":" << rHist.m_maxNs <<
+                 ",\"p50_ns\":" << getQuantile( access, s, 0.5 ) <<
+                 ",\"p99_ns\":" << getQuantile( access, s, 0.99 ) <<
+                 ",\"p999_ns\":" << getQuantile( access, s, 0.999 ) <<
+                 ",\"buckets\":[";
+         bool first = true;
+         for( uint i = 0; i < LATENCY_BUCKETS; i++ )
+         {
+            if( rHist.m_aBucket[i] == 0 )
+               continue;
+            if( !first )
+               rOut << ',';
+            first = false;
+            rOut << '[' << getBucketLowerBound( i ) << ',' << rHist.m_aBucket[i] << ']';
+         }
+         rOut << "]}\n";
+      }
+   }
+   rOut.flush();
+}
+
+/*!----------------------------------------------------------------------------
+ */
+inline void WbHistogram::showAtExit( const std::string& rFileName )
+{
+   /*
+    * The process wide object has to be constructed before the exit handler
+    * becomes registered, so it will destructed after the exit handler.
+    */
+   get();
+   static std::string s_fileName;
+   s_fileName = rFileName;
+   static bool s_registered = false;
+   if( s_registered )
+      return;
+   s_registered = true;
+   std::atexit( []()
+   {
+      try
+      {
+         if( s_fileName.empty() )
+            get().snapshot().print( std::cout );
+         else
+            get().dumpToFile( s_fileName );
+      }
+      catch( std::exception& e )
+      {
+         std::cerr << "ERROR: " << e.what() << std::endl;
+      }
+   });
+}
+
+} /* namespace Scu */
+
+#endif /* ifndef _SCU_WB_HISTOGRAM_HPP */
+//================================== EOF ======================================
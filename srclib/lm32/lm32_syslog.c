@@ -76,19 +76,34 @@ STATIC MMU_ADDR_T mg_adminOffset = 0;
 
 /*! ---------------------------------------------------------------------------
  */
-STATIC inline void syslogWriteRam( unsigned int index, const RAM_PAYLOAD_T* pData )
+STATIC inline void syslogWriteRam( unsigned int index, const RAM_PAYLOAD_T* pData,
+                                   const size_t len )
 {
    DDR3_CRITICAL_SECTION_ENTER();
-   ddr3write64( index, pData );
+   ddr3WriteBlock64( index, pData, len );
    DDR3_CRITICAL_SECTION_EXIT();
 }
 
 /*! ---------------------------------------------------------------------------
  */
-STATIC inline void syslogReadRam( unsigned int index, RAM_PAYLOAD_T* pData )
+STATIC inline void syslogReadRam( unsigned int index, RAM_PAYLOAD_T* pData,
+                                  const size_t len )
 {
    DDR3_CRITICAL_SECTION_ENTER();
-   ddr3read64( pData, index );
+   ddr3ReadBlock64( pData, index, len );
+   DDR3_CRITICAL_SECTION_EXIT();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+STATIC inline void syslogWriteRamRing( const RAM_RING_INDEXES_T* pIndexes,
+                                       const RAM_PAYLOAD_T* pData,
+                                       const size_t len )
+{
+   DDR3_CRITICAL_SECTION_ENTER();
+   ddr3WriteRing64( pIndexes->offset, pIndexes->capacity,
+                    ramRingGetWriteIndex( pIndexes ) - pIndexes->offset,
+                    pData, len );
    DDR3_CRITICAL_SECTION_EXIT();
 }
 
@@ -100,40 +115,47 @@ STATIC inline void syslogReadRam( unsigned int index, RAM_PAYLOAD_T* pData )
 
 /*! ---------------------------------------------------------------------------
  */
-STATIC inline void syslogWriteRam( unsigned int index, const RAM_PAYLOAD_T* pData )
+STATIC inline void syslogWriteRam( unsigned int index, const RAM_PAYLOAD_T* pData,
+                                   const size_t len )
+{
+   sramWriteBlock64( index, pData, len );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+STATIC inline void syslogReadRam( unsigned int index, RAM_PAYLOAD_T* pData,
+                                  const size_t len )
 {
-   sramWrite64( index, pData );
+   sramReadBlock64( pData, index, len );
 }
 
 /*! ---------------------------------------------------------------------------
  */
-STATIC inline void syslogReadRam( unsigned int index, RAM_PAYLOAD_T* pData )
+STATIC inline void syslogWriteRamRing( const RAM_RING_INDEXES_T* pIndexes,
+                                       const RAM_PAYLOAD_T* pData,
+                                       const size_t len )
 {
-   sramRead64( pData, index );
+   sramWriteRing64( pIndexes->offset, pIndexes->capacity,
+                    ramRingGetWriteIndex( pIndexes ) - pIndexes->offset,
+                    pData, len );
 }
 
 #endif /* else ifdef CONFIG_SCU_USE_DDR3 */
 
 /*! ---------------------------------------------------------------------------
  */
-STATIC void syslogWriteFifoAdmin( const SYSLOG_FIFO_ADMIN_T* pAdmin )
+STATIC void syslogWriteFifoAdmin( const SYSLOG_FIFO_ADMIN_T* pAdmin,
+                                  const size_t len )
 {
-   MMU_ADDR_T index = mg_adminOffset;
-   for( size_t i = 0; i < SYSLOG_FIFO_ADMIN_SIZE; i++, index++ )
-   {
-      syslogWriteRam( index, &((RAM_PAYLOAD_T*)pAdmin)[i] );
-   }
+   syslogWriteRam( mg_adminOffset, (const RAM_PAYLOAD_T*)pAdmin, len );
 }
 
 /*! ---------------------------------------------------------------------------
  */
 STATIC void syslogReadFifoAdmin( SYSLOG_FIFO_ADMIN_T* pAdmin )
 {
-   MMU_ADDR_T index = mg_adminOffset;
-   for( size_t i = 0; i < SYSLOG_FIFO_ADMIN_SIZE; i++, index++ )
-   {
-      syslogReadRam( index, &((RAM_PAYLOAD_T*)pAdmin)[i] );
-   }
+   syslogReadRam( mg_adminOffset, (RAM_PAYLOAD_T*)pAdmin,
+                  SYSLOG_FIFO_ADMIN_SIZE );
    ramRingDbgPrintIndexes( &pAdmin->admin.indexes, "read" );
 }
 
@@ -167,7 +189,8 @@ MMU_STATUS_T lm32LogInit( unsigned int numOfItems )
       .admin.indexes.capacity = numOfItems - SYSLOG_FIFO_ADMIN_SIZE,
       .admin.indexes.start    = 0,
       .admin.indexes.end      = 0,
-      .admin.wasRead          = 0
+      .admin.wasRead          = 0,
+      .capabilities           = RAM_RING_DIRECT_CAPABILITY
    };
 
    /*
@@ -182,7 +205,7 @@ MMU_STATUS_T lm32LogInit( unsigned int numOfItems )
              fifoAdmin.admin.indexes.offset,
              fifoAdmin.admin.indexes.capacity );
 
-   syslogWriteFifoAdmin( &fifoAdmin );
+   syslogWriteFifoAdmin( &fifoAdmin, SYSLOG_FIFO_ADMIN_SIZE );
 
    return status;
 }
@@ -200,8 +223,12 @@ STATIC inline void syslogPushItem( const SYSLOG_FIFO_ITEM_T* pItem )
 
    /*
     * Removing the items which has been probably read by the Linux daemon.
+    * The member wasRead becomes written back only when it has been modified,
+    * otherwise a read index published in the meantime by the Linux daemon
+    * would be overwritten.
     */
-   sysLogFifoSynchonizeReadIndex( &admin );
+   const size_t adminLen = sysLogFifoSynchonizeReadIndex( &admin )?
+                                SYSLOG_FIFO_ADMIN_SIZE : SYSLOG_FIFO_SERVER_ADMIN_SIZE;
 
    /*
     * Is enough space for the new item?
@@ -213,13 +240,11 @@ STATIC inline void syslogPushItem( const SYSLOG_FIFO_ITEM_T* pItem )
       sysLogFifoAddToReadIndex( &admin, SYSLOG_FIFO_ITEM_SIZE );
    }
 
-   for( size_t i = 0; i < SYSLOG_FIFO_ITEM_SIZE; i++ )
-   {
-      syslogWriteRam( sysLogFifoGetWriteIndex( &admin ), &((RAM_PAYLOAD_T*)pItem)[i] );
-      sysLogFifoIncWriteIndex( &admin );
-   }
+   syslogWriteRamRing( &admin.admin.indexes, (const RAM_PAYLOAD_T*)pItem,
+                       SYSLOG_FIFO_ITEM_SIZE );
+   sysLogFifoAddToWriteIndex( &admin, SYSLOG_FIFO_ITEM_SIZE );
 
-   syslogWriteFifoAdmin( &admin );
+   syslogWriteFifoAdmin( &admin, adminLen );
 
    syslogUnlock();
 }
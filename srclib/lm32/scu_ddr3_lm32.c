@@ -125,16 +125,16 @@ DDR3_T* ddr3GetObj( void )
 }
 
 /*! ---------------------------------------------------------------------------
- * @see scu_ddr3_lm32.h
+ * @brief Writes a 64-bit value in the DDR3 RAM without locking.
+ * @note The caller has to hold the DDR3- lock.
  */
-void ddr3write64( const unsigned int index64, const DDR3_PAYLOAD_T* pData )
+STATIC inline ALWAYS_INLINE
+void ddr3Store64( const unsigned int index64, const DDR3_PAYLOAD_T* pData )
 {
-   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
    DDR_ASSERT( index64 <= DDR3_MAX_INDEX64 );
 
    const unsigned int index32 =
                   index64 * (sizeof(DDR3_PAYLOAD_T)/sizeof(uint32_t));
-   ddr3Lock();
    /*
     * CAUTION: Don't change the order of the following
     * code lines!
@@ -143,21 +143,19 @@ void ddr3write64( const unsigned int index64, const DDR3_PAYLOAD_T* pData )
    BARRIER();
    mg_oDdr3.pTrModeBase[index32+0] = pData->ad32[0]; // DDR3 low word second!
    BARRIER();
-
-   ddr3Unlock();
 }
 
 /*! ---------------------------------------------------------------------------
- * @see scu_ddr3_lm32.h
+ * @brief Reads a 64-bit value from the DDR3 RAM without locking.
+ * @note The caller has to hold the DDR3- lock.
  */
-void ddr3read64( DDR3_PAYLOAD_T* pData, const unsigned int index64 )
+STATIC inline ALWAYS_INLINE
+void ddr3Load64( DDR3_PAYLOAD_T* pData, const unsigned int index64 )
 {
-   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
    DDR_ASSERT( index64 <= DDR3_MAX_INDEX64 );
 
    const unsigned int index32 =
                   index64 * (sizeof(DDR3_PAYLOAD_T)/sizeof(uint32_t));
-   ddr3Lock();
    /*
     * CAUTION: Don't change the order of the following
     * code lines!
@@ -166,7 +164,145 @@ void ddr3read64( DDR3_PAYLOAD_T* pData, const unsigned int index64 )
    BARRIER();
    pData->ad32[1] = mg_oDdr3.pTrModeBase[index32+1]; // DDR3 high word second!
    BARRIER();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a contiguous block of 64-bit values without locking.
+ *
+ * The loop is unrolled by two items, that halves the loop overhead of the
+ * LM32 which has no branch prediction.
+ * @note The caller has to hold the DDR3- lock.
+ */
+STATIC inline ALWAYS_INLINE
+void ddr3StoreBlock64( unsigned int index64, const DDR3_PAYLOAD_T* pData,
+                       unsigned int len64 )
+{
+   while( len64 >= 2 )
+   {
+      ddr3Store64( index64 + 0, &pData[0] );
+      ddr3Store64( index64 + 1, &pData[1] );
+      index64 += 2;
+      pData   += 2;
+      len64   -= 2;
+   }
+   if( len64 != 0 )
+      ddr3Store64( index64, pData );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a contiguous block of 64-bit values without locking.
+ * @see ddr3StoreBlock64
+ * @note The caller has to hold the DDR3- lock.
+ */
+STATIC inline ALWAYS_INLINE
+void ddr3LoadBlock64( DDR3_PAYLOAD_T* pData, unsigned int index64,
+                      unsigned int len64 )
+{
+   while( len64 >= 2 )
+   {
+      ddr3Load64( &pData[0], index64 + 0 );
+      ddr3Load64( &pData[1], index64 + 1 );
+      index64 += 2;
+      pData   += 2;
+      len64   -= 2;
+   }
+   if( len64 != 0 )
+      ddr3Load64( pData, index64 );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3write64( const unsigned int index64, const DDR3_PAYLOAD_T* pData )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
+
+   ddr3Lock();
+   ddr3Store64( index64, pData );
+   ddr3Unlock();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3read64( DDR3_PAYLOAD_T* pData, const unsigned int index64 )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
 
+   ddr3Lock();
+   ddr3Load64( pData, index64 );
+   ddr3Unlock();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3WriteBlock64( const unsigned int index64,
+                       const DDR3_PAYLOAD_T* pData,
+                       const unsigned int len64 )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
+   DDR_ASSERT( (index64 + len64) <= (DDR3_MAX_INDEX64 + 1) );
+
+   ddr3Lock();
+   ddr3StoreBlock64( index64, pData, len64 );
+   ddr3Unlock();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3ReadBlock64( DDR3_PAYLOAD_T* pData,
+                      const unsigned int index64,
+                      const unsigned int len64 )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
+   DDR_ASSERT( (index64 + len64) <= (DDR3_MAX_INDEX64 + 1) );
+
+   ddr3Lock();
+   ddr3LoadBlock64( pData, index64, len64 );
+   ddr3Unlock();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3WriteRing64( const unsigned int offset64,
+                      const unsigned int capacity64,
+                      const unsigned int index64,
+                      const DDR3_PAYLOAD_T* pData,
+                      const unsigned int len64 )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
+   DDR_ASSERT( index64 < capacity64 );
+   DDR_ASSERT( len64 <= capacity64 );
+
+   const unsigned int upperLen = min( len64, capacity64 - index64 );
+
+   ddr3Lock();
+   ddr3StoreBlock64( offset64 + index64, pData, upperLen );
+   ddr3StoreBlock64( offset64, &pData[upperLen], len64 - upperLen );
+   ddr3Unlock();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_ddr3_lm32.h
+ */
+void ddr3ReadRing64( DDR3_PAYLOAD_T* pData,
+                     const unsigned int offset64,
+                     const unsigned int capacity64,
+                     const unsigned int index64,
+                     const unsigned int len64 )
+{
+   DDR_ASSERT( mg_oDdr3.pTrModeBase != DDR3_INVALID );
+   DDR_ASSERT( index64 < capacity64 );
+   DDR_ASSERT( len64 <= capacity64 );
+
+   const unsigned int upperLen = min( len64, capacity64 - index64 );
+
+   ddr3Lock();
+   ddr3LoadBlock64( pData, offset64 + index64, upperLen );
+   ddr3LoadBlock64( &pData[upperLen], offset64, len64 - upperLen );
    ddr3Unlock();
 }
 
@@ -94,6 +94,70 @@ void ddr3write64( const unsigned int index64,
 void ddr3read64( DDR3_PAYLOAD_T* pData,
                  const unsigned int index64 );
 
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a contiguous block of 64-bit values in the DDR3 RAM.
+ *
+ * Unlike a loop of ddr3write64() the DDR3- lock becomes taken only once
+ * for the whole block.
+ * @note Keep the blocks small, because the interrupts are disabled
+ *       during the whole write access.
+ * @param index64 64 bit aligned start index
+ * @param pData Pointer to the first 64 bit value to write.
+ * @param len64 Number of 64 bit values to write.
+ */
+void ddr3WriteBlock64( const unsigned int index64,
+                       const DDR3_PAYLOAD_T* pData,
+                       const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a contiguous block of 64-bit values from the DDR3 RAM
+ *        by taking the DDR3- lock only once.
+ * @see ddr3WriteBlock64
+ * @param pData Pointer to the target of at least len64 64-bit values.
+ * @param index64 64 bit aligned start index
+ * @param len64 Number of 64 bit values to read.
+ */
+void ddr3ReadBlock64( DDR3_PAYLOAD_T* pData,
+                      const unsigned int index64,
+                      const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a block of 64-bit values in a ring buffer in the DDR3 RAM
+ *        by taking the DDR3- lock only once.
+ *
+ * If the block exceeds the upper border of the ring buffer, then the
+ * rest becomes written at the begin of the ring buffer.
+ * @see RAM_RING_INDEXES_T
+ * @param offset64 Absolute start index of the ring buffer.
+ * @param capacity64 Capacity of the ring buffer in 64 bit values.
+ * @param index64 Write index relative to offset64,
+ *                has to be smaller than capacity64.
+ * @param pData Pointer to the first 64 bit value to write.
+ * @param len64 Number of 64 bit values to write, maximum capacity64.
+ */
+void ddr3WriteRing64( const unsigned int offset64,
+                      const unsigned int capacity64,
+                      const unsigned int index64,
+                      const DDR3_PAYLOAD_T* pData,
+                      const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a block of 64-bit values from a ring buffer in the DDR3 RAM
+ *        by taking the DDR3- lock only once.
+ * @see ddr3WriteRing64
+ * @param pData Pointer to the target of at least len64 64-bit values.
+ * @param offset64 Absolute start index of the ring buffer.
+ * @param capacity64 Capacity of the ring buffer in 64 bit values.
+ * @param index64 Read index relative to offset64,
+ *                has to be smaller than capacity64.
+ * @param len64 Number of 64 bit values to read, maximum capacity64.
+ */
+void ddr3ReadRing64( DDR3_PAYLOAD_T* pData,
+                     const unsigned int offset64,
+                     const unsigned int capacity64,
+                     const unsigned int index64,
+                     const unsigned int len64 );
+
 #ifndef CONFIG_DDR3_NO_BURST_FUNCTIONS
 /*! ---------------------------------------------------------------------------
  * @brief Returns the DDR3-fofo -status;
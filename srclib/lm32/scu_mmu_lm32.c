@@ -44,10 +44,7 @@ MMU_STATUS_T mmuInit( void )
  */
 void mmuRead( MMU_ADDR_T index, RAM_PAYLOAD_T* pItem, size_t len )
 {
-   for( size_t i = 0; i < len; i++, index++ )
-   {
-      ddr3read64( &pItem[i], index );
-   }
+   ddr3ReadBlock64( pItem, index, len );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -55,10 +52,7 @@ void mmuRead( MMU_ADDR_T index, RAM_PAYLOAD_T* pItem, size_t len )
  */
 void mmuWrite( MMU_ADDR_T index, const RAM_PAYLOAD_T* pItem, size_t len )
 {
-   for( size_t i = 0; i < len; i++, index++ )
-   {
-      ddr3write64( index, &pItem[i] );
-   }
+   ddr3WriteBlock64( index, pItem, len );
 }
 
 #else /******* SRAM- ACCESS *********/
@@ -76,10 +70,7 @@ MMU_STATUS_T mmuInit( void )
  */
 void mmuRead( MMU_ADDR_T index, RAM_PAYLOAD_T* pItem, size_t len )
 {
-   for( size_t i = 0; i < len; i++, index++ )
-   {
-      sramRead64( &pItem[i], index );
-   }
+   sramReadBlock64( pItem, index, len );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -87,10 +78,7 @@ void mmuRead( MMU_ADDR_T index, RAM_PAYLOAD_T* pItem, size_t len )
  */
 void mmuWrite( MMU_ADDR_T index, const RAM_PAYLOAD_T* pItem, size_t len )
 {
-   for( size_t i = 0; i < len; i++, index++ )
-   {
-      sramWite64( index, &pItem[i] );
-   }
+   sramWriteBlock64( index, pItem, len );
 }
 
 #endif /* else ifdef CONFIG_SCU_USE_DDR3 */
@@ -22,6 +22,202 @@
  * License along with this library. If not, @see <http://www.gnu.org/licenses/>
  ******************************************************************************
  */
+#include <sdb_lm32.h>
+#include <dbg.h>
+#include <scu_lm32_macros.h>
+#include <lm32Interrupts.h>
 #include "scu_sram_lm32.h"
 
+/*!
+ * @brief Wishbone base address of the SRAM.
+ */
+STATIC uint32_t* volatile mg_pSramBase = NULL;
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+int sramInit( void )
+{
+   mg_pSramBase = find_device_adr( GSI, WB_PSEUDO_SRAM );
+   if( mg_pSramBase == (uint32_t*)ERROR_NOT_FOUND )
+   {
+      mg_pSramBase = NULL;
+      DBPRINT1( "DBG: ERROR: SRAM: Can't find address of WB_PSEUDO_SRAM !\n" );
+      return -1;
+   }
+   return 0;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a 64-bit value in the SRAM without locking.
+ * @note The caller has to be within a critical section.
+ */
+STATIC inline ALWAYS_INLINE
+void sramStore64( const unsigned int index64, const SRAM_PAYLOAD_T* pData )
+{
+   SRAM_ASSERT( index64 <= SRAM_MAX_INDEX64 );
+
+   const unsigned int index32 =
+                  index64 * (sizeof(SRAM_PAYLOAD_T)/sizeof(uint32_t));
+   mg_pSramBase[index32+0] = pData->ad32[0];
+   BARRIER();
+   mg_pSramBase[index32+1] = pData->ad32[1];
+   BARRIER();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a 64-bit value from the SRAM without locking.
+ * @note The caller has to be within a critical section.
+ */
+STATIC inline ALWAYS_INLINE
+void sramLoad64( SRAM_PAYLOAD_T* pData, const unsigned int index64 )
+{
+   SRAM_ASSERT( index64 <= SRAM_MAX_INDEX64 );
+
+   const unsigned int index32 =
+                  index64 * (sizeof(SRAM_PAYLOAD_T)/sizeof(uint32_t));
+   pData->ad32[0] = mg_pSramBase[index32+0];
+   BARRIER();
+   pData->ad32[1] = mg_pSramBase[index32+1];
+   BARRIER();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a contiguous block of 64-bit values, loop unrolled by
+ *        two items.
+ * @note The caller has to be within a critical section.
+ */
+STATIC inline ALWAYS_INLINE
+void sramStoreBlock64( unsigned int index64, const SRAM_PAYLOAD_T* pData,
+                       unsigned int len64 )
+{
+   while( len64 >= 2 )
+   {
+      sramStore64( index64 + 0, &pData[0] );
+      sramStore64( index64 + 1, &pData[1] );
+      index64 += 2;
+      pData   += 2;
+      len64   -= 2;
+   }
+   if( len64 != 0 )
+      sramStore64( index64, pData );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a contiguous block of 64-bit values, loop unrolled by
+ *        two items.
+ * @note The caller has to be within a critical section.
+ */
+STATIC inline ALWAYS_INLINE
+void sramLoadBlock64( SRAM_PAYLOAD_T* pData, unsigned int index64,
+                      unsigned int len64 )
+{
+   while( len64 >= 2 )
+   {
+      sramLoad64( &pData[0], index64 + 0 );
+      sramLoad64( &pData[1], index64 + 1 );
+      index64 += 2;
+      pData   += 2;
+      len64   -= 2;
+   }
+   if( len64 != 0 )
+      sramLoad64( pData, index64 );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramWrite64( const unsigned int index64, const SRAM_PAYLOAD_T* pData )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+
+   criticalSectionEnter();
+   sramStore64( index64, pData );
+   criticalSectionExit();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramRead64( SRAM_PAYLOAD_T* pData, const unsigned int index64 )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+
+   criticalSectionEnter();
+   sramLoad64( pData, index64 );
+   criticalSectionExit();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramWriteBlock64( const unsigned int index64,
+                       const SRAM_PAYLOAD_T* pData,
+                       const unsigned int len64 )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+   SRAM_ASSERT( (index64 + len64) <= (SRAM_MAX_INDEX64 + 1) );
+
+   criticalSectionEnter();
+   sramStoreBlock64( index64, pData, len64 );
+   criticalSectionExit();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramReadBlock64( SRAM_PAYLOAD_T* pData,
+                      const unsigned int index64,
+                      const unsigned int len64 )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+   SRAM_ASSERT( (index64 + len64) <= (SRAM_MAX_INDEX64 + 1) );
+
+   criticalSectionEnter();
+   sramLoadBlock64( pData, index64, len64 );
+   criticalSectionExit();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramWriteRing64( const unsigned int offset64,
+                      const unsigned int capacity64,
+                      const unsigned int index64,
+                      const SRAM_PAYLOAD_T* pData,
+                      const unsigned int len64 )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+   SRAM_ASSERT( index64 < capacity64 );
+   SRAM_ASSERT( len64 <= capacity64 );
+
+   const unsigned int upperLen = min( len64, capacity64 - index64 );
+
+   criticalSectionEnter();
+   sramStoreBlock64( offset64 + index64, pData, upperLen );
+   sramStoreBlock64( offset64, &pData[upperLen], len64 - upperLen );
+   criticalSectionExit();
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_sram_lm32.h
+ */
+void sramReadRing64( SRAM_PAYLOAD_T* pData,
+                     const unsigned int offset64,
+                     const unsigned int capacity64,
+                     const unsigned int index64,
+                     const unsigned int len64 )
+{
+   SRAM_ASSERT( mg_pSramBase != NULL );
+   SRAM_ASSERT( index64 < capacity64 );
+   SRAM_ASSERT( len64 <= capacity64 );
+
+   const unsigned int upperLen = min( len64, capacity64 - index64 );
+
+   criticalSectionEnter();
+   sramLoadBlock64( pData, offset64 + index64, upperLen );
+   sramLoadBlock64( &pData[upperLen], offset64, len64 - upperLen );
+   criticalSectionExit();
+}
+
 /*================================== EOF ====================================*/
@@ -26,12 +26,97 @@
 #ifndef _SCU_SRAM_LM32_H
 #define _SCU_SRAM_LM32_H
 
+#include <stdint.h>
 #include <access64_type.h>
+#include <scu_sram.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*!
+ * @brief Payload type of the SRAM, it's the same like of the DDR3-RAM.
+ */
+typedef ACCESS64_T SRAM_PAYLOAD_T;
+
+/*! ---------------------------------------------------------------------------
+ * @brief Initializing of the SRAM.
+ * @retval 0 Initializing was successful
+ * @retval <0 Error
+ */
+int sramInit( void );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a 64-bit value in the SRAM
+ * @param index64 64 bit aligned index
+ * @param pData Pointer to the 64 bit data to write.
+ */
+void sramWrite64( const unsigned int index64, const SRAM_PAYLOAD_T* pData );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a 64-bit value from the SRAM
+ * @param pData Pointer to the 64-bit-target where the function should
+ *              copy the data.
+ * @param index64 64 bit aligned index
+ */
+void sramRead64( SRAM_PAYLOAD_T* pData, const unsigned int index64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a contiguous block of 64-bit values in the SRAM
+ *        within a single critical section.
+ * @param index64 64 bit aligned start index
+ * @param pData Pointer to the first 64 bit value to write.
+ * @param len64 Number of 64 bit values to write.
+ */
+void sramWriteBlock64( const unsigned int index64,
+                       const SRAM_PAYLOAD_T* pData,
+                       const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a contiguous block of 64-bit values from the SRAM
+ *        within a single critical section.
+ * @param pData Pointer to the target of at least len64 64-bit values.
+ * @param index64 64 bit aligned start index
+ * @param len64 Number of 64 bit values to read.
+ */
+void sramReadBlock64( SRAM_PAYLOAD_T* pData,
+                      const unsigned int index64,
+                      const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Writes a block of 64-bit values in a ring buffer in the SRAM
+ *        within a single critical section.
+ * @see ddr3WriteRing64
+ * @param offset64 Absolute start index of the ring buffer.
+ * @param capacity64 Capacity of the ring buffer in 64 bit values.
+ * @param index64 Write index relative to offset64,
+ *                has to be smaller than capacity64.
+ * @param pData Pointer to the first 64 bit value to write.
+ * @param len64 Number of 64 bit values to write, maximum capacity64.
+ */
+void sramWriteRing64( const unsigned int offset64,
+                      const unsigned int capacity64,
+                      const unsigned int index64,
+                      const SRAM_PAYLOAD_T* pData,
+                      const unsigned int len64 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads a block of 64-bit values from a ring buffer in the SRAM
+ *        within a single critical section.
+ * @see sramWriteRing64
+ * @param pData Pointer to the target of at least len64 64-bit values.
+ * @param offset64 Absolute start index of the ring buffer.
+ * @param capacity64 Capacity of the ring buffer in 64 bit values.
+ * @param index64 Read index relative to offset64,
+ *                has to be smaller than capacity64.
+ * @param len64 Number of 64 bit values to read, maximum capacity64.
+ */
+void sramReadRing64( SRAM_PAYLOAD_T* pData,
+                     const unsigned int offset64,
+                     const unsigned int capacity64,
+                     const unsigned int index64,
+                     const unsigned int len64 );
+
 #ifdef __cplusplus
 }
 #endif
@@ -102,9 +102,11 @@ typedef struct PACKED_SIZE
    RAM_RING_SHARED_INDEXES_T admin;
 
    /*!
-    * @brief Necessary for it to be divisible by SYSLOG_MEM_ITEM_T.
+    * @brief Capability of the handshake protocol published by the LM32,
+    *        RAM_RING_DIRECT_CAPABILITY or zero by a legacy firmware.
+    * @note Necessary for it to be divisible by SYSLOG_MEM_ITEM_T as well.
     */
-   RAM_RING_INDEX_T __padding__;
+   uint32_t         capabilities;
 } SYSLOG_FIFO_ADMIN_T;
 
 STATIC_ASSERT( sizeof(SYSLOG_FIFO_ADMIN_T) % sizeof(SYSLOG_MEM_ITEM_T) == 0 );
@@ -116,6 +118,19 @@ STATIC_ASSERT( sizeof(SYSLOG_FIFO_ADMIN_T) % sizeof(SYSLOG_MEM_ITEM_T) == 0 );
 STATIC const 
 size_t SYSLOG_FIFO_ADMIN_SIZE = (sizeof(SYSLOG_FIFO_ADMIN_T) / sizeof(SYSLOG_MEM_ITEM_T));
 
+STATIC_ASSERT( offsetof( SYSLOG_FIFO_ADMIN_T, admin.wasRead ) % sizeof(SYSLOG_MEM_ITEM_T) == 0 );
+
+/*! ---------------------------------------------------------------------------
+ * @brief Size of the part of the fifo administration object owned by the
+ *        LM32 in smallest addressable memory items.
+ *
+ * The remaining item holds the member wasRead, which is owned by the
+ * Linux daemon in the direct protocol.
+ * @see RAM_RING_PROTOCOL_FLAG
+ */
+STATIC const
+size_t SYSLOG_FIFO_SERVER_ADMIN_SIZE = (offsetof( SYSLOG_FIFO_ADMIN_T, admin.wasRead ) / sizeof(SYSLOG_MEM_ITEM_T));
+
 /*! ---------------------------------------------------------------------------
  * @ingroup LM32_LOG
  * @brief Type of a single log item.
@@ -172,7 +187,10 @@ RAM_RING_INDEX_T sysLogFifoGetSize( const SYSLOG_FIFO_ADMIN_T* pThis )
 STATIC inline
 RAM_RING_INDEX_T sysLogFifoGetItemSize( const SYSLOG_FIFO_ADMIN_T* pThis )
 {
-   return (sysLogFifoGetSize( pThis ) - pThis->admin.wasRead) / SYSLOG_FIFO_ITEM_SIZE;
+   const RAM_RING_INDEX_T pending =
+      ((pThis->admin.wasRead & RAM_RING_HANDSHAKE_MASK) == 0)? pThis->admin.wasRead : 0;
+
+   return (sysLogFifoGetSize( pThis ) - pending) / SYSLOG_FIFO_ITEM_SIZE;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -281,13 +299,18 @@ void sysLogFifoIncReadIndex( SYSLOG_FIFO_ADMIN_T* pThis )
  *       race conditions.
  *
  * In this way a handshaking transfer becomes possible.
+ * @see ramRingSharedSynchonizeReadIndex
  *
  * @param pThis Pointer to the shared ring indexes object.
+ * @retval true The member wasRead has been modified and has to be written
+ *              back.
+ * @retval false Writing back of SYSLOG_FIFO_SERVER_ADMIN_SIZE memory items
+ *               is sufficient.
  */
 STATIC inline
-void sysLogFifoSynchonizeReadIndex( SYSLOG_FIFO_ADMIN_T* pThis )
+bool sysLogFifoSynchonizeReadIndex( SYSLOG_FIFO_ADMIN_T* pThis )
 {
-   ramRingSharedSynchonizeReadIndex( &pThis->admin );
+   return ramRingSharedSynchonizeReadIndex( &pThis->admin );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -98,15 +98,6 @@ bool mmuIsPresent( void )
    return ( probe.ad32[0] == MMU_MAGIC );
 }
 
-/*! ---------------------------------------------------------------------------
- * @see scu_mmu.h
- */
-void mmuDelete( void )
-{
-   const RAM_PAYLOAD_T probe = { .ad32[0] = ~MMU_MAGIC, .ad32[1] = 0 };
-   mmuWrite( MMU_LIST_START, &probe, 1 );
-}
-
 /*! ---------------------------------------------------------------------------
  */
 void mmuReadItem( const MMU_ADDR_T index, MMU_ITEM_T* pItem )
@@ -126,40 +117,25 @@ void mmuWriteItem( const MMU_ADDR_T index, const MMU_ITEM_T* pItem )
             MMU_ITEMSIZE );
 }
 
-/*! ---------------------------------------------------------------------------
- * @see scu_mmu.h
- */
-unsigned int mmuGetNumberOfBlocks( void )
-{
-   if( !mmuIsPresent() )
-      return 0;
-
-   MMU_ITEM_T listItem = { .iNext = 0 };
-   unsigned int count = 0;
-   while( true )
-   {
-      mmuReadNextItem( &listItem );
-      if( listItem.iNext == 0 )
-         break;
-      count++;
-   }
-
-   return count;
-}
-
 /*!
  * @ingroup SCU_MMU
  * @brief Special block type for the beginning of the list only.
+ * @note The member generation overlays the member iStart of MMU_ITEM_T,
+ *       and the member reserved overlays its member length, which has
+ *       to be zero because mmuAlloc() adds it to the level.
  */
 typedef struct PACKED_SIZE
 {
    uint32_t magicNumber;
    uint32_t iNext;
-   uint64_t padding;
+   uint32_t generation;
+   uint32_t reserved;
 } START_BLOCK_T;
 
 STATIC_ASSERT( sizeof( START_BLOCK_T ) == sizeof( MMU_ITEM_T ) );
 STATIC_ASSERT( offsetof( START_BLOCK_T, iNext ) == offsetof( MMU_ITEM_T, iNext ) );
+STATIC_ASSERT( offsetof( START_BLOCK_T, generation ) == offsetof( MMU_ITEM_T, iStart ) );
+STATIC_ASSERT( offsetof( START_BLOCK_T, reserved ) == offsetof( MMU_ITEM_T, length ) );
 
 /*!
  * @ingroup SCU_MMU
@@ -173,6 +149,81 @@ typedef union
 
 STATIC_ASSERT( sizeof( START_BLOCK_ACCESS_T ) == sizeof( MMU_ITEM_T ) );
 
+/*! ---------------------------------------------------------------------------
+ * @ingroup SCU_MMU
+ * @brief Returns the successor of the given generation, skipping the
+ *        value zero.
+ */
+STATIC inline uint32_t mmuNextGeneration( uint32_t generation )
+{
+   generation++;
+   if( generation == MMU_NO_GENERATION )
+      generation++;
+   return generation;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SCU_MMU
+ * @brief Increments the generation counter in the start block of the list.
+ */
+STATIC void mmuIncrementGeneration( void )
+{
+   START_BLOCK_ACCESS_T access;
+   mmuReadItem( MMU_LIST_START, &access.item );
+   access.startBlock.generation = mmuNextGeneration( access.startBlock.generation );
+   mmuWriteItem( MMU_LIST_START, &access.item );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_mmu.h
+ */
+uint32_t mmuGetGeneration( void )
+{
+   START_BLOCK_ACCESS_T access;
+   mmuReadItem( MMU_LIST_START, &access.item );
+   if( access.startBlock.magicNumber != MMU_MAGIC )
+      return MMU_NO_GENERATION;
+   return access.startBlock.generation;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_mmu.h
+ */
+void mmuDelete( void )
+{
+   START_BLOCK_ACCESS_T access;
+   mmuReadItem( MMU_LIST_START, &access.item );
+   access.startBlock.magicNumber = ~MMU_MAGIC;
+   access.startBlock.iNext       = 0;
+  /*
+   * The generation survives the deletion, so a new created list
+   * can not be mistaken for the deleted one by a cache of the host.
+   */
+   access.startBlock.generation  = mmuNextGeneration( access.startBlock.generation );
+   mmuWriteItem( MMU_LIST_START, &access.item );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @see scu_mmu.h
+ */
+unsigned int mmuGetNumberOfBlocks( void )
+{
+   if( !mmuIsPresent() )
+      return 0;
+
+   MMU_ITEM_T listItem = { .iNext = 0 };
+   unsigned int count = 0;
+   while( true )
+   {
+      mmuReadNextItem( &listItem );
+      if( listItem.iNext == 0 )
+         break;
+      count++;
+   }
+
+   return count;
+}
+
 /*! ---------------------------------------------------------------------------
  * @see scu_mmu.h
  */
@@ -186,14 +237,16 @@ MMU_STATUS_T mmuAlloc( const MMU_TAG_T tag, MMU_ADDR_T* pStartAddr,
      /*
       * List has not yet been created.
       * This will made here.
+      * The generation counter continues a possibly former value,
+      * see mmuDelete().
       */
-      const START_BLOCK_ACCESS_T access =
-      {
-         .startBlock.magicNumber = MMU_MAGIC,
-         .startBlock.iNext       = 0,
-         .startBlock.padding     = 0L
-      };
-      mmuWriteItem( 0, &access.item );
+      START_BLOCK_ACCESS_T access;
+      mmuReadItem( MMU_LIST_START, &access.item );
+      access.startBlock.magicNumber = MMU_MAGIC;
+      access.startBlock.iNext       = 0;
+      access.startBlock.generation  = mmuNextGeneration( access.startBlock.generation );
+      access.startBlock.reserved    = 0;
+      mmuWriteItem( MMU_LIST_START, &access.item );
    }
 
    /*
@@ -247,6 +300,11 @@ MMU_STATUS_T mmuAlloc( const MMU_TAG_T tag, MMU_ADDR_T* pStartAddr,
    mmuPrintItem( &item );
    *pStartAddr = item.iStart;
 
+   /*
+    * Signaling the modification to possible caches of the host.
+    */
+   mmuIncrementGeneration();
+
    return OK;
 }
 
@@ -42,7 +42,7 @@
  *          +------------+------------+------------+------------+
  *          |      Magic number       |      Start index 1      |\
  *          +-------------------------+-------------------------+ start descriptor
- *          |            Padding respectively RFU               |/
+ *          |       Generation        |         RFU = 0         |/
  *          +------------+------------+-------------------------+
  * index 1> |   Tag 1    |  Flags 1   |      Start index 2      |\
  *          +------------+------------+-------------------------+ payload descriptor 1
@@ -269,6 +269,29 @@ unsigned int mmuGetNumberOfBlocks( void );
  */
 void mmuDelete( void );
 
+/*!
+ * @ingroup SCU_MMU
+ * @brief Return value of mmuGetGeneration() when no partition table is
+ *        present or the partition table has been created by a former
+ *        version without generation counter.
+ */
+#define MMU_NO_GENERATION 0
+
+/*! ---------------------------------------------------------------------------
+ * @ingroup SCU_MMU
+ * @brief Returns the generation counter of the partition table.
+ *
+ * The generation counter resides in the formerly unused padding of the
+ * start block and becomes incremented by each new allocated memory block
+ * and by mmuDelete(). As long as it doesn't change, the partition table
+ * hasn't changed, so the host can use a cached copy of it instead of
+ * climbing through the list by etherbone.
+ * @see Scu::mmu::Mmu
+ * @retval MMU_NO_GENERATION No partition table present, or it has been
+ *                           created by a former version.
+ */
+uint32_t mmuGetGeneration( void );
+
 /*! ---------------------------------------------------------------------------
  * @ingroup SCU_MMU
  * @brief Reads a single item.
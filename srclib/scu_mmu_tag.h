@@ -52,6 +52,14 @@ STATIC const MMU_TAG_T TAG_ADDAC_DAQ = 0xFF01;
  */
 STATIC const MMU_TAG_T TAG_MIL_DAQ   = 0xFF02;
 
+/*!
+ * @ingroup SCU_MMU
+ * @brief Memory block identifier for the deep polynomial buffers of
+ *        the function generators.
+ * @see scu_fg_deep_buffer.h
+ */
+STATIC const MMU_TAG_T TAG_FG_BUFFER = 0xFF03;
+
 /*!
  * @ingroup SCU_MMU
  * @brief Memory block identifier for LM32-log messages.
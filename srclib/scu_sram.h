@@ -27,6 +27,7 @@
 #ifndef _SCU_SRAM_H
 #define _SCU_SRAM_H
 #include <stdint.h>
+#include <helper_macros.h>
 
 #ifdef CONFIG_SRAM_PEDANTIC_CHECK
    /* CAUTION:
@@ -48,8 +49,8 @@ namespace Scu
 {
 #endif
 
-const unsigned int _32MB_IN_BYTE = 33554432;
-const unsigned int SRAM_MAX_INDEX64 = _32MB_IN_BYTE / sizeof(uint64_t) - 1;
+STATIC const unsigned int _32MB_IN_BYTE = 33554432;
+STATIC const unsigned int SRAM_MAX_INDEX64 = _32MB_IN_BYTE / sizeof(uint64_t) - 1;
 
 
 #ifdef __cplusplus
@@ -26,6 +26,7 @@
 #ifndef __DOCFSM__
  #include <daqt_onFoundProcess.hpp>
 #include <scu_env.hpp>
+#include <scu_wb_histogram.hpp>
 #endif
 
 #include "fb_command_line.hpp"
@@ -54,6 +55,18 @@ using namespace Scu;
 #ifndef DEFAULT_EB_CYCLE_GAP_TIME
    #define DEFAULT_EB_CYCLE_GAP_TIME  100
 #endif
+#ifndef DEFAULT_DRAIN_BLOCK_BUDGET
+   #define DEFAULT_DRAIN_BLOCK_BUDGET 1
+#endif
+#ifndef DEFAULT_ACQUISITION_RING_CAPACITY
+   #define DEFAULT_ACQUISITION_RING_CAPACITY 0
+#endif
+#ifndef DEFAULT_MIN_POLL_INTERVAL
+   #define DEFAULT_MIN_POLL_INTERVAL 100
+#endif
+#ifndef DEFAULT_MAX_POLL_INTERVAL
+   #define DEFAULT_MAX_POLL_INTERVAL 100000
+#endif
 
 #define FSM_INIT_FSM( state, attr... )      m_state = state
 #define FSM_TRANSITION( newState, attr... ) m_state = newState
@@ -142,6 +155,7 @@ vector<OPTION> CommandLine::c_optList =
               << HOT_KEY_PRINT_HISTORY << ": Prints the current LM32 history in a eb-console. (See option -H)\n"
               << HOT_KEY_BUILD_NEW << ": Rebuilds the objects respectively restart.\n"
               PRINT_HOT_KEY_SHOW_TIMING
+              << HOT_KEY_SHOW_HISTOGRAM << ": Shows the latency histograms of the wishbone accesses.\n"
                  "Esc: Program termination\n"
                  "\nCommandline options:\n";
          poParser->list( cout );
@@ -827,6 +841,76 @@ vector<OPTION> CommandLine::c_optList =
                     "If the DDR3-RAM is not involved in the data transfer,"
                     " then this option has no effect."
    },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::showAtExit( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::OPTIONAL_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "wb-histogram",
+      .m_helpText = "Prints the latency histograms of all wishbone accesses"
+                    " at the end of the program.\n"
+                    "PARAM: =<file name>\n"
+                    "If PARAM is given, then the histograms becomes written in"
+                    " JSON-lines format in this file instead, e.g. for offline"
+                    " comparison of several runs."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::get().setEnabled( false );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "no-wb-histogram",
+      .m_helpText = "Switches the recording of the latency histograms of the"
+                    " wishbone accesses off."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<CommandLine*>(poParser)->m_recordFileName = poParser->getOptArg();
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "record",
+      .m_helpText = "Records all incoming feedback tuples in the binary file"
+                    " given by PARAM.\n"
+                    "The file is organized in chunks with a index of the"
+                    " timestamp range of each channel, so it can be mapped"
+                    " in the memory and accessed randomly by timestamp.\n"
+                    "The file will written by a background thread in large"
+                    " blocks, so the data acquisition becomes not slowed down."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         CommandLine* pCmdLine = static_cast<CommandLine*>(poParser);
+         if( readInteger( pCmdLine->m_drainBlockBudget, poParser->getOptArg() ) )
+            return -1;
+         DEBUG_MESSAGE( "drain block budget: " << pCmdLine->m_drainBlockBudget );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'B',
+      .m_longOpt  = "drain-budget",
+      .m_helpText = "PARAM specifies the maximum number of ADDAC-DAQ blocks which"
+                    " becomes read and distributed in one polling cycle.\n"
+                    "A value greater than one activates the batched mode, in which"
+                    " all complete blocks up to PARAM becomes read by one"
+                    " ring-buffer access and acknowledged by one write access"
+                    " to the LM32.\n"
+                    "In this mode the option \"-b\" has no effect for ADDAC-DAQs.\n"
+                    "Default: " TO_STRING( DEFAULT_DRAIN_BLOCK_BUDGET )
+   },
    {
       OPT_LAMBDA( poParser,
       {
@@ -839,6 +923,58 @@ vector<OPTION> CommandLine::c_optList =
       .m_longOpt  = "clear-fifo-on-overflow",
       .m_helpText = "Deletes the FIFO in the DDR3-RAM or SRAM if it"
                     " threatens to overflow."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         CommandLine* pCmdLine = static_cast<CommandLine*>(poParser);
+         if( readInteger( pCmdLine->m_acquisitionRingCapacity, poParser->getOptArg() ) )
+            return -1;
+         DEBUG_MESSAGE( "acquisition ring capacity: " << pCmdLine->m_acquisitionRingCapacity );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'x',
+      .m_longOpt  = "threaded",
+      .m_helpText = "Activates the threaded mode: A own acquisition thread reads"
+                    " the DAQ-buffers and hands over the tuples via a ring"
+                    " of PARAM tuples per channel to the plot- and statistic"
+                    " consumers.\n"
+                    "If a ring is full, then the tuples becomes dropped and"
+                    " counted, in verbose mode the number of dropped tuples"
+                    " will shown.\n"
+                    "The value of zero disables the threaded mode.\n"
+                    "Default: " TO_STRING( DEFAULT_ACQUISITION_RING_CAPACITY )
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         CommandLine* pCmdLine = static_cast<CommandLine*>(poParser);
+         readTwoIntegerParameters( pCmdLine->m_minPollIntervalUs,
+                                   pCmdLine->m_maxPollIntervalUs,
+                                   pCmdLine->getOptArg() );
+         pCmdLine->m_adaptivePolling = true;
+         DEBUG_MESSAGE( "m_minPollIntervalUs: "
+                        << pCmdLine->m_minPollIntervalUs
+                        << "m_maxPollIntervalUs: "
+                        << pCmdLine->m_maxPollIntervalUs );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'w',
+      .m_longOpt  = "adaptive-poll",
+      .m_helpText = "PARAM=\"min,max\"\n"
+                    "Activates the adaptive polling: The poll interval becomes"
+                    " derived from the fill level and the fill rate of the"
+                    " DAQ-FIFOs.\n"
+                    "In idle the interval becomes doubled up to \"max\","
+                    " when the FIFO threatens to overflow then \"min\" will"
+                    " used.\n"
+                    "Both values are in microseconds.\n"
+                    "The default values are: \"" TO_STRING( DEFAULT_MIN_POLL_INTERVAL )
+                    "," TO_STRING( DEFAULT_MAX_POLL_INTERVAL ) "\""
    }
 };
 
@@ -934,6 +1070,11 @@ CommandLine::CommandLine( int argc, char** ppArgv )
    ,m_throttleTimeout( DEFAULT_THROTTLE_TIMEOUT )
    ,m_maxEbCycleDataLen( DEFAULT_MAX_EB_BLOCK_LEN )
    ,m_blockReadEbCycleGapTimeUs( DEFAULT_EB_CYCLE_GAP_TIME )
+   ,m_drainBlockBudget( DEFAULT_DRAIN_BLOCK_BUDGET )
+   ,m_acquisitionRingCapacity( DEFAULT_ACQUISITION_RING_CAPACITY )
+   ,m_adaptivePolling( false )
+   ,m_minPollIntervalUs( DEFAULT_MIN_POLL_INTERVAL )
+   ,m_maxPollIntervalUs( DEFAULT_MAX_POLL_INTERVAL )
    ,m_distributeDataPollIntervall( 0 )
    ,m_distributeDataPollMaximum( DEFAULT_CONSECUTIVE_POLL_MAXIMUM )
    ,m_isRunningOnScu( Scu::isRunningOnScu() )
@@ -993,6 +1134,11 @@ AllDaqAdministration* CommandLine::operator()( void )
       m_poAllDaq->setThrottleTimeout( m_throttleTimeout );
       m_poAllDaq->setMaxEbCycleDataLen( m_maxEbCycleDataLen );
       m_poAllDaq->setBlockReadEbCycleTimeUs( m_blockReadEbCycleGapTimeUs );
+      m_poAllDaq->setAddacDrainBlockBudget( m_drainBlockBudget );
+      if( !m_recordFileName.empty() )
+         m_poAllDaq->startRecording( m_recordFileName );
+      if( m_adaptivePolling )
+         m_poAllDaq->setAdaptivePolling( true, m_minPollIntervalUs, m_maxPollIntervalUs );
       if( m_autoBuilding )
          autoBuild();
       if( m_doClearBuffer )
@@ -1072,7 +1218,8 @@ int CommandLine::onArgument( void )
       {
          assert( m_poAllDaq == nullptr );
          m_targetUrlGiven = true;
-         if( arg.find( "tcp/" ) == string::npos )
+         if( (arg.find( "tcp/" ) == string::npos) &&
+             !FeSupport::Scu::Etherbone::isSimulatorAddress( arg ) )
             arg = "tcp/" + arg;
 #if 0
          if( daq::isConcurrentProcessRunning( getProgramName(), arg ) )
@@ -99,6 +99,11 @@ class CommandLine: public PARSER
    uint                       m_throttleTimeout;
    uint                       m_maxEbCycleDataLen;
    uint                       m_blockReadEbCycleGapTimeUs;
+   uint                       m_drainBlockBudget;
+   uint                       m_acquisitionRingCapacity;
+   bool                       m_adaptivePolling;
+   uint                       m_minPollIntervalUs;
+   uint                       m_maxPollIntervalUs;
    uint                       m_distributeDataPollIntervall;
    uint                       m_distributeDataPollMaximum;
 
@@ -112,6 +117,7 @@ class CommandLine: public PARSER
    std::string                m_gnuplotTerminal;
    std::string                m_gnuplotOutput;
    std::string                m_gnuplotLineStyle;
+   std::string                m_recordFileName;
 
    static bool readInteger( uint&, const std::string& );
    static bool readFloat( float&, const std::string& );
@@ -165,6 +171,11 @@ public:
       return !m_gnuplotOutput.empty();
    }
 
+   const std::string& getRecordFileName( void ) const
+   {
+      return m_recordFileName;
+   }
+
    bool isAutoBuilding( void ) const
    {
       return m_autoBuilding;
@@ -242,6 +253,20 @@ public:
       return m_distributeDataPollMaximum;
    }
 
+   /*!
+    * @brief Returns the capacity of the tuple hand-off ring per channel,
+    *        a value of zero means the threaded mode is disabled.
+    */
+   uint getAcquisitionRingCapacity( void ) const
+   {
+      return m_acquisitionRingCapacity;
+   }
+
+   bool isThreaded( void ) const
+   {
+      return m_acquisitionRingCapacity != 0;
+   }
+
 protected:
    int onErrorUnrecognizedShortOption( char unrecognized ) override;
    int onErrorUnrecognizedLongOption( const std::string& unrecognized ) override;
@@ -79,7 +79,7 @@ void onUexpectedException( void )
 /*! ---------------------------------------------------------------------------
  */
 FbChannel::FbChannel( uint iterfaceAddress )
-   :FgFeedbackTuple(iterfaceAddress )
+   :FgFeedbackBlock(iterfaceAddress )
    ,m_pPlot( nullptr )
    ,m_startTime( 0 )
    ,m_lastTime( 0 )
@@ -91,6 +91,7 @@ FbChannel::FbChannel( uint iterfaceAddress )
    ,m_iterator(m_aPlotList.begin())
    ,m_singleShoot( false )
    ,m_callCount( 0 )
+   ,m_recordChannel( -1 )
 {
    reset();
 }
@@ -235,23 +236,61 @@ void FbChannel::addItem( const uint64_t time,
 }
 
 /*! ---------------------------------------------------------------------------
- * @dotfile fg-feedback.gv
+ * @brief Writes the tuples in the record file, the channel becomes
+ *        registered by the recorder at its first tuple.
  */
-void FbChannel::onData( TUPLE_T oTuple )
+void FbChannel::record( const TIMESTAMP_SPAN_T& rTimestamps,
+                        const DAQ_SPAN_T& rActValues,
+                        const DAQ_SPAN_T& rSetValues )
 {
-   m_callCount++;
+   daq::DaqRecorder* pRecorder = getAdministration()->getRecorder();
+   if( m_recordChannel < 0 )
+   {
+      m_recordChannel = pRecorder->addChannel( daq::DAQ_REC_KIND_FEEDBACK,
+                           daq::makeRecordFgName( getSocket(), getFgNumber() ) );
+   }
+   for( std::size_t i = 0; i < rTimestamps.size(); i++ )
+   {
+      pRecorder->writeTuple( m_recordChannel, rTimestamps[i],
+                             rActValues[i], rSetValues[i] );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FbChannel::onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                             const DAQ_SPAN_T& rActValues,
+                             const DAQ_SPAN_T& rSetValues )
+{
+   if( getAdministration()->getRecorder() != nullptr )
+      record( rTimestamps, rActValues, rSetValues );
 
    if( m_pPlot == nullptr )
    {
+      m_callCount += rTimestamps.size();
    #ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
       if( getCommandLine()->isMakeStatistic() )
          return;
    #endif
-      getAdministration()->getTupleStatistics()->add( this, oTuple );
+      getAdministration()->getTupleStatistics()->add( this, rTimestamps,
+                                                      rActValues, rSetValues );
       return;
    }
 
-   m_currentTime = oTuple.m_timestamp;
+   for( std::size_t i = 0; i < rTimestamps.size(); i++ )
+      plotTuple( rTimestamps[i], rActValues[i], rSetValues[i] );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @dotfile fg-feedback.gv
+ */
+void FbChannel::plotTuple( const uint64_t timestamp,
+                           const DAQ_T actValue,
+                           const DAQ_T setValue )
+{
+   m_callCount++;
+
+   m_currentTime = timestamp;
    if( m_state != START )
    {
       uint64_t timeinterval = m_currentTime - m_lastTime;
@@ -284,7 +323,7 @@ void FbChannel::onData( TUPLE_T oTuple )
             m_startTime = m_currentTime;
             if( getCommandLine()->isContinuePlottingEnabled() )
                m_timeToPlot = m_currentTime + getPlotIntervalTime();
-            addItem( 0, oTuple.m_actValue, oTuple.m_setValue, !isSetValueInvalid() );
+            addItem( 0, actValue, setValue, !isSetValueInvalid() );
             m_minTime = static_cast<uint64_t>(~0);
             m_maxTime = 0;
             m_callCount++;
@@ -298,7 +337,7 @@ void FbChannel::onData( TUPLE_T oTuple )
             {
                FSM_TRANSITION_NEXT( PLOT, color = green );
             }
-            addItem( plotTime, oTuple.m_actValue, oTuple.m_setValue, !isSetValueInvalid() );
+            addItem( plotTime, actValue, setValue, !isSetValueInvalid() );
             if( getCommandLine()->isContinuePlottingEnabled() &&
                 (m_currentTime >= m_timeToPlot) )
             {
@@ -325,8 +364,8 @@ void FbChannel::onData( TUPLE_T oTuple )
    }
    while( next );
 
-   m_lastSetRawValue = oTuple.m_setValue;
-   m_lastActRawValue = oTuple.m_actValue;
+   m_lastSetRawValue = setValue;
+   m_lastActRawValue = actValue;
    m_lastTime = m_currentTime;
 }
 
@@ -382,6 +421,7 @@ AllDaqAdministration::AllDaqAdministration( CommandLine* m_poCommandLine,
    :FgFeedbackAdministration( DaqEb::EtherboneConnection::getInstance( ebAddress ) )
    ,m_poCommandLine( m_poCommandLine )
    ,m_poTupleStatistics( nullptr )
+   ,m_poRecorder( nullptr )
 #ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
    ,m_oStatistics( this )
 #endif
@@ -396,6 +436,20 @@ AllDaqAdministration::~AllDaqAdministration( void )
 {
    vector<Device*>    vDevices;
 
+   if( m_poRecorder != nullptr )
+   {
+      setRecorder( nullptr );
+      try
+      {
+         m_poRecorder->close();
+      }
+      catch( std::exception& e )
+      {
+         ERROR_MESSAGE( e.what() );
+      }
+      delete m_poRecorder;
+   }
+
    for( const auto& i: *this )
    {
       vDevices.push_back( static_cast<Device*>(i) );
@@ -411,6 +465,20 @@ AllDaqAdministration::~AllDaqAdministration( void )
    DaqEb::EtherboneConnection::releaseInstance( getEbAccess()->getEbPtr() );
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void AllDaqAdministration::startRecording( const std::string& rFileName )
+{
+   assert( m_poRecorder == nullptr );
+   m_poRecorder = new daq::DaqRecorder( rFileName, "fg-feedback " +
+                                        getEbAccess()->getNetAddress() );
+   /*
+    * Besides the feedback tuples the raw DAQ data becomes recorded as well,
+    * so the recording can be replayed via "sim://replay=<file>".
+    */
+   setRecorder( m_poRecorder );
+}
+
 /*! ---------------------------------------------------------------------------
  */
 void AllDaqAdministration::setSingleShoot( bool enable )
@@ -569,6 +637,15 @@ int fbMain( int argc, char** ppArgv )
       uint intervalTime = 0;
       uint remainingData = 0;
 
+      if( cmdLine.isThreaded() )
+      {
+         pDaqAdmin->startAcquisition( cmdLine.getAcquisitionRingCapacity() );
+         if( cmdLine.isVerbose() )
+            cout << "Threaded mode with "
+                 << cmdLine.getAcquisitionRingCapacity()
+                 << " tuples per channel" << endl;
+      }
+
       while( ((key = Terminal::readKey()) != '\e') && !repeat )
       {
          switch( key )
@@ -629,6 +706,11 @@ int fbMain( int argc, char** ppArgv )
                   cout << "Restart..." << endl;
                break;
             }
+            case HOT_KEY_SHOW_HISTOGRAM:
+            {
+               WbHistogram::get().snapshot().print( cout );
+               break;
+            }
          #ifdef CONFIG_EB_TIME_MEASSUREMENT
             case HOT_KEY_SHOW_TIMING:
             {
@@ -672,21 +754,32 @@ int fbMain( int argc, char** ppArgv )
             {
                try
                {
-                  do
+                  if( cmdLine.isThreaded() )
+                  { /*
+                     * The etherbone readout runs in the acquisition thread,
+                     * here the received tuples becomes delivered only.
+                     */
+                     pDaqAdmin->dispatchData();
+                  }
+                  else
                   {
-                     remainingData = pDaqAdmin->distributeData();
-                     ::usleep( 1000 );
-                     maximum++;
-                     /*!
-                      * @todo Replace the fixed number of 1000 by a calculated mamber with the FiFo-size.
-                      */
-                     if( maximum >= cmdLine.getDistributeDataPollMaximum() )
+                     do
                      {
-                        ERROR_MESSAGE( "Maximum of consecutive call of distributeData() exceedet!" );
-                        break;
+                        remainingData = pDaqAdmin->distributeData();
+                        if( !pDaqAdmin->isAdaptivePolling() )
+                           ::usleep( 1000 );
+                        maximum++;
+                        /*!
+                         * @todo Replace the fixed number of 1000 by a calculated mamber with the FiFo-size.
+                         */
+                        if( maximum >= cmdLine.getDistributeDataPollMaximum() )
+                        {
+                           ERROR_MESSAGE( "Maximum of consecutive call of distributeData() exceedet!" );
+                           break;
+                        }
                      }
+                     while( remainingData != 0 );
                   }
-                  while( remainingData != 0 );
                }
                catch( daq::DaqException& e )
                {
@@ -705,10 +798,23 @@ int fbMain( int argc, char** ppArgv )
             }
             pDaqAdmin->getTupleStatistics()->print();
             if( cmdLine.isVerbose() )
-                std::cout << ESC_CLR_LINE "Maximum: " << maximum << " " << std::endl;
+            {
+                std::cout << ESC_CLR_LINE "Maximum: " << maximum << " ";
+                if( cmdLine.isThreaded() )
+                   std::cout << "Dropped: " << pDaqAdmin->getOverflowCount() << " ";
+                std::cout << std::endl;
+            }
          }
-         ::usleep( 1000 );
+         /*
+          * In adaptive mode the waiting time becomes limited to 1/10 second
+          * in order to keep the keyboard responsive.
+          */
+         const uint delay = ( pDaqAdmin->isAdaptivePolling() && !cmdLine.isThreaded() )?
+                            std::min( pDaqAdmin->getPollDelayUs(), daq::MICROSECS_PER_SEC / 10 ) : 1000;
+         if( delay != 0 )
+            ::usleep( delay );
       }
+      pDaqAdmin->stopAcquisition();
       DEBUG_MESSAGE( "Loop left" );
    }
    while( repeat );
@@ -34,6 +34,7 @@
  #include <daq_eb_ram_buffer.hpp>
  #include <daq_calculations.hpp>
  #include <fb_command_line.hpp>
+ #include <daq_recorder.hpp>
  #ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
    #include <daq_statistics.hpp>
  #endif
@@ -60,6 +61,9 @@
 #ifndef HOT_KEY_CLEAR_BUFFER
   #define HOT_KEY_CLEAR_BUFFER        'c'
 #endif
+#ifndef HOT_KEY_SHOW_HISTOGRAM
+  #define HOT_KEY_SHOW_HISTOGRAM      'w'
+#endif
 #if defined( CONFIG_EB_TIME_MEASSUREMENT ) && !defined( HOT_KEY_SHOW_TIMING )
   #define HOT_KEY_SHOW_TIMING         't'
 #endif
@@ -86,7 +90,7 @@ class CommandLine;
 class AllDaqAdministration;
 class TupleStatistics;
 //////////////////////////////////////////////////////////////////////////////
-class FbChannel: public FgFeedbackTuple
+class FbChannel: public FgFeedbackBlock
 {
    friend class Plot;
    constexpr static uint64_t c_minimumPlotInterval = daq::NANOSECS_PER_SEC / 10;
@@ -127,7 +131,13 @@ class FbChannel: public FgFeedbackTuple
    PLOT_LIST_T::iterator m_iterator;
    bool                  m_singleShoot;
    uint                  m_callCount;
-   
+
+   /*!
+    * @brief Channel number of the recorder, negative if this channel
+    *        isn't registered by the recorder yet.
+    */
+   int                   m_recordChannel;
+
 public:
    FbChannel( uint iterfaceAddress );
    virtual ~FbChannel( void );
@@ -179,7 +189,17 @@ private:
    void onActSetTimestampDeviation( const uint64_t setTimeStamp,
                                     const uint64_t actTimestamp ) override;
 
-   void onData( TUPLE_T oTuple ) override;
+   void onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                     const DAQ_SPAN_T& rActValues,
+                     const DAQ_SPAN_T& rSetValues ) override;
+
+   void record( const TIMESTAMP_SPAN_T& rTimestamps,
+                const DAQ_SPAN_T& rActValues,
+                const DAQ_SPAN_T& rSetValues );
+
+   void plotTuple( const uint64_t timestamp,
+                   const DAQ_T actValue,
+                   const DAQ_T setValue );
 
    void addItem( const uint64_t time,
                  const DAQ_T actValue,
@@ -229,6 +249,7 @@ class AllDaqAdministration: public FgFeedbackAdministration
 
    CommandLine*      m_poCommandLine;
    TupleStatistics*  m_poTupleStatistics;
+   daq::DaqRecorder* m_poRecorder;
 
 #ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
    daq::Statistics m_oStatistics;
@@ -255,6 +276,22 @@ public:
       assert( m_poTupleStatistics != nullptr );
       return m_poTupleStatistics;
    }
+
+   /*!
+    * @brief Starts the recording of all incoming feedback tuples
+    *        in the given file.
+    * @see daq::DaqRecorder
+    */
+   void startRecording( const std::string& rFileName );
+
+   /*!
+    * @brief Returns the pointer to the recorder respectively nullptr
+    *        when the recording isn't active.
+    */
+   daq::DaqRecorder* getRecorder( void )
+   {
+      return m_poRecorder;
+   }
 //TODO  void onUnregistered( RingItem* pUnknownItem )  override;
 
 #ifdef CONFIG_USE_ADDAC_DAQ_BLOCK_STATISTICS
@@ -24,9 +24,16 @@
  * License along with this library. If not, see <http://www.gnu.org/licenses/>.
  ******************************************************************************
  */
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <algorithm>
 #include <scu_env.hpp>
 #include <message_macros.hpp>
 #include <scu_ddr3_access.hpp>
+#include <scu_wb_histogram.hpp>
 #include <daq_calculations.hpp>
 #include "logd_cmdline.hpp"
 
@@ -38,6 +45,38 @@ using namespace Scu;
 #define DEFAULT_MAX_ITEMS            100
 #define DEFAULT_MAX_ITEMS_IN_MEMORY 1000
 #define DEFAULT_TARGET              "/var/log/lm32.log"
+#define DEFAULT_FORMAT_CACHE_PREFIX "/tmp/lm32-logd_"
+#define DEFAULT_FORMAT_CACHE_SUFFIX ".fmtcache"
+
+/*! ---------------------------------------------------------------------------
+ * @brief Creates the private directory of the effective user for the
+ *        default format cache, if not already present.
+ * @retval true Directory is present, belongs to the effective user and is
+ *              not accessible by others.
+ * @retval false Directory is not trustworthy.
+ */
+static bool makePrivateDirectory( const std::string& rDir )
+{
+   if( (::mkdir( rDir.c_str(), S_IRWXU ) != 0) && (errno != EEXIST) )
+   {
+      ERROR_MESSAGE( "Unable to create directory \"" << rDir << "\": "
+                     << ::strerror( errno ) );
+      return false;
+   }
+
+   struct stat oStat;
+   if( ::lstat( rDir.c_str(), &oStat ) != 0 )
+      return false;
+
+   if( !S_ISDIR( oStat.st_mode ) || (oStat.st_uid != ::geteuid()) ||
+       ((oStat.st_mode & (S_IRWXG | S_IRWXO)) != 0) )
+   {
+      ERROR_MESSAGE( "Directory \"" << rDir << "\" is not a private directory"
+                     " of this user!" );
+      return false;
+   }
+   return true;
+}
 
 /*! ---------------------------------------------------------------------------
  * @brief Initializing the command line options.
@@ -266,9 +305,11 @@ CommandLine::OPT_LIST_T CommandLine::c_optList =
       .m_id       = 0,
       .m_shortOpt = 'I',
       .m_longOpt  = "interval",
-      .m_helpText = "PARAM=\"<new poll interval in milliseconds>\"\n"
-                    "Overwrites the default interval of " TO_STRING( DEFAULT_INTERVAL )
-                    " milliseconds."
+      .m_helpText = "PARAM=\"<new maximum poll interval in milliseconds>\"\n"
+                    "Overwrites the default maximum interval of " TO_STRING( DEFAULT_INTERVAL )
+                    " milliseconds.\n"
+                    "The poll interval becomes shortened automatically down to one"
+                    " millisecond when the fill level of the FiFo rises."
    },
    {
       OPT_LAMBDA( poParser,
@@ -377,12 +418,11 @@ CommandLine::OPT_LIST_T CommandLine::c_optList =
       .m_id       = 0,
       .m_shortOpt = 'm',
       .m_longOpt  = "maxitems",
-      .m_helpText = "PARAM=\"<number of maximum message-items per interval>\"\n"
-                    "Overwrites the default number of maximum items per interval of "
+      .m_helpText = "PARAM=\"<number of maximum message-items per etherbone-cycle>\"\n"
+                    "Overwrites the default number of maximum items per etherbone-cycle of "
                     TO_STRING(DEFAULT_MAX_ITEMS) " with a new value.\n"
-                    "That means, this is the maximum number of log-items which becomes\n"
-                    "read out and evaluated per poll interval.\n"
-                    "It determines also the length of the ehterbone-cycle.\n"
+                    "Per poll interval the whole FiFo becomes read out, by several\n"
+                    "etherbone-cycles if necessary.\n"
                     "The poll interval can be adjusted by the option -I respectively --interval."
    },
    {
@@ -431,6 +471,68 @@ CommandLine::OPT_LIST_T CommandLine::c_optList =
                     "If the DDR3-RAM is not involved in the data transfer,"
                     " then this option has no effect."
    },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::showAtExit( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::OPTIONAL_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "wb-histogram",
+      .m_helpText = "Prints the latency histograms of all wishbone accesses"
+                    " at the end of the program.\n"
+                    "PARAM: =<file name>\n"
+                    "If PARAM is given, then the histograms becomes written in"
+                    " JSON-lines format in this file instead, e.g. for offline"
+                    " comparison of several runs."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::get().setEnabled( false );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "no-wb-histogram",
+      .m_helpText = "Switches the recording of the latency histograms of the"
+                    " wishbone accesses off."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<CommandLine*>(poParser)->m_formatCacheFile = poParser->getOptArg();
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "format-cache",
+      .m_helpText = "PARAM specifies the file in which the format strings of the"
+                    " LM32- application becomes cached across restarts of this"
+                    " daemon.\n"
+                    "The cache becomes rebuilt automatically when the build-ID"
+                    " of the LM32- application has been changed.\n"
+                    "The default is: " DEFAULT_FORMAT_CACHE_PREFIX "<UID>/<SCU-name>"
+                    DEFAULT_FORMAT_CACHE_SUFFIX "\n"
+                    "The directory becomes created accessible for the user only."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<CommandLine*>(poParser)->m_noFormatCache = true;
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "no-format-cache",
+      .m_helpText = "The format strings will not stored in a file, they becomes"
+                    " cached in the memory only."
+   },
    {
       OPT_LAMBDA( poParser,
       {
@@ -537,6 +639,7 @@ CommandLine::CommandLine( int argc, char** ppArgv )
    ,m_readBuildId( false )
    ,m_doReset( false )
    ,m_timeInUtc( false )
+   ,m_noFormatCache( false )
    ,m_interval( DEFAULT_INTERVAL )
    ,m_maxItemsPerInterval( DEFAULT_MAX_ITEMS )
    ,m_burstLimit( Ddr3Access::NEVER_BURST )
@@ -583,7 +686,8 @@ int CommandLine::onArgument( void )
    }
 
    m_scuUrl = getArgVect()[getArgIndex()];
-   if( m_scuUrl.find( "tcp/" ) == string::npos )
+   if( (m_scuUrl.find( "tcp/" ) == string::npos) &&
+       !FeSupport::Scu::Etherbone::isSimulatorAddress( m_scuUrl ) )
          m_scuUrl = "tcp/" + m_scuUrl;
 
    return 1;
@@ -603,6 +707,33 @@ std::string& CommandLine::operator()( void )
       ::exit( EXIT_FAILURE );
    }
 
+   if( m_noFormatCache )
+   {
+      m_formatCacheFile.clear();
+   }
+   else if( m_formatCacheFile.empty() )
+   {
+      std::string scuName = m_scuUrl.substr( m_scuUrl.find_first_of( '/' ) + 1 );
+      std::replace( scuName.begin(), scuName.end(), '/', '_' );
+      const std::string dir = DEFAULT_FORMAT_CACHE_PREFIX + to_string( ::geteuid() );
+      if( makePrivateDirectory( dir ) )
+         m_formatCacheFile = dir + '/' + scuName + DEFAULT_FORMAT_CACHE_SUFFIX;
+      else
+         WARNING_MESSAGE( "Format strings becomes cached in the memory only!" );
+   }
+   else if( m_formatCacheFile[0] != '/' )
+   { /*
+      * The daemon changes in the root directory,
+      * therefore a relative file name has to be made absolute.
+      */
+      char* pCwd = ::getcwd( nullptr, 0 );
+      if( pCwd != nullptr )
+      {
+         m_formatCacheFile = std::string( pCwd ) + '/' + m_formatCacheFile;
+         ::free( pCwd );
+      }
+   }
+
    if( m_humanTimestamp && m_noTimestamp )
       WARNING_MESSAGE( "Timestamp will not printed, therefore"
                        " the option for human readable timestamp"
@@ -58,6 +58,7 @@ private:
    bool          m_readBuildId;
    bool          m_doReset;
    bool          m_timeInUtc;
+   bool          m_noFormatCache;
    uint          m_interval;
    uint          m_maxItemsPerInterval;
    int           m_burstLimit;
@@ -66,6 +67,7 @@ private:
    FILTER_FLAG_T m_filterFlags;
    std::string   m_scuUrl;
    std::string   m_logFile;
+   std::string   m_formatCacheFile;
 
    static int readInteger( const std::string& );
 
@@ -195,6 +197,15 @@ public:
       return m_localTimeOffset;
    }
 
+   /*!
+    * @brief Returns the absolute file name of the persistent cache of the
+    *        format strings, if empty then the cache will not stored.
+    */
+   std::string& getFormatCacheFile( void )
+   {
+      return m_formatCacheFile;
+   }
+
 private:
    int onArgument( void ) override;
    int onErrorUnrecognizedShortOption( char unrecognized ) override;
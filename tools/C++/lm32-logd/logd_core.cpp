@@ -27,7 +27,13 @@
  #include <iomanip>
  #include <iostream>
  #include <sstream>
+ #include <vector>
  #include <syslog.h>
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <unistd.h>
+ #include <limits.h>
+ #include <sys/uio.h>
  #include <scu_mmu_tag.h>
  #include <daq_calculations.hpp>
  #include <message_macros.hpp>
@@ -69,6 +75,21 @@ using namespace std;
 
 constexpr uint BUILD_ID_ADDR = Lm32Access::OFFSET + 0x100;
 
+/*!
+ * @brief Maximum number of 32-bit words of the LM32 memory which becomes
+ *        read within a single etherbone cycle.
+ */
+constexpr uint LM32_BURST_WORDS = 256;
+
+/*!
+ * @brief Number of bytes per etherbone cycle for reading strings which
+ *        are not in the format cache, e.g. arguments of "%s".
+ */
+constexpr uint LM32_STRING_CHUNK = 64;
+
+static_assert( (LM32_STRING_CHUNK % sizeof(uint32_t)) == 0, "" );
+static_assert( (BUILD_ID_ADDR % sizeof(uint32_t)) == 0, "" );
+
 static_assert( EB_DATA32 == sizeof(uint32_t), "" );
 
 
@@ -118,29 +139,16 @@ int Lm32Logd::StringBuffer::sync( void )
       selfMessage << "ERROR: lm32-logd self: ";
    }
 
-   if( m_rParent.m_rCmdLine.isDemonize() )
-   {
-      if( m_rParent.m_logfile.is_open() )
-      {
-         if( m_rParent.m_isError )
-            m_rParent.m_logfile << selfMessage.str() << str() << std::endl;
-         else
-            m_rParent.m_logfile << str() << std::flush;
-      }
-      else if( m_rParent.m_isSyslogOpen )
-      {
-         if( m_rParent.m_isError )
-            ::syslog( LOG_ERR, "%s%s", selfMessage.str().c_str(), str().c_str() );
-         else
-            ::syslog( LOG_NOTICE, "%s", str().c_str() );
-      }
-   }
-   else
-   {
-      if( m_rParent.m_isError )
-         ERROR_MESSAGE( selfMessage.str() << str() );
-      else
-         std::cout << str() << std::flush;
+   if( !str().empty() || m_rParent.m_isError )
+   { /*
+      * The output becomes made by the writer stage,
+      * so it will not mixed with the log items.
+      */
+      OUTPUT_T output;
+      output.m_vLines.push_back( selfMessage.str() + str() );
+      output.m_items   = 0;
+      output.m_isError = m_rParent.m_isError;
+      m_rParent.post( std::move( output ) );
    }
    str("");
    m_rParent.m_isError = false;
@@ -151,12 +159,28 @@ int Lm32Logd::StringBuffer::sync( void )
 /*!
  * @brief Macro for log-messages which concerns the log-daemon self.
  */
-#define LOG_SELF( msg... )           \
-{                                    \
-    setError();                      \
-    *this << msg << std::flush;      \
+#define LOG_SELF( msg... )                                            \
+{                                                                     \
+    std::lock_guard<std::recursive_mutex> _lock( m_oStreamMutex );   \
+    setError();                                                       \
+    *this << msg << std::flush;                                       \
 }
 
+/*!
+ * @brief Minimum poll interval of the DDR3-FiFo in microseconds.
+ */
+constexpr uint MIN_POLL_INTERVAL_US = 1000;
+
+/*!
+ * @brief Maximum number of item batches between reader and formatting stage.
+ */
+constexpr std::size_t ITEM_QUEUE_CAPACITY = 16;
+
+/*!
+ * @brief Maximum number of outputs between formatting and writer stage.
+ */
+constexpr std::size_t OUTPUT_QUEUE_CAPACITY = 64;
+
 /*! ---------------------------------------------------------------------------
  */
 Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
@@ -165,12 +189,22 @@ Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
    ,m_rCmdLine( rCmdLine )
    ,m_oMmu( poRam )
    ,m_oLm32( m_oMmu.getEb() )
+   ,m_oFormatCache( rCmdLine.getFormatCacheFile() )
    ,m_lastTimestamp( 0 )
    ,m_isError( false )
    ,m_isSyslogOpen( false )
-   ,m_pMiddleBuffer( nullptr )
+   ,m_ringProtocol( RING_PROTOCOL_T::LEGACY )
+   ,m_ringRequestPending( true )
+   ,m_oRingClient()
+   ,m_logfile( -1 )
    ,m_poTerminal( nullptr )
    ,m_taiToUtcOffset( 0 )
+   ,m_oItemQueue( ITEM_QUEUE_CAPACITY )
+   ,m_oOutputQueue( OUTPUT_QUEUE_CAPACITY )
+   ,m_pipelineRunning( false )
+   ,m_pipelineFailed( false )
+   ,m_counters()
+   ,m_oScheduler( MIN_POLL_INTERVAL_US, rCmdLine.getPollInterwalTime() * 1000 )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
 
@@ -185,8 +219,9 @@ Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
       else
       {
          DEBUG_MESSAGE( "Opening file: " << m_rCmdLine.getLogfileName() );
-         m_logfile.open( m_rCmdLine.getLogfileName(), ios::out | ios::app  );
-         if( !m_logfile.is_open() )
+         m_logfile = ::open( m_rCmdLine.getLogfileName().c_str(),
+                             O_WRONLY | O_APPEND | O_CREAT, 0644 );
+         if( m_logfile < 0 )
          {
             string msg = "Unable to open ";
             msg += m_rCmdLine.getLogfileName();
@@ -200,11 +235,18 @@ Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
       m_poTerminal = new Terminal;
    }
 
+   /*
+    * The build-ID is the key of the format cache,
+    * therefore it becomes read in any cases.
+    */
+   std::string rawBuildId;
+   fetchStringFromLm32( rawBuildId, BUILD_ID_ADDR );
+
    if( m_rCmdLine.isReadBuildId() || m_rCmdLine.isAddBuildId() )
    {
       std::string idStr;
 
-      readStringFromLm32( idStr, BUILD_ID_ADDR, true );
+      appendFiltered( idStr, rawBuildId, true );
       if( m_rCmdLine.isReadBuildId() )
       {
          cout << idStr << endl;
@@ -219,6 +261,17 @@ Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
       *this << idStr << std::flush;
    }
 
+   if( m_oFormatCache.load( rawBuildId ) )
+   {
+      if( m_rCmdLine.isVerbose() )
+         cout << m_oFormatCache.size() << " format strings loaded from: \""
+              << m_oFormatCache.getFileName() << '"' << endl;
+   }
+   else
+   {
+      prefetchLm32();
+   }
+
    if( !m_rCmdLine.isNoTimestamp() && (m_rCmdLine.isUtc() || (m_rCmdLine.getLocalTimeOffset() != 0)) )
    {
    #ifdef CONFIG_USE_SAFTLIB_MODULE_FOR_TAI_TO_UTC
@@ -353,10 +406,11 @@ Lm32Logd::Lm32Logd( RamAccess* poRam, CommandLine& rCmdLine )
 Lm32Logd::~Lm32Logd( void )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
-   if( m_pMiddleBuffer != nullptr )
+   stopPipeline();
+   if( m_logfile >= 0 )
    {
-      DEBUG_MESSAGE( "Deleting reserved memory for middle buffer." );
-      delete[] m_pMiddleBuffer;
+      DEBUG_MESSAGE( "Closing log file." );
+      ::close( m_logfile );
    }
    if( m_poTerminal != nullptr )
    {
@@ -424,6 +478,23 @@ void Lm32Logd::write( const uint index,
    }
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::execute( EtherboneAccess::EB_BATCH_T& rBatch )
+{
+   assert( m_oMmu.getEb()->isConnected() );
+   try
+   {
+      m_oMmu.getRamAccess()->execute( rBatch );
+   }
+   catch( std::exception& e )
+   {
+      if( m_rCmdLine.isDemonize() )
+         LOG_SELF( e.what() )
+      throw;
+   }
+}
+
 /*! ---------------------------------------------------------------------------
  */
 int Lm32Logd::readKey( void )
@@ -490,14 +561,25 @@ void Lm32Logd::resetFiFo( void )
 
    SYSLOG_FIFO_ADMIN_T fifoAdmin;
 
+   /*
+    * The capability word published by the LM32 has to be preserved.
+    */
+   read( m_fifoAdminBase, reinterpret_cast<uint64_t*>(&fifoAdmin),
+         sizeof(SYSLOG_FIFO_ADMIN_T) / sizeof(uint64_t) );
+
    fifoAdmin.admin.indexes.offset   = m_offset;
    fifoAdmin.admin.indexes.capacity = m_capacity;
    ramRingReset( &fifoAdmin.admin.indexes );
    fifoAdmin.admin.wasRead = 0;
-   fifoAdmin.__padding__ = 0;
 
    write( m_fifoAdminBase, reinterpret_cast<uint64_t*>(&fifoAdmin),
           sizeof(SYSLOG_FIFO_ADMIN_T) / sizeof(uint64_t) );
+
+   /*
+    * The reset falls back to the legacy protocol.
+    */
+   m_ringProtocol       = RING_PROTOCOL_T::LEGACY;
+   m_ringRequestPending = true;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -514,22 +596,153 @@ void Lm32Logd::setResponse( uint64_t n )
         );
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::setResponse( EtherboneAccess::EB_BATCH_T& rBatch, uint64_t n )
+{
+   DEBUG_MESSAGE_M_FUNCTION( n );
+   static_assert( offsetof( SYSLOG_FIFO_ADMIN_T, admin.wasRead ) % sizeof( SYSLOG_MEM_ITEM_T ) == 0, "" );
+
+   m_oMmu.getRamAccess()->write( rBatch,
+                                 m_fifoAdminBase +
+                                    offsetof( SYSLOG_FIFO_ADMIN_T, admin.wasRead ) / sizeof( SYSLOG_MEM_ITEM_T ),
+                                 &n,
+                                 1
+                               );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool Lm32Logd::updateRingProtocol( SYSLOG_FIFO_ADMIN_T& rAdmin )
+{
+   switch( m_ringProtocol )
+   {
+      case RING_PROTOCOL_T::REQUESTED:
+      {
+         if( ramRingSharedIsDirectRequest( &rAdmin.admin ) )
+         { /*
+            * LM32 has not answered yet, that happens at its next log message.
+            */
+            return false;
+         }
+         if( ramRingSharedIsDirect( &rAdmin.admin ) )
+         {
+            ramRingClientInit( &m_oRingClient, &rAdmin.admin, nullptr );
+            m_ringProtocol  = RING_PROTOCOL_T::DIRECT;
+            break;
+         }
+         /*
+          * Legacy LM32 firmware has cleared the request.
+          */
+         DEBUG_MESSAGE( "LM32 supports the legacy FiFo handshake only." );
+         m_ringProtocol = RING_PROTOCOL_T::LEGACY;
+         return rAdmin.admin.wasRead == 0;
+      }
+      case RING_PROTOCOL_T::DIRECT:
+      {
+         if( ramRingSharedIsDirect( &rAdmin.admin ) )
+            break;
+         /*
+          * FiFo has been reset, that falls back to the legacy protocol.
+          */
+         m_ringProtocol       = RING_PROTOCOL_T::LEGACY;
+         m_ringRequestPending = true;
+      } FALL_THROUGH
+      case RING_PROTOCOL_T::LEGACY:
+      {
+         if( ramRingSharedIsDirect( &rAdmin.admin ) )
+         { /*
+            * Direct protocol has been already negotiated by a previous
+            * session, continuing at the published read index.
+            */
+            ramRingClientInit( &m_oRingClient, &rAdmin.admin, nullptr );
+            m_ringProtocol  = RING_PROTOCOL_T::DIRECT;
+            break;
+         }
+         if( rAdmin.admin.wasRead != 0 )
+         { /*
+            * Last posted messages was not yet acknowledged by LM32,
+            * therefore there are no new messages present.
+            */
+            return false;
+         }
+         if( !m_ringRequestPending ||
+             (rAdmin.capabilities != RAM_RING_DIRECT_CAPABILITY) )
+            return true;
+         /*
+          * Requesting the direct protocol once and only from a LM32
+          * firmware which has published its support. A legacy firmware
+          * would add the request to the read index.
+          */
+         m_ringRequestPending = false;
+         m_ringProtocol       = RING_PROTOCOL_T::REQUESTED;
+         setResponse( ramRingSharedGetDirectRequest( &rAdmin.admin ) );
+         return false;
+      }
+   }
+
+   /*
+    * Direct protocol: Replacing the indexes of the LM32 by the own view.
+    */
+   RAM_RING_INDEXES_T view;
+   if( !ramRingClientGetView( &m_oRingClient, &view, &rAdmin.admin, nullptr ) )
+      m_counters.m_overruns++;
+   rAdmin.admin.indexes = view;
+   return true;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint64_t Lm32Logd::getResponse( const uint n )
+{
+   if( m_ringProtocol != RING_PROTOCOL_T::DIRECT )
+      return n;
+
+   ramRingSharedSetConsumerIndex( &m_fiFoAdmin.admin,
+                                  ramRingClientRelease( &m_oRingClient,
+                                                        &m_fiFoAdmin.admin.indexes,
+                                                        nullptr ) );
+   return m_fiFoAdmin.admin.wasRead;
+}
+
 /*! ---------------------------------------------------------------------------
  */
 uint Lm32Logd::readLm32( char* pData, std::size_t len, const std::size_t offset )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
    static_assert( sizeof( *pData ) == EB_DATA8, "" );
+   assert( (offset % sizeof( uint32_t )) == 0 );
+   assert( (len % sizeof( uint32_t )) == 0 );
 
-   if( (offset-Lm32Access::OFFSET + len) >= Lm32Access::MEM_SIZE )
+   if( (offset-Lm32Access::OFFSET + len) > Lm32Access::MEM_SIZE )
    {
       DEBUG_MESSAGE( "End of memory, can't read full length of: " << len );
       len -= (offset-Lm32Access::OFFSET + len) - Lm32Access::MEM_SIZE;
    }
 
+   /*
+    * Reading in 32-bit words, that needs the quarter of wishbone cycles
+    * compared to a reading byte by byte.
+    */
+   uint32_t buffer[LM32_BURST_WORDS];
    try
    {
-      m_oLm32.read( offset, pData, len );
+      for( std::size_t i = 0; i < len; )
+      {
+         std::size_t words = (len - i) / sizeof( uint32_t );
+         if( words > ARRAY_SIZE( buffer ) )
+            words = ARRAY_SIZE( buffer );
+         m_oLm32.read( offset + i, buffer, words );
+         for( std::size_t w = 0; w < words; w++ )
+         { /*
+            * LM32 is big endian.
+            */
+            pData[i++] = static_cast<char>( buffer[w] >> 24 );
+            pData[i++] = static_cast<char>( buffer[w] >> 16 );
+            pData[i++] = static_cast<char>( buffer[w] >> 8 );
+            pData[i++] = static_cast<char>( buffer[w] );
+         }
+      }
    }
    catch( std::exception& e )
    {
@@ -540,6 +753,60 @@ uint Lm32Logd::readLm32( char* pData, std::size_t len, const std::size_t offset
    return len;
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::prefetchLm32( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+   /*
+    * The boundaries of the read-only data are not known by the host,
+    * therefore the whole LM32 memory above the build-ID becomes read.
+    */
+   std::vector<char> image( Lm32Access::MAX_ADDR - BUILD_ID_ADDR );
+   image.resize( readLm32( image.data(), image.size(), BUILD_ID_ADDR ) );
+   m_oFormatCache.setImage( image, BUILD_ID_ADDR );
+
+   if( m_rCmdLine.isVerbose() )
+      cout << "LM32 memory prefetched for format strings." << endl;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::fetchStringFromLm32( std::string& rRaw, uint addr )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+
+   char buffer[LM32_STRING_CHUNK];
+   uint skip = addr % sizeof( uint32_t );
+   addr -= skip;
+   while( addr < Lm32Access::MAX_ADDR )
+   {
+      const uint len = readLm32( buffer, sizeof( buffer ), addr );
+      for( uint i = skip; i < len; i++ )
+      {
+         if( buffer[i] == '\0' )
+            return;
+         rRaw += buffer[i];
+      }
+      skip = 0;
+      addr += len;
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::readFormatString( std::string& rFormat, const uint addr )
+{
+   const std::string* pRaw = m_oFormatCache.find( addr );
+   if( pRaw == nullptr )
+   {
+      std::string raw;
+      fetchStringFromLm32( raw, addr );
+      pRaw = &m_oFormatCache.insert( addr, raw );
+   }
+   appendFiltered( rFormat, *pRaw, false );
+}
+
 /*! ---------------------------------------------------------------------------
  */
 inline bool Lm32Logd::isDecDigit( const char c )
@@ -562,6 +829,16 @@ uint Lm32Logd::readStringFromLm32( std::string& rStr, uint addr, const bool alwa
       throw std::runtime_error( errTxt );
    }
 
+   std::string raw;
+   fetchStringFromLm32( raw, addr );
+   return appendFiltered( rStr, raw, alwaysLinefeed );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint Lm32Logd::appendFiltered( std::string& rStr, const std::string& rRaw,
+                               const bool alwaysLinefeed )
+{
    enum STATE_T
    {
       FSM_DECLARE_STATE( NO_ESC,      color=blue ),
@@ -572,115 +849,109 @@ uint Lm32Logd::readStringFromLm32( std::string& rStr, uint addr, const bool alwa
    };
 
    FSM_INIT_FSM( NO_ESC, color=blue );
-   char buffer[16];
    uint ret = 0;
-   while( true )
+   for( const char c: rRaw )
    {
-      const uint len = readLm32( buffer, sizeof( buffer ), addr );
-      for( uint i = 0; i < len; i++ )
-      {
-         if( (buffer[i] == '\0') || (addr + i >= Lm32Access::MAX_ADDR) )
+      /*
+       * FSM for filtering out escape sequences if demanded.
+       */
+      bool next;
+      do
+      { /*
+         * Flag "next" becomes "true" within the macro FSM_TRANSITION_NEXT.
+         */
+         next = false;
+         switch( state )
          {
-            DEBUG_MESSAGE( "received string: \"" << rStr.substr(rStr.length()-ret) << "\"" );
-            return ret;
-         }
-         /*
-          * FSM for filtering out escape sequences if demanded.
-          */
-         bool next;
-         do
-         { /*
-            * Flag "next" becomes "true" within the macro FSM_TRANSITION_NEXT.
-            */
-            next = false;
-            switch( state )
+            case NO_ESC:
             {
-               case NO_ESC:
+               if( !m_rCmdLine.isForConsole() && !alwaysLinefeed )
                {
-                  if( !m_rCmdLine.isForConsole() && !alwaysLinefeed )
+                  if( (c == '\n') || (c == '\r') )
                   {
-                     if( (buffer[i] == '\n') || (buffer[i] == '\r') )
+                     if( c == '\n')
                      {
-                        if( buffer[i] == '\n')
-                        {
-                           rStr += ' ';
-                           ret++;
-                        }
-                        FSM_TRANSITION_SELF( color=blue );
-                     }
-                     if( (buffer[i] == '\e') && !m_rCmdLine.isAllowedEscSequences() )
-                     {
-                        FSM_TRANSITION( ESC_CHAR, color=green, label='Esc' );
+                        rStr += ' ';
+                        ret++;
                      }
+                     FSM_TRANSITION_SELF( color=blue );
+                  }
+                  if( (c == '\e') && !m_rCmdLine.isAllowedEscSequences() )
+                  {
+                     FSM_TRANSITION( ESC_CHAR, color=green, label='Esc' );
                   }
-                  rStr += buffer[i];
-                  ret++;
-                  FSM_TRANSITION_SELF();
                }
+               rStr += c;
+               ret++;
+               FSM_TRANSITION_SELF();
+            }
 
-               case ESC_CHAR:
-               {
-                  if( buffer[i] == '[' )
-                     FSM_TRANSITION( ESC_FIRST, label ='[' );
+            case ESC_CHAR:
+            {
+               if( c == '[' )
+                  FSM_TRANSITION( ESC_FIRST, label ='[' );
 
-                  FSM_TRANSITION( NO_ESC );
-               }
+               FSM_TRANSITION( NO_ESC );
+            }
 
-               case ESC_FIRST:
-               {
-                  if( isDecDigit( buffer[i] ) )
-                     FSM_TRANSITION( ESC_DIGIT, label='0-9' );
+            case ESC_FIRST:
+            {
+               if( isDecDigit( c ) )
+                  FSM_TRANSITION( ESC_DIGIT, label='0-9' );
 
-                  FSM_TRANSITION_NEXT( ESC_OP_CODE );
-               }
+               FSM_TRANSITION_NEXT( ESC_OP_CODE );
+            }
 
-               case ESC_DIGIT:
-               {
-                  if( isDecDigit( buffer[i] ) )
-                     FSM_TRANSITION_SELF( label ='0-9');
+            case ESC_DIGIT:
+            {
+               if( isDecDigit( c ) )
+                  FSM_TRANSITION_SELF( label ='0-9');
 
-                  FSM_TRANSITION_NEXT( ESC_OP_CODE );
-               }
+               FSM_TRANSITION_NEXT( ESC_OP_CODE );
+            }
 
-               case ESC_OP_CODE:
-               {
-                  if( (buffer[i] == ';') || isDecDigit( buffer[i] ) )
-                     FSM_TRANSITION( ESC_DIGIT, label='0-9 or ;' );
+            case ESC_OP_CODE:
+            {
+               if( (c == ';') || isDecDigit( c ) )
+                  FSM_TRANSITION( ESC_DIGIT, label='0-9 or ;' );
 
-                  FSM_TRANSITION( NO_ESC );
-               }
+               FSM_TRANSITION( NO_ESC );
             }
          }
-         while( next );
       }
-      addr += len;
+      while( next );
    }
+   DEBUG_MESSAGE( "received string: \"" << rStr.substr(rStr.length()-ret) << "\"" );
+   return ret;
 }
 
 /*! ---------------------------------------------------------------------------
  */
-void Lm32Logd::readItems( SYSLOG_FIFO_ITEM_T* pData, const uint len )
+void Lm32Logd::readItems( EtherboneAccess::EB_BATCH_T& rBatch,
+                          SYSLOG_FIFO_ITEM_T* pData, const uint len )
 {
    DEBUG_MESSAGE_M_FUNCTION( " len = " << len );
    DEBUG_MESSAGE( "Read-index: " << sysLogFifoGetReadIndex( &m_fiFoAdmin ) );
 
-   read( sysLogFifoGetReadIndex( &m_fiFoAdmin ),
-         reinterpret_cast<uint64_t*>(pData),
-         len * sizeof(SYSLOG_MEM_ITEM_T) / sizeof(uint64_t) );
+   m_oMmu.getRamAccess()->read( rBatch,
+                                sysLogFifoGetReadIndex( &m_fiFoAdmin ),
+                                reinterpret_cast<uint64_t*>(pData),
+                                len * sizeof(SYSLOG_MEM_ITEM_T) / sizeof(uint64_t) );
 
    sysLogFifoAddToReadIndex( &m_fiFoAdmin, len );
 }
 
 /*! ---------------------------------------------------------------------------
  */
-void Lm32Logd::readItems( void )
+uint Lm32Logd::readItems( ITEM_BATCH_T& rItems, uint& rRemaining )
 {
  //  DEBUG_MESSAGE_M_FUNCTION("");
 
+   rRemaining = 0;
    SYSLOG_FIFO_ADMIN_T fifoAdmin;
 
    updateFiFoAdmin( fifoAdmin );
-   if( fifoAdmin.admin.wasRead != 0 )
+   if( !updateRingProtocol( fifoAdmin ) )
    { /*
       * Last posted messages was not yet acknowledged by LM32,
       * therefore there are no new messages present.
@@ -689,15 +960,18 @@ void Lm32Logd::readItems( void )
        * @todo In very rare cases there still seem to be problems here.
        *       Workaround: Restart this application by option -r.
        */
-      return;
+      m_counters.m_ackPending++;
+      rRemaining = 1;
+      return 0;
    }
 
-   uint size = sysLogFifoGetSize( &fifoAdmin );
+   const uint size = sysLogFifoGetSize( &fifoAdmin );
    if( size == 0 )
    { /*
       * No log-messages present.
       */
-      return;
+      m_counters.m_fifoLevel = 0;
+      return 0;
    }
 
    if( (size % SYSLOG_FIFO_ITEM_SIZE) != 0 )
@@ -707,42 +981,311 @@ void Lm32Logd::readItems( void )
       /*!
        * @todo Check this - maybe this could be a problem!
        */
-      return;
+      rRemaining = 1;
+      return 0;
    }
    m_fiFoAdmin = fifoAdmin;
 
-   if( m_pMiddleBuffer == nullptr )
+   const uint numOfItems = size / SYSLOG_FIFO_ITEM_SIZE;
+   rItems.resize( numOfItems );
+
+   /*
+    * The whole content of the FiFo becomes read, the option -m limits
+    * the number of items per etherbone cycle only. The acknowledge
+    * becomes made within the last etherbone cycle.
+    */
+   const uint maxPerCycle = m_rCmdLine.getMaxItems() * SYSLOG_FIFO_ITEM_SIZE;
+   uint done = 0;
+   while( done < size )
    {
-      DEBUG_MESSAGE( "Allocating middle buffer for a maximum of "
-                     << m_rCmdLine.getMaxItems() << " log-messages." );
-      m_pMiddleBuffer = new SYSLOG_FIFO_ITEM_T[ m_rCmdLine.getMaxItems() * SYSLOG_FIFO_ITEM_SIZE ];
+      EtherboneAccess::EB_BATCH_T oBatch;
+      const uint cycleEnd = done + (((size - done) < maxPerCycle)? (size - done) : maxPerCycle);
+      while( done < cycleEnd )
+      { /*
+         * Reading of both parts of the ring buffer, if necessary.
+         */
+         uint len = sysLogFifoGetUpperReadSize( &m_fiFoAdmin );
+         if( len > (cycleEnd - done) )
+            len = cycleEnd - done;
+         assert( (len % SYSLOG_FIFO_ITEM_SIZE) == 0 );
+         readItems( oBatch, &rItems[done / SYSLOG_FIFO_ITEM_SIZE], len );
+         done += len;
+      }
+      if( done == size )
+         setResponse( oBatch, getResponse( size ) );
+      execute( oBatch );
    }
 
-   const uint readTotalLen = min( size, static_cast<uint>(m_rCmdLine.getMaxItems() * SYSLOG_FIFO_ITEM_SIZE) );
-   uint len = readTotalLen;
-   const uint numOfItems = readTotalLen / SYSLOG_FIFO_ITEM_SIZE;
+   DEBUG_MESSAGE( "received: " << numOfItems << " items" );
+   m_counters.m_itemsRead   += numOfItems;
+   m_counters.m_drainCycles++;
+   m_counters.m_fifoLevel    = numOfItems;
+   if( numOfItems > m_counters.m_maxFifoLevel )
+      m_counters.m_maxFifoLevel = numOfItems;
+   const uint64_t lag = getOutputLag();
+   if( lag > m_counters.m_maxOutputLag )
+      m_counters.m_maxOutputLag = lag;
+
+   return numOfItems;
+}
 
-   SYSLOG_FIFO_ITEM_T* pData = m_pMiddleBuffer;
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::formatItems( OUTPUT_T& rOutput, const ITEM_BATCH_T& rItems )
+{
+   rOutput.m_vLines.reserve( rItems.size() );
+   rOutput.m_items   = rItems.size();
+   rOutput.m_isError = false;
+   for( const auto& item: rItems )
+   {
+      std::string line;
+      evaluateItem( line, item );
+      if( !line.empty() )
+         rOutput.m_vLines.push_back( std::move( line ) );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::writeOutput( std::vector<OUTPUT_T>& rvOutput )
+{
+   uint64_t items = 0;
 
-   uint lenToEnd = sysLogFifoGetUpperReadSize( &m_fiFoAdmin );
-   if( lenToEnd < readTotalLen )
+   if( m_sink )
    {
-      DEBUG_MESSAGE( "reading first part"  );
-      readItems( pData, lenToEnd );
-      pData += (lenToEnd / SYSLOG_FIFO_ITEM_SIZE);
-      len   -= lenToEnd;
+      for( const auto& output: rvOutput )
+      {
+         for( const auto& line: output.m_vLines )
+            m_sink( line, output.m_isError );
+         items += output.m_items;
+      }
    }
-   assert( sysLogFifoGetUpperReadSize( &m_fiFoAdmin ) >= readTotalLen );
-   readItems( pData, len );
-   setResponse( readTotalLen );
+   else if( m_isSyslogOpen )
+   { /*
+      * Each message needs its own invocation of syslog.
+      */
+      for( const auto& output: rvOutput )
+      {
+         for( const auto& line: output.m_vLines )
+            ::syslog( output.m_isError? LOG_ERR : LOG_NOTICE, "%s", line.c_str() );
+         m_counters.m_writeCalls += output.m_vLines.size();
+         items += output.m_items;
+      }
+   }
+   else if( m_logfile >= 0 )
+   { /*
+      * All lines becomes written by a minimum of system calls.
+      */
+      static const char c_lf = '\n';
+      std::vector<struct iovec> vIov;
+      for( const auto& output: rvOutput )
+      {
+         for( const auto& line: output.m_vLines )
+         {
+            vIov.push_back( { const_cast<char*>(line.data()), line.size() } );
+            if( output.m_isError )
+               vIov.push_back( { const_cast<char*>(&c_lf), sizeof( c_lf ) } );
+         }
+         items += output.m_items;
+      }
 
-   DEBUG_MESSAGE( "received: " << numOfItems << " items" );
-   for( uint i = 0; i < numOfItems; i++ )
+      std::size_t i = 0;
+      while( i < vIov.size() )
+      {
+         const int n = static_cast<int>( std::min( vIov.size() - i,
+                                                   static_cast<std::size_t>(IOV_MAX) ) );
+         const ssize_t written = ::writev( m_logfile, &vIov[i], n );
+         m_counters.m_writeCalls++;
+         if( written < 0 )
+         {
+            if( errno == EINTR )
+               continue;
+            std::string errStr = "Unable to write in \"";
+            errStr += m_rCmdLine.getLogfileName();
+            errStr += "\": ";
+            errStr += ::strerror( errno );
+            throw std::runtime_error( errStr );
+         }
+         /*
+          * Skipping the written parts, a short write continues
+          * within the partial written part.
+          */
+         std::size_t rest = written;
+         while( (i < vIov.size()) && (rest >= vIov[i].iov_len) )
+            rest -= vIov[i++].iov_len;
+         if( rest > 0 )
+         {
+            vIov[i].iov_base = static_cast<char*>(vIov[i].iov_base) + rest;
+            vIov[i].iov_len -= rest;
+         }
+      }
+   }
+   else
+   {
+      for( const auto& output: rvOutput )
+      {
+         for( const auto& line: output.m_vLines )
+         {
+            if( output.m_isError )
+               ERROR_MESSAGE( line );
+            else
+               std::cout << line;
+         }
+         items += output.m_items;
+      }
+      std::cout << std::flush;
+      m_counters.m_writeCalls++;
+   }
+
+   m_counters.m_itemsWritten += items;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::post( OUTPUT_T&& rOutput )
+{
+   if( m_pipelineRunning )
    {
-      std::string output;
-      evaluateItem( output, m_pMiddleBuffer[i] );
-      *this << output << std::flush;
+      m_oOutputQueue.push( std::move( rOutput ) );
+      return;
    }
+
+   std::vector<OUTPUT_T> vOutput;
+   vOutput.push_back( std::move( rOutput ) );
+   writeOutput( vOutput );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::startPipeline( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+   assert( !m_pipelineRunning );
+
+   m_oItemQueue.reopen();
+   m_oOutputQueue.reopen();
+   m_pipelineException = nullptr;
+   m_pipelineFailed    = false;
+   m_pipelineRunning   = true;
+   m_oWriterThread = std::thread( &Lm32Logd::writerLoop, this );
+   m_oFormatThread = std::thread( &Lm32Logd::formatLoop, this );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::stopPipeline( void )
+{
+   if( !m_pipelineRunning )
+      return;
+
+   DEBUG_MESSAGE_M_FUNCTION("");
+
+   /*
+    * The formatting stage finishes the queued items at first,
+    * afterwards the writer stage its queued outputs.
+    */
+   m_oItemQueue.close();
+   m_oFormatThread.join();
+   m_oOutputQueue.close();
+   m_oWriterThread.join();
+   m_pipelineRunning = false;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::setPipelineException( void )
+{
+   bool expected = false;
+   if( m_pipelineFailed.compare_exchange_strong( expected, true ) )
+      m_pipelineException = std::current_exception();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::formatLoop( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+   try
+   {
+      ITEM_BATCH_T items;
+      while( m_oItemQueue.pop( items ) )
+      {
+         OUTPUT_T output;
+         formatItems( output, items );
+         m_oOutputQueue.push( std::move( output ) );
+      }
+   }
+   catch( ... )
+   { /*
+      * Releasing the reader stage, the exception becomes re-thrown there.
+      */
+      setPipelineException();
+      m_oItemQueue.close();
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::writerLoop( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+   try
+   {
+      std::vector<OUTPUT_T> vOutput;
+      while( m_oOutputQueue.popAll( vOutput ) )
+      {
+         writeOutput( vOutput );
+         vOutput.clear();
+      }
+   }
+   catch( ... )
+   {
+      setPipelineException();
+      m_oOutputQueue.close();
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int Lm32Logd::waitForEvent( const uint timeUs )
+{
+   if( m_poTerminal == nullptr )
+   {
+      if( timeUs > 0 )
+         ::usleep( timeUs );
+      return 0;
+   }
+
+   /*
+    * Waiting for the keyboard instead of polling it.
+    */
+   struct pollfd fds = { STDIN_FILENO, POLLIN, 0 };
+   const struct timespec timeout =
+   {
+      .tv_sec  = static_cast<time_t>(timeUs / daq::MICROSECS_PER_SEC),
+      .tv_nsec = static_cast<long>((timeUs % daq::MICROSECS_PER_SEC) * 1000)
+   };
+   if( ::ppoll( &fds, 1, &timeout, nullptr ) <= 0 )
+      return 0;
+
+   return readKey();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void Lm32Logd::printCounters( std::ostream& rOut ) const
+{
+   rOut << "Log items read:       " << m_counters.m_itemsRead
+        << "\nLog items written:    " << m_counters.m_itemsWritten
+        << "\nOutput lag:           " << getOutputLag()
+        << "\nMax. output lag:      " << m_counters.m_maxOutputLag
+        << "\nFiFo drain cycles:    " << m_counters.m_drainCycles
+        << "\nPending acknowledges: " << m_counters.m_ackPending
+        << "\nFiFo overruns:        " << m_counters.m_overruns
+        << "\nFiFo level:           " << m_counters.m_fifoLevel
+        << "\nMax. FiFo level:      " << m_counters.m_maxFifoLevel
+        << " of " << m_capacity / SYSLOG_FIFO_ITEM_SIZE
+        << "\nWrite calls:          " << m_counters.m_writeCalls << std::endl;
 }
 
 /*! ---------------------------------------------------------------------------
@@ -846,7 +1389,7 @@ void Lm32Logd::evaluateItem( std::string& rOutput, const SYSLOG_FIFO_ITEM_T& ite
    }
 
    std::string format;
-   readStringFromLm32( format, item.format );
+   readFormatString( format, item.format );
 
    enum STATE_T
    {
@@ -1060,38 +1603,83 @@ void Lm32Logd::evaluateItem( std::string& rOutput, const SYSLOG_FIFO_ITEM_T& ite
    rOutput += '\n';
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+uint Lm32Logd::poll( void )
+{
+   const daq::USEC_T now = daq::getSysMicrosecs();
+   if( m_oScheduler.isDue( now ) )
+   {
+      ITEM_BATCH_T items;
+      uint remaining;
+      const uint n = readItems( items, remaining );
+      m_oScheduler.setLevel( n );
+      m_oScheduler.schedule( now, remaining, m_capacity / SYSLOG_FIFO_ITEM_SIZE, 0 );
+      if( n > 0 )
+      {
+         std::vector<OUTPUT_T> vOutput( 1 );
+         formatItems( vOutput[0], items );
+         writeOutput( vOutput );
+      }
+   }
+   return m_oScheduler.getDelayUs( daq::getSysMicrosecs() );
+}
+
 /*! ---------------------------------------------------------------------------
  */
 void Lm32Logd::operator()( const bool& rExit )
 {
    DEBUG_MESSAGE_M_FUNCTION("");
 
+   ITEM_BATCH_T items;
+   uint remaining;
+
    if( m_rCmdLine.isSingleShoot() )
    {
       DEBUG_MESSAGE( "Single shoot is active" );
-      readItems();
+      if( readItems( items, remaining ) > 0 )
+      {
+         std::vector<OUTPUT_T> vOutput( 1 );
+         formatItems( vOutput[0], items );
+         writeOutput( vOutput );
+      }
       return;
    }
 
-   uint intervalTime = 0;
+   const uint fifoCapacity = m_capacity / SYSLOG_FIFO_ITEM_SIZE;
+
+   startPipeline();
+
    /*
-    * Main loop.
+    * Main loop respectively reader stage.
     */
    DEBUG_MESSAGE( "Entering main-loop..." );
-   while( !rExit && (readKey() != '\e') )
+   int key = 0;
+   while( !rExit && (key != '\e') && !m_pipelineFailed )
    {
-      const uint it = daq::getSysMicrosecs();
-      if( it > intervalTime )
+      const daq::USEC_T now = daq::getSysMicrosecs();
+      if( m_oScheduler.isDue( now ) )
       {
-         intervalTime = it + m_rCmdLine.getPollInterwalTime() * 1000;
-         readItems();
+         const uint n = readItems( items, remaining );
+         m_oScheduler.setLevel( n );
+         m_oScheduler.schedule( now, remaining, fifoCapacity, 0 );
+         if( n > 0 )
+         {
+            m_oItemQueue.push( std::move( items ) );
+            items.clear();
+         }
       }
-      /*!
-       * @todo Improve the CPU-load maybe at this point.
-       */
-      ::usleep( 1000 );
+      key = waitForEvent( m_oScheduler.getDelayUs( daq::getSysMicrosecs() ) );
    }
-   DEBUG_MESSAGE( "Loop left by " << (rExit? "SIGTERM":"Esc") );
+   DEBUG_MESSAGE( "Loop left by " << (rExit? "SIGTERM": m_pipelineFailed? "exception" : "Esc") );
+
+   stopPipeline();
+
+   if( m_pipelineFailed )
+      std::rethrow_exception( m_pipelineException );
+
+   if( m_rCmdLine.isVerbose() )
+      printCounters( cout );
 }
 
 //================================== EOF ======================================
@@ -29,14 +29,22 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
-#include <fstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <daqt_read_stdin.hpp>
+#include <TBoundedQueue.hpp>
+#include <poll_scheduler.hpp>
 #include <scu_mmu_fe.hpp>
 #include <scu_ddr3_access.hpp>
 #include <scu_sram_access.hpp>
 #include <scu_lm32_access.hpp>
 #include <lm32_syslog_common.h>
 #include "logd_cmdline.hpp"
+#include "logd_format_cache.hpp"
 
 namespace Scu
 {
@@ -91,6 +99,95 @@ public:
  */
 class Lm32Logd: public std::iostream
 {
+public:
+   /*!
+    * @brief Counters of the log pipeline for diagnostic purposes.
+    */
+   struct COUNTERS_T
+   {
+      /*!
+       * @brief Number of log items which has been read from the FiFo.
+       */
+      std::atomic<uint64_t> m_itemsRead;
+
+      /*!
+       * @brief Number of log items which has been written to the output
+       *        or has been filtered out.
+       */
+      std::atomic<uint64_t> m_itemsWritten;
+
+      /*!
+       * @brief Number of polls which has found log items.
+       */
+      std::atomic<uint64_t> m_drainCycles;
+
+      /*!
+       * @brief Number of polls at which the LM32 has not acknowledged
+       *        the previous read yet.
+       */
+      std::atomic<uint64_t> m_ackPending;
+
+      /*!
+       * @brief Number of polls at which the LM32 has overwritten unread
+       *        log items, direct protocol only.
+       */
+      std::atomic<uint64_t> m_overruns;
+
+      /*!
+       * @brief Number of log items in the FiFo at the last poll.
+       */
+      std::atomic<uint>     m_fifoLevel;
+
+      /*!
+       * @brief Maximum number of log items found in the FiFo at a poll.
+       */
+      std::atomic<uint>     m_maxFifoLevel;
+
+      /*!
+       * @brief Maximum number of log items which has been read but not
+       *        written yet.
+       */
+      std::atomic<uint64_t> m_maxOutputLag;
+
+      /*!
+       * @brief Number of system calls for writing the output.
+       */
+      std::atomic<uint64_t> m_writeCalls;
+   };
+
+   /*!
+    * @brief Type of a optional output target instead of syslog,
+    *        log file or console.
+    * @note Log messages are terminated by a line feed, self diagnostic
+    *       messages (isError == true) not.
+    * @see setOutputSink
+    */
+   using SINK_T = std::function<void( const std::string& rLine, const bool isError )>;
+
+private:
+   /*!
+    * @brief Items read from the FiFo by one poll.
+    */
+   using ITEM_BATCH_T = std::vector<SYSLOG_FIFO_ITEM_T>;
+
+   /*!
+    * @brief Output of the formatting stage for the writer stage.
+    */
+   struct OUTPUT_T
+   {
+      std::vector<std::string> m_vLines;
+
+      /*!
+       * @brief Number of FiFo items which this output represents.
+       */
+      uint                     m_items;
+
+      /*!
+       * @brief True for self diagnostic messages.
+       */
+      bool                     m_isError;
+   };
+
    /*!
     * @brief Class contains the buffer of the output stream.
     */
@@ -115,6 +212,7 @@ class Lm32Logd: public std::iostream
    CommandLine&         m_rCmdLine;
    mmu::Mmu             m_oMmu;
    Lm32LogAccess        m_oLm32;
+   FormatCache          m_oFormatCache;
    uint                 m_fifoAdminBase;
    mmu::MMU_ADDR_T      m_offset;
    std::size_t          m_capacity;
@@ -123,13 +221,71 @@ class Lm32Logd: public std::iostream
    bool                 m_isSyslogOpen;
    SYSLOG_FIFO_ADMIN_T  m_fiFoAdmin;
 
-   SYSLOG_FIFO_ITEM_T*  m_pMiddleBuffer;
-   std::ofstream        m_logfile;
+   /*!
+    * @brief State of the FiFo handshake with the LM32.
+    * @see RAM_RING_PROTOCOL_FLAG
+    */
+   enum class RING_PROTOCOL_T
+   {
+      LEGACY,    /*!<@brief Acknowledge via wasRead          */
+      REQUESTED, /*!<@brief Direct protocol requested        */
+      DIRECT     /*!<@brief Read index published directly    */
+   };
+
+   RING_PROTOCOL_T      m_ringProtocol;
+   bool                 m_ringRequestPending;
+   RAM_RING_CLIENT_T    m_oRingClient;
+
+   /*!
+    * @brief File descriptor of the log file, or -1 when not used.
+    */
+   int                  m_logfile;
 
    Terminal*            m_poTerminal;
 
    int64_t              m_taiToUtcOffset;
 
+   /*!
+    * @brief Serializes the self diagnostic messages of the pipeline threads
+    *        in the output stream.
+    */
+   std::recursive_mutex m_oStreamMutex;
+
+   /*!
+    * @brief Queue between the reader stage and the formatting stage.
+    */
+   TBoundedQueue<ITEM_BATCH_T> m_oItemQueue;
+
+   /*!
+    * @brief Queue between the formatting stage and the writer stage.
+    */
+   TBoundedQueue<OUTPUT_T> m_oOutputQueue;
+
+   std::thread          m_oFormatThread;
+   std::thread          m_oWriterThread;
+
+   /*!
+    * @brief Is true as long as the formatting and the writer thread
+    *        are running.
+    */
+   bool                 m_pipelineRunning;
+
+   /*!
+    * @brief Becomes true when a pipeline thread has been terminated by an
+    *        exception, it becomes re-thrown in the reader thread.
+    */
+   std::atomic<bool>    m_pipelineFailed;
+   std::exception_ptr   m_pipelineException;
+
+   COUNTERS_T           m_counters;
+
+   /*!
+    * @brief Adapts the poll interval to the fill level of the FiFo.
+    */
+   PollScheduler        m_oScheduler;
+
+   SINK_T               m_sink;
+
 public:
    /*!
     * @brief Constructor makes all necessary initialization
@@ -152,6 +308,28 @@ public:
     */
    void operator()( const bool& rExit );
 
+   /*!
+    * @brief Makes a single poll of the FiFo and evaluates the read items
+    *        within the calling thread.
+    *
+    * This is the alternative to operator() for applications which
+    * schedules the polls of several log daemons by its own.
+    * @note The function operator() must not run at the same time.
+    * @return Time in microseconds up to the next due poll.
+    */
+   uint poll( void );
+
+   /*!
+    * @brief Redirects the output of the log messages and of the self
+    *        diagnostic messages to the given function.
+    * @note The sink function becomes invoked by the writer thread
+    *       respectively by the thread which invokes poll().
+    */
+   void setOutputSink( const SINK_T& rSink )
+   {
+      m_sink = rSink;
+   }
+
    /*!
     * @brief Returns the last received time-stamp.
     */
@@ -180,6 +358,28 @@ public:
     */
    void setBurstLimit( int burstLimit );
 
+   /*!
+    * @brief Returns the counters of the log pipeline.
+    */
+   const COUNTERS_T& getCounters( void ) const
+   {
+      return m_counters;
+   }
+
+   /*!
+    * @brief Returns the number of log items which has been read from
+    *        the FiFo but not written to the output yet.
+    */
+   uint64_t getOutputLag( void ) const
+   {
+      return m_counters.m_itemsRead.load() - m_counters.m_itemsWritten.load();
+   }
+
+   /*!
+    * @brief Prints the counters of the log pipeline.
+    */
+   void printCounters( std::ostream& rOut ) const;
+
 private:
    /*!
     * @brief Reads via the WB/EB-bus fron the SCU-TAM.
@@ -196,16 +396,42 @@ private:
                const uint size );
 
    /*!
-    * @brief Reads the LM32- memory
+    * @brief Reads the LM32- memory in 32-bit words.
+    * @note The offset and the length has to be dividable by four.
     */
    uint readLm32( char* pData, std::size_t len,
                   const std::size_t offset );
 
+   /*!
+    * @brief Reads the LM32- memory in large bursts into the format cache,
+    *        so that new format strings will not read via etherbone.
+    */
+   void prefetchLm32( void );
+
+   /*!
+    * @brief Reads a zero terminated ASCII-string from the LM32-memory
+    *        without any filtering.
+    */
+   void fetchStringFromLm32( std::string& rRaw, uint addr );
+
+   /*!
+    * @brief Appends the given raw string to rStr by filtering out
+    *        line feeds and escape sequences if demanded.
+    * @return Number of appended characters.
+    */
+   uint appendFiltered( std::string& rStr, const std::string& rRaw,
+                        const bool alwaysLinefeed );
+
    /*!
     * @brief Reads a zero terminated ASCII-string from the LM32-memory.
     */
    uint readStringFromLm32( std::string& rStr, uint addr, const bool = false );
 
+   /*!
+    * @brief Reads a format string by the format cache.
+    */
+   void readFormatString( std::string& rFormat, const uint addr );
+
    bool _updateFiFoAdmin( SYSLOG_FIFO_ADMIN_T& );
    /*!
     * @brief Reads FiFo indexes (pointer) from the DDR3-RAM.
@@ -225,20 +451,104 @@ private:
    void setResponse( uint64_t n );
 
    /*!
-    * @brief Reads log-items from the DDR3-memory.
+    * @brief Queues the writing of the number of read log-items in the
+    *        given batch object.
+    * @see setResponse
     */
-   void readItems( SYSLOG_FIFO_ITEM_T* pData, const uint len );
+   void setResponse( EtherboneAccess::EB_BATCH_T& rBatch, uint64_t n );
 
    /*!
-    * @brief Reads log-items from the DDR3-memory.
+    * @brief Evaluates the handshake word of the given FiFo administration
+    *        and replaces its indexes by the own view in the direct protocol.
+    * @retval true Log items can be read.
+    * @retval false An acknowledge of the LM32 is pending.
     */
-   void readItems( void );
+   bool updateRingProtocol( SYSLOG_FIFO_ADMIN_T& rAdmin );
+
+   /*!
+    * @brief Returns the response for the given number of read memory items,
+    *        in the direct protocol the read index of m_fiFoAdmin.
+    */
+   uint64_t getResponse( const uint n );
+
+   /*!
+    * @brief Executes all queued accesses of the given batch object
+    *        within a single etherbone cycle.
+    */
+   void execute( EtherboneAccess::EB_BATCH_T& rBatch );
+
+   /*!
+    * @brief Queues the reading of log-items from the DDR3-memory
+    *        in the given batch object.
+    */
+   void readItems( EtherboneAccess::EB_BATCH_T& rBatch,
+                   SYSLOG_FIFO_ITEM_T* pData, const uint len );
+
+   /*!
+    * @brief Reader stage: Reads all log-items which are currently in the
+    *        DDR3-FiFo and acknowledges them.
+    * @param rItems Target of the read items.
+    * @param rRemaining Becomes set to a value unequal zero when the FiFo
+    *                   could not be read completely, so the next poll
+    *                   shall be made soon.
+    * @return Number of read log items.
+    */
+   uint readItems( ITEM_BATCH_T& rItems, uint& rRemaining );
+
+   /*!
+    * @brief Formatting stage: Evaluates all items of a batch.
+    */
+   void formatItems( OUTPUT_T& rOutput, const ITEM_BATCH_T& rItems );
 
    /*!
     * @brief Evaluates one log-item.
     */
    void evaluateItem( std::string& rOutput, const SYSLOG_FIFO_ITEM_T& item );
 
+   /*!
+    * @brief Writer stage: Writes the given outputs by a minimum of
+    *        system calls.
+    */
+   void writeOutput( std::vector<OUTPUT_T>& rvOutput );
+
+   /*!
+    * @brief Passes a output to the writer thread, or writes it directly
+    *        when the pipeline isn't running.
+    */
+   void post( OUTPUT_T&& rOutput );
+
+   /*!
+    * @brief Starts the formatting and the writer thread.
+    */
+   void startPipeline( void );
+
+   /*!
+    * @brief Lets the formatting and the writer thread finish the queued
+    *        data and terminates them.
+    */
+   void stopPipeline( void );
+
+   /*!
+    * @brief Thread function of the formatting stage.
+    */
+   void formatLoop( void );
+
+   /*!
+    * @brief Thread function of the writer stage.
+    */
+   void writerLoop( void );
+
+   /*!
+    * @brief Stores the exception of a failed pipeline thread.
+    */
+   void setPipelineException( void );
+
+   /*!
+    * @brief Waits up to the given time or until a key has been pressed.
+    * @return Code of the pressed key or zero.
+    */
+   int waitForEvent( const uint timeUs );
+
    /*!
     * @brief Reads a key from the PC-keyboard.
     */
@@ -0,0 +1,330 @@
+/*!
+ *  @file logd_format_cache.cpp
+ *  @brief Persistent cache of the format strings of the LM32 log system.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sstream>
+#include <stdexcept>
+#include <message_macros.hpp>
+#include "logd_format_cache.hpp"
+
+using namespace Scu;
+using namespace std;
+
+/*!
+ * @brief Identifier and version of the cache file.
+ * @note The numbers in the file are stored in the byte order of the host,
+ *       a file of a foreign host becomes rejected by the magic number.
+ */
+constexpr uint32_t FILE_MAGIC   = 0x4C4D4643; // "LMFC"
+constexpr uint32_t FILE_VERSION = 1;
+
+/*!
+ * @brief Upper limit of a plausible string length in the file,
+ *        protects against corrupt files.
+ */
+constexpr uint32_t MAX_STRING_LEN = 0x10000;
+
+/*!
+ * @brief Smallest size of a cache item in the file: address and
+ *        string length.
+ */
+constexpr std::size_t MIN_ITEM_SIZE = 2 * sizeof( uint32_t );
+
+/*! ---------------------------------------------------------------------------
+ */
+static inline void writeU32( ostream& rFile, const uint32_t value )
+{
+   rFile.write( reinterpret_cast<const char*>(&value), sizeof( value ) );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+static inline bool readU32( istream& rFile, uint32_t& rValue )
+{
+   return static_cast<bool>( rFile.read( reinterpret_cast<char*>(&rValue), sizeof( rValue ) ) );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+static bool readString( istream& rFile, string& rStr )
+{
+   uint32_t len;
+   if( !readU32( rFile, len ) || (len > MAX_STRING_LEN) )
+      return false;
+   rStr.resize( len );
+   return static_cast<bool>( rFile.read( &rStr[0], len ) );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Reads the whole content of the cache file, when it is a regular
+ *        file which belongs to the effective user and can't be written
+ *        by others.
+ * @note Symbolic links will not followed.
+ * @retval true File content read.
+ * @retval false File not present or not trustworthy.
+ */
+static bool readTrustedFile( const string& rFileName, string& rContent )
+{
+   const int fd = ::open( rFileName.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC );
+   if( fd < 0 )
+   {
+      if( errno == ENOENT )
+         DEBUG_MESSAGE( "No cache file: " << rFileName );
+      else
+         ERROR_MESSAGE( "Unable to open format cache file: " << rFileName
+                        << ": " << ::strerror( errno ) );
+      return false;
+   }
+
+   struct stat oStat;
+   bool ret = false;
+   if( ::fstat( fd, &oStat ) != 0 )
+   {
+      ERROR_MESSAGE( "Unable to stat format cache file: " << rFileName
+                     << ": " << ::strerror( errno ) );
+   }
+   else if( !S_ISREG( oStat.st_mode ) || (oStat.st_uid != ::geteuid()) ||
+            ((oStat.st_mode & (S_IWGRP | S_IWOTH)) != 0) )
+   {
+      ERROR_MESSAGE( "Format cache file \"" << rFileName
+                     << "\" is not a private file of this user, ignored!" );
+   }
+   else
+   {
+      rContent.resize( oStat.st_size );
+      ssize_t len = 0;
+      while( static_cast<std::size_t>(len) < rContent.size() )
+      {
+         const ssize_t n = ::read( fd, &rContent[len], rContent.size() - len );
+         if( n <= 0 )
+            break;
+         len += n;
+      }
+      rContent.resize( len );
+      ret = true;
+   }
+
+   ::close( fd );
+   return ret;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+FormatCache::FormatCache( const string& rFileName )
+   :m_fileName( rFileName )
+   ,m_imageBase( 0 )
+   ,m_modified( false )
+   ,m_hits( 0 )
+   ,m_misses( 0 )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_fileName );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+FormatCache::~FormatCache( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "hits: " << m_hits << " misses: " << m_misses );
+   try
+   {
+      save();
+   }
+   catch( std::exception& e )
+   {
+      ERROR_MESSAGE( e.what() );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool FormatCache::load( const string& rBuildId )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_fileName );
+
+   m_buildId = rBuildId;
+   m_map.clear();
+   m_modified = false;
+
+   if( m_fileName.empty() )
+      return false;
+
+   string content;
+   if( !readTrustedFile( m_fileName, content ) )
+      return false;
+
+   istringstream file( content );
+
+   uint32_t value;
+   if( !readU32( file, value ) || (value != FILE_MAGIC) )
+      return false;
+   if( !readU32( file, value ) || (value != FILE_VERSION) )
+      return false;
+
+   string buildId;
+   if( !readString( file, buildId ) || (buildId != m_buildId) )
+   {
+      DEBUG_MESSAGE( "Cache file belongs to a other LM32 application." );
+      return false;
+   }
+
+   uint32_t count;
+   if( !readU32( file, count ) )
+      return false;
+
+   /*
+    * The number of items can't exceed the remaining file size.
+    */
+   if( count > (content.size() - static_cast<std::size_t>(file.tellg())) / MIN_ITEM_SIZE )
+   {
+      DEBUG_MESSAGE( "Cache file is corrupt: " << m_fileName );
+      return false;
+   }
+
+   MAP_T map;
+   map.reserve( count );
+   for( uint32_t i = 0; i < count; i++ )
+   {
+      ADDR_T addr;
+      string str;
+      if( !readU32( file, addr ) || !readString( file, str ) )
+      {
+         DEBUG_MESSAGE( "Cache file is corrupt: " << m_fileName );
+         return false;
+      }
+      map[addr] = std::move( str );
+   }
+
+   m_map.swap( map );
+   DEBUG_MESSAGE( m_map.size() << " format strings loaded from: " << m_fileName );
+   return true;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FormatCache::save( void )
+{
+   if( !m_modified || m_fileName.empty() )
+      return;
+
+   DEBUG_MESSAGE_M_FUNCTION( m_fileName );
+
+   ostringstream file;
+   writeU32( file, FILE_MAGIC );
+   writeU32( file, FILE_VERSION );
+   writeU32( file, m_buildId.size() );
+   file.write( m_buildId.data(), m_buildId.size() );
+   writeU32( file, m_map.size() );
+   for( const auto& item: m_map )
+   {
+      writeU32( file, item.first );
+      writeU32( file, item.second.size() );
+      file.write( item.second.data(), item.second.size() );
+   }
+   const string content = file.str();
+
+   /*
+    * Writing in a new created temporary file with a unique name at first
+    * and renaming it afterwards, so the cache file is never incomplete
+    * and a planted file or symbolic link can't be written.
+    */
+   string tmpName = m_fileName + ".XXXXXX";
+   const int fd = ::mkstemp( &tmpName[0] );
+   if( fd < 0 )
+      throw runtime_error( "Unable to create format cache file: " + tmpName +
+                           ": " + ::strerror( errno ) );
+
+   std::size_t len = 0;
+   while( len < content.size() )
+   {
+      const ssize_t n = ::write( fd, &content[len], content.size() - len );
+      if( n <= 0 )
+         break;
+      len += n;
+   }
+   if( (::close( fd ) != 0) || (len != content.size()) )
+   {
+      ::remove( tmpName.c_str() );
+      throw runtime_error( "Unable to write format cache file: " + tmpName );
+   }
+
+   if( ::rename( tmpName.c_str(), m_fileName.c_str() ) != 0 )
+   {
+      string errStr = "Unable to rename \"" + tmpName + "\" to \"" + m_fileName + "\": ";
+      errStr += ::strerror( errno );
+      ::remove( tmpName.c_str() );
+      throw runtime_error( errStr );
+   }
+   m_modified = false;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void FormatCache::setImage( vector<char>& rImage, const ADDR_T base )
+{
+   m_image.swap( rImage );
+   rImage.clear();
+   m_imageBase = base;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+const string* FormatCache::find( const ADDR_T addr )
+{
+   const auto it = m_map.find( addr );
+   if( it != m_map.end() )
+   {
+      m_hits++;
+      return &it->second;
+   }
+
+   m_misses++;
+   if( (addr < m_imageBase) || ((addr - m_imageBase) >= m_image.size()) )
+      return nullptr;
+
+   const char* pBegin = &m_image[addr - m_imageBase];
+   const void* pEnd   = ::memchr( pBegin, '\0', m_image.size() - (addr - m_imageBase) );
+   if( pEnd == nullptr )
+   { /*
+      * String isn't terminated within the image.
+      */
+      return nullptr;
+   }
+
+   return &insert( addr, string( pBegin, static_cast<const char*>(pEnd) ) );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+const string& FormatCache::insert( const ADDR_T addr, const string& rStr )
+{
+   m_modified = true;
+   return m_map[addr] = rStr;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,173 @@
+/*!
+ *  @file logd_format_cache.hpp
+ *  @brief Persistent cache of the format strings of the LM32 log system.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _LOGD_FORMAT_CACHE_HPP
+#define _LOGD_FORMAT_CACHE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Cache of the raw (not filtered) format strings of a LM32 application.
+ *
+ * Format strings are literals in the read-only data of the LM32 application,
+ * therefore a format string is completely determined by the build-ID of
+ * the LM32 application and its address. Once read, a format string never
+ * has to be read again via etherbone, even not after a restart of the
+ * daemon, when the cache has been stored in a file.
+ *
+ * Additionally a image of the LM32 memory can be prefetched in large
+ * bursts during the start-up, so that even format strings which appears
+ * the first time will not read character by character via etherbone.
+ *
+ * @note Arguments of "%s" shall not be cached, because they could
+ *       point to mutable data.
+ */
+class FormatCache
+{
+public:
+   using ADDR_T = uint32_t;
+
+private:
+   using MAP_T = std::unordered_map<ADDR_T, std::string>;
+
+   /*!
+    * @brief File name of the persistent cache, if empty then the cache
+    *        will not stored.
+    */
+   const std::string   m_fileName;
+
+   /*!
+    * @brief Build-ID of the LM32 application which the cache belongs to.
+    */
+   std::string         m_buildId;
+
+   /*!
+    * @brief Format strings addressed by their LM32 address.
+    */
+   MAP_T               m_map;
+
+   /*!
+    * @brief Prefetched image of the LM32 memory.
+    */
+   std::vector<char>   m_image;
+
+   /*!
+    * @brief LM32 address of the first byte of m_image.
+    */
+   ADDR_T              m_imageBase;
+
+   /*!
+    * @brief Becomes true when the cache has to be stored.
+    */
+   bool                m_modified;
+
+   uint64_t            m_hits;
+   uint64_t            m_misses;
+
+public:
+   /*!
+    * @brief Constructor
+    * @param rFileName Name of the file in which the cache will persist.
+    *                  If empty then the cache exists in the memory only.
+    */
+   FormatCache( const std::string& rFileName );
+
+   /*!
+    * @brief Destructor stores the cache in the file if modified.
+    */
+   ~FormatCache( void );
+
+   /*!
+    * @brief Sets the build-ID of the current LM32 application and loads
+    *        the cache from the file, if the file belongs to this build-ID.
+    * @note A file which isn't a regular file of the effective user or
+    *       which is writable by others becomes ignored.
+    * @param rBuildId Raw build-ID string of the LM32 application.
+    * @retval true  Cache has been loaded.
+    * @retval false Cache is empty, a prefetching of the LM32 memory
+    *               is recommended.
+    */
+   bool load( const std::string& rBuildId );
+
+   /*!
+    * @brief Stores the cache in its file, if modified.
+    * @note The file becomes replaced atomically by a new created temporary
+    *       file, so a concurrent reading daemon will never see a partial
+    *       written file.
+    */
+   void save( void );
+
+   /*!
+    * @brief Takes the prefetched image of the LM32 memory.
+    * @param rImage Memory image, becomes empty after the call.
+    * @param base LM32 address of the first byte of the image.
+    */
+   void setImage( std::vector<char>& rImage, const ADDR_T base );
+
+   /*!
+    * @brief Returns a pointer to the cached raw format string of the
+    *        given LM32 address, or nullptr when not present.
+    *
+    * If the string isn't in the cache yet, but in the prefetched image,
+    * then it becomes taken from the image into the cache.
+    */
+   const std::string* find( const ADDR_T addr );
+
+   /*!
+    * @brief Puts a raw format string which has been read from the LM32
+    *        memory in the cache.
+    */
+   const std::string& insert( const ADDR_T addr, const std::string& rStr );
+
+   std::size_t size( void ) const
+   {
+      return m_map.size();
+   }
+
+   uint64_t getHits( void ) const
+   {
+      return m_hits;
+   }
+
+   uint64_t getMisses( void ) const
+   {
+      return m_misses;
+   }
+
+   const std::string& getFileName( void ) const
+   {
+      return m_fileName;
+   }
+};
+
+} // namespace Scu
+#endif // ifndef _LOGD_FORMAT_CACHE_HPP
+//================================== EOF ======================================
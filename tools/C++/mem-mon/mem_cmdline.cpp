@@ -26,6 +26,7 @@
  */
 #include <scu_env.hpp>
 #include <message_macros.hpp>
+#include <EtherboneConnection.hpp>
 #include <sstream>
 #include  <stdexcept>
 #include "mem_cmdline.hpp"
@@ -307,7 +308,8 @@ int CommandLine::onArgument( void )
    }
 
    m_scuUrl = getArgVect()[getArgIndex()];
-   if( m_scuUrl.find( "tcp/" ) == string::npos )
+   if( (m_scuUrl.find( "tcp/" ) == string::npos) &&
+       !FeSupport::Scu::Etherbone::isSimulatorAddress( m_scuUrl ) )
          m_scuUrl = "tcp/" + m_scuUrl;
 
    return 1;
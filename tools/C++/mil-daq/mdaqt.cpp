@@ -267,7 +267,28 @@ MilDaqAdministration::MilDaqAdministration( CommandLine* m_poCommandLine,
  */
 MilDaqAdministration::~MilDaqAdministration( void )
 {
+   daq::DaqRecorder* poRecorder = getRecorder();
+   if( poRecorder != nullptr )
+   {
+      setRecorder( nullptr );
+      try
+      {
+         poRecorder->close();
+      }
+      catch( std::exception& e )
+      {
+         ERROR_MESSAGE( e.what() );
+      }
+      delete poRecorder;
+   }
+}
 
+/*! ---------------------------------------------------------------------------
+ */
+void MilDaqAdministration::startRecording( const std::string& rFileName )
+{
+   assert( getRecorder() == nullptr );
+   setRecorder( new daq::DaqRecorder( rFileName, "mdaqt " + getScuDomainName() ) );
 }
 
 /*! ---------------------------------------------------------------------------
@@ -34,6 +34,7 @@
  #include <daq_eb_ram_buffer.hpp>
  #include <daq_calculations.hpp>
  #include <mdaqt_command_line.hpp>
+ #include <daq_recorder.hpp>
 #endif
 
 #ifndef HOT_KEY_RECEIVE
@@ -193,8 +194,8 @@ public:
 class MilDaqAdministration: public Scu::MiLdaq::DaqAdministrationFgList
 {
    friend class CommandLine;
-   Lm32Swi        m_oSwi;
-   CommandLine*   m_poCommandLine;
+   Lm32Swi            m_oSwi;
+   CommandLine*       m_poCommandLine;
 
 public:
    MilDaqAdministration( CommandLine* m_poCommandLine, std::string ebAddress );
@@ -205,6 +206,14 @@ public:
       return m_poCommandLine;
    }
 
+   /*!
+    * @brief Starts the recording of all received MIL-DAQ items
+    *        in the given file.
+    * @see daq::DaqRecorder
+    * @see DaqAdministration::setRecorder
+    */
+   void startRecording( const std::string& rFileName );
+
    Device* getDevice( const uint number )
    {
       return static_cast<Device*>(DaqAdministration::getDevice( number ));
@@ -480,6 +480,22 @@ vector<OPTION> CommandLine::c_optList =
       .m_helpText = "Activates or deactivates the gap reading. "
                     "PARAM is the gap reading interval in milliseconds. "
                     "A value of zero deactivates the gap reading."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<CommandLine*>(poParser)->m_recordFileName = poParser->getOptArg();
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "record",
+      .m_helpText = "Records all received MIL-DAQ items in the binary file"
+                    " given by PARAM.\n"
+                    "The file is organized in chunks with a index of the"
+                    " timestamp range of each channel, so it can be mapped"
+                    " in the memory and accessed randomly by timestamp."
    }
 };
 
@@ -568,7 +584,11 @@ MilDaqAdministration* CommandLine::operator()( void )
       return nullptr;
 
    if( m_poAllDaq != nullptr )
+   {
+      if( !m_recordFileName.empty() )
+         m_poAllDaq->startRecording( m_recordFileName );
       return m_poAllDaq;
+   }
 
    if( !m_targetUrlGiven )
    {
@@ -615,7 +635,8 @@ int CommandLine::onArgument( void )
       {
          assert( m_poAllDaq == nullptr );
          m_targetUrlGiven = true;
-         if( arg.find( "tcp/" ) == string::npos )
+         if( (arg.find( "tcp/" ) == string::npos) &&
+             !FeSupport::Scu::Etherbone::isSimulatorAddress( arg ) )
             arg = "tcp/" + arg;
 #if 0
          if( daq::isConcurrentProcessRunning( getProgramName(), arg ) )
@@ -90,6 +90,7 @@ class CommandLine: public PARSER
    std::string                m_gnuplotTerminal;
    std::string                m_gnuplotOutput;
    std::string                m_gnuplotLineStyle;
+   std::string                m_recordFileName;
 
    static bool readInteger( uint&, const std::string& );
    static bool readFloat( float&, const std::string& );
@@ -132,6 +133,11 @@ public:
       return m_gnuplotLineStyle;
    }
 
+   const std::string& getRecordFileName( void ) const
+   {
+      return m_recordFileName;
+   }
+
    bool isOutputFileDefined( void ) const
    {
       return !m_gnuplotOutput.empty();
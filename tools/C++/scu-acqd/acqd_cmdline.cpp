@@ -0,0 +1,326 @@
+/*!
+ *  @file acqd_cmdline.cpp
+ *  @brief Command line parser of the SCU acquisition daemon.
+ *
+ *  @see https://github.com/UlrichBecker/command_line_option_parser_cpp11
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <stdlib.h>
+#include <algorithm>
+#include <helper_macros.h>
+#include <scu_env.hpp>
+#include <message_macros.hpp>
+#include <EtherboneConnection.hpp>
+#include <poll_scheduler.hpp>
+#include "acqd_cmdline.hpp"
+
+using namespace std;
+using namespace CLOP;
+using namespace Scu;
+
+#define DEFAULT_SOCKET_PATH       "/tmp/scu-acqd.sock"
+#define DEFAULT_NUM_WORKERS       4
+#define DEFAULT_MAX_CLIENT_BUFFER 1048576
+
+/*! ---------------------------------------------------------------------------
+ * @brief Initializing the command line options.
+ */
+AcqdCommandLine::OPT_LIST_T AcqdCommandLine::c_optList =
+{
+   {
+      OPT_LAMBDA( poParser,
+      {
+         cout << "\nAcquisition daemon for the function generator feedback of several SCUs.\n"
+                 "(c) 2026 GSI; Author: Ulrich Becker <u.becker@gsi.de>\n\n"
+                 "Usage:\n\t"
+              << poParser->getProgramName() << " [options] <SCU URL> [<SCU URL> ...]\n\n"
+                 "Each SCU becomes polled by a pool of worker threads, the acquired data\n"
+                 "can be subscribed by clients via the local socket given by option -s.\n"
+                 "The protocol is line based, the client can send the following commands:\n\n"
+                 "\t" ESC_BOLD "LIST" ESC_NORMAL "           Lists all topics.\n"
+                 "\t" ESC_BOLD "SUB <topic>" ESC_NORMAL "    Subscribes a topic, \"prefix*\" and \"*\" are allowed.\n"
+                 "\t" ESC_BOLD "UNSUB <topic>" ESC_NORMAL "  Unsubscribes a topic.\n"
+                 "\t" ESC_BOLD "STAT" ESC_NORMAL "           Prints the number of dropped bytes.\n\n"
+                 "Topics are \"<SCU>/fg-<socket>-<device>\" with lines of"
+                 " \"<topic> <timestamp> <set value> <actual value>\"\n"
+                 "and \"<SCU>/log\" with the log messages of the LM32 application"
+                 " when option -l is given.\n\n"
+                 "Example:\n\t"
+              << "echo \"SUB scuxl4711/*\" | socat - UNIX-CONNECT:" DEFAULT_SOCKET_PATH "\n\n"
+                 "Options:"
+              << endl;
+         poParser->list( cout );
+         cout << endl;
+         ::exit( EXIT_SUCCESS );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'h',
+      .m_longOpt  = "help",
+      .m_helpText = "Print this help and exit"
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_verbose = true;
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'v',
+      .m_longOpt  = "verbose",
+      .m_helpText = "Be verbose"
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_lm32Log = true;
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'l',
+      .m_longOpt  = "lm32-log",
+      .m_helpText = "Forwards the log messages of the LM32 application of each SCU\n"
+                    "in the topic \"<SCU>/log\".\n"
+                    "NOTE: A concurrent running lm32-logd for the same SCU has to be terminated."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_socketPath = poParser->getOptArg();
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 's',
+      .m_longOpt  = "socket",
+      .m_helpText = "PARAM is the file name of the local socket for the clients.\n"
+                    "Default: " DEFAULT_SOCKET_PATH
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         const uint n = readInteger( poParser->getOptArg() );
+         if( n == 0 )
+         {
+            ERROR_MESSAGE( "At least one worker thread is necessary!" );
+            return -1;
+         }
+         static_cast<AcqdCommandLine*>(poParser)->m_numWorkers = n;
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'w',
+      .m_longOpt  = "workers",
+      .m_helpText = "PARAM is the maximum number of worker threads which polls the SCUs.\n"
+                    "Default: " TO_STRING( DEFAULT_NUM_WORKERS )
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_minPollIntervalUs = readInteger( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'm',
+      .m_longOpt  = "min-interval",
+      .m_helpText = "PARAM is the minimum poll interval per SCU in microseconds,"
+                    " which becomes used at a high fill level of the DAQ-FIFOs."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_maxPollIntervalUs = readInteger( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'M',
+      .m_longOpt  = "max-interval",
+      .m_helpText = "PARAM is the maximum poll interval per SCU in microseconds,"
+                    " which becomes used in idle."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<AcqdCommandLine*>(poParser)->m_maxClientBuffer = readInteger( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = 'b',
+      .m_longOpt  = "client-buffer",
+      .m_helpText = "PARAM is the maximum number of bytes which can be buffered for a"
+                    " single client.\nIf a client is too slow then further data for"
+                    " this client becomes dropped.\n"
+                    "Default: " TO_STRING( DEFAULT_MAX_CLIENT_BUFFER )
+   }
+}; // AcqdCommandLine::c_optList
+
+///////////////////////////////////////////////////////////////////////////////
+/*! ---------------------------------------------------------------------------
+*/
+uint AcqdCommandLine::readInteger( const string& roStr )
+{
+   int retVal;
+   try
+   {
+      retVal = stoi( roStr, nullptr, (roStr[0] == '0' && roStr[1] == 'x')? 16 : 10 );
+   }
+   catch( std::exception& e )
+   {
+      retVal = -1;
+   }
+   if( retVal < 0 )
+   {
+      std::string errStr = "Positive integer number is expected and not that: \"";
+      errStr += roStr;
+      errStr += "\" !";
+      throw std::runtime_error( errStr );
+   }
+   return retVal;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+AcqdCommandLine::AcqdCommandLine( int argc, char** ppArgv )
+   :PARSER( argc, ppArgv )
+   ,m_verbose( false )
+   ,m_lm32Log( false )
+   ,m_numWorkers( DEFAULT_NUM_WORKERS )
+   ,m_minPollIntervalUs( PollScheduler::DEFAULT_MIN_INTERVAL_US )
+   ,m_maxPollIntervalUs( PollScheduler::DEFAULT_MAX_INTERVAL_US )
+   ,m_maxClientBuffer( DEFAULT_MAX_CLIENT_BUFFER )
+   ,m_socketPath( DEFAULT_SOCKET_PATH )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+
+   add( c_optList );
+   sortShort();
+
+   if( PARSER::operator()() < 0 )
+      ::exit( EXIT_FAILURE );
+
+   if( isRunningOnScu() )
+   {
+      WARNING_MESSAGE( "Program is running on SCU, therefore only the"
+                       " local SCU becomes polled!" );
+      m_vScuUrls.clear();
+      m_vScuUrls.push_back( "dev/wbm0" );
+   }
+
+   if( m_vScuUrls.empty() )
+   {
+      ERROR_MESSAGE( "Missing SCU URL" );
+      ::exit( EXIT_FAILURE );
+   }
+
+   if( m_minPollIntervalUs > m_maxPollIntervalUs )
+   {
+      ERROR_MESSAGE( "Minimum poll interval is greater than the maximum!" );
+      ::exit( EXIT_FAILURE );
+   }
+
+   if( m_numWorkers > m_vScuUrls.size() )
+      m_numWorkers = m_vScuUrls.size();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+AcqdCommandLine::~AcqdCommandLine( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onArgument( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION("");
+
+   string url = getArgVect()[getArgIndex()];
+   if( (url.find( "tcp/" ) == string::npos) &&
+       !FeSupport::Scu::Etherbone::isSimulatorAddress( url ) )
+         url = "tcp/" + url;
+
+   if( find( m_vScuUrls.begin(), m_vScuUrls.end(), url ) != m_vScuUrls.end() )
+   {
+      ERROR_MESSAGE( "SCU \"" << url << "\" is given more than once!" );
+      ::exit( EXIT_FAILURE );
+   }
+
+   m_vScuUrls.push_back( url );
+   return 1;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorUnrecognizedShortOption( char unrecognized )
+{
+   ERROR_MESSAGE( "Unknown short option: \"-" << unrecognized << "\"" );
+   return 0;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorUnrecognizedLongOption( const std::string& unrecognized )
+{
+   ERROR_MESSAGE( "Unknown long option: \"--" << unrecognized << "\"" );
+   return 0;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorShortMissingRequiredArg( void )
+{
+   ERROR_MESSAGE( "Missing argument of option: -" << getCurrentOption()->m_shortOpt );
+   return -1;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorLongMissingRequiredArg( void )
+{
+   ERROR_MESSAGE( "Missing argument of option: --" << getCurrentOption()->m_longOpt );
+   return -1;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorShortOptionalArg( void )
+{
+   ERROR_MESSAGE( "Missing argument after '=' of option: -" << getCurrentOption()->m_shortOpt );
+   return -1;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+int AcqdCommandLine::onErrorlongOptionalArg( void )
+{
+   ERROR_MESSAGE( "Missing argument after '=' of option --" << getCurrentOption()->m_longOpt );
+   return -1;
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,126 @@
+/*!
+ *  @file acqd_cmdline.hpp
+ *  @brief Command line parser of the SCU acquisition daemon.
+ *
+ *  @see https://github.com/UlrichBecker/command_line_option_parser_cpp11
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _ACQD_CMDLINE_HPP
+#define _ACQD_CMDLINE_HPP
+
+#include <string>
+#include <vector>
+#include <parse_opts.hpp>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Command line of the daemon scu-acqd.
+ * @note Named differently to Scu::CommandLine of lm32-logd, because the
+ *       modules of lm32-logd are linked in this daemon as well.
+ */
+class AcqdCommandLine: public CLOP::PARSER
+{
+   using OPT_LIST_T = std::vector<CLOP::OPTION>;
+   static OPT_LIST_T c_optList;
+
+   bool                     m_verbose;
+   bool                     m_lm32Log;
+   uint                     m_numWorkers;
+   uint                     m_minPollIntervalUs;
+   uint                     m_maxPollIntervalUs;
+   uint                     m_maxClientBuffer;
+   std::string              m_socketPath;
+   std::vector<std::string> m_vScuUrls;
+
+   static uint readInteger( const std::string& );
+
+public:
+   AcqdCommandLine( int argc, char** ppArgv );
+   virtual ~AcqdCommandLine( void );
+
+   bool isVerbose( void ) const
+   {
+      return m_verbose;
+   }
+
+   /*!
+    * @brief Returns true if the log messages of the LM32 applications
+    *        shall be forwarded as well.
+    */
+   bool isLm32LogEnabled( void ) const
+   {
+      return m_lm32Log;
+   }
+
+   /*!
+    * @brief Returns the number of worker threads, which is at most
+    *        the number of SCUs.
+    */
+   uint getNumberOfWorkers( void ) const
+   {
+      return m_numWorkers;
+   }
+
+   uint getMinPollIntervalUs( void ) const
+   {
+      return m_minPollIntervalUs;
+   }
+
+   uint getMaxPollIntervalUs( void ) const
+   {
+      return m_maxPollIntervalUs;
+   }
+
+   /*!
+    * @brief Returns the maximum number of bytes which can be buffered
+    *        for a single client.
+    */
+   uint getMaxClientBuffer( void ) const
+   {
+      return m_maxClientBuffer;
+   }
+
+   const std::string& getSocketPath( void ) const
+   {
+      return m_socketPath;
+   }
+
+   const std::vector<std::string>& getScuUrls( void ) const
+   {
+      return m_vScuUrls;
+   }
+
+private:
+   int onArgument( void ) override;
+   int onErrorUnrecognizedShortOption( char unrecognized ) override;
+   int onErrorUnrecognizedLongOption( const std::string& unrecognized ) override;
+   int onErrorShortMissingRequiredArg( void ) override;
+   int onErrorLongMissingRequiredArg( void ) override;
+   int onErrorShortOptionalArg( void ) override;
+   int onErrorlongOptionalArg( void ) override;
+};
+
+} // namespace Scu
+#endif // ifndef _ACQD_CMDLINE_HPP
+//================================== EOF ======================================
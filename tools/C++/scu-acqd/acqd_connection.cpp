@@ -0,0 +1,229 @@
+/*!
+ *  @file acqd_connection.cpp
+ *  @brief Connection of the SCU acquisition daemon to a single SCU.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <message_macros.hpp>
+#include <BusException.hpp>
+#include <scu_ddr3_access.hpp>
+#include <scu_sram_access.hpp>
+#include <logd_cmdline.hpp>
+#include <logd_core.hpp>
+#include "acqd_cmdline.hpp"
+#include "acqd_connection.hpp"
+
+using namespace Scu;
+using namespace std;
+namespace EB = FeSupport::Scu::Etherbone;
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns the name of the SCU by removing the protocol prefix.
+ */
+static string makeScuName( const string& rUrl )
+{
+   if( rUrl.compare( 0, 4, "tcp/" ) == 0 )
+      return rUrl.substr( 4 );
+   return rUrl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*! ---------------------------------------------------------------------------
+ */
+void ScuConnection::Channel::setup( SubscriptionServer* poServer,
+                                    const string& rScuName )
+{
+   m_poServer = poServer;
+   m_topic = rScuName + '/' + getFgName();
+   m_poServer->addTopic( m_topic );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ScuConnection::Channel::onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                                          const DAQ_SPAN_T& rActValues,
+                                          const DAQ_SPAN_T& rSetValues )
+{
+   /*
+    * Formatting only when anybody is interested in this channel.
+    */
+   if( (m_poServer == nullptr) || !m_poServer->isSubscribed( m_topic ) )
+      return;
+
+   m_text.clear();
+   for( std::size_t i = 0; i < rTimestamps.size(); i++ )
+   {
+      m_text += m_topic;
+      m_text += ' ';
+      m_text += to_string( rTimestamps[i] );
+      m_text += ' ';
+      m_text += to_string( rSetValues[i] );
+      m_text += ' ';
+      m_text += to_string( rActValues[i] );
+      m_text += '\n';
+   }
+   m_poServer->publish( m_topic, m_text );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*! ---------------------------------------------------------------------------
+ */
+ScuConnection::ScuConnection( const string& rUrl, SubscriptionServer& rServer,
+                              const AcqdCommandLine& rCmdLine )
+   :m_url( rUrl )
+   ,m_name( makeScuName( rUrl ) )
+   ,m_rServer( rServer )
+   ,m_pollCount( 0 )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_url );
+
+   m_poFgAdmin.reset( new FgFeedbackAdministration( m_url ) );
+   m_poFgAdmin->setAdaptivePolling( true, rCmdLine.getMinPollIntervalUs(),
+                                          rCmdLine.getMaxPollIntervalUs() );
+   buildChannels();
+
+   if( !rCmdLine.isLm32LogEnabled() )
+      return;
+
+   try
+   {
+      buildLogd( rCmdLine );
+   }
+   catch( ... )
+   {
+      m_poLogd.reset();
+      m_poRam.reset();
+      deleteChannels();
+      throw;
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+ScuConnection::~ScuConnection( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_url );
+
+   m_poLogd.reset();
+   m_poRam.reset();
+   deleteChannels();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ScuConnection::buildChannels( void )
+{
+   m_poFgAdmin->autoBuildAllDevicesAndChannels<Channel>();
+
+   for( const auto& pDevice: *m_poFgAdmin )
+   {
+      for( const auto& pChannel: *pDevice )
+         static_cast<Channel*>(pChannel)->setup( &m_rServer, m_name );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ScuConnection::deleteChannels( void )
+{
+   vector<FgFeedbackDevice*> vDevices;
+   for( const auto& pDevice: *m_poFgAdmin )
+      vDevices.push_back( pDevice );
+
+   for( const auto& pDevice: vDevices )
+   {
+      vector<FgFeedbackChannel*> vChannels;
+      for( const auto& pChannel: *pDevice )
+         vChannels.push_back( pChannel );
+
+      for( const auto& pChannel: vChannels )
+         delete static_cast<Channel*>(pChannel);
+
+      delete pDevice;
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ScuConnection::buildLogd( const AcqdCommandLine& rCmdLine )
+{
+   /*
+    * The log daemon is configured by its own command line, so it
+    * behaves exactly like a standalone running lm32-logd.
+    * The maximum poll interval is given in milliseconds.
+    */
+   m_vLogdArgs = { "lm32-logd", m_url,
+                   "-I" + to_string( (rCmdLine.getMaxPollIntervalUs() + 999) / 1000 ) };
+   for( auto& rArg: m_vLogdArgs )
+      m_vLogdArgv.push_back( &rArg[0] );
+   m_vLogdArgv.push_back( nullptr );
+   m_poLogdCmdLine.reset( new CommandLine( m_vLogdArgs.size(), m_vLogdArgv.data() ) );
+
+   try
+   {
+      m_poRam.reset( new Ddr3Access( m_url ) );
+      DEBUG_MESSAGE( m_name << ": Using DDR3-RAM on SCU3" );
+   }
+   catch( EB::BusException& e )
+   {
+      string exceptText = e.what();
+      if( exceptText.find( "VendorId" ) == string::npos )
+         throw;
+
+      m_poRam.reset( new SramAccess( m_url ) );
+      DEBUG_MESSAGE( m_name << ": Using SRAM on SCU4" );
+   }
+
+   m_poLogd.reset( new Lm32Logd( m_poRam.get(), *m_poLogdCmdLine ) );
+
+   m_logTopic = m_name + "/log";
+   m_rServer.addTopic( m_logTopic );
+   m_poLogd->setOutputSink( [this]( const string& rLine, const bool isError )
+   {
+      if( !m_rServer.hasSubscribers() )
+         return;
+      string text = m_logTopic + (isError? " ERROR: " : " ") + rLine;
+      while( !text.empty() && (text.back() == '\n') )
+         text.pop_back();
+      text += '\n';
+      m_rServer.publish( m_logTopic, text );
+   });
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint ScuConnection::poll( void )
+{
+   m_pollCount++;
+   m_poFgAdmin->distributeData();
+   uint delayUs = m_poFgAdmin->getPollDelayUs();
+
+   if( m_poLogd )
+   {
+      const uint logdDelayUs = m_poLogd->poll();
+      if( logdDelayUs < delayUs )
+         delayUs = logdDelayUs;
+   }
+
+   return delayUs;
+}
+
+//================================== EOF ======================================
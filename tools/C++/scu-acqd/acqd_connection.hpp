@@ -0,0 +1,157 @@
+/*!
+ *  @file acqd_connection.hpp
+ *  @brief Connection of the SCU acquisition daemon to a single SCU.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _ACQD_CONNECTION_HPP
+#define _ACQD_CONNECTION_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <scu_fg_feedback.hpp>
+#include <scu_memory.hpp>
+#include "acqd_server.hpp"
+
+namespace Scu
+{
+
+class AcqdCommandLine;
+class CommandLine;
+class Lm32Logd;
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Connection to a single SCU, it contains the feedback
+ *        administration of all found function generators and optionally
+ *        the log daemon of the LM32 application.
+ *
+ * Both become polled synchronously by poll(), which becomes invoked by
+ * one worker thread of the pool at a time, therefore the objects of a
+ * connection need no protection of its own.
+ * @see ConnectionPool
+ */
+class ScuConnection
+{
+   /*!
+    * @brief Feedback channel which publishes its received tuples.
+    */
+   class Channel: public FgFeedbackBlock
+   {
+      SubscriptionServer* m_poServer;
+      std::string         m_topic;
+      std::string         m_text;
+
+   public:
+      Channel( const uint fgNumber )
+         :FgFeedbackBlock( fgNumber )
+         ,m_poServer( nullptr )
+      {}
+
+      /*!
+       * @brief Connects this channel with the server, the topic becomes
+       *        "<SCU name>/<function generator name>".
+       */
+      void setup( SubscriptionServer* poServer, const std::string& rScuName );
+
+      const std::string& getTopic( void ) const
+      {
+         return m_topic;
+      }
+
+   protected:
+      void onDataBlock( const TIMESTAMP_SPAN_T& rTimestamps,
+                        const DAQ_SPAN_T& rActValues,
+                        const DAQ_SPAN_T& rSetValues ) override;
+   };
+
+   const std::string                         m_url;
+   const std::string                         m_name;
+   SubscriptionServer&                       m_rServer;
+
+   std::unique_ptr<FgFeedbackAdministration> m_poFgAdmin;
+
+   /*!
+    * @brief Arguments of the synthesized command line of the log daemon.
+    */
+   std::vector<std::string>                  m_vLogdArgs;
+   std::vector<char*>                        m_vLogdArgv;
+   std::unique_ptr<CommandLine>              m_poLogdCmdLine;
+   std::unique_ptr<RamAccess>                m_poRam;
+   std::unique_ptr<Lm32Logd>                 m_poLogd;
+   std::string                               m_logTopic;
+
+   uint64_t                                  m_pollCount;
+
+   void buildChannels( void );
+   void deleteChannels( void );
+   void buildLogd( const AcqdCommandLine& rCmdLine );
+
+public:
+   /*!
+    * @brief Constructor establishes the connection to the SCU and creates
+    *        a feedback channel for each found function generator.
+    * @param rUrl Etherbone address of the SCU.
+    * @param rServer Server for publishing the received data.
+    * @param rCmdLine Command line of the daemon.
+    */
+   ScuConnection( const std::string& rUrl, SubscriptionServer& rServer,
+                  const AcqdCommandLine& rCmdLine );
+
+   ~ScuConnection( void );
+
+   /*!
+    * @brief Polls the DAQ-FIFOs and the LM32 log FIFO once and
+    *        distributes the received data.
+    * @return Time in microseconds up to the next due poll.
+    */
+   uint poll( void );
+
+   /*!
+    * @brief Returns the name of the SCU, that is the URL without
+    *        the protocol prefix "tcp/".
+    */
+   const std::string& getName( void ) const
+   {
+      return m_name;
+   }
+
+   const std::string& getUrl( void ) const
+   {
+      return m_url;
+   }
+
+   uint getNumberOfChannels( void )
+   {
+      return m_poFgAdmin->getNumberOfRegisteredChannels();
+   }
+
+   uint64_t getPollCount( void ) const
+   {
+      return m_pollCount;
+   }
+};
+
+} // namespace Scu
+#endif // ifndef _ACQD_CONNECTION_HPP
+//================================== EOF ======================================
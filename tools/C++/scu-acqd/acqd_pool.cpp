@@ -0,0 +1,150 @@
+/*!
+ *  @file acqd_pool.cpp
+ *  @brief Pool of worker threads which polls the connections of the
+ *         SCU acquisition daemon.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <chrono>
+#include <assert.h>
+#include <message_macros.hpp>
+#include "acqd_pool.hpp"
+
+using namespace Scu;
+using namespace std;
+
+/*! ---------------------------------------------------------------------------
+ */
+ConnectionPool::ConnectionPool( void )
+   :m_stop( false )
+   ,m_pollErrors( 0 )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+ConnectionPool::~ConnectionPool( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+   stop();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ConnectionPool::add( ScuConnection* poConnection )
+{
+   {
+      lock_guard<mutex> lock( m_oMutex );
+      m_queue.push( ITEM_T{ daq::getSysMicrosecs(), poConnection } );
+   }
+   m_wakeUp.notify_one();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ConnectionPool::start( const uint numWorkers )
+{
+   assert( m_vWorkers.empty() );
+   m_stop = false;
+   for( uint i = 0; i < numWorkers; i++ )
+      m_vWorkers.push_back( thread( &ConnectionPool::workerLoop, this ) );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ConnectionPool::stop( void )
+{
+   {
+      lock_guard<mutex> lock( m_oMutex );
+      m_stop = true;
+   }
+   m_wakeUp.notify_all();
+   for( auto& rWorker: m_vWorkers )
+      rWorker.join();
+   m_vWorkers.clear();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint64_t ConnectionPool::getNumberOfPollErrors( void )
+{
+   lock_guard<mutex> lock( m_oMutex );
+   return m_pollErrors;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void ConnectionPool::workerLoop( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+
+   unique_lock<mutex> lock( m_oMutex );
+   while( !m_stop )
+   {
+      if( m_queue.empty() )
+      { /*
+         * All connections are busy by other workers.
+         */
+         m_wakeUp.wait( lock );
+         continue;
+      }
+
+      const daq::USEC_T now = daq::getSysMicrosecs();
+      if( m_queue.top().m_dueTime > now )
+      { /*
+         * Waiting until the earliest connection is due, a connection which
+         * becomes returned meanwhile with a earlier due time wakes up.
+         */
+         m_wakeUp.wait_for( lock, chrono::microseconds( m_queue.top().m_dueTime - now ) );
+         continue;
+      }
+
+      ScuConnection* poConnection = m_queue.top().m_poConnection;
+      m_queue.pop();
+
+      /*
+       * The poll runs without lock, so the other workers can poll the
+       * other connections meanwhile.
+       */
+      lock.unlock();
+      uint delayUs;
+      try
+      {
+         delayUs = poConnection->poll();
+      }
+      catch( std::exception& e )
+      {
+         ERROR_MESSAGE( poConnection->getName() << ": " << e.what() );
+         delayUs = ERROR_RETRY_US;
+         lock.lock();
+         m_pollErrors++;
+         lock.unlock();
+      }
+      const daq::USEC_T dueTime = daq::getSysMicrosecs() + delayUs;
+      lock.lock();
+
+      m_queue.push( ITEM_T{ dueTime, poConnection } );
+      m_wakeUp.notify_one();
+   }
+}
+
+//================================== EOF ======================================
@@ -0,0 +1,121 @@
+/*!
+ *  @file acqd_pool.hpp
+ *  @brief Pool of worker threads which polls the connections of the
+ *         SCU acquisition daemon.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _ACQD_POOL_HPP
+#define _ACQD_POOL_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <daq_calculations.hpp>
+#include "acqd_connection.hpp"
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Shared scheduler of all SCU connections.
+ *
+ * The connections are ordered by the time of their next due poll in
+ * a priority queue. Each worker takes the connection with the earliest
+ * due time, waits until it is due, polls it and puts it back with the
+ * new due time returned by ScuConnection::poll().
+ *
+ * Because a connection is removed from the queue during its poll, it
+ * becomes polled by only one worker at a time, but a SCU with a high
+ * data rate is not bound to a particular thread. The number of threads
+ * is independent of the number of SCUs, so the etherbone latency of one
+ * SCU doesn't delay the other SCUs as long as enough workers are free.
+ */
+class ConnectionPool
+{
+   /*!
+    * @brief Waiting time in microseconds after a failed poll.
+    */
+   static constexpr uint ERROR_RETRY_US = 1000000;
+
+   struct ITEM_T
+   {
+      daq::USEC_T    m_dueTime;
+      ScuConnection* m_poConnection;
+
+      bool operator>( const ITEM_T& rOther ) const
+      {
+         return m_dueTime > rOther.m_dueTime;
+      }
+   };
+
+   using QUEUE_T = std::priority_queue<ITEM_T, std::vector<ITEM_T>, std::greater<ITEM_T>>;
+
+   QUEUE_T                  m_queue;
+   std::mutex               m_oMutex;
+   std::condition_variable  m_wakeUp;
+   std::vector<std::thread> m_vWorkers;
+   bool                     m_stop;
+   uint64_t                 m_pollErrors;
+
+   void workerLoop( void );
+
+public:
+   ConnectionPool( void );
+   ~ConnectionPool( void );
+
+   /*!
+    * @brief Adds a connection which becomes polled immediately.
+    * @note The connection is not owned by this object, it has to exist
+    *       as long as the pool is running.
+    */
+   void add( ScuConnection* poConnection );
+
+   /*!
+    * @brief Starts the given number of worker threads.
+    */
+   void start( const uint numWorkers );
+
+   /*!
+    * @brief Stops all worker threads, a running poll becomes finished
+    *        before.
+    */
+   void stop( void );
+
+   uint getNumberOfWorkers( void ) const
+   {
+      return m_vWorkers.size();
+   }
+
+   /*!
+    * @brief Returns the number of polls which has been failed by a
+    *        exception.
+    */
+   uint64_t getNumberOfPollErrors( void );
+};
+
+} // namespace Scu
+#endif // ifndef _ACQD_POOL_HPP
+//================================== EOF ======================================
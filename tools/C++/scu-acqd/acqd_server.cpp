@@ -0,0 +1,495 @@
+/*!
+ *  @file acqd_server.cpp
+ *  @brief Local socket server of the SCU acquisition daemon, distributes
+ *         the acquired data to the subscribed clients.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <assert.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <stdexcept>
+#include <algorithm>
+#include <message_macros.hpp>
+#include "acqd_server.hpp"
+
+using namespace Scu;
+using namespace std;
+
+/*!
+ * @brief Maximum length of a command line of a client.
+ */
+constexpr std::size_t MAX_COMMAND_LEN = 256;
+
+/*! ---------------------------------------------------------------------------
+ * @brief Throws a system error by evaluation of 'errno'.
+ */
+static void throwSysError( string errStr )
+{
+   errStr += " ";
+   errStr += ::strerror( errno );
+   throw runtime_error( errStr );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+static void setNonBlocking( const int fd )
+{
+   const int flags = ::fcntl( fd, F_GETFL, 0 );
+   if( (flags < 0) || (::fcntl( fd, F_SETFL, flags | O_NONBLOCK ) < 0) )
+      throwSysError( "Unable to set non-blocking mode!" );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @brief Returns true if a process is listening on the given socket.
+ */
+static bool isListening( const struct sockaddr_un& rAddr )
+{
+   const int fd = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+   if( fd < 0 )
+      throwSysError( "Unable to create socket!" );
+   const bool ret = ::connect( fd, reinterpret_cast<const struct sockaddr*>(&rAddr),
+                               sizeof( rAddr ) ) == 0;
+   ::close( fd );
+   return ret;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+SubscriptionServer::SubscriptionServer( const string& rSocketPath,
+                                        const std::size_t maxClientBuffer )
+   :m_socketPath( rSocketPath )
+   ,m_maxClientBuffer( maxClientBuffer )
+   ,m_listenFd( -1 )
+   ,m_wakeFd{ -1, -1 }
+   ,m_wakePending( false )
+   ,m_subscriptionCount( 0 )
+   ,m_stop( false )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_socketPath );
+
+   struct sockaddr_un addr;
+   ::memset( &addr, 0, sizeof( addr ) );
+   addr.sun_family = AF_UNIX;
+   if( m_socketPath.size() >= sizeof( addr.sun_path ) )
+      throw runtime_error( "Socket path too long: \"" + m_socketPath + "\"!" );
+   ::strncpy( addr.sun_path, m_socketPath.c_str(), sizeof( addr.sun_path ) - 1 );
+
+   /*
+    * An existing socket file becomes removed only when nobody is
+    * listening on it anymore, a second daemon must not steal the socket
+    * of a running one.
+    */
+   struct stat oStat;
+   if( ::lstat( m_socketPath.c_str(), &oStat ) == 0 )
+   {
+      if( !S_ISSOCK( oStat.st_mode ) )
+         throw runtime_error( "\"" + m_socketPath + "\" exists and is not a socket!" );
+      if( isListening( addr ) )
+         throw runtime_error( "Socket \"" + m_socketPath + "\" is already in use!" );
+      ::unlink( m_socketPath.c_str() );
+   }
+
+   if( ::pipe( m_wakeFd ) < 0 )
+      throwSysError( "Unable to create pipe!" );
+   setNonBlocking( m_wakeFd[0] );
+   setNonBlocking( m_wakeFd[1] );
+
+   m_listenFd = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+   if( m_listenFd < 0 )
+      throwSysError( "Unable to create socket!" );
+
+   if( ::bind( m_listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof( addr ) ) < 0 )
+      throwSysError( "Unable to bind socket \"" + m_socketPath + "\"!" );
+
+   if( ::listen( m_listenFd, SOMAXCONN ) < 0 )
+      throwSysError( "Unable to listen on socket \"" + m_socketPath + "\"!" );
+   setNonBlocking( m_listenFd );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+SubscriptionServer::~SubscriptionServer( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( m_socketPath );
+
+   stop();
+   for( auto& rClient: m_lClients )
+      closeClient( rClient );
+
+   if( m_listenFd >= 0 )
+   {
+      ::close( m_listenFd );
+      ::unlink( m_socketPath.c_str() );
+   }
+   for( const int fd: m_wakeFd )
+   {
+      if( fd >= 0 )
+         ::close( fd );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::start( void )
+{
+   assert( !m_oThread.joinable() );
+   m_stop = false;
+   m_oThread = thread( &SubscriptionServer::ioLoop, this );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::stop( void )
+{
+   if( !m_oThread.joinable() )
+      return;
+   m_stop = true;
+   wakeUp();
+   m_oThread.join();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::wakeUp( void )
+{
+   if( m_wakePending.exchange( true ) )
+      return;
+   const char c = 0;
+   if( ::write( m_wakeFd[1], &c, sizeof( c ) ) < 0 )
+   { /*
+      * Pipe is full, the I/O thread will wake up anyway.
+      */
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::addTopic( const string& rTopic )
+{
+   lock_guard<mutex> lock( m_oMutex );
+   m_topics.insert( rTopic );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool SubscriptionServer::isMatching( const string& rPattern, const string& rTopic )
+{
+   if( !rPattern.empty() && (rPattern.back() == '*') )
+      return rTopic.compare( 0, rPattern.size() - 1, rPattern, 0, rPattern.size() - 1 ) == 0;
+   return rPattern == rTopic;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+bool SubscriptionServer::isSubscribed( const string& rTopic ) const
+{
+   if( !hasSubscribers() )
+      return false;
+
+   lock_guard<mutex> lock( m_oMutex );
+   for( const auto& rClient: m_lClients )
+   {
+      for( const auto& rPattern: rClient.m_vSubscriptions )
+      {
+         if( isMatching( rPattern, rTopic ) )
+            return true;
+      }
+   }
+   return false;
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::publish( const string& rTopic, const string& rText )
+{
+   if( !hasSubscribers() || rText.empty() )
+      return;
+
+   bool doWakeUp = false;
+   {
+      lock_guard<mutex> lock( m_oMutex );
+      for( auto& rClient: m_lClients )
+      {
+         if( rClient.m_closed )
+            continue;
+         const bool subscribed = any_of( rClient.m_vSubscriptions.begin(),
+                                         rClient.m_vSubscriptions.end(),
+                                         [&rTopic]( const string& rPattern )
+                                         { return isMatching( rPattern, rTopic ); } );
+         if( !subscribed )
+            continue;
+
+         if( appendOutput( rClient, rText ) )
+            doWakeUp = true;
+      }
+   }
+
+   if( doWakeUp )
+      wakeUp();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+uint SubscriptionServer::getNumberOfClients( void ) const
+{
+   lock_guard<mutex> lock( m_oMutex );
+   return m_lClients.size();
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::accept( void )
+{
+   while( true )
+   {
+      const int fd = ::accept( m_listenFd, nullptr, nullptr );
+      if( fd < 0 )
+      {
+         if( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+            ERROR_MESSAGE( "accept: " << ::strerror( errno ) );
+         return;
+      }
+      try
+      {
+         setNonBlocking( fd );
+      }
+      catch( std::exception& e )
+      {
+         ERROR_MESSAGE( e.what() );
+         ::close( fd );
+         continue;
+      }
+      lock_guard<mutex> lock( m_oMutex );
+      m_lClients.push_back( CLIENT_T{ fd, string(), string(), {}, 0, false } );
+      DEBUG_MESSAGE( "Client connected, fd: " << fd );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @note The mutex has to be locked by the caller.
+ */
+void SubscriptionServer::closeClient( CLIENT_T& rClient )
+{
+   if( rClient.m_fd >= 0 )
+   {
+      DEBUG_MESSAGE( "Client disconnected, fd: " << rClient.m_fd );
+      ::close( rClient.m_fd );
+      rClient.m_fd = -1;
+   }
+   m_subscriptionCount -= rClient.m_vSubscriptions.size();
+   rClient.m_vSubscriptions.clear();
+   rClient.m_closed = true;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @note The mutex has to be locked by the caller.
+ */
+bool SubscriptionServer::appendOutput( CLIENT_T& rClient, const string& rText )
+{
+   if( (rClient.m_output.size() + rText.size()) > m_maxClientBuffer )
+   { /*
+      * Client is too slow, dropping the text instead of blocking
+      * the acquisition.
+      */
+      rClient.m_droppedBytes += rText.size();
+      return false;
+   }
+   rClient.m_output += rText;
+   return true;
+}
+
+/*! ---------------------------------------------------------------------------
+ * @note The mutex has to be locked by the caller.
+ */
+void SubscriptionServer::onCommand( CLIENT_T& rClient, const string& rLine )
+{
+   const std::size_t sep = rLine.find( ' ' );
+   const string command  = rLine.substr( 0, sep );
+   const string argument = (sep == string::npos)? string() : rLine.substr( sep + 1 );
+
+   if( command == "LIST" )
+   {
+      for( const auto& rTopic: m_topics )
+         appendOutput( rClient, "TOPIC " + rTopic + '\n' );
+   }
+   else if( command == "SUB" && !argument.empty() )
+   {
+      if( find( rClient.m_vSubscriptions.begin(), rClient.m_vSubscriptions.end(),
+                argument ) == rClient.m_vSubscriptions.end() )
+      {
+         rClient.m_vSubscriptions.push_back( argument );
+         m_subscriptionCount++;
+      }
+   }
+   else if( command == "UNSUB" && !argument.empty() )
+   {
+      const auto it = find( rClient.m_vSubscriptions.begin(),
+                            rClient.m_vSubscriptions.end(), argument );
+      if( it == rClient.m_vSubscriptions.end() )
+      {
+         appendOutput( rClient, "ERROR not subscribed: " + argument + '\n' );
+         return;
+      }
+      rClient.m_vSubscriptions.erase( it );
+      m_subscriptionCount--;
+   }
+   else if( command == "STAT" )
+   {
+      appendOutput( rClient, "DROPPED " + to_string( rClient.m_droppedBytes ) + '\n' );
+   }
+   else
+   {
+      appendOutput( rClient, "ERROR unknown command: " + rLine + '\n' );
+      return;
+   }
+   appendOutput( rClient, "OK\n" );
+}
+
+/*! ---------------------------------------------------------------------------
+ * @note The mutex has to be locked by the caller.
+ */
+void SubscriptionServer::receive( CLIENT_T& rClient )
+{
+   /*
+    * A single read per poll event, so a flooding client can't hold the
+    * mutex. The remainder of the input stays pending for the next event.
+    * The input buffer can't exceed MAX_COMMAND_LEN plus one byte.
+    */
+   assert( rClient.m_input.size() <= MAX_COMMAND_LEN );
+   char buffer[MAX_COMMAND_LEN + 1];
+   const ssize_t n = ::recv( rClient.m_fd, buffer,
+                             sizeof( buffer ) - rClient.m_input.size(), 0 );
+   if( n == 0 )
+   {
+      closeClient( rClient );
+      return;
+   }
+   if( n < 0 )
+   {
+      if( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+         closeClient( rClient );
+      return;
+   }
+   rClient.m_input.append( buffer, n );
+
+   std::size_t pos;
+   while( (pos = rClient.m_input.find( '\n' )) != string::npos )
+   {
+      string line = rClient.m_input.substr( 0, pos );
+      rClient.m_input.erase( 0, pos + 1 );
+      if( !line.empty() && (line.back() == '\r') )
+         line.pop_back();
+      if( !line.empty() )
+         onCommand( rClient, line );
+   }
+
+   if( rClient.m_input.size() > MAX_COMMAND_LEN )
+   {
+      ERROR_MESSAGE( "Command line of client too long, closing connection!" );
+      closeClient( rClient );
+   }
+}
+
+/*! ---------------------------------------------------------------------------
+ * @note The mutex has to be locked by the caller.
+ */
+void SubscriptionServer::send( CLIENT_T& rClient )
+{
+   if( rClient.m_output.empty() )
+      return;
+
+   const ssize_t n = ::send( rClient.m_fd, rClient.m_output.data(),
+                             rClient.m_output.size(), MSG_NOSIGNAL );
+   if( n < 0 )
+   {
+      if( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+         closeClient( rClient );
+      return;
+   }
+   rClient.m_output.erase( 0, n );
+}
+
+/*! ---------------------------------------------------------------------------
+ */
+void SubscriptionServer::ioLoop( void )
+{
+   DEBUG_MESSAGE_M_FUNCTION( "" );
+
+   vector<struct pollfd> vPollFds;
+   while( !m_stop )
+   {
+      vPollFds.clear();
+      vPollFds.push_back( { m_wakeFd[0], POLLIN, 0 } );
+      vPollFds.push_back( { m_listenFd,  POLLIN, 0 } );
+      {
+         lock_guard<mutex> lock( m_oMutex );
+         m_lClients.remove_if( []( const CLIENT_T& rClient ) { return rClient.m_closed; } );
+         for( const auto& rClient: m_lClients )
+         {
+            vPollFds.push_back( { rClient.m_fd,
+                                  static_cast<short>(POLLIN | (rClient.m_output.empty()? 0 : POLLOUT)),
+                                  0 } );
+         }
+      }
+
+      if( ::poll( vPollFds.data(), vPollFds.size(), -1 ) < 0 )
+      {
+         if( errno == EINTR )
+            continue;
+         ERROR_MESSAGE( "poll: " << ::strerror( errno ) );
+         break;
+      }
+
+      if( (vPollFds[0].revents & POLLIN) != 0 )
+      {
+         char buffer[64];
+         m_wakePending = false;
+         while( ::read( m_wakeFd[0], buffer, sizeof( buffer ) ) > 0 );
+      }
+
+      if( (vPollFds[1].revents & POLLIN) != 0 )
+         accept();
+
+      lock_guard<mutex> lock( m_oMutex );
+      std::size_t i = 2;
+      for( auto& rClient: m_lClients )
+      {
+         if( (i >= vPollFds.size()) || (vPollFds[i].fd != rClient.m_fd) )
+            break; // Client has been accepted during this cycle.
+         const short revents = vPollFds[i++].revents;
+         if( rClient.m_closed )
+            continue;
+         if( (revents & (POLLIN | POLLHUP | POLLERR)) != 0 )
+            receive( rClient );
+         if( !rClient.m_closed )
+            send( rClient ); // Published data and answers of commands.
+      }
+   }
+}
+
+//================================== EOF ======================================
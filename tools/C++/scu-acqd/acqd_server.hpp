@@ -0,0 +1,182 @@
+/*!
+ *  @file acqd_server.hpp
+ *  @brief Local socket server of the SCU acquisition daemon, distributes
+ *         the acquired data to the subscribed clients.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#ifndef _ACQD_SERVER_HPP
+#define _ACQD_SERVER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+namespace Scu
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief Publish/subscribe server on a Unix domain socket.
+ *
+ * The worker threads of the daemon publish text lines to topics, e.g.
+ * "scuxl4711/fg-39-130" or "scuxl4711/log". A client subscribes one or more
+ * topics by a line based protocol, each line is a command:
+ * @code
+ * LIST                  Lists all known topics, terminated by "OK".
+ * SUB   <topic>         Subscribes a topic, "prefix*" and "*" are allowed.
+ * UNSUB <topic>         Counterpart to SUB.
+ * STAT                  Prints the number of dropped bytes of this client.
+ * @endcode
+ * Each published line begins with its topic.
+ *
+ * All sockets are handled by a single I/O thread in non-blocking mode.
+ * The output of each client is buffered up to a limited size, when a client
+ * is too slow then the new data for this client becomes dropped and
+ * counted, so a slow client can never stall the acquisition.
+ */
+class SubscriptionServer
+{
+   /*!
+    * @brief Connection to a single client.
+    */
+   struct CLIENT_T
+   {
+      int                      m_fd;
+      std::string              m_input;
+      std::string              m_output;
+      std::vector<std::string> m_vSubscriptions;
+      uint64_t                 m_droppedBytes;
+      bool                     m_closed;
+   };
+
+   const std::string     m_socketPath;
+   const std::size_t     m_maxClientBuffer;
+   int                   m_listenFd;
+
+   /*!
+    * @brief Pipe for waking up the I/O thread when new data are present.
+    */
+   int                   m_wakeFd[2];
+   std::atomic<bool>     m_wakePending;
+
+   /*!
+    * @brief Protects m_lClients and m_topics.
+    */
+   mutable std::mutex    m_oMutex;
+   std::list<CLIENT_T>   m_lClients;
+   std::set<std::string> m_topics;
+
+   /*!
+    * @brief Number of subscriptions of all clients, allows the publishers
+    *        to skip the formatting of data nobody is interested in.
+    */
+   std::atomic<uint>     m_subscriptionCount;
+
+   std::thread           m_oThread;
+   std::atomic<bool>     m_stop;
+
+   void ioLoop( void );
+   void wakeUp( void );
+   void accept( void );
+   void receive( CLIENT_T& rClient );
+   void send( CLIENT_T& rClient );
+   bool appendOutput( CLIENT_T& rClient, const std::string& rText );
+   void onCommand( CLIENT_T& rClient, const std::string& rLine );
+   void closeClient( CLIENT_T& rClient );
+
+   static bool isMatching( const std::string& rPattern, const std::string& rTopic );
+
+public:
+   /*!
+    * @brief Constructor opens the listening socket.
+    * @param rSocketPath File name of the Unix domain socket, a stale
+    *                    socket file becomes replaced. When another process
+    *                    is listening on it, an exception will be thrown.
+    * @param maxClientBuffer Maximum number of bytes which can be buffered
+    *                        per client.
+    */
+   SubscriptionServer( const std::string& rSocketPath,
+                       const std::size_t maxClientBuffer );
+
+   /*!
+    * @brief Destructor stops the I/O thread, closes all connections and
+    *        removes the socket file.
+    */
+   ~SubscriptionServer( void );
+
+   /*!
+    * @brief Starts the I/O thread.
+    */
+   void start( void );
+
+   /*!
+    * @brief Stops the I/O thread.
+    */
+   void stop( void );
+
+   /*!
+    * @brief Makes a topic known for the command LIST.
+    */
+   void addTopic( const std::string& rTopic );
+
+   /*!
+    * @brief Returns true if at least one client has subscribed anything.
+    * @note Fast check without locking.
+    */
+   bool hasSubscribers( void ) const
+   {
+      return m_subscriptionCount.load( std::memory_order_relaxed ) != 0;
+   }
+
+   /*!
+    * @brief Returns true if at least one client has subscribed the
+    *        given topic.
+    */
+   bool isSubscribed( const std::string& rTopic ) const;
+
+   /*!
+    * @brief Sends the given text to all clients which have subscribed
+    *        the given topic.
+    * @param rTopic Topic of the text.
+    * @param rText One or more complete lines, each terminated by '\\n'.
+    */
+   void publish( const std::string& rTopic, const std::string& rText );
+
+   /*!
+    * @brief Returns the number of currently connected clients.
+    */
+   uint getNumberOfClients( void ) const;
+
+   const std::string& getSocketPath( void ) const
+   {
+      return m_socketPath;
+   }
+};
+
+} // namespace Scu
+#endif // ifndef _ACQD_SERVER_HPP
+//================================== EOF ======================================
@@ -0,0 +1,132 @@
+/*!
+ *  @file scu-acqd.cpp
+ *  @brief Main module of the acquisition daemon for several SCUs.
+ *
+ *  Each SCU becomes served by a connection object containing its function
+ *  generator feedback channels and optionally its LM32 log daemon.
+ *  All connections are polled by a shared pool of worker threads, the
+ *  received data can be subscribed by local clients via a Unix domain socket.
+ *
+ *  @date 16.10.2026
+ *  @copyright (C) 2026 GSI Helmholtz Centre for Heavy Ion Research GmbH
+ *
+ *  @author Ulrich Becker <u.becker@gsi.de>
+ *
+ ******************************************************************************
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************
+ */
+#include <exception>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <message_macros.hpp>
+#include "acqd_cmdline.hpp"
+#include "acqd_server.hpp"
+#include "acqd_connection.hpp"
+#include "acqd_pool.hpp"
+
+#ifndef CONFIG_OECORE_SDK_VERSION
+   #warning "CAUTION: Module becomes not build by YOCTO SDK !"
+#endif
+
+using namespace std;
+using namespace Scu;
+
+/*! ---------------------------------------------------------------------------
+ */
+int main( int argc, char** ppArgv )
+{
+   DEBUG_MESSAGE_FUNCTION("");
+   try
+   {
+      AcqdCommandLine oCmdLine( argc, ppArgv );
+
+      /*
+       * The signals for termination becomes blocked before any thread
+       * has been started, so all threads inherit this mask and the
+       * signals can be received by the main thread only.
+       */
+      sigset_t sigSet;
+      ::sigemptyset( &sigSet );
+      ::sigaddset( &sigSet, SIGTERM );
+      ::sigaddset( &sigSet, SIGINT );
+      const int status = ::pthread_sigmask( SIG_BLOCK, &sigSet, nullptr );
+      if( status != 0 )
+         throw runtime_error( string( "Can't block the signals SIGTERM and SIGINT: " )
+                              + ::strerror( status ) );
+
+      SubscriptionServer oServer( oCmdLine.getSocketPath(),
+                                  oCmdLine.getMaxClientBuffer() );
+
+      /*
+       * Establishing the connections to all SCUs.
+       */
+      vector<unique_ptr<ScuConnection>> vConnections;
+      for( const auto& rUrl: oCmdLine.getScuUrls() )
+      {
+         vConnections.push_back( unique_ptr<ScuConnection>(
+                                 new ScuConnection( rUrl, oServer, oCmdLine ) ) );
+         if( oCmdLine.isVerbose() )
+            cout << vConnections.back()->getName() << ": "
+                 << vConnections.back()->getNumberOfChannels()
+                 << " feedback channel(s)" << endl;
+      }
+
+      ConnectionPool oPool;
+      for( const auto& pConnection: vConnections )
+         oPool.add( pConnection.get() );
+
+      oServer.start();
+      oPool.start( oCmdLine.getNumberOfWorkers() );
+
+      if( oCmdLine.isVerbose() )
+         cout << "Serving " << vConnections.size() << " SCU(s) by "
+              << oPool.getNumberOfWorkers() << " worker thread(s) on socket \""
+              << oServer.getSocketPath() << "\"." << endl;
+
+      int sigNo;
+      ::sigwait( &sigSet, &sigNo );
+      DEBUG_MESSAGE( "Signal " << sigNo << " received." );
+
+      oPool.stop();
+      oServer.stop();
+
+      if( oCmdLine.isVerbose() )
+      {
+         for( const auto& pConnection: vConnections )
+            cout << pConnection->getName() << ": " << pConnection->getPollCount()
+                 << " polls" << endl;
+         cout << "Failed polls: " << oPool.getNumberOfPollErrors() << endl;
+         cout << "Process: \"" << oCmdLine.getProgramName() << "\" terminated." << endl;
+      }
+   }
+   catch( std::exception& e )
+   {
+      ERROR_MESSAGE( e.what() );
+      return EXIT_FAILURE;
+   }
+   catch( ... )
+   {
+      ERROR_MESSAGE( "Undefined exception occurred!" );
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
+
+//================================== EOF ======================================
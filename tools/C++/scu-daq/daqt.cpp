@@ -543,10 +543,33 @@ DaqContainer::~DaqContainer( void )
    if( m_poCommandLine->isVerbose() )
       cout << "End " << getScuDomainName() << endl;
 
+   DaqRecorder* poRecorder = getRecorder();
+   if( poRecorder != nullptr )
+   {
+      setRecorder( nullptr );
+      try
+      {
+         poRecorder->close();
+      }
+      catch( std::exception& e )
+      {
+         ERROR_MESSAGE( e.what() );
+      }
+      delete poRecorder;
+   }
+
    if( isDoReset() )
       sendReset();
 }
 
+/*! ---------------------------------------------------------------------------
+ */
+void DaqContainer::startRecording( const std::string& rFileName )
+{
+   assert( getRecorder() == nullptr );
+   setRecorder( new DaqRecorder( rFileName, "daqt " + getScuDomainName() ) );
+}
+
 /*! ---------------------------------------------------------------------------
  */
 bool DaqContainer::checkCommandLineParameter( void )
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <daq_administration.hpp>
 #include <daqt_attributes.hpp>
+#include <daq_recorder.hpp>
 #include <string>
 #include <iostream>
 #include <gnuplotstream.hpp>
@@ -94,6 +95,13 @@ public:
       return m_poCommandLine;
    }
 
+   /*!
+    * @brief Starts the recording of all received blocks in the given file.
+    * @see DaqRecorder
+    * @see DaqAdministration::setRecorder
+    */
+   void startRecording( const std::string& rFileName );
+
    Device* getDeviceBySlot( unsigned int slot );
 
    bool checkCommandLineParameter( void );
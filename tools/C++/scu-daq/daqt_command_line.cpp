@@ -25,6 +25,7 @@
 #include <sstream>
 #ifndef __DOCFSM__
  #include <daqt_onFoundProcess.hpp>
+ #include <scu_wb_histogram.hpp>
 #endif
 
 #include "daqt_command_line.hpp"
@@ -613,6 +614,53 @@ vector<OPTION> CommandLine::c_optList =
                     ESC_BOLD "-y=,0xDACAFFEE" ESC_NORMAL "  Will send the default offset time of "
                     TO_STRING( __DAQ_DEFAULT_SYNC_TIMEOFFSET__ ) " milliseconds "
                     "and the ECA-tag of 0xDACAFFEE.\n"
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::showAtExit( poParser->getOptArg() );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::OPTIONAL_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "wb-histogram",
+      .m_helpText = "Prints the latency histograms of all wishbone accesses"
+                    " at the end of the program.\n"
+                    "PARAM: =<file name>\n"
+                    "If PARAM is given, then the histograms becomes written in"
+                    " JSON-lines format in this file instead, e.g. for offline"
+                    " comparison of several runs."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         WbHistogram::get().setEnabled( false );
+         return 0;
+      }),
+      .m_hasArg   = OPTION::NO_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "no-wb-histogram",
+      .m_helpText = "Switches the recording of the latency histograms of the"
+                    " wishbone accesses off."
+   },
+   {
+      OPT_LAMBDA( poParser,
+      {
+         static_cast<CommandLine*>(poParser)->m_recordFileName = poParser->getOptArg();
+         return 0;
+      }),
+      .m_hasArg   = OPTION::REQUIRED_ARG,
+      .m_id       = 0,
+      .m_shortOpt = '\0',
+      .m_longOpt  = "record",
+      .m_helpText = "Records all received DAQ blocks including its device"
+                    " descriptors in the binary file given by PARAM.\n"
+                    "The file is organized in chunks with a index of the"
+                    " timestamp- and sequence range of each channel, so it"
+                    " can be mapped in the memory and accessed randomly by"
+                    " timestamp."
    }
 };
 
@@ -712,6 +760,8 @@ DaqContainer* CommandLine::operator()( void )
    if( m_poAllDaq->checkForAttributeConflicts() )
       return nullptr;
    m_poAllDaq->sendAttributes();
+   if( !m_recordFileName.empty() )
+      m_poAllDaq->startRecording( m_recordFileName );
    return m_poAllDaq;
 }
 
@@ -751,7 +801,8 @@ int CommandLine::onArgument( void )
       case READ_EB_NAME:
       {
          SCU_ASSERT( m_poAllDaq == nullptr );
-         if( arg.find( "tcp/" ) == string::npos )
+         if( (arg.find( "tcp/" ) == string::npos) &&
+             !FeSupport::Scu::Etherbone::isSimulatorAddress( arg ) )
             arg = "tcp/" + arg;
 #if 0
          //TODO Doesn't works yet!
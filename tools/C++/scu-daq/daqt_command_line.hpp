@@ -65,6 +65,7 @@ class CommandLine: public PARSER
    std::string    m_gnuplotBin;
    std::string    m_gnuplotTerminal;
    std::string    m_gnuplotOutput;
+   std::string    m_recordFileName;
 
    static bool readInteger( unsigned int&, const std::string& );
 
@@ -115,6 +116,11 @@ public:
    {
       return !m_gnuplotOutput.empty();
    }
+
+   const std::string& getRecordFileName( void ) const
+   {
+      return m_recordFileName;
+   }
 };
 
 } // namespace daqt